@@ -419,6 +419,14 @@
 // Lossless compression with Zstandard algorithm
 # include <Siv3D/Compression.hpp>
 
+// Zstandard の圧縮用辞書
+// Dictionary for Zstandard compression
+# include <Siv3D/CompressionDictionary.hpp>
+
+// Zstandard の圧縮・展開コンテキスト
+// Reusable Zstandard compression contexts
+# include <Siv3D/Compressor.hpp>
+
 //// アーカイブファイルからの読み込み
 //# include <Siv3D/ArchivedFileReader.hpp>
 
@@ -538,6 +546,12 @@
 // 複数の多角形
 # include <Siv3D/MultiPolygon.hpp>
 
+// 当たり判定を高速に行うための前処理を済ませた多角形
+# include <Siv3D/PreparedPolygon.hpp>
+
+// 変更のあった部分だけを計算し直す多角形の集合演算
+# include <Siv3D/IncrementalMultiPolygon.hpp>
+
 // 2 次ベジェ曲線
 # include <Siv3D/Bezier2.hpp>
 
@@ -758,6 +772,9 @@
 // 音声波形
 # include <Siv3D/Wave.hpp>
 
+// 省メモリな音声波形
+# include <Siv3D/CompactWave.hpp>
+
 // Sound Font
 # include <Siv3D/SoundFont.hpp>
 
@@ -878,6 +895,10 @@
 // Profiling
 # include <Siv3D/Profiler.hpp>
 
+// フレームプロファイラー
+// Frame profiler
+# include <Siv3D/FrameProfiler.hpp>
+
 // プロセス
 // Process
 # include <Siv3D/Process.hpp>
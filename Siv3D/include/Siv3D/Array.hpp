@@ -24,10 +24,8 @@
 # include "DefaultRNG.hpp"
 
 # ifdef SIV3D_CONCURRENT
+	# include <atomic>
 	# include <future>
-	# if SIV3D_PLATFORM(WINDOWS)
-	#	include <execution>
-	# endif
 # endif
 
 namespace s3d
@@ -2135,73 +2133,27 @@ namespace s3d
 		/// <param name="f">
 		/// 条件を記述した関数
 		/// </param>
-		/// <param name="numThreads">
-		/// 使用するスレッド数の最大数
-		/// </param>
 		/// <returns>
 		/// 見つかった要素の個数
 		/// </returns>
 		template <class Fty, std::enable_if_t<std::is_invocable_r_v<bool, Fty, Type>>* = nullptr>
 		[[nodiscard]] size_t parallel_count_if(Fty f) const
 		{
-		# if SIV3D_PLATFORM(WINDOWS)
-
-			return std::count_if(std::execution::par, begin(), end(), f);
-
-		# else
-
 			if (isEmpty())
 			{
 				return 0;
 			}
 
-			const size_t numThreads = Threading::GetConcurrency();
+			std::atomic<size_t> result = 0;
 
-			if (numThreads <= 1)
+			auto countRange = [this, &f, &result](const size_t first, const size_t last)
 			{
-				return count_if(f);
-			}
-
-			const size_t countPerthread = Max<size_t>(1, (size() + (numThreads - 1)) / numThreads);
+				result += std::count_if(begin() + first, begin() + last, f);
+			};
 
-			Array<std::future<std::ptrdiff_t>> futures;
-
-			auto it = begin();
-			size_t countLeft = size();
-
-			for (size_t i = 0; i < (numThreads - 1); ++i)
-			{
-				const size_t n = Min(countPerthread, countLeft);
-
-				if (n == 0)
-				{
-					break;
-				}
-
-				futures.emplace_back(std::async(std::launch::async, [=, &f]()
-				{
-					return std::count_if(it, it + n, f);
-				}));
-
-				it += n;
-				countLeft -= n;
-			}
-
-			size_t result = 0;
-		
-			if (countLeft)
-			{
-				result = std::count_if(it, it + countLeft, f);
-			}
-
-			for (auto& future : futures)
-			{
-				result += future.get();
-			}
+			detail::ParallelForRange(0, size(), countRange, 0);
 
 			return result;
-
-		# endif
 		}
 
 		/// <summary>
@@ -2210,140 +2162,52 @@ namespace s3d
 		/// <param name="f">
 		/// 各要素への参照を引数にとる関数
 		/// </param>
-		/// <param name="numThreads">
-		/// 使用するスレッド数の最大数
-		/// </param>
-		/// <returns>
-		/// *this
-		/// </returns>
 		template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, Type&>>* = nullptr>
 		void parallel_each(Fty f)
 		{
-		# if SIV3D_PLATFORM(WINDOWS)
-
-			std::for_each(std::execution::par, begin(), end(), f);
-
-		# else
-
 			if (isEmpty())
 			{
 				return;
 			}
 
-			const size_t numThreads = Threading::GetConcurrency();
-
-			if (numThreads <= 1)
+			auto eachRange = [this, &f](const size_t first, const size_t last)
 			{
-				return each(f);
-			}
+				const auto itEnd = begin() + last;
 
-			const size_t countPerthread = Max<size_t>(1, (size() + (numThreads - 1)) / numThreads);
-
-			Array<std::future<std::ptrdiff_t>> futures;
-
-			auto it = begin();
-			size_t countLeft = size();
-
-			for (size_t i = 0; i < (numThreads - 1); ++i)
-			{
-				const size_t n = Min(countPerthread, countLeft);
-
-				if (n == 0)
+				for (auto it = begin() + first; it != itEnd; ++it)
 				{
-					break;
+					f(*it);
 				}
+			};
 
-				futures.emplace_back(std::async(std::launch::async, [=, &f]()
-				{
-					std::for_each(it, it + n, f);
-				}));
-
-				it += n;
-				countLeft -= n;
-			}
-
-			if (countLeft)
-			{
-				std::for_each(it, it + countLeft, f);
-			}
-
-			for (auto& future : futures)
-			{
-				future.get();
-			}
-
-		# endif
+			detail::ParallelForRange(0, size(), eachRange, 0);
 		}
 
 		/// <summary>
-		/// 配列の各要素への参照を引数に、並列化して関数を呼び出します。
+		/// 配列の各要素を引数に、並列化して関数を呼び出します。
 		/// </summary>
 		/// <param name="f">
-		/// 各要素への参照を引数にとる関数
-		/// </param>
-		/// <param name="numThreads">
-		/// 使用するスレッド数の最大数
+		/// 各要素を引数にとる関数
 		/// </param>
-		/// <returns>
-		/// *this
-		/// </returns>
 		template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, Type>>* = nullptr>
 		void parallel_each(Fty f) const
 		{
-		# if SIV3D_PLATFORM(WINDOWS)
-
-			std::for_each(std::execution::par, begin(), end(), f);
-
-		# else
-
 			if (isEmpty())
 			{
 				return;
 			}
 
-			const size_t numThreads = Threading::GetConcurrency();
-
-			if (numThreads <= 1)
+			auto eachRange = [this, &f](const size_t first, const size_t last)
 			{
-				return each(f);
-			}
-
-			const size_t countPerthread = Max<size_t>(1, (size() + (numThreads - 1)) / numThreads);
+				const auto itEnd = begin() + last;
 
-			Array<std::future<std::ptrdiff_t>> futures;
-
-			auto it = begin();
-			size_t countLeft = size();
-
-			for (size_t i = 0; i < (numThreads - 1); ++i)
-			{
-				const size_t n = Min(countPerthread, countLeft);
-
-				if (n == 0)
+				for (auto it = begin() + first; it != itEnd; ++it)
 				{
-					break;
+					f(*it);
 				}
+			};
 
-				futures.emplace_back(std::async(std::launch::async, [=, &f]()
-				{
-					std::for_each(it, it + n, f);
-				}));
-
-				it += n;
-				countLeft -= n;
-			}
-
-			if (countLeft)
-			{
-				std::for_each(it, it + countLeft, f);
-			}
-
-			for (auto& future : futures)
-			{
-				future.get();
-			}
-
-		# endif
+			detail::ParallelForRange(0, size(), eachRange, 0);
 		}
 
 		/// <summary>
@@ -2352,9 +2216,6 @@ namespace s3d
 		/// <param name="f">
 		/// 各要素に適用する関数
 		/// </param>
-		/// <param name="numThreads">
-		/// 使用するスレッド数の最大数
-		/// </param>
 		/// <returns>
 		/// 配列の各要素に関数を適用した戻り値からなる配列
 		/// </returns>
@@ -2368,61 +2229,20 @@ namespace s3d
 				return Array<Ret>{};
 			}
 
-			const size_t numThreads = Threading::GetConcurrency();
-
-			if (numThreads <= 1)
-			{
-				return map(f);
-			}
-
 			Array<Ret> new_array(size());
 
-			const size_t countPerthread = Max<size_t>(1, (size() + (numThreads - 1)) / numThreads);
-
-			Array<std::future<void>> futures;
-
-			auto itDst = new_array.begin();
-			auto itSrc = begin();
-			size_t countLeft = size();
-
-			for (size_t i = 0; i < (numThreads - 1); ++i)
-			{
-				const size_t n = Min(countPerthread, countLeft);
-
-				if (n == 0)
-				{
-					break;
-				}
-
-				futures.emplace_back(std::async(std::launch::async, [=, &f]() mutable
-				{
-					const auto itSrcEnd = itSrc + n;
-
-					while (itSrc != itSrcEnd)
-					{
-						*itDst++ = f(*itSrc++);
-					}
-				}));
-
-				itDst += n;
-				itSrc += n;
-				countLeft -= n;
-			}
-
-			if (countLeft)
+			auto mapRange = [this, &f, &new_array](const size_t first, const size_t last)
 			{
-				const auto itSrcEnd = end();
+				auto itDst = new_array.begin() + first;
+				const auto itSrcEnd = begin() + last;
 
-				while (itSrc != itSrcEnd)
+				for (auto itSrc = begin() + first; itSrc != itSrcEnd; ++itSrc)
 				{
-					*itDst++ = f(*itSrc++);
+					*itDst++ = f(*itSrc);
 				}
-			}
+			};
 
-			for (auto& future : futures)
-			{
-				future.get();
-			}
+			detail::ParallelForRange(0, size(), mapRange, 0);
 
 			return new_array;
 		}
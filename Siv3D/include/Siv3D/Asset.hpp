@@ -13,6 +13,8 @@
 # include "Fwd.hpp"
 # include "Array.hpp"
 # include "String.hpp"
+# include "Duration.hpp"
+# include "Optional.hpp"
 
 namespace s3d
 {
@@ -34,6 +36,11 @@ namespace s3d
 
 		bool loadAsync = false;
 
+		/// <summary>
+		/// 非同期ロードの優先度（大きいほど先にロードされる）
+		/// </summary>
+		int32 loadPriority = 0;
+
 		[[nodiscard]] static AssetParameter Default();
 
 		[[nodiscard]] static AssetParameter LoadImmediately();
@@ -43,6 +50,24 @@ namespace s3d
 		[[nodiscard]] AssetParameter withTag(const AssetTag& tag) const;
 
 		[[nodiscard]] AssetParameter withTag(const Array<AssetTag>& _tags) const;
+
+		[[nodiscard]] AssetParameter withPriority(int32 priority) const;
+	};
+
+	/// <summary>
+	/// 非同期ロードにかかった時間
+	/// </summary>
+	struct AssetLoadingTime
+	{
+		/// <summary>
+		/// ロード待ちのキューに入っていた時間
+		/// </summary>
+		MicrosecondsF queueTime{ 0.0 };
+
+		/// <summary>
+		/// ロード処理そのものにかかった時間
+		/// </summary>
+		MicrosecondsF loadTime{ 0.0 };
 	};
 
 	/// <summary>
@@ -102,5 +127,11 @@ namespace s3d
 		[[nodiscard]] bool isPreloaded() const;
 
 		[[nodiscard]] bool loadSucceeded() const;
+
+		void prioritize();
+
+		bool cancelLoading();
+
+		[[nodiscard]] const Optional<AssetLoadingTime>& getLoadingTime() const;
 	};
 }
@@ -15,6 +15,7 @@
 # include "Optional.hpp"
 # include "AssetHandle.hpp"
 # include "Wave.hpp"
+# include "CompactWave.hpp"
 # include "Duration.hpp"
 # include "NamedParameter.hpp"
 
@@ -59,6 +60,16 @@ namespace s3d
 
 		using IDType = AudioHandle::IDWrapperType;
 
+		/// <summary>
+		/// ファイルを少しずつデコードしながら再生することを示すタグ
+		/// </summary>
+		struct FileStreaming {};
+
+		/// <summary>
+		/// ファイルを少しずつデコードしながら再生することを示すタグ
+		/// </summary>
+		static constexpr FileStreaming Stream{};
+
 		/// <summary>
 		/// デフォルトコンストラクタ
 		/// </summary>
@@ -106,6 +117,43 @@ namespace s3d
 
 		Audio(const FilePath& path, Arg::loopBegin_<Duration> loopBegin, Arg::loopEnd_<Duration> loopEnd);
 
+		/// <summary>
+		/// ファイルをすべてデコードせずに、再生しながら少しずつデコードするオーディオを作成します。
+		/// </summary>
+		/// <param name="path">
+		/// 音声ファイルのパス（Ogg Vorbis, Linux では MP3, AAC も）
+		/// </param>
+		/// <remarks>
+		/// メモリ上に保持するのは再生位置付近のサンプルだけなので、長い BGM に向いています。
+		/// 対応していない形式やプラットフォームでは、すべてデコードしたオーディオを作成します。
+		/// ストリーミング再生のオーディオでは getWave() は空の Wave を返し、playOneShot() は何もしません。
+		/// </remarks>
+		Audio(FileStreaming, const FilePath& path);
+
+		Audio(FileStreaming, const FilePath& path, Arg::loop_<bool> loop);
+
+		Audio(FileStreaming, const FilePath& path, Arg::loopBegin_<uint64> loopBegin);
+
+		Audio(FileStreaming, const FilePath& path, Arg::loopBegin_<uint64> loopBegin, Arg::loopEnd_<uint64> loopEnd);
+
+		/// <summary>
+		/// CompactWave のサンプルを、再生しながら float に変換するオーディオを作成します。
+		/// </summary>
+		/// <param name="wave">
+		/// 波形データ
+		/// </param>
+		/// <remarks>
+		/// 対応していないプラットフォームでは、Wave に変換したオーディオを作成します。
+		/// CompactWave から作成したオーディオでは getWave() は空の Wave を返し、getCompactWave() で波形データにアクセスします。
+		/// </remarks>
+		explicit Audio(CompactWave&& wave);
+
+		Audio(CompactWave&& wave, Arg::loop_<bool> loop);
+
+		explicit Audio(const CompactWave& wave);
+
+		Audio(const CompactWave& wave, Arg::loop_<bool> loop);
+
 		Audio(GMInstrument instrumrnt, uint8 key, const Duration& duration, double velocity = 1.0, Arg::samplingRate_<uint32> samplingRate = Wave::DefaultSamplingRate, float silenceValue = 0.01f);
 
 		explicit Audio(IReader&& reader, AudioFormat format = AudioFormat::Unspecified);
@@ -199,6 +247,19 @@ namespace s3d
 		/// </summary>
 		[[nodiscard]] double lengthSec() const;
 
+		/// <summary>
+		/// ファイルを少しずつデコードしながら再生するオーディオであるかを返します。
+		/// </summary>
+		[[nodiscard]] bool isStreaming() const;
+
+		/// <summary>
+		/// オーディオがサンプルを保持するために確保しているメモリのバイト数を返します。
+		/// </summary>
+		/// <remarks>
+		/// ストリーミング再生の場合はリングバッファとデコーダの作業領域の合計です。
+		/// </remarks>
+		[[nodiscard]] size_t residentBytes() const;
+
 		/// <summary>
 		/// 波形データにアクセスします。
 		/// </summary>
@@ -207,6 +268,14 @@ namespace s3d
 		/// </returns>
 		[[nodiscard]] const Wave& getWave() const;
 
+		/// <summary>
+		/// CompactWave から作成したオーディオの波形データにアクセスします。
+		/// </summary>
+		/// <returns>
+		/// サウンドの波形データへの参照。CompactWave から作成していない場合は空
+		/// </returns>
+		[[nodiscard]] const CompactWave& getCompactWave() const;
+
 		/// <summary>
 		/// 再生位置を変更します。
 		/// </summary>
@@ -796,29 +796,14 @@ namespace s3d
 				return 0;
 			}
 
-			const size_t n = std::max<size_t>(1, size() / std::max<size_t>(1, numThreads));
+			std::atomic<size_t> result = 0;
 
-			Array<std::future<std::ptrdiff_t>> futures;
-
-			auto it = begin();
-			const auto last = end();
-
-			for (; it < last - n; it += n)
+			auto countRange = [this, &f, &result](const size_t first, const size_t last)
 			{
-				futures.emplace_back(std::async(std::launch::async, [=, &f]()
-				{
-					return std::count_if(it, it + n, f);
-				}));
-			}
+				result += std::count_if(begin() + first, begin() + last, f);
+			};
 
-			std::for_each(it, last, f);
-
-			size_t result = 0;
-
-			for (auto& future : futures)
-			{
-				result += future.get();
-			}
+			detail::ParallelForRange(0, size(), countRange, parallelGrainSize(numThreads));
 
 			return result;
 		}
@@ -831,27 +816,17 @@ namespace s3d
 				return *this;
 			}
 
-			const size_t n = std::max<size_t>(1, size() / std::max<size_t>(1, numThreads));
-
-			Array<std::future<void>> futures;
-
-			auto it = begin();
-			const auto last = end();
-
-			for (; it < last - n; it += n)
+			auto eachRange = [this, &f](const size_t first, const size_t last)
 			{
-				futures.emplace_back(std::async(std::launch::async, [=, &f]()
-				{
-					std::for_each(it, it + n, f);
-				}));
-			}
+				const auto itEnd = begin() + last;
 
-			std::for_each(it, last, f);
+				for (auto it = begin() + first; it != itEnd; ++it)
+				{
+					f(*it);
+				}
+			};
 
-			for (auto& future : futures)
-			{
-				future.wait();
-			}
+			detail::ParallelForRange(0, size(), eachRange, parallelGrainSize(numThreads));
 
 			return *this;
 		}
@@ -864,27 +839,17 @@ namespace s3d
 				return *this;
 			}
 
-			const size_t n = std::max<size_t>(1, size() / std::max<size_t>(1, numThreads));
-
-			Array<std::future<void>> futures;
-
-			auto it = begin();
-			const auto last = end();
-
-			for (; it < last - n; it += n)
+			auto eachRange = [this, &f](const size_t first, const size_t last)
 			{
-				futures.emplace_back(std::async(std::launch::async, [=, &f]()
+				const auto itEnd = begin() + last;
+
+				for (auto it = begin() + first; it != itEnd; ++it)
 				{
-					std::for_each(it, it + n, f);
-				}));
-			}
+					f(*it);
+				}
+			};
 
-			std::for_each(it, last, f);
-
-			for (auto& future : futures)
-			{
-				future.wait();
-			}
+			detail::ParallelForRange(0, size(), eachRange, parallelGrainSize(numThreads));
 
 			return *this;
 		}
@@ -901,38 +866,35 @@ namespace s3d
 
 			new_array.resize(size());
 
-			const size_t n = std::max<size_t>(1, size() / std::max<size_t>(1, numThreads));
+			auto mapRange = [this, &f, &new_array](const size_t first, const size_t last)
+			{
+				auto itDst = new_array.begin() + first;
+				const auto itSrcEnd = begin() + last;
 
-			Array<std::future<void>> futures;
+				for (auto itSrc = begin() + first; itSrc != itSrcEnd; ++itSrc)
+				{
+					*itDst++ = f(*itSrc);
+				}
+			};
 
-			auto itSrc = begin();
-			const auto itSrcEnd = end();
-			auto itDst = new_array.begin();
+			detail::ParallelForRange(0, size(), mapRange, parallelGrainSize(numThreads));
 
-			for (; itSrc < itSrcEnd - n; itSrc += n, itDst += n)
-			{
-				futures.emplace_back(std::async(std::launch::async, [=, &f]() mutable
-				{
-					const auto itSrcEnd = itSrc + n;
+			return new_array;
+		}
 
-					while (itSrc != itSrcEnd)
-					{
-						*itDst++ = f(*itSrc++);
-					}
-				}));
-			}
+	private:
 
-			while (itSrc != itSrcEnd)
+		// numThreads がサポートされるスレッド数より少ない場合は、分割数がそれを超えないようにする
+		[[nodiscard]] size_t parallelGrainSize(const size_t numThreads) const noexcept
+		{
+			if (numThreads >= Threading::GetConcurrency())
 			{
-				*itDst++ = f(*itSrc++);
+				return 0;
 			}
 
-			for (auto& future : futures)
-			{
-				future.wait();
-			}
+			const size_t n = std::max<size_t>(1, numThreads);
 
-			return new_array;
+			return ((size() + (n - 1)) / n);
 		}
 
 	# endif
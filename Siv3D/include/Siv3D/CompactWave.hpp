@@ -0,0 +1,195 @@
+//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include "Fwd.hpp"
+# include "Array.hpp"
+# include "WaveSample.hpp"
+# include "Wave.hpp"
+
+namespace s3d
+{
+	/// <summary>
+	/// CompactWave が保持するサンプルの形式
+	/// </summary>
+	enum class WaveSampleFormat : uint8
+	{
+		/// <summary>
+		/// 16 ビット整数
+		/// </summary>
+		S16,
+
+		/// <summary>
+		/// 32 ビット浮動小数点数
+		/// </summary>
+		F32,
+	};
+
+	/// <summary>
+	/// サンプルの形式・チャンネル数・サンプリングレートを元の音声のまま保持する波形データ
+	/// </summary>
+	/// <remarks>
+	/// Wave は 1 サンプルあたり 8 バイト（float のステレオ）を使いますが、
+	/// CompactWave は 16 ビットのモノラルなら 2 バイトで保持します。
+	/// 再生や FFT では、必要な範囲だけをその場で float に変換します。
+	/// </remarks>
+	class CompactWave
+	{
+	private:
+
+		Array<int16> m_s16;
+
+		Array<float> m_f32;
+
+		size_t m_samples = 0;
+
+		uint32 m_samplingRate = Wave::DefaultSamplingRate;
+
+		uint32 m_channels = 2;
+
+		WaveSampleFormat m_format = WaveSampleFormat::S16;
+
+	public:
+
+		CompactWave() = default;
+
+		/// <summary>
+		/// Wave から CompactWave を作成します。
+		/// </summary>
+		/// <param name="wave">
+		/// 波形データ
+		/// </param>
+		/// <param name="format">
+		/// サンプルの形式
+		/// </param>
+		/// <remarks>
+		/// すべてのサンプルで左右の値が等しい場合はモノラルで保持します。
+		/// </remarks>
+		explicit CompactWave(const Wave& wave, WaveSampleFormat format = WaveSampleFormat::S16);
+
+		/// <summary>
+		/// Wave から CompactWave を作成します。
+		/// </summary>
+		/// <param name="wave">
+		/// 波形データ
+		/// </param>
+		/// <param name="format">
+		/// サンプルの形式
+		/// </param>
+		/// <param name="mono">
+		/// true の場合、左右の平均をモノラルで保持する
+		/// </param>
+		CompactWave(const Wave& wave, WaveSampleFormat format, bool mono);
+
+		/// <summary>
+		/// 音声ファイルを読み込んで CompactWave を作成します。
+		/// </summary>
+		/// <param name="path">
+		/// 音声ファイルのパス
+		/// </param>
+		/// <param name="format">
+		/// サンプルの形式
+		/// </param>
+		explicit CompactWave(const FilePath& path, WaveSampleFormat format = WaveSampleFormat::S16);
+
+		/// <summary>
+		/// 16 ビット整数のサンプル列から CompactWave を作成します。
+		/// </summary>
+		/// <param name="samples">
+		/// チャンネル順に並んだサンプル列
+		/// </param>
+		/// <param name="channels">
+		/// チャンネル数（1 または 2）
+		/// </param>
+		/// <param name="samplingRate">
+		/// サンプリングレート
+		/// </param>
+		CompactWave(Array<int16>&& samples, size_t channels, Arg::samplingRate_<uint32> samplingRate);
+
+		[[nodiscard]] bool isEmpty() const noexcept
+		{
+			return (m_samples == 0);
+		}
+
+		[[nodiscard]] explicit operator bool() const noexcept
+		{
+			return !isEmpty();
+		}
+
+		[[nodiscard]] uint32 samplingRate() const noexcept
+		{
+			return m_samplingRate;
+		}
+
+		[[nodiscard]] uint32 channels() const noexcept
+		{
+			return m_channels;
+		}
+
+		[[nodiscard]] WaveSampleFormat format() const noexcept
+		{
+			return m_format;
+		}
+
+		[[nodiscard]] size_t samples() const noexcept
+		{
+			return m_samples;
+		}
+
+		[[nodiscard]] size_t lengthSample() const noexcept
+		{
+			return m_samples;
+		}
+
+		[[nodiscard]] double lengthSec() const noexcept
+		{
+			return static_cast<double>(m_samples) / m_samplingRate;
+		}
+
+		/// <summary>
+		/// サンプルを保持するために確保しているメモリのバイト数を返します。
+		/// </summary>
+		[[nodiscard]] size_t size_bytes() const noexcept;
+
+		/// <summary>
+		/// pos から count サンプルを、float のステレオに変換して書き込みます。
+		/// </summary>
+		/// <param name="pos">
+		/// 読み出す位置（サンプル）
+		/// </param>
+		/// <param name="count">
+		/// 読み出すサンプル数
+		/// </param>
+		/// <param name="dst">
+		/// count サンプルを書き込める領域
+		/// </param>
+		void getSamples(size_t pos, size_t count, WaveSample* dst) const;
+
+		/// <summary>
+		/// pos から count サンプルを、左右の平均の float に変換して書き込みます。
+		/// </summary>
+		/// <param name="pos">
+		/// 読み出す位置（サンプル）
+		/// </param>
+		/// <param name="count">
+		/// 読み出すサンプル数
+		/// </param>
+		/// <param name="dst">
+		/// count 個の float を書き込める領域
+		/// </param>
+		void getMonoSamples(size_t pos, size_t count, float* dst) const;
+
+		/// <summary>
+		/// float のステレオの Wave に変換します。
+		/// </summary>
+		[[nodiscard]] Wave toWave() const;
+	};
+}
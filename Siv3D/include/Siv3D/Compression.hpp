@@ -22,13 +22,17 @@ namespace s3d
 
 		constexpr int32 MaxCompressionLevel = 22;
 
-		[[nodiscard]] ByteArray Compress(ByteArrayViewAdapter view, int32 compressionLevel = DefaultCompressionLevel);
+		// numWorkers: 圧縮に使うワーカースレッドの数。0 の場合は呼び出し元のスレッドで圧縮する
+		[[nodiscard]] ByteArray Compress(ByteArrayViewAdapter view, int32 compressionLevel = DefaultCompressionLevel, size_t numWorkers = 0);
 
-		[[nodiscard]] ByteArray CompressFile(FilePathView path, int32 compressionLevel = DefaultCompressionLevel);
+		[[nodiscard]] ByteArray CompressFile(FilePathView path, int32 compressionLevel = DefaultCompressionLevel, size_t numWorkers = 0);
 
-		bool CompressToFile(ByteArrayViewAdapter view, FilePathView outputPath, int32 compressionLevel = DefaultCompressionLevel);
+		bool CompressToFile(ByteArrayViewAdapter view, FilePathView outputPath, int32 compressionLevel = DefaultCompressionLevel, size_t numWorkers = 0);
 
-		bool CompressFileToFile(FilePathView inputPath, FilePathView outputPath, int32 compressionLevel = DefaultCompressionLevel);
+		bool CompressFileToFile(FilePathView inputPath, FilePathView outputPath, int32 compressionLevel = DefaultCompressionLevel, size_t numWorkers = 0);
+
+		// reader の現在位置から終端までを一定の大きさごとに読み込んで圧縮し、writer に書き込む
+		bool CompressStream(IReader& reader, IWriter& writer, int32 compressionLevel = DefaultCompressionLevel, size_t numWorkers = 0);
 
 		[[nodiscard]] ByteArray Decompress(ByteArrayView view);
 
@@ -37,5 +41,8 @@ namespace s3d
 		bool DecompressToFile(ByteArrayView view, FilePathView outputPath);
 
 		bool DecompressFileToFile(FilePathView inputPath, FilePathView outputPath);
+
+		// reader の現在位置から終端までを一定の大きさごとに読み込んで展開し、writer に書き込む
+		bool DecompressStream(IReader& reader, IWriter& writer);
 	}
 }
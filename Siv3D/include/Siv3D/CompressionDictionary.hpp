@@ -0,0 +1,81 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <memory>
+# include "Fwd.hpp"
+# include "Array.hpp"
+# include "ByteArrayView.hpp"
+# include "Compression.hpp"
+
+namespace s3d
+{
+	/// <summary>
+	/// Zstandard の圧縮用辞書
+	/// </summary>
+	/// <remarks>
+	/// 似た内容を持つ小さなデータを多数圧縮する場合に、圧縮率と速度を改善します。
+	/// 圧縮と展開には同じ辞書を使う必要があります。
+	/// </remarks>
+	class CompressionDictionary
+	{
+	private:
+
+		class CompressionDictionaryDetail;
+
+		std::shared_ptr<CompressionDictionaryDetail> pImpl;
+
+		friend class Compressor;
+
+		friend class Decompressor;
+
+	public:
+
+		static constexpr size_t DefaultDictionarySize = (110 * 1024);
+
+		CompressionDictionary();
+
+		explicit CompressionDictionary(ByteArrayView dictionary, int32 compressionLevel = Compression::DefaultCompressionLevel);
+
+		explicit CompressionDictionary(FilePathView path, int32 compressionLevel = Compression::DefaultCompressionLevel);
+
+		~CompressionDictionary();
+
+		[[nodiscard]] bool isEmpty() const;
+
+		[[nodiscard]] explicit operator bool() const;
+
+		[[nodiscard]] uint32 id() const;
+
+		[[nodiscard]] int32 compressionLevel() const;
+
+		[[nodiscard]] ByteArrayView view() const;
+
+		bool save(FilePathView path) const;
+
+		/// <summary>
+		/// サンプルデータから辞書を作成します。
+		/// </summary>
+		/// <param name="samples">
+		/// サンプルデータ。圧縮したいデータと似たものを数百個以上用意します。
+		/// </param>
+		/// <param name="dictionarySize">
+		/// 辞書の最大サイズ（バイト）
+		/// </param>
+		/// <param name="compressionLevel">
+		/// この辞書で圧縮するときの圧縮レベル
+		/// </param>
+		/// <returns>
+		/// 作成した辞書。失敗した場合は空の辞書
+		/// </returns>
+		[[nodiscard]] static CompressionDictionary Train(const Array<ByteArrayView>& samples, size_t dictionarySize = DefaultDictionarySize, int32 compressionLevel = Compression::DefaultCompressionLevel);
+	};
+}
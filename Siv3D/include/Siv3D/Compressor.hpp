@@ -0,0 +1,97 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <memory>
+# include "Fwd.hpp"
+# include "ByteArrayView.hpp"
+# include "Compression.hpp"
+
+namespace s3d
+{
+	/// <summary>
+	/// Zstandard の圧縮コンテキスト
+	/// </summary>
+	/// <remarks>
+	/// 作業用メモリを使い回すため、多数のデータを続けて圧縮する場合は Compression::Compress() より高速です。
+	/// 1 つの Compressor を複数のスレッドから同時に使うことはできません。
+	/// </remarks>
+	class Compressor
+	{
+	private:
+
+		class CompressorDetail;
+
+		std::shared_ptr<CompressorDetail> pImpl;
+
+	public:
+
+		/// <param name="compressionLevel">
+		/// 圧縮レベル
+		/// </param>
+		/// <param name="numWorkers">
+		/// 圧縮に使うワーカースレッドの数。0 の場合は呼び出し元のスレッドで圧縮する
+		/// </param>
+		explicit Compressor(int32 compressionLevel = Compression::DefaultCompressionLevel, size_t numWorkers = 0);
+
+		explicit Compressor(const CompressionDictionary& dictionary, size_t numWorkers = 0);
+
+		~Compressor();
+
+		[[nodiscard]] bool isOpen() const;
+
+		[[nodiscard]] explicit operator bool() const;
+
+		[[nodiscard]] ByteArray compress(ByteArrayViewAdapter view);
+
+		/// <summary>
+		/// reader の現在位置から終端までを圧縮し、writer に書き込みます。
+		/// </summary>
+		/// <remarks>
+		/// データは一定の大きさごとに読み書きされ、全体がメモリ上に置かれることはありません。
+		/// </remarks>
+		bool compress(IReader& reader, IWriter& writer);
+	};
+
+	/// <summary>
+	/// Zstandard の展開コンテキスト
+	/// </summary>
+	/// <remarks>
+	/// 1 つの Decompressor を複数のスレッドから同時に使うことはできません。
+	/// </remarks>
+	class Decompressor
+	{
+	private:
+
+		class DecompressorDetail;
+
+		std::shared_ptr<DecompressorDetail> pImpl;
+
+	public:
+
+		Decompressor();
+
+		explicit Decompressor(const CompressionDictionary& dictionary);
+
+		~Decompressor();
+
+		[[nodiscard]] bool isOpen() const;
+
+		[[nodiscard]] explicit operator bool() const;
+
+		[[nodiscard]] ByteArray decompress(ByteArrayView view);
+
+		/// <summary>
+		/// reader の現在位置から終端までを展開し、writer に書き込みます。
+		/// </summary>
+		bool decompress(IReader& reader, IWriter& writer);
+	};
+}
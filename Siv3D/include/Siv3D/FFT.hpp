@@ -11,7 +11,9 @@
 
 # pragma once
 # include "Array.hpp"
+# include "Grid.hpp"
 # include "Wave.hpp"
+# include "CompactWave.hpp"
 # include "Scene.hpp"
 
 namespace s3d
@@ -97,6 +99,91 @@ namespace s3d
 		FFTResult();
 	};
 
+	/// <summary>
+	/// STFT で各フレームに掛ける窓関数
+	/// </summary>
+	enum class FFTWindow : uint8
+	{
+		/// <summary>
+		/// 矩形窓（窓関数を掛けない）
+		/// </summary>
+		Rectangular,
+
+		/// <summary>
+		/// ハン窓
+		/// </summary>
+		Hann,
+
+		/// <summary>
+		/// ハミング窓
+		/// </summary>
+		Hamming,
+
+		/// <summary>
+		/// ブラックマン窓
+		/// </summary>
+		Blackman,
+	};
+
+	/// <summary>
+	/// STFT の設定
+	/// </summary>
+	struct STFTDesc
+	{
+		/// <summary>
+		/// 1 フレームの FFT サンプル数
+		/// </summary>
+		FFTSampleLength sampleLength = FFTSampleLength::SL2K;
+
+		/// <summary>
+		/// 隣り合うフレームの間隔（サンプル）
+		/// </summary>
+		uint32 hopSize = 512;
+
+		/// <summary>
+		/// 窓関数
+		/// </summary>
+		FFTWindow window = FFTWindow::Hann;
+	};
+
+	/// <summary>
+	/// STFT の結果
+	/// </summary>
+	struct Spectrogram
+	{
+		/// <summary>
+		/// 各フレームの振幅スペクトル。行がフレーム、列が周波数ビン
+		/// </summary>
+		Grid<float> magnitudes;
+
+		/// <summary>
+		/// 1 ビンあたりの周波数（Hz）
+		/// </summary>
+		double resolution = Wave::DefaultSamplingRate / 2048.0;
+
+		uint32 samplingRate = Wave::DefaultSamplingRate;
+
+		uint32 hopSize = 512;
+
+		[[nodiscard]] size_t num_frames() const noexcept
+		{
+			return magnitudes.height();
+		}
+
+		[[nodiscard]] size_t num_bins() const noexcept
+		{
+			return magnitudes.width();
+		}
+
+		/// <summary>
+		/// フレームの先頭の時刻（秒）を返します。
+		/// </summary>
+		[[nodiscard]] double frameTimeSec(size_t frame) const noexcept
+		{
+			return static_cast<double>(frame) * hopSize / samplingRate;
+		}
+	};
+
 	namespace FFT
 	{
 		/// <summary>
@@ -133,6 +220,23 @@ namespace s3d
 		/// </returns>
 		void Analyze(FFTResult& result, const Wave& wave, uint32 pos, FFTSampleLength sampleLength = FFTSampleLength::Default);
 
+		/// <summary>
+		/// FFT を実行します。
+		/// </summary>
+		/// <param name="wave">
+		/// 入力の波形
+		/// </param>
+		/// <param name="pos">
+		/// 波形中の位置（サンプル）
+		/// </param>
+		/// <param name="sampleLength">
+		/// FFT サンプル数
+		/// </param>
+		/// <returns>
+		/// FFT の結果
+		/// </returns>
+		void Analyze(FFTResult& result, const CompactWave& wave, uint32 pos, FFTSampleLength sampleLength = FFTSampleLength::Default);
+
 		void Analyze(FFTResult& result, const Array<WaveSampleS16>& wave, uint32 pos, uint32 samplingRate, FFTSampleLength sampleLength = FFTSampleLength::Default);
 
 		/// <summary>
@@ -154,5 +258,56 @@ namespace s3d
 		/// FFT の結果
 		/// </returns>
 		void Analyze(FFTResult& result, const float* input, uint32 length, uint32 samplingRate, FFTSampleLength sampleLength = FFTSampleLength::Default);
+
+		/// <summary>
+		/// 波形全体の STFT を実行し、スペクトログラムを作成します。
+		/// </summary>
+		/// <param name="result">
+		/// 結果を書き込むスペクトログラム。フレーム数とビン数が同じなら、確保済みのメモリをそのまま使う
+		/// </param>
+		/// <param name="input">
+		/// 入力のモノラルの波形
+		/// </param>
+		/// <param name="length">
+		/// 入力のサンプル数
+		/// </param>
+		/// <param name="samplingRate">
+		/// 入力のサンプリングレート
+		/// </param>
+		/// <param name="desc">
+		/// STFT の設定
+		/// </param>
+		/// <remarks>
+		/// フレーム i は位置 i * hopSize からの FFT サンプル数で、波形の範囲外は 0 とします。
+		/// フレームは複数のスレッドで並列に処理します。この関数と Analyze() は、複数のスレッドから同時に呼べます。
+		/// </remarks>
+		void STFT(Spectrogram& result, const float* input, size_t length, uint32 samplingRate, const STFTDesc& desc = {});
+
+		/// <summary>
+		/// 波形全体の STFT を実行し、スペクトログラムを作成します。
+		/// </summary>
+		/// <param name="result">
+		/// 結果を書き込むスペクトログラム
+		/// </param>
+		/// <param name="wave">
+		/// 入力の波形。左右の平均を解析する
+		/// </param>
+		/// <param name="desc">
+		/// STFT の設定
+		/// </param>
+		void STFT(Spectrogram& result, const Wave& wave, const STFTDesc& desc = {});
+
+		void STFT(Spectrogram& result, const CompactWave& wave, const STFTDesc& desc = {});
+
+		/// <summary>
+		/// STFT のフレーム数を返します。
+		/// </summary>
+		/// <param name="length">
+		/// 入力のサンプル数
+		/// </param>
+		/// <param name="hopSize">
+		/// 隣り合うフレームの間隔（サンプル）
+		/// </param>
+		[[nodiscard]] size_t STFTFrameCount(size_t length, uint32 hopSize) noexcept;
 	}
 }
@@ -81,7 +81,58 @@ namespace s3d
 
 		int32 index = 0;
 	};
-	
+
+	/// <summary>
+	/// フォントのグリフを書き込むテクスチャ（アトラス）の設定
+	/// </summary>
+	struct FontAtlasDesc
+	{
+		/// <summary>
+		/// 1 ページの幅と高さ（ピクセル）。0 の場合は 1 枚のテクスチャを必要に応じて拡張する
+		/// </summary>
+		int32 pageSize = 0;
+
+		/// <summary>
+		/// ページ数の上限。使い切ると、最も長い間使われていないページのグリフを捨てて再利用する
+		/// </summary>
+		int32 maxPages = 4;
+	};
+
+	/// <summary>
+	/// フォントのアトラスの使用状況
+	/// </summary>
+	struct FontAtlasStats
+	{
+		size_t num_pages = 0;
+
+		/// <summary>
+		/// アトラスに書き込まれているグリフの数
+		/// </summary>
+		size_t num_glyphs = 0;
+
+		/// <summary>
+		/// ページの面積のうち、グリフが使っている割合 [0.0, 1.0]
+		/// </summary>
+		double occupancy = 0.0;
+
+		/// <summary>
+		/// グリフの画像を CPU 側で保持するのに使っているバイト数
+		/// </summary>
+		size_t imageBytes = 0;
+
+		/// <summary>
+		/// これまでにテクスチャへ転送したバイト数
+		/// </summary>
+		size_t uploadedBytes = 0;
+
+		size_t num_uploads = 0;
+
+		/// <summary>
+		/// これまでにグリフを捨てて再利用したページの数
+		/// </summary>
+		size_t num_evictions = 0;
+	};
+
 	class Font
 	{
 	protected:
@@ -110,6 +161,16 @@ namespace s3d
 
 		Font(int32 fontSize, const FilePath& path, FontStyle style = FontStyle::Default);
 
+		/// <summary>
+		/// グリフを固定サイズのページに書き込むフォントを作成します。
+		/// </summary>
+		/// <remarks>
+		/// グリフの画像は 1 ピクセル 1 バイトで保持され、テクスチャには新しく書き込んだ部分だけが転送されます。
+		/// </remarks>
+		Font(int32 fontSize, Typeface typeface, FontStyle style, const FontAtlasDesc& atlas);
+
+		Font(int32 fontSize, const FilePath& path, FontStyle style, const FontAtlasDesc& atlas);
+
 		virtual ~Font();
 
 		void release();
@@ -178,7 +239,15 @@ namespace s3d
 		template <class ... Args>
 		[[nodiscard]] inline DrawableText operator()(const Args& ... args) const;
 
+		/// <summary>
+		/// グリフが書き込まれたテクスチャを返します。
+		/// </summary>
+		/// <remarks>
+		/// FontAtlasDesc でページを使うフォントの場合は、最初のページを返します。
+		/// </remarks>
 		[[nodiscard]] const Texture& getTexture() const;
+
+		[[nodiscard]] FontAtlasStats getAtlasStats() const;
 	};
 
 	class GlyphIterator
@@ -0,0 +1,195 @@
+//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include "Fwd.hpp"
+# include "Array.hpp"
+# include "String.hpp"
+
+namespace s3d
+{
+	/// <summary>
+	/// フレームプロファイラの計測区間
+	/// </summary>
+	/// <remarks>
+	/// SIV3D_PROFILE_ZONE が静的な定数として作成し、区間はこのオブジェクトのアドレスで識別します。
+	/// </remarks>
+	struct ProfilerZone
+	{
+		/// <summary>
+		/// 区間の名前
+		/// </summary>
+		const char32* name;
+
+		/// <summary>
+		/// 区間のあるソースファイル
+		/// </summary>
+		const char* file;
+
+		/// <summary>
+		/// 区間のある行
+		/// </summary>
+		uint32 line;
+	};
+
+	/// <summary>
+	/// 計測された 1 つの区間
+	/// </summary>
+	struct ProfilerEvent
+	{
+		const ProfilerZone* zone = nullptr;
+
+		/// <summary>
+		/// 区間の開始時刻（Time::GetNanosec() の値）
+		/// </summary>
+		uint64 beginNanosec = 0;
+
+		/// <summary>
+		/// 区間の終了時刻（Time::GetNanosec() の値）
+		/// </summary>
+		uint64 endNanosec = 0;
+
+		/// <summary>
+		/// 区間を計測したスレッドの番号（メインスレッドは 0）
+		/// </summary>
+		uint32 threadIndex = 0;
+
+		/// <summary>
+		/// 同じスレッドで計測中だった外側の区間の数
+		/// </summary>
+		uint32 depth = 0;
+	};
+
+	/// <summary>
+	/// Profiler::BeginCapture() で計測したフレームの記録
+	/// </summary>
+	struct ProfilerCapture
+	{
+		/// <summary>
+		/// 終了したすべての区間
+		/// </summary>
+		Array<ProfilerEvent> events;
+
+		/// <summary>
+		/// 各フレームの開始時刻（Time::GetNanosec() の値）
+		/// </summary>
+		Array<uint64> frameBeginNanosec;
+
+		/// <summary>
+		/// スレッドごとのバッファがあふれて記録できなかった区間の数
+		/// </summary>
+		size_t num_dropped = 0;
+
+		[[nodiscard]] bool isEmpty() const noexcept
+		{
+			return events.isEmpty();
+		}
+
+		/// <summary>
+		/// Chrome の trace event 形式の JSON に変換します。
+		/// </summary>
+		/// <remarks>
+		/// chrome://tracing や Perfetto で読み込めます。
+		/// </remarks>
+		[[nodiscard]] String toChromeTrace() const;
+
+		/// <summary>
+		/// Chrome の trace event 形式の JSON ファイルを保存します。
+		/// </summary>
+		/// <param name="path">
+		/// 保存するファイルのパス
+		/// </param>
+		/// <returns>
+		/// 保存に成功した場合 true, それ以外の場合は false
+		/// </returns>
+		bool saveChromeTrace(FilePathView path) const;
+	};
+
+	namespace detail
+	{
+		/// <summary>
+		/// 計測中であれば区間の開始時刻を、そうでなければ 0 を返します。
+		/// </summary>
+		[[nodiscard]] uint64 ProfilerZoneBegin() noexcept;
+
+		void ProfilerZoneEnd(const ProfilerZone& zone, uint64 beginNanosec) noexcept;
+	}
+
+	/// <summary>
+	/// スコープの開始から終了までを 1 つの区間として計測します。
+	/// </summary>
+	/// <remarks>
+	/// 計測中でなければ、アトミック変数を 1 回読むだけです。
+	/// </remarks>
+	class ProfilerScope
+	{
+	private:
+
+		const ProfilerZone& m_zone;
+
+		uint64 m_beginNanosec;
+
+	public:
+
+		explicit ProfilerScope(const ProfilerZone& zone) noexcept
+			: m_zone(zone)
+			, m_beginNanosec(detail::ProfilerZoneBegin()) {}
+
+		ProfilerScope(const ProfilerScope&) = delete;
+
+		ProfilerScope& operator =(const ProfilerScope&) = delete;
+
+		~ProfilerScope()
+		{
+			if (m_beginNanosec)
+			{
+				detail::ProfilerZoneEnd(m_zone, m_beginNanosec);
+			}
+		}
+	};
+
+	namespace Profiler
+	{
+		/// <summary>
+		/// 次のフレームから、frames フレームの間の区間の計測を始めます。
+		/// </summary>
+		/// <param name="frames">
+		/// 計測するフレーム数
+		/// </param>
+		/// <remarks>
+		/// 計測したフレームは、IsCapturing() が false になったあとに GetCapture() で取得します。
+		/// </remarks>
+		void BeginCapture(size_t frames = 1);
+
+		/// <summary>
+		/// BeginCapture() で要求した計測が終わっていないかを返します。
+		/// </summary>
+		[[nodiscard]] bool IsCapturing();
+
+		/// <summary>
+		/// 最後に計測が終わったフレームの記録を返します。
+		/// </summary>
+		[[nodiscard]] const ProfilerCapture& GetCapture();
+	}
+}
+
+# define SIV3D_PROFILE_ZONE_CONCAT_PRIVATE(a, b) a##b
+# define SIV3D_PROFILE_ZONE_PRIVATE(name, line)	\
+	static constexpr s3d::ProfilerZone SIV3D_PROFILE_ZONE_CONCAT_PRIVATE(siv3dProfilerZone, line){ name, __FILE__, line };	\
+	const s3d::ProfilerScope SIV3D_PROFILE_ZONE_CONCAT_PRIVATE(siv3dProfilerScope, line){ SIV3D_PROFILE_ZONE_CONCAT_PRIVATE(siv3dProfilerZone, line) }
+
+/// <summary>
+/// このスコープの終わりまでを、name という名前の区間として計測します。
+/// </summary>
+/// <remarks>
+/// name は U"..." の文字列リテラルです。
+/// </remarks>
+# define SIV3D_PROFILE_ZONE(name) SIV3D_PROFILE_ZONE_PRIVATE(name, __LINE__)
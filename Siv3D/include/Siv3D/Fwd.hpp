@@ -369,6 +369,19 @@ namespace s3d
 	enum class OutputLevel;
 	enum class LogDescription;
 
+	//////////////////////////////////////////////////////
+	//
+	//	CompressionDictionary.hpp
+	//
+	class CompressionDictionary;
+
+	//////////////////////////////////////////////////////
+	//
+	//	Compressor.hpp
+	//
+	class Compressor;
+	class Decompressor;
+
 	//////////////////////////////////////////////////////
 	//
 	//	CSVData.hpp
@@ -569,6 +582,18 @@ namespace s3d
 	//
 	class MultiPolygon;
 
+	//////////////////////////////////////////////////////
+	//
+	//	PreparedPolygon.hpp
+	//
+	class PreparedPolygon;
+
+	//////////////////////////////////////////////////////
+	//
+	//	IncrementalMultiPolygon.hpp
+	//
+	class IncrementalMultiPolygon;
+
 	//////////////////////////////////////////////////////
 	//
 	//	Bezier2.hpp
@@ -791,6 +816,13 @@ namespace s3d
 	//
 	class Wave;
 
+	//////////////////////////////////////////////////////
+	//
+	//	CompactWave.hpp
+	//
+	enum class WaveSampleFormat : uint8;
+	class CompactWave;
+
 	//////////////////////////////////////////////////////
 	//
 	//	SoundFont.hpp
@@ -804,6 +836,9 @@ namespace s3d
 	//
 	enum class FFTSampleLength;
 	struct FFTResult;
+	enum class FFTWindow : uint8;
+	struct STFTDesc;
+	struct Spectrogram;
 
 	//////////////////////////////////////////////////////
 	//
@@ -912,6 +947,15 @@ namespace s3d
 	//
 	struct Statistics;
 
+	//////////////////////////////////////////////////////
+	//
+	//	FrameProfiler.hpp
+	//
+	struct ProfilerZone;
+	struct ProfilerEvent;
+	struct ProfilerCapture;
+	class ProfilerScope;
+
 	//////////////////////////////////////////////////////
 	//
 	//	Process.hpp
@@ -1182,6 +1226,8 @@ namespace s3d
 	enum class Typeface;
 	enum class FontStyle : uint32;
 	struct Glyph;
+	struct FontAtlasDesc;
+	struct FontAtlasStats;
 	class Font;
 	class GlyphIterator;
 	struct DrawableText;
@@ -1339,6 +1385,7 @@ namespace s3d
 	//	NavMesh.hpp
 	//
 	struct NavMeshConfig;
+	class NavMeshSlicedQuery;
 	class NavMesh;
 
 	//////////////////////////////////////////////////////
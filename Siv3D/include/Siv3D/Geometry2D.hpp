@@ -381,6 +381,16 @@ namespace s3d
 		[[nodiscard]] Array<Polygon> Or(const Polygon& a, const Polygon& b);
 		[[nodiscard]] Array<Polygon> Xor(const Polygon& a, const Polygon& b);
 
+		/// <summary>
+		/// 多角形の和集合を、近いもの同士から並列に合わせて求めます。
+		/// </summary>
+		[[nodiscard]] Array<Polygon> Or(const Array<Polygon>& polygons);
+
+		/// <summary>
+		/// a の和集合から b の和集合を取り除きます。
+		/// </summary>
+		[[nodiscard]] Array<Polygon> Subtract(const Array<Polygon>& a, const Array<Polygon>& b);
+
 		[[nodiscard]] double FrechetDistance(const LineString& a, const LineString& b);
 
 		[[nodiscard]] double HausdorffDistance(const LineString& a, const LineString& b);
@@ -11,6 +11,7 @@
 
 # pragma once
 # include "Fwd.hpp"
+# include "Array.hpp"
 # include "Optional.hpp"
 # include "Uncopyable.hpp"
 # include "Color.hpp"
@@ -90,6 +91,35 @@ namespace s3d
 		// 現在までの 2D 描画を実行
 		void Flush();
 
+		// 描画の実行前に、効果の無いステート変更を取り除き、隣接するドローコールをまとめるかを設定（デフォルトでは有効）
+		// *まとめられたドローコールの数は Profiler::GetStatistics() の mergedDrawcalls で確認できる
+		void SetCommandCompactionEnabled(bool enabled);
+
+		// 描画コマンドの最適化が有効であるかを返す
+		[[nodiscard]] bool IsCommandCompactionEnabled();
+
+		// 複数の長方形をまとめて描く
+		void DrawRects(const Array<RectF>& rects, const ColorF& color);
+
+		// 複数の長方形をそれぞれの色でまとめて描く
+		// *rects と colors の要素数が異なる場合は、少ないほうに合わせる
+		void DrawRects(const Array<RectF>& rects, const Array<ColorF>& colors);
+
+		// 複数の円をまとめて描く
+		void DrawCircles(const Array<Circle>& circles, const ColorF& color);
+
+		// 複数の円をそれぞれの色でまとめて描く
+		// *circles と colors の要素数が異なる場合は、少ないほうに合わせる
+		void DrawCircles(const Array<Circle>& circles, const Array<ColorF>& colors);
+
+		// 同じテクスチャの複数の領域を、rects の各長方形にまとめて描く
+		// *uvRects は UV 座標で指定し、rects と uvRects の要素数が異なる場合は、少ないほうに合わせる
+		void DrawTextureRegions(const Texture& texture, const Array<RectF>& rects, const Array<RectF>& uvRects, const ColorF& diffuse);
+
+		// 同じテクスチャの複数の領域を、rects の各長方形にそれぞれの色でまとめて描く
+		// *rects, uvRects, colors の要素数が異なる場合は、最も少ないものに合わせる
+		void DrawTextureRegions(const Texture& texture, const Array<RectF>& rects, const Array<RectF>& uvRects, const Array<ColorF>& colors);
+
 		namespace Internal
 		{
 			void SetColorMul(const ColorF& color);
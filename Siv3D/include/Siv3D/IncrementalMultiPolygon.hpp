@@ -0,0 +1,97 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <memory>
+# include "Fwd.hpp"
+# include "MultiPolygon.hpp"
+
+namespace s3d
+{
+	/// <summary>
+	/// 多角形を足したりくり抜いたりした結果を、変更のあった部分だけ計算し直して保持します。
+	/// </summary>
+	/// <remarks>
+	/// 平面を tileSize の正方形のタイルに分け、タイルごとに、そのタイルに重なる多角形を追加した順に演算します。
+	/// 結果の多角形はタイルの境界で分かれます。
+	/// </remarks>
+	class IncrementalMultiPolygon
+	{
+	private:
+
+		class IncrementalMultiPolygonDetail;
+
+		std::shared_ptr<IncrementalMultiPolygonDetail> pImpl;
+
+	public:
+
+		static constexpr double DefaultTileSize = 256.0;
+
+		IncrementalMultiPolygon();
+
+		explicit IncrementalMultiPolygon(double tileSize);
+
+		~IncrementalMultiPolygon();
+
+		/// <summary>
+		/// 多角形を足します。
+		/// </summary>
+		/// <returns>
+		/// 多角形の ID。空の多角形の場合は 0
+		/// </returns>
+		uint32 add(const Polygon& polygon);
+
+		/// <summary>
+		/// 多角形の範囲をくり抜きます。
+		/// </summary>
+		/// <returns>
+		/// 多角形の ID。空の多角形の場合は 0
+		/// </returns>
+		uint32 subtract(const Polygon& polygon);
+
+		/// <summary>
+		/// add() や subtract() で追加した多角形を置き換えます。演算の順番は変わりません。
+		/// </summary>
+		bool replace(uint32 id, const Polygon& polygon);
+
+		/// <summary>
+		/// add() や subtract() で追加した多角形を取り除きます。
+		/// </summary>
+		bool remove(uint32 id);
+
+		void clear();
+
+		/// <summary>
+		/// 変更のあったタイルだけを並列に計算し直します。
+		/// </summary>
+		/// <returns>
+		/// 計算し直したタイルの数
+		/// </returns>
+		size_t update();
+
+		/// <summary>
+		/// update() で反映されていない変更があるかを返します。
+		/// </summary>
+		[[nodiscard]] bool hasChanges() const;
+
+		/// <summary>
+		/// 最後の update() の結果を返します。
+		/// </summary>
+		[[nodiscard]] const MultiPolygon& getMultiPolygon() const;
+
+		[[nodiscard]] double tileSize() const;
+
+		/// <summary>
+		/// 多角形が重なっているタイルの数を返します。
+		/// </summary>
+		[[nodiscard]] size_t num_tiles() const;
+	};
+}
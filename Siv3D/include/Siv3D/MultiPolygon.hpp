@@ -168,6 +168,16 @@ namespace s3d
 
 		[[nodiscard]] MultiPolygon simplified(double maxDistance = 2.0) const;
 
+		/// <summary>
+		/// 各多角形を並列に distance だけ広げ、重なった部分を 1 つにまとめます。
+		/// </summary>
+		[[nodiscard]] MultiPolygon calculateBuffer(double distance) const;
+
+		/// <summary>
+		/// 角を丸めて広げる calculateBuffer() です。
+		/// </summary>
+		[[nodiscard]] MultiPolygon calculateRoundBuffer(double distance) const;
+
 		template <class Shape2DType>
 		[[nodiscard]] bool intersects(const Shape2DType& shape) const
 		{
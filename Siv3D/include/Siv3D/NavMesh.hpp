@@ -14,7 +14,9 @@
 # include "Fwd.hpp"
 # include "Array.hpp"
 # include "PointVector.hpp"
+# include "AABB.hpp"
 # include "Math.hpp"
+# include "Duration.hpp"
 
 namespace s3d
 {
@@ -32,12 +34,68 @@ namespace s3d
 
 		double agentRadius = 0.25;
 
+		/// <summary>
+		/// タイルの一辺のセル数。0 の場合は全体を 1 つのタイルとして構築します。
+		/// </summary>
+		/// <remarks>
+		/// タイルに分けると、障害物やエリアを変更したときに、重なるタイルだけが再構築されます。
+		/// </remarks>
+		int32 tileSize = 0;
+
 		[[nodiscard]] static constexpr NavMeshConfig Default()
 		{
 			return NavMeshConfig();
 		}
 	};
 
+	/// <summary>
+	/// 複数のフレームに分けて進める経路探索
+	/// </summary>
+	/// <remarks>
+	/// NavMesh::querySliced() で作成します。
+	/// </remarks>
+	class NavMeshSlicedQuery
+	{
+	private:
+
+		class NavMeshSlicedQueryDetail;
+
+		std::shared_ptr<NavMeshSlicedQueryDetail> pImpl;
+
+		friend class NavMesh;
+
+		explicit NavMeshSlicedQuery(const std::shared_ptr<NavMeshSlicedQueryDetail>& detail);
+
+	public:
+
+		NavMeshSlicedQuery();
+
+		~NavMeshSlicedQuery();
+
+		/// <summary>
+		/// 探索を最大 maxIterations 回進めます。
+		/// </summary>
+		/// <returns>
+		/// 探索が終わった場合 true
+		/// </returns>
+		bool update(int32 maxIterations);
+
+		/// <summary>
+		/// 探索を、終わるか budget の時間が経つまで進めます。
+		/// </summary>
+		/// <returns>
+		/// 探索が終わった場合 true
+		/// </returns>
+		bool updateFor(const Duration& budget);
+
+		[[nodiscard]] bool isDone() const;
+
+		/// <summary>
+		/// 探索が終わった後の経路を返します。経路が見つからなかった場合は空です。
+		/// </summary>
+		[[nodiscard]] const Array<Vec3>& getPath() const;
+	};
+
 	class NavMesh
 	{
 	private:
@@ -46,6 +104,8 @@ namespace s3d
 
 		std::shared_ptr<NavMeshDetail> pImpl;
 
+		friend class NavMeshSlicedQuery;
+
 	public:
 
 		NavMesh();
@@ -57,5 +117,61 @@ namespace s3d
 		bool build(const Array<Float3>& vertices, const Array<uint16>& indices, const Array<uint8>& areaIDs, const NavMeshConfig& config = NavMeshConfig::Default());
 
 		[[nodiscard]] Array<Vec3> query(const Vec3& start, const Vec3& end) const;
+
+		/// <summary>
+		/// 複数の始点と終点の組について、経路を並列に探索します。
+		/// </summary>
+		[[nodiscard]] Array<Array<Vec3>> queryBatch(const Array<std::pair<Vec3, Vec3>>& startEnds) const;
+
+		/// <summary>
+		/// 複数のフレームに分けて進める経路探索を開始します。
+		/// </summary>
+		[[nodiscard]] NavMeshSlicedQuery querySliced(const Vec3& start, const Vec3& end) const;
+
+		/// <summary>
+		/// 範囲内を通れなくする障害物を追加します。
+		/// </summary>
+		/// <param name="box">
+		/// 障害物の範囲。床と重なる高さで指定します。
+		/// </param>
+		/// <remarks>
+		/// 変更は、再構築が終わった後の update() で反映されます。
+		/// </remarks>
+		/// <returns>
+		/// 障害物の ID。失敗した場合は 0
+		/// </returns>
+		uint32 addObstacle(const AABB& box);
+
+		/// <summary>
+		/// 範囲内の床のエリア ID を変更します。
+		/// </summary>
+		/// <returns>
+		/// エリアの ID。失敗した場合は 0
+		/// </returns>
+		uint32 addArea(const AABB& box, uint8 areaID);
+
+		/// <summary>
+		/// addObstacle() や addArea() で追加したものを取り除きます。
+		/// </summary>
+		bool removeArea(uint32 id);
+
+		/// <summary>
+		/// バックグラウンドで再構築が終わったタイルを差し替え、残りの変更があれば次の再構築を始めます。
+		/// </summary>
+		/// <param name="waitForRebuild">
+		/// すべての変更が反映されるまで待つ場合は true
+		/// </param>
+		/// <remarks>
+		/// 毎フレーム、経路探索の前に呼びます。差し替えられたタイルを通っていた NavMeshSlicedQuery は失敗します。
+		/// </remarks>
+		/// <returns>
+		/// 差し替えたタイルの数
+		/// </returns>
+		size_t update(bool waitForRebuild = false);
+
+		/// <summary>
+		/// 反映されていない変更があるかを返します。
+		/// </summary>
+		[[nodiscard]] bool isRebuilding() const;
 	};
 }
@@ -138,6 +138,95 @@ namespace s3d
 		[[nodiscard]] std::array<P2Contact, 2>::const_iterator end() const noexcept;
 	};
 
+	struct P2RaycastHit
+	{
+		/// <summary>
+		/// 交差した位置
+		/// </summary>
+		Vec2 pos = Vec2(0, 0);
+
+		/// <summary>
+		/// 交差した位置における形状の法線
+		/// </summary>
+		Vec2 normal = Vec2(0, 0);
+
+		/// <summary>
+		/// 始点から交差した位置までの、移動量全体に対する割合 [0, 1]
+		/// </summary>
+		double fraction = 0.0;
+
+		/// <summary>
+		/// 交差した物体の ID
+		/// </summary>
+		P2BodyID id = 0;
+	};
+
+	/// <summary>
+	/// 直前の P2World::update() または P2World::updateFixed() にかかった時間 [ミリ秒]
+	/// </summary>
+	/// <remarks>
+	/// updateFixed() で複数のステップを進めた場合は、その合計です。
+	/// </remarks>
+	struct P2Profile
+	{
+		/// <summary>
+		/// ステップ全体
+		/// </summary>
+		double step = 0.0;
+
+		/// <summary>
+		/// 接触の更新
+		/// </summary>
+		double collide = 0.0;
+
+		/// <summary>
+		/// 拘束の解決（broadphase を含む）
+		/// </summary>
+		double solve = 0.0;
+
+		/// <summary>
+		/// 形状の AABB の更新と、新しい接触の検出
+		/// </summary>
+		double broadphase = 0.0;
+
+		/// <summary>
+		/// 連続衝突判定
+		/// </summary>
+		double solveTOI = 0.0;
+
+		/// <summary>
+		/// 進めたステップ数
+		/// </summary>
+		size_t numSteps = 0;
+	};
+
+	/// <summary>
+	/// P2World の状態のスナップショット
+	/// </summary>
+	/// <remarks>
+	/// 物体、形状、ジョイントの構成が保存時と同じ P2World にだけ復元できます。
+	/// 同じスナップショットに繰り返し保存する場合、確保済みのメモリが再利用されます。
+	/// </remarks>
+	class P2WorldSnapshot
+	{
+	private:
+
+		friend class P2World;
+
+		Array<uint8> m_data;
+
+		// m_data のうち b2World の状態が占めるバイト数。残りは衝突情報
+		size_t m_worldSize = 0;
+
+	public:
+
+		[[nodiscard]] bool isEmpty() const noexcept;
+
+		[[nodiscard]] size_t size_bytes() const noexcept;
+
+		void clear();
+	};
+
 	class P2World
 	{
 	private:
@@ -166,6 +255,36 @@ namespace s3d
 
 		void update(double timeStep = Scene::DeltaTime(), int32 velocityIterations = 6, int32 positionIterations = 2) const;
 
+		/// <summary>
+		/// 経過時間 deltaTime の分だけ、固定の timeStep で物理演算を進めます。
+		/// </summary>
+		/// <param name="deltaTime">
+		/// 経過時間 [秒]
+		/// </param>
+		/// <param name="timeStep">
+		/// 1 ステップの時間 [秒]
+		/// </param>
+		/// <param name="maxSubSteps">
+		/// 1 回の呼び出しで進める最大のステップ数。超えた分の時間は捨てられます
+		/// </param>
+		/// <remarks>
+		/// timeStep に満たない残りの時間は次回に持ち越され、P2Body::getInterpolatedTransform() の補間に使われます。
+		/// </remarks>
+		/// <returns>
+		/// 進めたステップ数
+		/// </returns>
+		size_t updateFixed(double deltaTime = Scene::DeltaTime(), double timeStep = (1.0 / 60.0), size_t maxSubSteps = 8, int32 velocityIterations = 6, int32 positionIterations = 2) const;
+
+		/// <summary>
+		/// updateFixed() で持ち越された時間の、timeStep に対する割合 [0, 1) を返します。update() の後は 1 です。
+		/// </summary>
+		[[nodiscard]] double getInterpolationAlpha() const;
+
+		/// <summary>
+		/// 直前の update() または updateFixed() にかかった時間を返します。
+		/// </summary>
+		[[nodiscard]] const P2Profile& getProfile() const;
+
 		[[nodiscard]] P2Body createDummy(const Vec2& center, P2BodyType bodyType = P2BodyType::Dynamic);
 
 		[[nodiscard]] P2Body createLine(const Vec2& center, const Line& line, const P2Material& material = P2Material(), const P2Filter& filter = P2Filter(), P2BodyType bodyType = P2BodyType::Dynamic);
@@ -234,8 +353,80 @@ namespace s3d
 		[[nodiscard]] P2RopeJoint createRopeJoint(const P2Body& bodyA, const Vec2& anchorPosA, const P2Body& bodyB, const Vec2& anchorPosB, double maxLength);
 		[[nodiscard]] P2SliderJoint createSliderJoint(const P2Body& bodyA, const P2Body& bodyB, const Vec2& anchorPos, const Vec2& normalizedAxis);
 
+		/// <summary>
+		/// 直前の update() または updateFixed() で接触していた物体の組を返します。
+		/// </summary>
+		/// <remarks>
+		/// updateFixed() で複数のステップを進めた場合は、いずれかのステップで接触した組がすべて含まれ、力積はステップ間で合計されます。
+		/// 接触点と法線は、その組が最後に接触したステップのものです。
+		/// ステップが進まなかった場合、接触が続いている組は num_contacts が 0 のまま残ります。
+		/// </remarks>
 		[[nodiscard]] const HashTable<P2ContactPair, P2Collision>& getCollisions() const;
 
+		// 以下のクエリは、filter.maskBits と categoryBits が重なる形状だけを対象とする
+
+		/// <summary>
+		/// 形状のバウンディングボックスが rect と重なる物体の ID を返します。
+		/// </summary>
+		[[nodiscard]] Array<P2BodyID> queryAABB(const RectF& rect, const P2Filter& filter = P2Filter()) const;
+
+		/// <summary>
+		/// 形状が circle と重なる物体の ID を返します。
+		/// </summary>
+		[[nodiscard]] Array<P2BodyID> queryOverlap(const Circle& circle, const P2Filter& filter = P2Filter()) const;
+
+		/// <summary>
+		/// 形状が quad と重なる物体の ID を返します。
+		/// </summary>
+		/// <remarks>
+		/// quad は三角形に分けて調べ、面積がほぼ 0 の三角形は無視します。
+		/// </remarks>
+		[[nodiscard]] Array<P2BodyID> queryOverlap(const Quad& quad, const P2Filter& filter = P2Filter()) const;
+
+		/// <summary>
+		/// 形状が polygon と重なる物体の ID を返します。
+		/// </summary>
+		/// <remarks>
+		/// polygon は三角形に分けて調べ、面積がほぼ 0 の三角形は無視します。
+		/// </remarks>
+		[[nodiscard]] Array<P2BodyID> queryOverlap(const Polygon& polygon, const P2Filter& filter = P2Filter()) const;
+
+		/// <summary>
+		/// start から end への線分と最初に交差する形状を返します。
+		/// </summary>
+		[[nodiscard]] Optional<P2RaycastHit> raycast(const Vec2& start, const Vec2& end, const P2Filter& filter = P2Filter()) const;
+
+		/// <summary>
+		/// 複数の線分について、それぞれ最初に交差する形状を返します。
+		/// </summary>
+		/// <remarks>
+		/// 線分は複数のスレッドで並列に処理されます。処理中に物体を変更してはいけません。
+		/// </remarks>
+		[[nodiscard]] Array<Optional<P2RaycastHit>> raycast(const Array<Line>& rays, const P2Filter& filter = P2Filter()) const;
+
+		/// <summary>
+		/// start から end への線分と交差するすべての形状を、start に近い順に返します。
+		/// </summary>
+		[[nodiscard]] Array<P2RaycastHit> raycastAll(const Vec2& start, const Vec2& end, const P2Filter& filter = P2Filter()) const;
+
+		/// <summary>
+		/// circle を translation だけ移動させたときに、最初に接触する形状を返します。
+		/// </summary>
+		[[nodiscard]] Optional<P2RaycastHit> circleCast(const Circle& circle, const Vec2& translation, const P2Filter& filter = P2Filter()) const;
+
+		/// <summary>
+		/// 物体、形状、接触、ジョイントの状態と衝突情報を snapshot に保存します。
+		/// </summary>
+		void takeSnapshot(P2WorldSnapshot& snapshot) const;
+
+		/// <summary>
+		/// snapshot に保存した状態に戻します。以降の update() は保存時からの update() とビット単位で同じ結果になります。
+		/// </summary>
+		/// <returns>
+		/// 物体、形状、ジョイントの構成が保存時と異なり、復元できなかった場合 false
+		/// </returns>
+		bool restoreSnapshot(const P2WorldSnapshot& snapshot);
+
 		[[nodiscard]] b2World* getWorldPtr() const;
 	};
 
@@ -328,6 +519,26 @@ namespace s3d
 
 		[[nodiscard]] std::pair<Vec2, double> getTransform() const;
 
+		/// <summary>
+		/// P2World::updateFixed() の最後のステップの前後の位置を、P2World::getInterpolationAlpha() で補間した位置を返します。
+		/// </summary>
+		[[nodiscard]] Vec2 getInterpolatedPos() const;
+
+		/// <summary>
+		/// P2World::updateFixed() の最後のステップの前後の角度を、P2World::getInterpolationAlpha() で補間した角度を返します。
+		/// </summary>
+		[[nodiscard]] double getInterpolatedAngle() const;
+
+		[[nodiscard]] std::pair<Vec2, double> getInterpolatedTransform() const;
+
+		/// <summary>
+		/// 現在の姿勢から補間された姿勢への変換行列を返します。
+		/// </summary>
+		/// <remarks>
+		/// Transformer2D に渡すと、draw() などで補間された姿勢の物体を描けます。
+		/// </remarks>
+		[[nodiscard]] Mat3x2 getInterpolationMat() const;
+
 		P2Body& setVelocity(const Vec2& v);
 
 		[[nodiscard]] Vec2 getVelocity() const;
@@ -47,6 +47,12 @@ namespace s3d
 
 	public:
 
+		/// <summary>
+		/// 三角形分割のインデックスの型
+		/// </summary>
+		/// <remarks>
+		/// 頂点数が 65535 を超える多角形は、代わりに 32-bit のインデックスを持ちます。
+		/// </remarks>
 		using IndexType = uint16;
 
 		Polygon();
@@ -63,6 +69,10 @@ namespace s3d
 
 		Polygon(const Array<Vec2>& outer, const Array<Array<Vec2>>& holes, const Array<Float2>& vertices, const Array<IndexType>& indices, const RectF& boundingRect, bool checkValidity = false);
 
+		Polygon(const Array<Vec2>& outer, const Array<uint32>& indices, const RectF& boundingRect, bool checkValidity = false);
+
+		Polygon(const Array<Vec2>& outer, const Array<Array<Vec2>>& holes, const Array<Float2>& vertices, const Array<uint32>& indices, const RectF& boundingRect, bool checkValidity = false);
+
 		Polygon(const Shape2D& shape);
 
 		explicit Polygon(std::initializer_list<Vec2> outer);
@@ -89,8 +99,22 @@ namespace s3d
 
 		[[nodiscard]] const Array<Float2>& vertices() const;
 
+		/// <summary>
+		/// 三角形分割のインデックスを返します。
+		/// </summary>
+		/// <remarks>
+		/// 頂点数が 65535 を超える場合は空です。代わりに indices32() を使います。
+		/// </remarks>
 		[[nodiscard]] const Array<IndexType>& indices() const;
 
+		/// <summary>
+		/// 頂点数が 65535 を超える多角形の、三角形分割の 32-bit インデックスを返します。
+		/// </summary>
+		/// <remarks>
+		/// それ以外の場合は空です。
+		/// </remarks>
+		[[nodiscard]] const Array<uint32>& indices32() const;
+
 		[[nodiscard]] const RectF& boundingRect() const;
 
 		[[nodiscard]] size_t num_triangles() const;
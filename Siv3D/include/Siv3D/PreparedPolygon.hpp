@@ -0,0 +1,98 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include "Fwd.hpp"
+# include "Array.hpp"
+# include "PointVector.hpp"
+# include "Line.hpp"
+# include "Polygon.hpp"
+
+namespace s3d
+{
+	/// <summary>
+	/// 点や線分との当たり判定を高速に行うための前処理を済ませた多角形
+	/// </summary>
+	/// <remarks>
+	/// 辺を y 方向の帯に分けて登録しておき、判定では対象の帯の辺だけを調べます。
+	/// 頂点数の多い多角形に対して何度も判定する場合に使います。
+	/// 作成後は変更できないため、複数のスレッドから同時に判定できます。
+	/// </remarks>
+	class PreparedPolygon
+	{
+	private:
+
+		Polygon m_polygon;
+
+		Array<Line> m_edges;
+
+		// 帯 i に含まれる辺の番号は m_bandEdges[m_bandOffsets[i]] から m_bandEdges[m_bandOffsets[i + 1]] の手前まで
+		Array<uint32> m_bandOffsets;
+
+		Array<uint32> m_bandEdges;
+
+		double m_top = 0.0;
+
+		double m_bandScale = 0.0;
+
+		void addEdges(const Array<Vec2>& ring);
+
+		[[nodiscard]] size_t bandIndex(double y) const noexcept;
+
+		[[nodiscard]] bool intersectsBand(size_t band, const Line& line, double minX, double maxX) const;
+
+	public:
+
+		PreparedPolygon() = default;
+
+		explicit PreparedPolygon(const Polygon& polygon);
+
+		[[nodiscard]] explicit operator bool() const noexcept { return !isEmpty(); }
+
+		[[nodiscard]] bool isEmpty() const noexcept;
+
+		[[nodiscard]] const Polygon& polygon() const noexcept;
+
+		[[nodiscard]] const RectF& boundingRect() const noexcept;
+
+		[[nodiscard]] size_t num_bands() const noexcept;
+
+		[[nodiscard]] bool intersects(const Point& point) const;
+
+		[[nodiscard]] bool intersects(const Vec2& point) const;
+
+		[[nodiscard]] bool intersects(const Line& line) const;
+
+		/// <summary>
+		/// 点が多角形の内部にあるかを返します。
+		/// </summary>
+		/// <remarks>
+		/// 穴の中の点は含まれません。辺の上の点が含まれるかは、辺の向きによって決まります。
+		/// </remarks>
+		[[nodiscard]] bool contains(const Point& point) const;
+
+		[[nodiscard]] bool contains(const Vec2& point) const;
+
+		[[nodiscard]] bool leftClicked() const;
+
+		[[nodiscard]] bool leftPressed() const;
+
+		[[nodiscard]] bool leftReleased() const;
+
+		[[nodiscard]] bool rightClicked() const;
+
+		[[nodiscard]] bool rightPressed() const;
+
+		[[nodiscard]] bool rightReleased() const;
+
+		[[nodiscard]] bool mouseOver() const;
+	};
+}
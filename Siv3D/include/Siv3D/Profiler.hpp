@@ -19,6 +19,15 @@ namespace s3d
 		size_t drawcalls = 0;
 
 		size_t triangles = 0;
+
+		// 2D 描画コマンドの最適化によって、ほかのドローコールにまとめられたドローコールの数
+		size_t mergedDrawcalls = 0;
+
+		// 2D 描画で GPU の頂点バッファ・インデックスバッファに転送したバイト数
+		size_t uploadedBytes = 0;
+
+		// 2D 描画の頂点・インデックスがバッファに収まらず、バッチが分割された回数
+		size_t batchSplits = 0;
 	};
 
 	/// <summary>
@@ -40,5 +49,13 @@ namespace s3d
 		void EnableAssetCreationWarning(bool enabled);
 
 		[[nodiscard]] Statistics GetStatistics();
+
+		/// <summary>
+		/// 非同期ロードの開始を待っているアセットの数を取得します。
+		/// </summary>
+		/// <returns>
+		/// ロード待ちのアセットの数
+		/// </returns>
+		[[nodiscard]] size_t AssetLoadingQueueDepth();
 	}
 }
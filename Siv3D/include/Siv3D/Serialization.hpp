@@ -633,6 +633,13 @@ namespace s3d
 		archive(value.inners());
 		archive(value.vertices());
 		archive(value.indices());
+
+		// 頂点数が 65535 を超える場合は、空の 16-bit インデックスの後に 32-bit インデックスを続ける
+		if (value.indices().isEmpty() && (Largest<Polygon::IndexType> < value.vertices().size()))
+		{
+			archive(value.indices32());
+		}
+
 		archive(value.boundingRect());
 	}
 
@@ -648,6 +655,16 @@ namespace s3d
 		archive(holes);
 		archive(vertices);
 		archive(indices);
+
+		if (indices.isEmpty() && (Largest<Polygon::IndexType> < vertices.size()))
+		{
+			Array<uint32> indices32;
+			archive(indices32);
+			archive(boundingRect);
+			value = Polygon(outer, holes, vertices, indices32, boundingRect);
+			return;
+		}
+
 		archive(boundingRect);
 		value = Polygon(outer, holes, vertices, indices, boundingRect);
 	}
@@ -106,5 +106,16 @@ namespace s3d
 		static void UnregisterAll();
 
 		[[nodiscard]] static bool IsReady(const AssetName& name);
+
+		/// <summary>
+		/// 非同期ロードが完了したアセットの、ロード待ちとロードにかかった時間を返します。
+		/// </summary>
+		/// <param name="name">
+		/// アセット名
+		/// </param>
+		/// <returns>
+		/// 非同期ロードが完了していない場合は none
+		/// </returns>
+		[[nodiscard]] static Optional<AssetLoadingTime> GetLoadingTime(const AssetName& name);
 	};
 }
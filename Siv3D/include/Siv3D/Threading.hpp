@@ -10,10 +10,28 @@
 //-----------------------------------------------
 
 # pragma once
+# include <type_traits>
+# include <memory>
 # include "Fwd.hpp"
 
 namespace s3d
 {
+	namespace detail
+	{
+		using ParallelForFunction = void(*)(void* context, size_t first, size_t last);
+
+		void ParallelForImpl(size_t first, size_t last, size_t grainSize, ParallelForFunction function, void* context);
+
+		template <class Fty>
+		inline void ParallelForRange(const size_t first, const size_t last, Fty& f, const size_t grainSize)
+		{
+			ParallelForImpl(first, last, grainSize, [](void* context, const size_t _first, const size_t _last)
+			{
+				(*static_cast<Fty*>(context))(_first, _last);
+			}, static_cast<void*>(std::addressof(f)));
+		}
+	}
+
 	namespace Threading
 	{
 		/// <summary>
@@ -25,5 +43,49 @@ namespace s3d
 		/// Number of concurrent threads supported.
 		/// </returns>
 		[[nodiscard]] size_t GetConcurrency() noexcept;
+
+		/// <summary>
+		/// 並列処理に使われるワーカースレッドの数を取得する（呼び出し元のスレッドは含まない）
+		/// Returns the number of worker threads used by parallel algorithms, not including the calling thread.
+		/// </summary>
+		/// <returns>
+		/// ワーカースレッドの数
+		/// Number of worker threads.
+		/// </returns>
+		[[nodiscard]] size_t GetWorkerCount() noexcept;
+
+		/// <summary>
+		/// [first, last) の各インデックスを引数に、並列化して関数を呼び出す
+		/// Calls the function for each index in [first, last) in parallel.
+		/// </summary>
+		/// <param name="first">
+		/// 最初のインデックス
+		/// </param>
+		/// <param name="last">
+		/// 最後のインデックスの次
+		/// </param>
+		/// <param name="f">
+		/// インデックスを引数にとる関数
+		/// </param>
+		/// <param name="grainSize">
+		/// 1 つのタスクが処理するインデックスの最小数。0 の場合は自動で決定する
+		/// Minimum number of indices processed by one task. Determined automatically if 0.
+		/// </param>
+		/// <remarks>
+		/// 関数の中から ParallelFor を呼び出すこともできる
+		/// </remarks>
+		template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, size_t>>* = nullptr>
+		inline void ParallelFor(const size_t first, const size_t last, Fty f, const size_t grainSize = 0)
+		{
+			auto rangeFunction = [&f](const size_t _first, const size_t _last)
+			{
+				for (size_t i = _first; i < _last; ++i)
+				{
+					f(i);
+				}
+			};
+
+			detail::ParallelForRange(first, last, rangeFunction, grainSize);
+		}
 	}
 }
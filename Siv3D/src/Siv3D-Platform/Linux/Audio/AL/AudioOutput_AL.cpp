@@ -0,0 +1,129 @@
+//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Audio/Mixer/AudioMixer.hpp>
+# include "AudioOutput_AL.hpp"
+
+namespace s3d
+{
+	AudioOutput_AL::AudioOutput_AL(const uint32 samplingRate, const size_t bufferFrames)
+		: m_samplingRate(samplingRate)
+		, m_bufferFrames(bufferFrames)
+		, m_s16Buffer(bufferFrames * 2)
+	{
+		::alGenSources(1, &m_source);
+		::alGenBuffers(static_cast<ALsizei>(NumBuffers), m_buffers.data());
+
+		if (::alGetError() != AL_NO_ERROR)
+		{
+			m_source = 0;
+
+			return;
+		}
+
+		::alSourcef(m_source, AL_GAIN, 1.0f);
+		::alSourcef(m_source, AL_PITCH, 1.0f);
+		::alSource3f(m_source, AL_POSITION, 0, 0, 0);
+		::alSource3f(m_source, AL_VELOCITY, 0, 0, 0);
+		::alSourcei(m_source, AL_LOOPING, AL_FALSE);
+
+		m_freeBuffers.assign(m_buffers.begin(), m_buffers.end());
+	}
+
+	AudioOutput_AL::~AudioOutput_AL()
+	{
+		if (m_source)
+		{
+			::alSourceStop(m_source);
+
+			::alSourcei(m_source, AL_BUFFER, 0);
+
+			::alDeleteSources(1, &m_source);
+
+			::alDeleteBuffers(static_cast<ALsizei>(NumBuffers), m_buffers.data());
+		}
+	}
+
+	bool AudioOutput_AL::isInitialized() const noexcept
+	{
+		return (m_source != 0);
+	}
+
+	uint32 AudioOutput_AL::samplingRate() const
+	{
+		return m_samplingRate;
+	}
+
+	size_t AudioOutput_AL::framesWanted()
+	{
+		ALint processed = 0;
+		::alGetSourcei(m_source, AL_BUFFERS_PROCESSED, &processed);
+
+		while (processed-- > 0)
+		{
+			ALuint buffer = 0;
+
+			::alSourceUnqueueBuffers(m_source, 1, &buffer);
+
+			m_freeBuffers << buffer;
+		}
+
+		return (m_freeBuffers.size() * m_bufferFrames);
+	}
+
+	void AudioOutput_AL::submit(const float* samples, size_t frames)
+	{
+		while (frames && m_freeBuffers)
+		{
+			const size_t count = std::min(frames, m_bufferFrames);
+
+			AudioMixer::ConvertToS16(samples, m_s16Buffer.data(), count * 2);
+
+			const ALuint buffer = m_freeBuffers.back();
+
+			m_freeBuffers.pop_back();
+
+			::alBufferData(buffer, AL_FORMAT_STEREO16, m_s16Buffer.data(),
+						   static_cast<ALsizei>(count * sizeof(int16) * 2), m_samplingRate);
+
+			::alSourceQueueBuffers(m_source, 1, &buffer);
+
+			samples += (count * 2);
+			frames -= count;
+		}
+
+		ALint state = 0;
+		::alGetSourcei(m_source, AL_SOURCE_STATE, &state);
+
+		if (state != AL_PLAYING)
+		{
+			// キューが空になって止まっていた
+			if (m_started)
+			{
+				++m_underruns;
+			}
+
+			::alSourcePlay(m_source);
+
+			m_started = true;
+		}
+	}
+
+	double AudioOutput_AL::latencySec() const
+	{
+		return (static_cast<double>(NumBuffers * m_bufferFrames) / m_samplingRate);
+	}
+
+	size_t AudioOutput_AL::num_underruns() const
+	{
+		return m_underruns;
+	}
+}
@@ -0,0 +1,66 @@
+//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <AL/al.h>
+# include <AL/alc.h>
+# include <array>
+# include <atomic>
+# include <Siv3D/Array.hpp>
+# include <Audio/Mixer/IAudioOutput.hpp>
+
+namespace s3d
+{
+	/// <summary>
+	/// 1 つの OpenAL ソースに、AudioMixer が合成したサンプルをキューで渡す IAudioOutput
+	/// </summary>
+	class AudioOutput_AL : public IAudioOutput
+	{
+	private:
+
+		static constexpr size_t NumBuffers = 4;
+
+		uint32 m_samplingRate = 44100;
+
+		size_t m_bufferFrames = 0;
+
+		ALuint m_source = 0;
+
+		std::array<ALuint, NumBuffers> m_buffers = {{ 0 }};
+
+		// キューに入っていないバッファ
+		Array<ALuint> m_freeBuffers;
+
+		Array<int16> m_s16Buffer;
+
+		bool m_started = false;
+
+		std::atomic<size_t> m_underruns = { 0 };
+
+	public:
+
+		AudioOutput_AL(uint32 samplingRate, size_t bufferFrames);
+
+		~AudioOutput_AL() override;
+
+		[[nodiscard]] bool isInitialized() const noexcept;
+
+		[[nodiscard]] uint32 samplingRate() const override;
+
+		[[nodiscard]] size_t framesWanted() override;
+
+		void submit(const float* samples, size_t frames) override;
+
+		[[nodiscard]] double latencySec() const override;
+
+		[[nodiscard]] size_t num_underruns() const override;
+	};
+}
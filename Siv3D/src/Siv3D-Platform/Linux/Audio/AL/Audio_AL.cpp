@@ -0,0 +1,249 @@
+//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Audio_AL.hpp"
+
+namespace s3d
+{
+	Audio_AL::Audio_AL(Wave&& wave, AudioMixer& mixer)
+		: m_pMixer(&mixer)
+		, m_source(std::make_shared<WaveMixerSource>(std::move(wave)))
+	{
+		m_voice = m_pMixer->createVoice(m_source);
+
+		m_voiceShots.reserve(MaxVoiceShots);
+	}
+
+	Audio_AL::Audio_AL(CompactWave&& wave, AudioMixer& mixer)
+		: m_pMixer(&mixer)
+	{
+		auto compact = std::make_shared<CompactMixerSource>(std::move(wave));
+
+		m_compact = compact.get();
+
+		m_source = std::move(compact);
+
+		m_voice = m_pMixer->createVoice(m_source);
+
+		m_voiceShots.reserve(MaxVoiceShots);
+	}
+
+	Audio_AL::Audio_AL(std::unique_ptr<IAudioStreamDecoder>&& decoder, AudioMixer& mixer)
+		: m_pMixer(&mixer)
+	{
+		auto stream = std::make_shared<StreamingMixerSource>(std::move(decoder));
+
+		m_stream = stream.get();
+
+		m_source = std::move(stream);
+
+		m_voice = m_pMixer->createVoice(m_source);
+	}
+
+	Audio_AL::~Audio_AL()
+	{
+		if (!m_pMixer)
+		{
+			return;
+		}
+
+		m_pMixer->removeVoices(m_voiceShots);
+
+		m_pMixer->removeVoice(m_voice);
+	}
+
+	bool Audio_AL::isInitialized() const noexcept
+	{
+		return (m_voice != AudioMixer::NullVoice);
+	}
+
+	uint32 Audio_AL::samplingRate() const
+	{
+		return m_source->samplingRate();
+	}
+
+	size_t Audio_AL::samples() const
+	{
+		return m_source->size();
+	}
+
+	bool Audio_AL::isStreaming() const noexcept
+	{
+		return (m_stream != nullptr);
+	}
+
+	size_t Audio_AL::residentBytes() const
+	{
+		return m_source->residentBytes();
+	}
+
+	const Wave& Audio_AL::getWave() const
+	{
+		if (m_stream || m_compact)
+		{
+			static const Wave emptyWave;
+
+			return emptyWave;
+		}
+
+		return static_cast<const WaveMixerSource&>(*m_source).getWave();
+	}
+
+	const CompactWave& Audio_AL::getCompactWave() const
+	{
+		if (!m_compact)
+		{
+			static const CompactWave emptyWave;
+
+			return emptyWave;
+		}
+
+		return m_compact->getCompactWave();
+	}
+
+	void Audio_AL::setLoop(const bool loop, const int64 loopBeginSample, const int64 loopEndSample)
+	{
+		if (!loop)
+		{
+			m_loop.reset();
+		}
+		else
+		{
+			m_loop.emplace(loopBeginSample, loopEndSample);
+		}
+
+		m_pMixer->setLoop(m_voice, m_loop);
+
+		m_pMixer->stop(m_voice);
+
+		if (m_stream)
+		{
+			m_stream->setLoop(m_loop);
+
+			m_stream->seek(0);
+		}
+	}
+
+	const Optional<AudioLoopTiming>& Audio_AL::getLoop() const
+	{
+		return m_loop;
+	}
+
+	bool Audio_AL::play()
+	{
+		m_pMixer->play(m_voice);
+
+		return true;
+	}
+
+	void Audio_AL::pause()
+	{
+		m_pMixer->pause(m_voice);
+	}
+
+	void Audio_AL::stop()
+	{
+		m_pMixer->stop(m_voice);
+
+		if (m_stream)
+		{
+			m_stream->seek(0);
+		}
+	}
+
+	bool Audio_AL::isPlaying() const
+	{
+		return m_pMixer->isPlaying(m_voice);
+	}
+
+	bool Audio_AL::isPaused() const
+	{
+		return m_pMixer->isPaused(m_voice);
+	}
+
+	uint64 Audio_AL::posSample() const
+	{
+		return m_pMixer->posSample(m_voice);
+	}
+
+	uint64 Audio_AL::samplesPlayed() const
+	{
+		return m_pMixer->samplesPlayed(m_voice);
+	}
+
+	void Audio_AL::setPosSample(const int64 posSample)
+	{
+		m_pMixer->setPosSample(m_voice, posSample);
+
+		if (m_stream)
+		{
+			// ミキサーが範囲に収めた位置からデコードする
+			m_stream->seek(m_pMixer->posSample(m_voice));
+		}
+	}
+
+	void Audio_AL::setVolume(const std::pair<double, double>& volume)
+	{
+		if (volume == m_volume)
+		{
+			return;
+		}
+
+		m_volume = volume;
+
+		m_pMixer->setVolume(m_voice, m_volume.first, m_volume.second);
+	}
+
+	std::pair<double, double> Audio_AL::getVolume() const
+	{
+		return m_volume;
+	}
+
+	void Audio_AL::setSpeed(const double speed)
+	{
+		m_speed = Clamp(speed, AudioMixer::MinSpeed, AudioMixer::MaxSpeed);
+
+		m_pMixer->setSpeed(m_voice, m_speed);
+	}
+
+	double Audio_AL::getSpeed() const
+	{
+		return m_speed;
+	}
+
+	void Audio_AL::playOneShot(const double volume, const double pitch)
+	{
+		// 1 つのデコーダを複数の再生位置で共有できない
+		if (m_stream)
+		{
+			return;
+		}
+
+		// 再生し終えたボイスはミキサーが削除している
+		m_voiceShots.remove_if([this](const AudioMixer::VoiceID voice) { return !m_pMixer->hasVoice(voice); });
+
+		if ((m_voiceShots.size() + 1) >= MaxVoiceShots)
+		{
+			m_pMixer->removeVoice(m_voiceShots.front());
+
+			m_voiceShots.pop_front();
+		}
+
+		m_voiceShots << m_pMixer->playOneShot(m_source, volume, pitch);
+	}
+
+	void Audio_AL::stopAllShots()
+	{
+		m_pMixer->removeVoices(m_voiceShots);
+
+		m_voiceShots.clear();
+	}
+}
@@ -13,6 +13,10 @@
 # include <Siv3D/String.hpp>
 # include <Siv3D/MathConstants.hpp>
 # include <Siv3D/EngineLog.hpp>
+# include <Siv3DEngine.hpp>
+# include <AudioFormat/IAudioFormat.hpp>
+# include <Audio/Mixer/AudioOutput_Null.hpp>
+# include "AudioOutput_AL.hpp"
 
 namespace s3d
 {
@@ -26,6 +30,15 @@ namespace s3d
 		LOG_TRACE(U"CAudio_AL::~~CAudio_AL()");
 		
 		m_audios.destroy();
+
+		{
+			const AudioMixerStats stats = m_mixer.getStats();
+
+			LOG_INFO(U"ℹ️ Audio mixer: {} blocks, {:.3f} ms/block (max {:.3f} ms), latency {:.1f} ms, {} underruns"_fmt(
+				stats.num_blocks, stats.averageMixMillisec, stats.maxMixMillisec, stats.latencyMillisec, stats.num_underruns));
+		}
+
+		m_mixer.stop();
 		
 		if (m_context)
 		{
@@ -41,41 +54,40 @@ namespace s3d
 
 	bool CAudio_AL::hasAudioDevice() const
 	{
-		// [Siv3D ToDo]
-		return true;
+		return m_hasAudioDevice;
 	}
 
 	bool CAudio_AL::init()
 	{
 		LOG_TRACE(U"CAudio_AL::init()");
 		
-		m_device = ::alcOpenDevice(nullptr);
-		
-		if (!m_device)
-		{
-			return false;
-		}
-		
-		m_context = ::alcCreateContext(m_device, nullptr);
-		
-		if (!m_context)
+		m_hasAudioDevice = initDevice();
+
+		if (m_hasAudioDevice)
 		{
-			return false;
+			auto output = std::make_unique<AudioOutput_AL>(OutputSamplingRate, AudioMixer::BlockFrames);
+
+			if (output->isInitialized())
+			{
+				m_mixer.start(std::move(output));
+			}
+			else
+			{
+				m_hasAudioDevice = false;
+			}
 		}
-		
-		if (!::alcMakeContextCurrent(m_context))
+
+		if (!m_hasAudioDevice)
 		{
-			return false;
+			// デバイスが無くても、再生位置などは実時間で進める
+			m_mixer.start(std::make_unique<AudioOutput_Null>(OutputSamplingRate, AudioMixer::BlockFrames * 4));
+
+			LOG_INFO(U"ℹ️ No audio device is available. Audio output is discarded");
 		}
 		
-		::alListener3f(AL_POSITION, 0, 0, 1.0f);
-		::alListener3f(AL_VELOCITY, 0, 0, 0);
-		const ALfloat listenerOri[] = { 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 0.0f };
-		::alListenerfv(AL_ORIENTATION, listenerOri);
-		
 		auto nullAudio = std::make_unique<Audio_AL>(
 			Wave(SecondsF(0.5), Arg::generator = [](double t) {
-				return 0.5 * std::sin(t * Math::TwoPi) * std::sin(t * Math::TwoPi * 220.0 * (t * 4.0 + 1.0)); }));
+				return 0.5 * std::sin(t * Math::TwoPi) * std::sin(t * Math::TwoPi * 220.0 * (t * 4.0 + 1.0)); }), m_mixer);
 		
 		if (!nullAudio->isInitialized())
 		{
@@ -96,7 +108,7 @@ namespace s3d
 			return AudioID::NullAsset();
 		}
 		
-		auto audio = std::make_unique<Audio_AL>(std::move(wave));
+		auto audio = std::make_unique<Audio_AL>(std::move(wave), m_mixer);
 		
 		if (!audio->isInitialized())
 		{
@@ -106,6 +118,45 @@ namespace s3d
 		return m_audios.add(std::move(audio));
 	}
 
+	AudioID CAudio_AL::createCompact(CompactWave&& wave)
+	{
+		if (!wave)
+		{
+			return AudioID::NullAsset();
+		}
+
+		auto audio = std::make_unique<Audio_AL>(std::move(wave), m_mixer);
+
+		if (!audio->isInitialized())
+		{
+			return AudioID::NullAsset();
+		}
+
+		return m_audios.add(std::move(audio));
+	}
+
+	AudioID CAudio_AL::createStreaming(const FilePath& path)
+	{
+		auto decoder = Siv3DEngine::Get<ISiv3DAudioFormat>()->openStream(path);
+
+		if (!decoder)
+		{
+			// ストリーミング再生に対応していない形式は、すべてデコードする
+			return create(Wave(path));
+		}
+
+		auto audio = std::make_unique<Audio_AL>(std::move(decoder), m_mixer);
+
+		if (!audio->isInitialized())
+		{
+			return AudioID::NullAsset();
+		}
+
+		LOG_DEBUG(U"ℹ️ Streaming audio `{0}` ({1} KiB resident)"_fmt(path, audio->residentBytes() / 1024));
+
+		return m_audios.add(std::move(audio));
+	}
+
 	void CAudio_AL::release(const AudioID handleID)
 	{
 		m_audios.erase(handleID);
@@ -113,40 +164,40 @@ namespace s3d
 
 	uint32 CAudio_AL::samplingRate(const AudioID handleID)
 	{
-		return m_audios[handleID]->getWave().samplingRate();
+		return m_audios[handleID]->samplingRate();
 	}
 
 	size_t CAudio_AL::samples(const AudioID handleID)
 	{
-		return m_audios[handleID]->getWave().size();
+		return m_audios[handleID]->samples();
 	}
 
 	void CAudio_AL::setLoop(const AudioID handleID, const bool loop, const int64 loopBeginSample, const int64 loopEndSample)
 	{
-		return m_audios[handleID]->getStream().setLoop(loop, loopBeginSample, loopEndSample);
+		return m_audios[handleID]->setLoop(loop, loopBeginSample, loopEndSample);
 	}
 	
 	Optional<AudioLoopTiming> CAudio_AL::getLoop(const AudioID handleID)
 	{
-		return m_audios[handleID]->getStream().getLoop();
+		return m_audios[handleID]->getLoop();
 	}
 
 	bool CAudio_AL::play(const AudioID handleID, const SecondsF& fadeinDuration)
 	{
 		// [Siv3D ToDo]
-		return m_audios[handleID]->getStream().play();
+		return m_audios[handleID]->play();
 	}
 	
 	void CAudio_AL::pause(const AudioID handleID, const SecondsF& fadeoutDuration)
 	{
 		// [Siv3D ToDo]
-		m_audios[handleID]->getStream().pause();
+		m_audios[handleID]->pause();
 	}
 	
 	void CAudio_AL::stop(const AudioID handleID, const SecondsF& fadeoutDuration)
 	{
 		// [Siv3D ToDo]
-		m_audios[handleID]->getStream().stop();
+		m_audios[handleID]->stop();
 	}
 	
 	void CAudio_AL::playOneShot(const AudioID handleID, const double volume, const double pitch)
@@ -161,27 +212,37 @@ namespace s3d
 
 	bool CAudio_AL::isPlaying(const AudioID handleID)
 	{
-		return m_audios[handleID]->getStream().isPlaying();
+		return m_audios[handleID]->isPlaying();
 	}
 
 	bool CAudio_AL::isPaused(const AudioID handleID)
 	{
-		return m_audios[handleID]->getStream().isPaused();
+		return m_audios[handleID]->isPaused();
 	}
 
 	uint64 CAudio_AL::posSample(const AudioID handleID)
 	{
-		return m_audios[handleID]->getStream().getPosSample();
+		return m_audios[handleID]->posSample();
 	}
 
 	uint64 CAudio_AL::streamPosSample(const AudioID handleID)
 	{
-		return m_audios[handleID]->getStream().streamPosSample();
+		return m_audios[handleID]->posSample();
 	}
 
 	uint64 CAudio_AL::samplesPlayed(const AudioID handleID)
 	{
-		return m_audios[handleID]->getStream().samplesPlayed();
+		return m_audios[handleID]->samplesPlayed();
+	}
+
+	bool CAudio_AL::isStreaming(const AudioID handleID)
+	{
+		return m_audios[handleID]->isStreaming();
+	}
+
+	size_t CAudio_AL::residentBytes(const AudioID handleID)
+	{
+		return m_audios[handleID]->residentBytes();
 	}
 
 	const Wave& CAudio_AL::getWave(AudioID handleID)
@@ -189,44 +250,72 @@ namespace s3d
 		return m_audios[handleID]->getWave();
 	}
 
+	const CompactWave& CAudio_AL::getCompactWave(const AudioID handleID)
+	{
+		return m_audios[handleID]->getCompactWave();
+	}
+
 	void CAudio_AL::setPosSample(const AudioID handleID, const int64 sample)
 	{
-		const auto& audio = m_audios[handleID];
-		const bool isPlaying = audio->getStream().isPlaying();
-		audio->getStream().pause();
-		
-		audio->getStream().setPosSmaple(sample);
-		
-		if (isPlaying)
-		{
-			audio->getStream().play();
-		}
+		m_audios[handleID]->setPosSample(sample);
 	}
 
 	void CAudio_AL::setVolume(const AudioID handleID, const std::pair<double, double>& volume)
 	{
-		m_audios[handleID]->getStream().setVolume(volume);
+		m_audios[handleID]->setVolume(volume);
 	}
 
 	std::pair<double, double> CAudio_AL::getVolume(const AudioID handleID)
 	{
-		return m_audios[handleID]->getStream().getVolume();
+		return m_audios[handleID]->getVolume();
 	}
 
 	void CAudio_AL::setSpeed(const AudioID handleID, const double speed)
 	{
-		m_audios[handleID]->getStream().setSpeed(speed);
+		m_audios[handleID]->setSpeed(speed);
 	}
 
 	double CAudio_AL::getSpeed(const AudioID handleID)
 	{
-		return m_audios[handleID]->getStream().getSpeed();
+		return m_audios[handleID]->getSpeed();
 	}
 
 	std::pair<double, double> CAudio_AL::getMinMaxSpeed(const AudioID)
 	{
-		// [Siv3D ToDo]
-		return{ 1.0 / 1024.0 , 2.0 };
+		return{ AudioMixer::MinSpeed, AudioMixer::MaxSpeed };
+	}
+
+	bool CAudio_AL::initDevice()
+	{
+		m_device = ::alcOpenDevice(nullptr);
+		
+		if (!m_device)
+		{
+			return false;
+		}
+		
+		m_context = ::alcCreateContext(m_device, nullptr);
+		
+		if (!m_context)
+		{
+			::alcCloseDevice(m_device);
+
+			m_device = nullptr;
+
+			return false;
+		}
+		
+		if (!::alcMakeContextCurrent(m_context))
+		{
+			return false;
+		}
+		
+		::alListener3f(AL_POSITION, 0, 0, 1.0f);
+		::alListener3f(AL_VELOCITY, 0, 0, 0);
+		const ALfloat listenerOri[] = { 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 0.0f };
+		::alListenerfv(AL_ORIENTATION, listenerOri);
+
+		return true;
 	}
 
 	bool CAudio_AL::updateFade()
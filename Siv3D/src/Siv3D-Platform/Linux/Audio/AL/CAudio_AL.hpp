@@ -9,8 +9,11 @@
 //
 //-----------------------------------------------
 
+# include <AL/al.h>
+# include <AL/alc.h>
 # include <AssetHandleManager/AssetHandleManager.hpp>
 # include <Audio/IAudio.hpp>
+# include <Audio/Mixer/AudioMixer.hpp>
 # include "Audio_AL.hpp"
 
 namespace s3d
@@ -18,13 +21,22 @@ namespace s3d
 	class CAudio_AL : public ISiv3DAudio
 	{
 	private:
+
+		static constexpr uint32 OutputSamplingRate = 44100;
 		
 		ALCdevice* m_device = nullptr;
 		
 		ALCcontext* m_context = nullptr;
+
+		bool m_hasAudioDevice = false;
+
+		// すべてのボイスを合成するミキサー。OpenAL には合成結果だけを渡す
+		AudioMixer m_mixer;
 		
 		AssetHandleManager<AudioID, Audio_AL> m_audios{ U"Audio" };
 
+		bool initDevice();
+
 	public:
 
 		CAudio_AL();
@@ -37,6 +49,10 @@ namespace s3d
 
 		AudioID create(Wave&& wave) override;
 
+		AudioID createCompact(CompactWave&& wave) override;
+
+		AudioID createStreaming(const FilePath& path) override;
+
 		void release(AudioID handleID) override;
 
 		uint32 samplingRate(AudioID handleID) override;
@@ -67,8 +83,14 @@ namespace s3d
 
 		uint64 samplesPlayed(AudioID handleID) override;
 
+		bool isStreaming(AudioID handleID) override;
+
+		size_t residentBytes(AudioID handleID) override;
+
 		const Wave& getWave(AudioID handleID) override;
 
+		const CompactWave& getCompactWave(AudioID handleID) override;
+
 		void setPosSample(AudioID handleID, int64 sample) override;
 
 		void setVolume(AudioID handleID, const std::pair<double, double>& volume) override;
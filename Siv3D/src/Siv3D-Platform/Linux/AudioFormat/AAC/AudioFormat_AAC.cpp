@@ -25,6 +25,7 @@ extern "C"
 #define av_err2str(errnum) av_make_error_string((char*)__builtin_alloca(AV_ERROR_MAX_STRING_SIZE), AV_ERROR_MAX_STRING_SIZE, errnum)
 
 # include <Siv3D/EngineLog.hpp>
+# include <Siv3D/IReader.hpp>
 
 # include "AudioFormat_AAC.hpp"
 
@@ -32,6 +33,48 @@ namespace s3d
 {
 	namespace detail
 	{
+		static int ReadPacket_Callback(void* opaque, uint8_t* buf, int buf_size)
+		{
+			IReader* reader = static_cast<IReader*>(opaque);
+
+			const int64 size = std::min<int64>(buf_size, (reader->size() - reader->getPos()));
+
+			if (size <= 0)
+			{
+				return AVERROR_EOF;
+			}
+
+			return static_cast<int>(reader->read(buf, size));
+		}
+
+		static int64_t SeekPacket_Callback(void* opaque, int64_t offset, int whence)
+		{
+			IReader* reader = static_cast<IReader*>(opaque);
+
+			switch (whence & ~AVSEEK_FORCE)
+			{
+			case AVSEEK_SIZE:
+				return reader->size();
+			case SEEK_SET:
+				break;
+			case SEEK_CUR:
+				offset += reader->getPos();
+				break;
+			case SEEK_END:
+				offset += reader->size();
+				break;
+			default:
+				return -1;
+			}
+
+			if ((offset < 0) || (reader->size() < offset) || !reader->setPos(offset))
+			{
+				return -1;
+			}
+
+			return offset;
+		}
+
 		class AACDecoder
 		{
 		private:
@@ -46,11 +89,19 @@ namespace s3d
 			int m_audio_stream_idx = 0;
 			AVCodec* m_codec = nullptr;
 			int m_out_count = 0;
+			int m_out_buf_size = 0;
 			int m_out_sample_rate = 0;
 			int64_t m_duration = 0;
 			size_t m_wave_idx = 0;
 
 			FilePath m_path;
+
+			// IReader から読み込む場合
+			std::unique_ptr<IReader> m_reader;
+			AVIOContext* m_io_context = nullptr;
+
+			// デコーダに終端を通知した
+			bool m_flushed = false;
 			
 			void setSample(Wave& wave, float* buf, size_t idx, size_t count)
 			{
@@ -112,6 +163,11 @@ namespace s3d
 					avcodec_free_context(&m_codec_context);
 				if (m_format_context != nullptr)
 					avformat_close_input(&m_format_context);
+				if (m_io_context != nullptr)
+				{
+					av_freep(&m_io_context->buffer);
+					avio_context_free(&m_io_context);
+				}
 			}
 			
 			bool init(const FilePath& path)
@@ -128,6 +184,49 @@ namespace s3d
 					return false;
 				}
 
+				return setup();
+			}
+
+			bool init(std::unique_ptr<IReader>&& reader)
+			{
+				constexpr int IOBufferSize = 32768;
+
+				m_reader = std::move(reader);
+
+				uint8_t* io_buffer = static_cast<uint8_t*>(av_malloc(IOBufferSize));
+				if (io_buffer == nullptr)
+				{
+					LOG_DEBUG(U"AACDecoder: av_malloc() failed (io_buffer)");
+					return false;
+				}
+
+				m_io_context = avio_alloc_context(io_buffer, IOBufferSize, 0, m_reader.get(), ReadPacket_Callback, nullptr, SeekPacket_Callback);
+				if (m_io_context == nullptr)
+				{
+					av_free(io_buffer);
+					LOG_DEBUG(U"AACDecoder: avio_alloc_context() failed");
+					return false;
+				}
+
+				m_format_context = avformat_alloc_context();
+				if (m_format_context == nullptr)
+				{
+					LOG_DEBUG(U"AACDecoder: avformat_alloc_context() failed");
+					return false;
+				}
+				m_format_context->pb = m_io_context;
+
+				if (avformat_open_input(&m_format_context, nullptr, nullptr, nullptr) != 0)
+				{
+					LOG_DEBUG(U"AACDecoder: avformat_open_input() failed (IReader)");
+					return false;
+				}
+
+				return setup();
+			}
+
+			bool setup()
+			{
 				if (avformat_find_stream_info(m_format_context, nullptr) < 0)
 				{
 					LOG_DEBUG(U"AACDecoder: avformat_find_stream_info() failed ({})"_fmt(m_path));
@@ -225,6 +324,7 @@ namespace s3d
 				}
 
 				m_out_count = buf_size / out_nb_channels;
+				m_out_buf_size = buf_size;
 
 				return true;
 			}
@@ -250,6 +350,208 @@ namespace s3d
 				wave.resize(m_wave_idx);
 				return wave;
 			}
+
+			int sampleRate() const
+			{
+				return m_out_sample_rate;
+			}
+
+			size_t numSamples() const
+			{
+				const AVRational sample_time_base = { 1, m_out_sample_rate };
+
+				if (m_duration > 0)
+				{
+					return static_cast<size_t>(av_rescale_q(m_duration, m_audio_stream->time_base, sample_time_base));
+				}
+				else if (m_format_context->duration > 0)
+				{
+					return static_cast<size_t>(av_rescale_q(m_format_context->duration, AV_TIME_BASE_Q, sample_time_base));
+				}
+
+				return 0;
+			}
+
+			size_t bufferBytes() const
+			{
+				return (m_out_buf_size + (m_io_context ? m_io_context->buffer_size : 0));
+			}
+
+			// 次のフレームをデコードして samples に書き込む。終端に達した場合は false
+			bool decodeFrame(Array<WaveSample>& samples, int64& framePos)
+			{
+				samples.clear();
+
+				for (;;)
+				{
+					if (avcodec_receive_frame(m_codec_context, m_frame) == 0)
+					{
+						const int ret = swr_convert(m_swr_context, &m_out_buf, m_out_count,
+								(const uint8_t**)(m_frame->data), m_frame->nb_samples);
+						if (ret < 0)
+						{
+							return false;
+						}
+
+						const WaveSample* pSrc = static_cast<const WaveSample*>(static_cast<const void*>(m_out_buf));
+						samples.insert(samples.end(), pSrc, pSrc + ret);
+
+						const int64_t timestamp = m_frame->best_effort_timestamp;
+						framePos = (timestamp == AV_NOPTS_VALUE) ? -1
+							: av_rescale_q(timestamp, m_audio_stream->time_base, AVRational{ 1, m_out_sample_rate });
+
+						return true;
+					}
+
+					if (m_flushed)
+					{
+						return false;
+					}
+
+					if (av_read_frame(m_format_context, m_packet) < 0)
+					{
+						avcodec_send_packet(m_codec_context, nullptr);
+						m_flushed = true;
+						continue;
+					}
+
+					if (m_packet->stream_index == m_audio_stream_idx)
+					{
+						avcodec_send_packet(m_codec_context, m_packet);
+					}
+
+					av_packet_unref(m_packet);
+				}
+			}
+
+			// pos を含むフレームの先頭に移動する
+			bool seek(const size_t pos)
+			{
+				const int64_t timestamp = av_rescale_q(static_cast<int64_t>(pos), AVRational{ 1, m_out_sample_rate }, m_audio_stream->time_base);
+
+				if (av_seek_frame(m_format_context, m_audio_stream_idx, timestamp, AVSEEK_FLAG_BACKWARD) < 0)
+				{
+					return false;
+				}
+
+				avcodec_flush_buffers(m_codec_context);
+				m_flushed = false;
+
+				return true;
+			}
+		};
+
+		class AACStreamDecoder : public IAudioStreamDecoder
+		{
+		private:
+
+			AACDecoder m_decoder;
+
+			size_t m_size = 0;
+
+			// デコード済みで、まだ read() で返していないサンプル
+			Array<WaveSample> m_pending;
+
+			size_t m_pendingPos = 0;
+
+		public:
+
+			explicit AACStreamDecoder(std::unique_ptr<IReader>&& reader)
+			{
+				if (!reader || !reader->isOpen())
+				{
+					return;
+				}
+
+				if (!m_decoder.init(std::move(reader)))
+				{
+					return;
+				}
+
+				m_size = m_decoder.numSamples();
+			}
+
+			bool isOpen() const noexcept
+			{
+				return (m_size != 0);
+			}
+
+			uint32 samplingRate() const override
+			{
+				return static_cast<uint32>(m_decoder.sampleRate());
+			}
+
+			size_t size() const override
+			{
+				return m_size;
+			}
+
+			size_t read(WaveSample* dst, const size_t count) override
+			{
+				size_t written = 0;
+
+				while (written < count)
+				{
+					if (m_pendingPos == m_pending.size())
+					{
+						int64 framePos = 0;
+
+						m_pendingPos = 0;
+
+						if (!m_decoder.decodeFrame(m_pending, framePos))
+						{
+							m_pending.clear();
+							break;
+						}
+
+						continue;
+					}
+
+					const size_t n = std::min((count - written), (m_pending.size() - m_pendingPos));
+
+					std::memcpy(dst + written, m_pending.data() + m_pendingPos, n * sizeof(WaveSample));
+
+					m_pendingPos += n;
+					written += n;
+				}
+
+				return written;
+			}
+
+			bool seek(const size_t pos) override
+			{
+				m_pending.clear();
+				m_pendingPos = 0;
+
+				if (!m_decoder.seek(pos))
+				{
+					return false;
+				}
+
+				// 移動したフレームの先頭から pos までを読み飛ばす
+				int64 framePos = 0;
+
+				while (m_decoder.decodeFrame(m_pending, framePos))
+				{
+					if (framePos < 0)
+					{
+						break;
+					}
+
+					if (pos < (static_cast<size_t>(framePos) + m_pending.size()))
+					{
+						m_pendingPos = (static_cast<int64>(pos) > framePos) ? (pos - framePos) : 0;
+						break;
+					}
+				}
+
+				return true;
+			}
+
+			size_t residentBytes() const override
+			{
+				return (m_pending.capacity() * sizeof(WaveSample) + m_decoder.bufferBytes());
+			}
 		};
 	}
 
@@ -309,4 +611,16 @@ namespace s3d
 		// not supported
 		return Wave();
 	}
+
+	std::unique_ptr<IAudioStreamDecoder> AudioFormat_AAC::openStream(std::unique_ptr<IReader>&& reader) const
+	{
+		auto decoder = std::make_unique<detail::AACStreamDecoder>(std::move(reader));
+
+		if (!decoder->isOpen())
+		{
+			return nullptr;
+		}
+
+		return decoder;
+	}
 }
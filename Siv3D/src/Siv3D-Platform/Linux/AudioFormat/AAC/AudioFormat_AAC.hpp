@@ -12,6 +12,7 @@
 # pragma once
 # include <Siv3D/Wave.hpp>
 # include <Siv3D/AudioFormat.hpp>
+# include <AudioFormat/IAudioStreamDecoder.hpp>
 
 namespace s3d
 {
@@ -33,6 +34,11 @@ namespace s3d
 
 		Wave decode(IReader& reader) const override;
 
+		/// <summary>
+		/// reader から少しずつデコードするデコーダを作成します。
+		/// </summary>
+		[[nodiscard]] std::unique_ptr<IAudioStreamDecoder> openStream(std::unique_ptr<IReader>&& reader) const;
+
 		//bool encode(const Image& image, IWriter& writer) const override;
 
 		//bool save(const Image& image, const FilePath& path) const override;
@@ -78,6 +78,194 @@ namespace s3d
 		{
 			return;
 		}
+		
+		class MP3StreamDecoder : public IAudioStreamDecoder
+		{
+		private:
+			
+			const AudioFormat_MP3& m_format;
+			
+			std::unique_ptr<IReader> m_reader;
+			
+			mpg123_handle* m_handle = nullptr;
+			
+			bool m_opened = false;
+			
+			uint32 m_samplingRate = Wave::DefaultSamplingRate;
+			
+			size_t m_size = 0;
+			
+			int m_channels = 2;
+			
+			// 1 回の mpg123_read() で受け取るサンプル
+			Array<int16> m_buffer;
+			
+		public:
+			
+			MP3StreamDecoder(const AudioFormat_MP3& format, std::unique_ptr<IReader>&& reader)
+				: m_format(format)
+				, m_reader(std::move(reader))
+				, m_buffer(4096 * 2)
+			{
+				if (!m_reader || !m_reader->isOpen())
+				{
+					return;
+				}
+				
+				m_handle = m_format.p_mpg123_new(nullptr, nullptr);
+				
+				if (!m_handle)
+				{
+					return;
+				}
+				
+				m_format.p_mpg123_param(m_handle, MPG123_RESYNC_LIMIT, -1, 0);
+				
+				if ((m_format.p_mpg123_param(m_handle, MPG123_FLAGS, MPG123_GAPLESS | MPG123_QUIET, 0) != MPG123_OK)
+					|| (m_format.p_mpg123_param(m_handle, MPG123_INDEX_SIZE, -1, 0) != MPG123_OK))
+				{
+					return;
+				}
+				
+				const long *rates = nullptr;
+				
+				size_t nrates = 0;
+				
+				m_format.p_mpg123_rates(&rates, &nrates);
+				
+				for (size_t i = 0; i < nrates; ++i)
+				{
+					if (m_format.p_mpg123_format(m_handle, rates[i], MPG123_MONO | MPG123_STEREO, MPG123_ENC_16) != MPG123_OK)
+					{
+						return;
+					}
+				}
+				
+				if (m_format.p_mpg123_replace_reader_handle(m_handle, Read_Callback, Seek_Callback, Cleanup_Callback) != MPG123_OK)
+				{
+					return;
+				}
+				
+				if (m_format.p_mpg123_open_handle(m_handle, m_reader.get()) != MPG123_OK)
+				{
+					return;
+				}
+				
+				m_opened = true;
+				
+				// シークに使うフレームの索引も作られる
+				if (m_format.p_mpg123_scan(m_handle) != MPG123_OK)
+				{
+					return;
+				}
+				
+				long rate = 0;
+				int channels = 0;
+				int enc = 0;
+				
+				if (m_format.p_mpg123_getformat(m_handle, &rate, &channels, &enc) != MPG123_OK)
+				{
+					return;
+				}
+				
+				const off_t length = m_format.p_mpg123_length(m_handle);
+				
+				if (length <= 0)
+				{
+					return;
+				}
+				
+				m_samplingRate = static_cast<uint32>(rate);
+				m_channels = channels;
+				m_size = static_cast<size_t>(length);
+			}
+			
+			~MP3StreamDecoder() override
+			{
+				if (m_opened)
+				{
+					m_format.p_mpg123_close(m_handle);
+				}
+				
+				if (m_handle)
+				{
+					m_format.p_mpg123_delete(m_handle);
+				}
+			}
+			
+			[[nodiscard]] bool isOpen() const noexcept
+			{
+				return (m_size != 0);
+			}
+			
+			uint32 samplingRate() const override
+			{
+				return m_samplingRate;
+			}
+			
+			size_t size() const override
+			{
+				return m_size;
+			}
+			
+			size_t read(WaveSample* dst, const size_t count) override
+			{
+				size_t written = 0;
+				
+				while (written < count)
+				{
+					const size_t wanted = std::min((count - written), (m_buffer.size() / 2));
+					size_t bytes = 0;
+					
+					const int ret = m_format.p_mpg123_read(m_handle, static_cast<unsigned char*>(static_cast<void*>(m_buffer.data())),
+														   (wanted * m_channels * sizeof(int16)), &bytes);
+					
+					if (ret == MPG123_NEW_FORMAT)
+					{
+						long rate = 0;
+						int enc = 0;
+						
+						m_format.p_mpg123_getformat(m_handle, &rate, &m_channels, &enc);
+					}
+					
+					const int16* pSrc = m_buffer.data();
+					const size_t samples = (bytes / (m_channels * sizeof(int16)));
+					
+					if (m_channels == 1)
+					{
+						for (size_t i = 0; i < samples; ++i)
+						{
+							dst[written++] = WaveSampleS16(pSrc[i]).asWaveSample();
+						}
+					}
+					else
+					{
+						for (size_t i = 0; i < samples; ++i)
+						{
+							dst[written++] = WaveSampleS16(pSrc[i * 2], pSrc[i * 2 + 1]).asWaveSample();
+						}
+					}
+					
+					if (((ret != MPG123_OK) && (ret != MPG123_NEW_FORMAT))
+						|| ((ret == MPG123_OK) && (bytes == 0)))
+					{
+						break;
+					}
+				}
+				
+				return written;
+			}
+			
+			bool seek(const size_t pos) override
+			{
+				return (m_format.p_mpg123_seek(m_handle, static_cast<off_t>(pos), SEEK_SET) >= 0);
+			}
+			
+			size_t residentBytes() const override
+			{
+				return m_buffer.size_bytes();
+			}
+		};
 	}
 	
 	AudioFormat_MP3::AudioFormat_MP3()
@@ -111,12 +299,14 @@ namespace s3d
 		p_mpg123_replace_reader_handle = DLL::GetFunction(m_mpg123, "mpg123_replace_reader_handle");
 		p_mpg123_close = DLL::GetFunction(m_mpg123, "mpg123_close");
 		p_mpg123_info = DLL::GetFunction(m_mpg123, "mpg123_info");
+		p_mpg123_read = DLL::GetFunction(m_mpg123, "mpg123_read");
+		p_mpg123_seek = DLL::GetFunction(m_mpg123, "mpg123_seek");
 		
 		if (!(p_mpg123_init && p_mpg123_new && p_mpg123_delete && p_mpg123_exit && p_mpg123_param
 			  && p_mpg123_rates && p_mpg123_format && p_mpg123_open_feed && p_mpg123_feed
 			  && p_mpg123_decode_frame && p_mpg123_getformat && p_mpg123_scan && p_mpg123_length
 			  && p_mpg123_open && p_mpg123_open_handle && p_mpg123_replace_reader_handle
-			  && p_mpg123_info))
+			  && p_mpg123_info && p_mpg123_read && p_mpg123_seek))
 		{
 			return;
 		}
@@ -340,4 +530,21 @@ namespace s3d
 		
 		return wave;
 	}
+	
+	std::unique_ptr<IAudioStreamDecoder> AudioFormat_MP3::openStream(std::unique_ptr<IReader>&& reader) const
+	{
+		if (!m_libmpg123Available)
+		{
+			return nullptr;
+		}
+		
+		auto decoder = std::make_unique<detail::MP3StreamDecoder>(*this, std::move(reader));
+		
+		if (!decoder->isOpen())
+		{
+			return nullptr;
+		}
+		
+		return decoder;
+	}
 }
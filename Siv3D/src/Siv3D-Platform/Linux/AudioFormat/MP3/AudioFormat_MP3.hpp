@@ -15,13 +15,21 @@
 # include <Siv3D/AudioFormat.hpp>
 # include <Siv3D/Logger.hpp>
 # include <Siv3D/Resource.hpp>
+# include <AudioFormat/IAudioStreamDecoder.hpp>
 
 namespace s3d
 {
+	namespace detail
+	{
+		class MP3StreamDecoder;
+	}
+
 	class AudioFormat_MP3 : public IAudioFormat
 	{
 	private:
 		
+		friend class detail::MP3StreamDecoder;
+		
 		void* m_mpg123 = nullptr;
 		
 		decltype(mpg123_init)* p_mpg123_init = nullptr;
@@ -42,6 +50,8 @@ namespace s3d
 		decltype(mpg123_open_handle)* p_mpg123_open_handle = nullptr;
 		decltype(mpg123_close)* p_mpg123_close = nullptr;
 		decltype(mpg123_info)* p_mpg123_info = nullptr;
+		decltype(mpg123_read)* p_mpg123_read = nullptr;
+		decltype(mpg123_seek)* p_mpg123_seek = nullptr;
 		
 		bool m_libmpg123Available = false;
 		
@@ -61,6 +71,11 @@ namespace s3d
 		
 		Wave decode(IReader& reader) const override;
 		
+		/// <summary>
+		/// reader から少しずつデコードするデコーダを作成します。
+		/// </summary>
+		[[nodiscard]] std::unique_ptr<IAudioStreamDecoder> openStream(std::unique_ptr<IReader>&& reader) const;
+		
 		//bool encode(const Image& image, IWriter& writer) const override;
 		
 		//bool save(const Image& image, const FilePath& path) const override;
@@ -134,7 +134,7 @@ namespace s3d
 		std::unique_ptr<GLStandardVS2D> m_standardVS;
 		std::unique_ptr<GLStandardPS2D> m_standardPS;
 		
-		BufferCreatorFunc m_bufferCreator;
+		BufferCreator m_bufferCreator;
 		
 		ShaderPipeline m_pipeline;
 		
@@ -149,6 +149,8 @@ namespace s3d
 		
 		Optional<PixelShader> m_currentCustomPS;
 
+		bool m_commandCompactionEnabled = true;
+
 	public:
 
 		CRenderer2D_GL();
@@ -219,6 +221,10 @@ namespace s3d
 		
 		Optional<RenderTexture> getRT() const override;
 
+		void setCommandCompactionEnabled(bool enabled) override;
+
+		bool isCommandCompactionEnabled() const override;
+
 		void addLine(const LineStyle& style, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2]) override;
 
 		void addTriangle(const Float2(&pts)[3], const Float4& color) override;
@@ -261,6 +267,10 @@ namespace s3d
 
 		void addShape2DTransformed(const Array<Float2>& vertices, const Array<uint16>& indices, float s, float c, const Float2& offset, const Float4& color) override;
 
+		void addShape2D(const Array<Float2>& vertices, const Array<uint32>& indices, const Optional<Float2>& offset, const Float4& color) override;
+
+		void addShape2DTransformed(const Array<Float2>& vertices, const Array<uint32>& indices, float s, float c, const Float2& offset, const Float4& color) override;
+
 		void addShape2DFrame(const Float2* pts, uint16 size, float thickness, const Float4& color) override;
 
 		void addSprite(const Vertex2D* vertices, size_t vertexCount, const uint16* indices, size_t indexCount) override;
@@ -281,6 +291,12 @@ namespace s3d
 			ParticleSystem2DParameters::SizeOverLifeTimeFunc sizeOverLifeTimeFunc,
 			ParticleSystem2DParameters::ColorOverLifeTimeFunc colorOverLifeTimeFunc) override;
 
+		void addRects(const RectF* rects, size_t count, const ColorF* colors, size_t colorStride) override;
+
+		void addCircles(const Circle* circles, size_t count, const ColorF* colors, size_t colorStride) override;
+
+		void addTextureRegions(const Texture& texture, const RectF* rects, const RectF* uvs, size_t count, const ColorF* colors, size_t colorStride) override;
+
 		const Texture& getBoxShadowTexture() const override;
 	};
 }
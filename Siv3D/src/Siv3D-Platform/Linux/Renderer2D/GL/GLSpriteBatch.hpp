@@ -14,7 +14,9 @@
 # include <GLFW/glfw3.h>
 # include <Siv3D/Array.hpp>
 # include <Siv3D/Vertex2D.hpp>
+# include <Renderer2D/Vertex2DBuilder.hpp>
 # include "GLRenderer2DCommand.hpp"
+# include "GLStreamingBuffer.hpp"
 
 namespace s3d
 {
@@ -40,6 +42,18 @@ namespace s3d
 			uint32 indexPos = 0;
 		};
 		
+		// 16-bit インデックスのバッチに収まらない図形の、配列上の位置
+		struct LargeDraw
+		{
+			uint32 vertexPos = 0;
+			
+			uint32 vertexSize = 0;
+			
+			uint32 indexPos = 0;
+			
+			uint32 indexSize = 0;
+		};
+		
 		GLuint m_vao = 0;
 		
 		GLuint m_vertexBuffer = 0;
@@ -48,6 +62,14 @@ namespace s3d
 		GLuint m_indexBuffer = 0;
 		uint32 m_indexBufferWritePos = 0;
 		
+		// GL_ARB_buffer_storage が使える場合は、永続的にマップしたリングバッファに転送する
+		bool m_streaming = false;
+		GLStreamingBuffer m_vertexStream;
+		GLStreamingBuffer m_indexStream;
+		
+		// 現在のフレームで GPU に転送したバイト数
+		size_t m_uploadedBytes = 0;
+		
 		Array<Vertex2D> m_vertexArray;
 		uint32 m_vertexArrayWritePos = 0;
 		
@@ -56,6 +78,22 @@ namespace s3d
 
 		Array<BatchBufferPos> m_batches;
 		
+		// 32-bit インデックスの専用バッファ。Draw ごとに必要な大きさで転送し直す
+		GLuint m_largeVao = 0;
+		GLuint m_largeVertexBuffer = 0;
+		GLuint m_largeIndexBuffer = 0;
+		
+		Array<Vertex2D> m_largeVertexArray;
+		uint32 m_largeVertexArrayWritePos = 0;
+		
+		Array<uint32> m_largeIndexArray;
+		uint32 m_largeIndexArrayWritePos = 0;
+		
+		Array<LargeDraw> m_largeDraws;
+		
+		// BufferCreator が getBuffer() を経由せずに書き込むための状態
+		Vertex2DBufferState m_bufferState;
+		
 		static constexpr uint32 InitialVertexArraySize	= 4096;
 		static constexpr uint32 InitialIndexArraySize	= 4096 * 8; // 32768
 		
@@ -65,6 +103,12 @@ namespace s3d
 		static constexpr uint32 VertexBufferSize		= 65535;// 65535;
 		static constexpr uint32 IndexBufferSize			= (VertexBufferSize + 1) * 4; // 524,288
 		
+		// BufferCreator による書き込みを書き込み位置とバッチに反映する
+		void syncBufferState() noexcept;
+		
+		// 書き込み位置とバッチから BufferCreator 用の状態を更新する
+		void updateBufferState() noexcept;
+		
 	public:
 		
 		GLSpriteBatch();
@@ -73,14 +117,24 @@ namespace s3d
 		
 		[[nodiscard]] bool init();
 		
-		[[nodiscard]] std::tuple<Vertex2D*, IndexType*, IndexType> getBuffer(const uint16 vertexSize, const uint32 indexSize, GLRenderer2DCommand& command);
+		[[nodiscard]] BufferCreator::BufferType getBuffer(const uint16 vertexSize, const uint32 indexSize, GLRenderer2DCommand& command);
+		
+		// 書き込み先と、GLRenderer2DCommand::pushDrawLarge() に渡すインデックスを返す
+		[[nodiscard]] std::tuple<Vertex2D*, uint32*, uint32> getLargeBuffer(uint32 vertexSize, uint32 indexSize);
 		
 		[[nodiscard]] size_t num_batches() const noexcept;
 		
+		[[nodiscard]] Vertex2DBufferState& getBufferState() noexcept;
+		
+		[[nodiscard]] size_t getUploadedBytes() const noexcept;
+		
 		void reset();
 		
-		//void setBuffers();
+		void setBuffers();
 		
 		[[nodiscard]] BatchInfo updateBuffers(size_t batchIndex);
+		
+		// 専用のバッファに転送してバインドし、インデックスの数を返す
+		[[nodiscard]] uint32 updateLargeBuffers(size_t largeDrawIndex);
 	};
 }
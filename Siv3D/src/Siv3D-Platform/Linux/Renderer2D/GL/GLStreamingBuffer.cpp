@@ -0,0 +1,134 @@
+//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <cstring>
+# include <cassert>
+# include "GLStreamingBuffer.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		// 1 秒
+		constexpr GLuint64 FenceTimeoutNanosec = 1'000'000'000;
+	}
+
+	GLStreamingBuffer::~GLStreamingBuffer()
+	{
+		release();
+	}
+
+	bool GLStreamingBuffer::IsAvailable()
+	{
+		return (GLEW_ARB_buffer_storage != 0);
+	}
+
+	bool GLStreamingBuffer::init(const GLenum target, const uint32 elementSize, const uint32 sectionSize)
+	{
+		constexpr GLbitfield flags = (GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
+
+		const GLsizeiptr bufferSize = static_cast<GLsizeiptr>(elementSize) * sectionSize * NumSections;
+
+		::glBufferStorage(target, bufferSize, nullptr, flags);
+
+		void* const p = ::glMapBufferRange(target, 0, bufferSize, flags);
+
+		if (!p)
+		{
+			return false;
+		}
+
+		m_data			= static_cast<uint8*>(p);
+		m_elementSize	= elementSize;
+		m_sectionSize	= sectionSize;
+		m_writePos		= 0;
+		m_currentSection = 0;
+
+		return true;
+	}
+
+	void GLStreamingBuffer::release()
+	{
+		for (auto& fence : m_fences)
+		{
+			if (fence)
+			{
+				::glDeleteSync(fence);
+				fence = nullptr;
+			}
+		}
+
+		// バッファ本体は所有者が glDeleteBuffers で解放する（マップも同時に解除される）
+		m_data = nullptr;
+	}
+
+	uint32 GLStreamingBuffer::write(const void* src, const uint32 count)
+	{
+		assert(m_data);
+		assert(count <= m_sectionSize);
+
+		// 1 回の書き込みが複数のセクションにまたがらないよう、収まらなければ次のセクションの先頭から書き込む
+		if (((m_currentSection + 1) * m_sectionSize) < (m_writePos + count))
+		{
+			fenceSection(m_currentSection);
+
+			m_currentSection = ((m_currentSection + 1) % NumSections);
+
+			m_writePos = static_cast<uint32>(m_currentSection * m_sectionSize);
+
+			waitSection(m_currentSection);
+		}
+
+		const uint32 offset = m_writePos;
+
+		std::memcpy(m_data + static_cast<size_t>(m_elementSize) * offset, src, static_cast<size_t>(m_elementSize) * count);
+
+		m_writePos += count;
+
+		return offset;
+	}
+
+	void GLStreamingBuffer::fenceSection(const size_t section)
+	{
+		// 書き込みは描画の直前に行われるため、この時点でこのセクションを読む描画コマンドはすべて発行済み
+		if (m_fences[section])
+		{
+			::glDeleteSync(m_fences[section]);
+		}
+
+		m_fences[section] = ::glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	}
+
+	void GLStreamingBuffer::waitSection(const size_t section)
+	{
+		GLsync& fence = m_fences[section];
+
+		if (!fence)
+		{
+			return;
+		}
+
+		for (;;)
+		{
+			const GLenum result = ::glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, detail::FenceTimeoutNanosec);
+
+			if ((result == GL_ALREADY_SIGNALED)
+				|| (result == GL_CONDITION_SATISFIED)
+				|| (result == GL_WAIT_FAILED))
+			{
+				break;
+			}
+		}
+
+		::glDeleteSync(fence);
+		fence = nullptr;
+	}
+}
@@ -13,6 +13,7 @@
 # include <Siv3DEngine.hpp>
 # include <Siv3D/MathConstants.hpp>
 # include <Siv3D/EngineLog.hpp>
+# include <Siv3D/FrameProfiler.hpp>
 # include "CAudio_X27.hpp"
 
 namespace s3d
@@ -131,6 +132,18 @@ namespace s3d
 		return m_audios.add(std::move(audio));
 	}
 
+	AudioID CAudio_X27::createCompact(CompactWave&& wave)
+	{
+		// [Siv3D ToDo] CompactWave のまま再生する
+		return create(wave.toWave());
+	}
+
+	AudioID CAudio_X27::createStreaming(const FilePath& path)
+	{
+		// [Siv3D ToDo] ストリーミング再生に対応する
+		return create(Wave(path));
+	}
+
 	void CAudio_X27::release(const AudioID handleID)
 	{
 		m_audios.erase(handleID);
@@ -242,11 +255,28 @@ namespace s3d
 		return m_audios[handleID]->getStream().getSamplesPlayed();
 	}
 
+	bool CAudio_X27::isStreaming(const AudioID)
+	{
+		return false;
+	}
+
+	size_t CAudio_X27::residentBytes(const AudioID handleID)
+	{
+		return m_audios[handleID]->getWave().size_bytes();
+	}
+
 	const Wave& CAudio_X27::getWave(const AudioID handleID)
 	{
 		return m_audios[handleID]->getWave();
 	}
 
+	const CompactWave& CAudio_X27::getCompactWave(const AudioID)
+	{
+		static const CompactWave wave;
+
+		return wave;
+	}
+
 	void CAudio_X27::setPosSample(const AudioID handleID, const int64 sample)
 	{
 		std::lock_guard lock(m_mutex);
@@ -305,6 +335,8 @@ namespace s3d
 
 	bool CAudio_X27::updateFade()
 	{
+		SIV3D_PROFILE_ZONE(U"Audio::updateFade");
+
 		std::lock_guard lock(m_mutex);
 
 		for (const auto& audio : m_audios)
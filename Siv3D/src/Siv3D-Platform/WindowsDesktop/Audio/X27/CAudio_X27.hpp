@@ -49,6 +49,10 @@ namespace s3d
 
 		AudioID create(Wave&& wave) override;
 
+		AudioID createCompact(CompactWave&& wave) override;
+
+		AudioID createStreaming(const FilePath& path) override;
+
 		void release(AudioID handleID) override;
 
 		uint32 samplingRate(AudioID handleID) override;
@@ -79,8 +83,14 @@ namespace s3d
 
 		uint64 samplesPlayed(AudioID handleID) override;
 
+		bool isStreaming(AudioID handleID) override;
+
+		size_t residentBytes(AudioID handleID) override;
+
 		const Wave& getWave(AudioID handleID) override;
 
+		const CompactWave& getCompactWave(AudioID handleID) override;
+
 		void setPosSample(AudioID handleID, int64 sample) override;
 
 		void setVolume(AudioID handleID, const std::pair<double, double>& volume) override;
@@ -16,9 +16,11 @@
 # include <Siv3D/Mat3x2.hpp>
 # include <Siv3D/FloatRect.hpp>
 # include <Siv3D/FloatQuad.hpp>
+# include <Siv3D/Circle.hpp>
 # include <Siv3D/Line.hpp>
 # include <Siv3D/Resource.hpp>
 # include <Siv3D/Math.hpp>
+# include <Siv3D/FrameProfiler.hpp>
 # include <ConstantBuffer/D3D11/D3D11ConstantBuffer.hpp>
 # include <Graphics/D3D11/CGraphics_D3D11.hpp>
 # include <Texture/D3D11/CTexture_D3D11.hpp>
@@ -121,10 +123,12 @@ namespace s3d
 		}
 
 		// バッファ作成関数を作成
-		m_bufferCreator = [this](IndexType vertexSize, IndexType indexSize)
+		m_bufferCreator = BufferCreator(m_batches.getBufferState(), this, [](void* context, IndexType vertexSize, IndexType indexSize)
 		{
-			return m_batches.getBuffer(vertexSize, indexSize, m_commands);
-		};
+			auto* const renderer = static_cast<CRenderer2D_D3D11*>(context);
+
+			return renderer->m_batches.getBuffer(vertexSize, indexSize, renderer->m_commands);
+		});
 
 		// シャドウ画像を作成
 		{
@@ -152,6 +156,8 @@ namespace s3d
 
 	void CRenderer2D_D3D11::flush()
 	{
+		SIV3D_PROFILE_ZONE(U"Renderer2D::flush");
+
 		ScopeGuard cleanUp = [this]()
 		{
 			m_currentCustomPS.reset();
@@ -161,6 +167,13 @@ namespace s3d
 
 		m_commands.flush();
 
+		const size_t recordedDrawcalls = m_commands.num_draws();
+
+		if (m_commandCompactionEnabled)
+		{
+			m_commands.compact();
+		}
+
 		CGraphics_D3D11* const pGraphics = dynamic_cast<CGraphics_D3D11* const>(Siv3DEngine::Get<ISiv3DGraphics>());
 		CTexture_D3D11* const pTexture = dynamic_cast<CTexture_D3D11* const>(Siv3DEngine::Get<ISiv3DTexture>());
 
@@ -220,6 +233,24 @@ namespace s3d
 					LOG_COMMAND(U"Draw[{}] indexCount = {}, startIndexLocation = {}"_fmt(index, indexCount, startIndexLocation));
 					break;
 				}
+			case RendererCommand::DrawLarge:
+				{
+					m_vsConstants2D._update_if_dirty();
+					m_psConstants2D._update_if_dirty();
+
+					const uint32 indexCount = m_batches.updateLargeBuffers(index);
+
+					m_context->DrawIndexed(indexCount, 0, 0);
+
+					// 続く Draw のために、バッチのバッファに戻す
+					m_batches.setBuffers();
+
+					++profile_drawcalls;
+					profile_vertices += indexCount;
+
+					LOG_COMMAND(U"DrawLarge[{}] indexCount = {}"_fmt(index, indexCount));
+					break;
+				}
 			case RendererCommand::ColorMul:
 				{
 					m_vsConstants2D->colorMul = m_commands.getColorMul(index);
@@ -418,6 +449,8 @@ namespace s3d
 		LOG_COMMAND(U"--({} commands)--"_fmt(m_commands.getList().size()));
 
 		Siv3DEngine::Get<ISiv3DProfiler>()->reportDrawcalls(profile_drawcalls, profile_vertices / 3);
+		Siv3DEngine::Get<ISiv3DProfiler>()->reportMergedDrawcalls(recordedDrawcalls - profile_drawcalls);
+		Siv3DEngine::Get<ISiv3DProfiler>()->reportSpriteBatchUploads(m_batches.getUploadedBytes(), m_batches.num_batches() - 1);
 	}
 
 	std::pair<float, FloatRect> CRenderer2D_D3D11::getLetterboxingTransform() const
@@ -681,6 +714,16 @@ namespace s3d
 		return m_commands.getCurrentRT();
 	}
 
+	void CRenderer2D_D3D11::setCommandCompactionEnabled(const bool enabled)
+	{
+		m_commandCompactionEnabled = enabled;
+	}
+
+	bool CRenderer2D_D3D11::isCommandCompactionEnabled() const
+	{
+		return m_commandCompactionEnabled;
+	}
+
 	void CRenderer2D_D3D11::addLine(const LineStyle& style, const Float2& begin, const Float2& end, const float thickness, const Float4(&colors)[2])
 	{
 		if (style.isSquareCap())
@@ -1019,6 +1062,14 @@ namespace s3d
 
 	void CRenderer2D_D3D11::addShape2D(const Array<Float2>& vertices, const Array<uint16>& indices, const Optional<Float2>& offset, const Float4& color)
 	{
+		// 頂点は 16-bit で指せても、インデックスの数がバッチに収まらない
+		if (Vertex2DBuilder::IsLargeShape2D(vertices.size(), indices.size()))
+		{
+			addShape2D(vertices, indices.map([](const uint16 index) { return static_cast<uint32>(index); }), offset, color);
+
+			return;
+		}
+
 		if (const uint16 count = Vertex2DBuilder::BuildShape2D(m_bufferCreator, vertices, indices, offset, color))
 		{
 			if (!m_currentCustomPS)
@@ -1029,8 +1080,47 @@ namespace s3d
 		}
 	}
 
+	void CRenderer2D_D3D11::addShape2D(const Array<Float2>& vertices, const Array<uint32>& indices, const Optional<Float2>& offset, const Float4& color)
+	{
+		if (!Vertex2DBuilder::IsLargeShape2D(vertices.size(), indices.size()))
+		{
+			if (const uint16 count = Vertex2DBuilder::BuildShape2D(m_bufferCreator, vertices, indices, offset, color))
+			{
+				if (!m_currentCustomPS)
+				{
+					m_commands.pushStandardPS(m_standardPS->shapeID);
+				}
+				m_commands.pushDraw(count);
+			}
+
+			return;
+		}
+
+		const auto[pVertex, pIndex, largeDrawIndex] = m_batches.getLargeBuffer(static_cast<uint32>(vertices.size()), static_cast<uint32>(indices.size()));
+
+		if (!pVertex)
+		{
+			return;
+		}
+
+		Vertex2DBuilder::BuildLargeShape2D(pVertex, pIndex, vertices, indices, offset, color);
+
+		if (!m_currentCustomPS)
+		{
+			m_commands.pushStandardPS(m_standardPS->shapeID);
+		}
+		m_commands.pushDrawLarge(largeDrawIndex);
+	}
+
 	void CRenderer2D_D3D11::addShape2DTransformed(const Array<Float2>& vertices, const Array<uint16>& indices, const float s, const float c, const Float2& offset, const Float4& color)
 	{
+		if (Vertex2DBuilder::IsLargeShape2D(vertices.size(), indices.size()))
+		{
+			addShape2DTransformed(vertices, indices.map([](const uint16 index) { return static_cast<uint32>(index); }), s, c, offset, color);
+
+			return;
+		}
+
 		if (const uint16 count = Vertex2DBuilder::BuildShape2DTransformed(m_bufferCreator, vertices, indices, s, c, offset, color))
 		{
 			if (!m_currentCustomPS)
@@ -1041,6 +1131,38 @@ namespace s3d
 		}
 	}
 
+	void CRenderer2D_D3D11::addShape2DTransformed(const Array<Float2>& vertices, const Array<uint32>& indices, const float s, const float c, const Float2& offset, const Float4& color)
+	{
+		if (!Vertex2DBuilder::IsLargeShape2D(vertices.size(), indices.size()))
+		{
+			if (const uint16 count = Vertex2DBuilder::BuildShape2DTransformed(m_bufferCreator, vertices, indices, s, c, offset, color))
+			{
+				if (!m_currentCustomPS)
+				{
+					m_commands.pushStandardPS(m_standardPS->shapeID);
+				}
+				m_commands.pushDraw(count);
+			}
+
+			return;
+		}
+
+		const auto[pVertex, pIndex, largeDrawIndex] = m_batches.getLargeBuffer(static_cast<uint32>(vertices.size()), static_cast<uint32>(indices.size()));
+
+		if (!pVertex)
+		{
+			return;
+		}
+
+		Vertex2DBuilder::BuildLargeShape2DTransformed(pVertex, pIndex, vertices, indices, s, c, offset, color);
+
+		if (!m_currentCustomPS)
+		{
+			m_commands.pushStandardPS(m_standardPS->shapeID);
+		}
+		m_commands.pushDrawLarge(largeDrawIndex);
+	}
+
 	void CRenderer2D_D3D11::addShape2DFrame(const Float2* pts, const uint16 size, const float thickness, const Float4& color)
 	{
 		if (const uint16 indexCount = Vertex2DBuilder::BuildShape2DFrame(m_bufferCreator, pts, size, thickness, color, getMaxScaling()))
@@ -1157,6 +1279,88 @@ namespace s3d
 		}
 	}
 
+	void CRenderer2D_D3D11::addRects(const RectF* rects, size_t count, const ColorF* colors, const size_t colorStride)
+	{
+		while (count)
+		{
+			size_t numBuilt = 0;
+
+			if (const uint16 indexCount = Vertex2DBuilder::BuildRects(m_bufferCreator, rects, count, colors, colorStride, numBuilt))
+			{
+				if (!m_currentCustomPS)
+				{
+					m_commands.pushStandardPS(m_standardPS->shapeID);
+				}
+				m_commands.pushDraw(indexCount);
+			}
+
+			if (numBuilt == 0)
+			{
+				break;
+			}
+
+			rects += numBuilt;
+			colors += (numBuilt * colorStride);
+			count -= numBuilt;
+		}
+	}
+
+	void CRenderer2D_D3D11::addCircles(const Circle* circles, size_t count, const ColorF* colors, const size_t colorStride)
+	{
+		const float scale = getMaxScaling();
+
+		while (count)
+		{
+			size_t numBuilt = 0;
+
+			if (const uint16 indexCount = Vertex2DBuilder::BuildCircles(m_bufferCreator, circles, count, colors, colorStride, scale, numBuilt))
+			{
+				if (!m_currentCustomPS)
+				{
+					m_commands.pushStandardPS(m_standardPS->shapeID);
+				}
+				m_commands.pushDraw(indexCount);
+			}
+
+			if (numBuilt == 0)
+			{
+				break;
+			}
+
+			circles += numBuilt;
+			colors += (numBuilt * colorStride);
+			count -= numBuilt;
+		}
+	}
+
+	void CRenderer2D_D3D11::addTextureRegions(const Texture& texture, const RectF* rects, const RectF* uvs, size_t count, const ColorF* colors, const size_t colorStride)
+	{
+		while (count)
+		{
+			size_t numBuilt = 0;
+
+			if (const uint16 indexCount = Vertex2DBuilder::BuildTextureRegions(m_bufferCreator, rects, uvs, count, colors, colorStride, numBuilt))
+			{
+				if (!m_currentCustomPS)
+				{
+					m_commands.pushStandardPS(texture.isSDF() ? m_standardPS->sdfID : m_standardPS->textureID);
+				}
+				m_commands.pushPSTexture(0, texture);
+				m_commands.pushDraw(indexCount);
+			}
+
+			if (numBuilt == 0)
+			{
+				break;
+			}
+
+			rects += numBuilt;
+			uvs += numBuilt;
+			colors += (numBuilt * colorStride);
+			count -= numBuilt;
+		}
+	}
+
 	const Texture& CRenderer2D_D3D11::getBoxShadowTexture() const
 	{
 		return *m_boxShadowTexture;
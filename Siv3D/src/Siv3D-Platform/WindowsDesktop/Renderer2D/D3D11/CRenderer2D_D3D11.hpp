@@ -119,12 +119,14 @@ namespace s3d
 
 		D3D11SpriteBatch m_batches;
 		D3D11Renderer2DCommand m_commands;
-		BufferCreatorFunc m_bufferCreator;
+		BufferCreator m_bufferCreator;
 
 		std::unique_ptr<Texture> m_boxShadowTexture;
 
 		Optional<PixelShader> m_currentCustomPS;
 
+		bool m_commandCompactionEnabled = true;
+
 	public:
 
 		CRenderer2D_D3D11();
@@ -195,6 +197,10 @@ namespace s3d
 
 		Optional<RenderTexture> getRT() const override;
 
+		void setCommandCompactionEnabled(bool enabled) override;
+
+		bool isCommandCompactionEnabled() const override;
+
 		void addLine(const LineStyle& style, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2]) override;
 
 		void addTriangle(const Float2(&pts)[3], const Float4& color) override;
@@ -237,6 +243,10 @@ namespace s3d
 
 		void addShape2DTransformed(const Array<Float2>& vertices, const Array<uint16>& indices, float s, float c, const Float2& offset, const Float4& color) override;
 
+		void addShape2D(const Array<Float2>& vertices, const Array<uint32>& indices, const Optional<Float2>& offset, const Float4& color) override;
+
+		void addShape2DTransformed(const Array<Float2>& vertices, const Array<uint32>& indices, float s, float c, const Float2& offset, const Float4& color) override;
+
 		void addShape2DFrame(const Float2* pts, uint16 size, float thickness, const Float4& color) override;
 
 		void addSprite(const Vertex2D* vertices, size_t vertexCount, const uint16* indices, size_t indexCount) override;
@@ -257,6 +267,12 @@ namespace s3d
 			ParticleSystem2DParameters::SizeOverLifeTimeFunc sizeOverLifeTimeFunc,
 			ParticleSystem2DParameters::ColorOverLifeTimeFunc colorOverLifeTimeFunc) override;
 
+		void addRects(const RectF* rects, size_t count, const ColorF* colors, size_t colorStride) override;
+
+		void addCircles(const Circle* circles, size_t count, const ColorF* colors, size_t colorStride) override;
+
+		void addTextureRegions(const Texture& texture, const RectF* rects, const RectF* uvs, size_t count, const ColorF* colors, size_t colorStride) override;
+
 		const Texture& getBoxShadowTexture() const override;
 	};
 }
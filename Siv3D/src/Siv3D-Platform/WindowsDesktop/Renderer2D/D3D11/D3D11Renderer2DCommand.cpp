@@ -10,6 +10,7 @@
 //-----------------------------------------------
 
 # include "D3D11Renderer2DCommand.hpp"
+# include <Renderer2D/Renderer2DCommandCompaction.hpp>
 # include <Siv3D/ConstantBuffer.hpp>
 
 namespace s3d
@@ -39,6 +40,7 @@ namespace s3d
 
 		// Buffer リセット
 		m_draws.clear();
+		m_numLargeDraws = 0;
 		m_constants.clear();
 		m_CBs.clear();
 		m_commands.emplace_back(RendererCommand::SetBuffers, 0);
@@ -228,6 +230,78 @@ namespace s3d
 		m_changes.reset();
 	}
 
+	void D3D11Renderer2DCommand::compact()
+	{
+		detail::CompactRenderer2DCommands(m_commands, m_compactedCommands, m_pendingStates,
+			[this](const uint32 dst, const uint32 src) { m_draws[dst].indexCount += m_draws[src].indexCount; },
+			[this](const RendererCommand command, const uint32 a, const uint32 b) { return isSameState(command, a, b); });
+	}
+
+	size_t D3D11Renderer2DCommand::num_draws() const noexcept
+	{
+		return (m_draws.size() + m_numLargeDraws);
+	}
+
+	bool D3D11Renderer2DCommand::isSameState(const RendererCommand command, const uint32 a, const uint32 b) const
+	{
+		if (a == b)
+		{
+			return true;
+		}
+
+		switch (command)
+		{
+		case RendererCommand::ColorMul:
+			return (m_colorMuls[a] == m_colorMuls[b]);
+		case RendererCommand::ColorAdd:
+			return (m_colorAdds[a] == m_colorAdds[b]);
+		case RendererCommand::BlendState:
+			return (m_blendStates[a] == m_blendStates[b]);
+		case RendererCommand::RasterizerState:
+			return (m_rasterizerStates[a] == m_rasterizerStates[b]);
+		case RendererCommand::PSSamplerState0:
+		case RendererCommand::PSSamplerState1:
+		case RendererCommand::PSSamplerState2:
+		case RendererCommand::PSSamplerState3:
+		case RendererCommand::PSSamplerState4:
+		case RendererCommand::PSSamplerState5:
+		case RendererCommand::PSSamplerState6:
+		case RendererCommand::PSSamplerState7:
+			{
+				const uint32 slot = FromEnum(command) - FromEnum(RendererCommand::PSSamplerState0);
+				return (m_psSamplerStates[slot][a] == m_psSamplerStates[slot][b]);
+			}
+		case RendererCommand::Transform:
+			return (m_combinedTransforms[a] == m_combinedTransforms[b]);
+		case RendererCommand::SetPS:
+			return (m_PSs[a] == m_PSs[b]);
+		case RendererCommand::SetRT:
+			return (m_RTs[a] == m_RTs[b]);
+		case RendererCommand::ScissorRect:
+			return (m_scissorRects[a] == m_scissorRects[b]);
+		case RendererCommand::Viewport:
+			return (m_viewports[a] == m_viewports[b]);
+		case RendererCommand::PSTexture0:
+		case RendererCommand::PSTexture1:
+		case RendererCommand::PSTexture2:
+		case RendererCommand::PSTexture3:
+		case RendererCommand::PSTexture4:
+		case RendererCommand::PSTexture5:
+		case RendererCommand::PSTexture6:
+		case RendererCommand::PSTexture7:
+			{
+				const uint32 slot = FromEnum(command) - FromEnum(RendererCommand::PSTexture0);
+				return (m_psTextures[slot][a] == m_psTextures[slot][b]);
+			}
+		case RendererCommand::SDFParam:
+			return (m_sdfParams[a] == m_sdfParams[b]);
+		case RendererCommand::InternalPSConstants:
+			return (m_internalPSConstants[a] == m_internalPSConstants[b]);
+		default:
+			return false;
+		}
+	}
+
 	void D3D11Renderer2DCommand::pushDraw(const uint16 indexCount)
 	{
 		if (m_changes.hasStateChange())
@@ -249,6 +323,13 @@ namespace s3d
 		m_commands.emplace_back(RendererCommand::UpdateBuffers, batchIndex);
 	}
 
+	void D3D11Renderer2DCommand::pushDrawLarge(const uint32 largeDrawIndex)
+	{
+		flush();
+		m_commands.emplace_back(RendererCommand::DrawLarge, largeDrawIndex);
+		++m_numLargeDraws;
+	}
+
 	void D3D11Renderer2DCommand::pushColorMul(const Float4& color)
 	{
 		constexpr auto command = RendererCommand::ColorMul;
@@ -34,7 +34,7 @@ namespace s3d
 		, m_indexArray(InitialIndexArraySize)
 		, m_batches(1)
 	{
-
+		updateBufferState();
 	}
 
 	bool D3D11SpriteBatch::init(ID3D11Device* device, ID3D11DeviceContext* context)
@@ -71,8 +71,10 @@ namespace s3d
 		return true;
 	}
 
-	std::tuple<Vertex2D*, IndexType*, IndexType> D3D11SpriteBatch::getBuffer(const uint16 vertexSize, const uint32 indexSize, D3D11Renderer2DCommand& command)
+	BufferCreator::BufferType D3D11SpriteBatch::getBuffer(const uint16 vertexSize, const uint32 indexSize, D3D11Renderer2DCommand& command)
 	{
+		syncBufferState();
+
 		// VB
 		if (const uint32 vertexArrayWritePosTarget = m_vertexArrayWritePos + vertexSize;
 			m_vertexArray.size() < vertexArrayWritePosTarget)
@@ -109,7 +111,7 @@ namespace s3d
 		}
 
 		auto& lastbatch = m_batches.back();
-		const std::tuple<Vertex2D*, IndexType*, IndexType> result{
+		const BufferCreator::BufferType result{
 			  m_vertexArray.data() + m_vertexArrayWritePos
 			, m_indexArray.data() + m_indexArrayWritePos
 			, lastbatch.vertexPos };
@@ -120,6 +122,44 @@ namespace s3d
 		lastbatch.vertexPos	+= vertexSize;
 		lastbatch.indexPos	+= indexSize;
 
+		updateBufferState();
+
+		return result;
+	}
+
+	std::tuple<Vertex2D*, uint32*, uint32> D3D11SpriteBatch::getLargeBuffer(const uint32 vertexSize, const uint32 indexSize)
+	{
+		const uint32 vertexArrayWritePosTarget = m_largeVertexArrayWritePos + vertexSize;
+		const uint32 indexArrayWritePosTarget = m_largeIndexArrayWritePos + indexSize;
+
+		if ((MaxVertexArraySize < vertexArrayWritePosTarget)
+			|| (MaxIndexArraySize < indexArrayWritePosTarget))
+		{
+			return{ nullptr, nullptr, 0 };
+		}
+
+		if (m_largeVertexArray.size() < vertexArrayWritePosTarget)
+		{
+			LOG_DEBUG(U"ℹ️ Resized D3D11SpriteBatch::m_largeVertexArray (size: {} -> {})"_fmt(m_largeVertexArray.size(), vertexArrayWritePosTarget));
+			m_largeVertexArray.resize(vertexArrayWritePosTarget);
+		}
+
+		if (m_largeIndexArray.size() < indexArrayWritePosTarget)
+		{
+			LOG_DEBUG(U"ℹ️ Resized D3D11SpriteBatch::m_largeIndexArray (size: {} -> {})"_fmt(m_largeIndexArray.size(), indexArrayWritePosTarget));
+			m_largeIndexArray.resize(indexArrayWritePosTarget);
+		}
+
+		const std::tuple<Vertex2D*, uint32*, uint32> result{
+			  m_largeVertexArray.data() + m_largeVertexArrayWritePos
+			, m_largeIndexArray.data() + m_largeIndexArrayWritePos
+			, static_cast<uint32>(m_largeDraws.size()) };
+
+		m_largeDraws.push_back({ m_largeVertexArrayWritePos, vertexSize, m_largeIndexArrayWritePos, indexSize });
+
+		m_largeVertexArrayWritePos	= vertexArrayWritePosTarget;
+		m_largeIndexArrayWritePos	= indexArrayWritePosTarget;
+
 		return result;
 	}
 
@@ -128,6 +168,11 @@ namespace s3d
 		return m_batches.size();
 	}
 
+	Vertex2DBufferState& D3D11SpriteBatch::getBufferState() noexcept
+	{
+		return m_bufferState;
+	}
+
 	void D3D11SpriteBatch::reset()
 	{
 		m_batches.clear();
@@ -135,6 +180,20 @@ namespace s3d
 
 		m_vertexArrayWritePos	= 0;
 		m_indexArrayWritePos	= 0;
+
+		m_largeDraws.clear();
+
+		m_largeVertexArrayWritePos	= 0;
+		m_largeIndexArrayWritePos	= 0;
+
+		m_uploadedBytes = 0;
+
+		updateBufferState();
+	}
+
+	size_t D3D11SpriteBatch::getUploadedBytes() const noexcept
+	{
+		return m_uploadedBytes;
 	}
 
 	void D3D11SpriteBatch::setBuffers()
@@ -150,6 +209,8 @@ namespace s3d
 
 	BatchInfo D3D11SpriteBatch::updateBuffers(const size_t batchIndex)
 	{
+		syncBufferState();
+
 		assert(batchIndex < m_batches.size());
 
 		size_t vertexArrayReadPos	= 0;
@@ -193,6 +254,7 @@ namespace s3d
 
 			batchInfo.baseVertexLocation = m_vertexBufferWritePos;
 			m_vertexBufferWritePos += vertexSize;
+			m_uploadedBytes += (sizeof(Vertex2D) * vertexSize);
 		}
 
 		// IB
@@ -225,8 +287,107 @@ namespace s3d
 			batchInfo.indexCount = indexSize;
 			batchInfo.startIndexLocation = m_indexBufferWritePos;
 			m_indexBufferWritePos += indexSize;
+			m_uploadedBytes += (sizeof(IndexType) * indexSize);
 		}
 
 		return batchInfo;
 	}
+
+	uint32 D3D11SpriteBatch::updateLargeBuffers(const size_t largeDrawIndex)
+	{
+		assert(largeDrawIndex < m_largeDraws.size());
+
+		const LargeDraw& largeDraw = m_largeDraws[largeDrawIndex];
+
+		// VB
+		if (m_largeVertexBufferSize < largeDraw.vertexSize)
+		{
+			const uint32 newBufferSize = static_cast<uint32>(detail::CalculateNewArraySize(std::max<uint32>(m_largeVertexBufferSize, VertexBufferSize), largeDraw.vertexSize));
+
+			const CD3D11_BUFFER_DESC desc(
+				sizeof(Vertex2D) * newBufferSize,
+				D3D11_BIND_VERTEX_BUFFER,
+				D3D11_USAGE_DYNAMIC,
+				D3D11_CPU_ACCESS_WRITE);
+
+			m_largeVertexBuffer.Reset();
+			m_largeVertexBufferSize = 0;
+
+			if (FAILED(m_device->CreateBuffer(&desc, nullptr, &m_largeVertexBuffer)))
+			{
+				return 0;
+			}
+
+			m_largeVertexBufferSize = newBufferSize;
+		}
+
+		// IB
+		if (m_largeIndexBufferSize < largeDraw.indexSize)
+		{
+			const uint32 newBufferSize = static_cast<uint32>(detail::CalculateNewArraySize(std::max<uint32>(m_largeIndexBufferSize, IndexBufferSize), largeDraw.indexSize));
+
+			const CD3D11_BUFFER_DESC desc(
+				sizeof(uint32) * newBufferSize,
+				D3D11_BIND_INDEX_BUFFER,
+				D3D11_USAGE_DYNAMIC,
+				D3D11_CPU_ACCESS_WRITE);
+
+			m_largeIndexBuffer.Reset();
+			m_largeIndexBufferSize = 0;
+
+			if (FAILED(m_device->CreateBuffer(&desc, nullptr, &m_largeIndexBuffer)))
+			{
+				return 0;
+			}
+
+			m_largeIndexBufferSize = newBufferSize;
+		}
+
+		D3D11_MAPPED_SUBRESOURCE res;
+
+		if (SUCCEEDED(m_context->Map(m_largeVertexBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &res)))
+		{
+			std::memcpy(res.pData, m_largeVertexArray.data() + largeDraw.vertexPos, sizeof(Vertex2D) * largeDraw.vertexSize);
+			m_context->Unmap(m_largeVertexBuffer.Get(), 0);
+		}
+
+		if (SUCCEEDED(m_context->Map(m_largeIndexBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &res)))
+		{
+			std::memcpy(res.pData, m_largeIndexArray.data() + largeDraw.indexPos, sizeof(uint32) * largeDraw.indexSize);
+			m_context->Unmap(m_largeIndexBuffer.Get(), 0);
+		}
+
+		m_uploadedBytes += (sizeof(Vertex2D) * largeDraw.vertexSize + sizeof(uint32) * largeDraw.indexSize);
+
+		ID3D11Buffer* const pBuf[1] = { m_largeVertexBuffer.Get() };
+		const UINT stride = sizeof(Vertex2D);
+		const UINT offset = 0;
+		m_context->IASetVertexBuffers(0, 1, pBuf, &stride, &offset);
+		m_context->IASetIndexBuffer(m_largeIndexBuffer.Get(), DXGI_FORMAT_R32_UINT, 0);
+
+		return largeDraw.indexSize;
+	}
+
+	void D3D11SpriteBatch::syncBufferState() noexcept
+	{
+		auto& lastbatch = m_batches.back();
+
+		m_vertexArrayWritePos	+= (m_bufferState.batchVertexPos - lastbatch.vertexPos);
+		m_indexArrayWritePos	+= (m_bufferState.batchIndexPos - lastbatch.indexPos);
+
+		lastbatch.vertexPos	= m_bufferState.batchVertexPos;
+		lastbatch.indexPos	= m_bufferState.batchIndexPos;
+	}
+
+	void D3D11SpriteBatch::updateBufferState() noexcept
+	{
+		const auto& lastbatch = m_batches.back();
+
+		m_bufferState.pVertex			= m_vertexArray.data() + m_vertexArrayWritePos;
+		m_bufferState.pIndex			= m_indexArray.data() + m_indexArrayWritePos;
+		m_bufferState.vertexSpace		= std::min<uint32>(static_cast<uint32>(m_vertexArray.size() - m_vertexArrayWritePos), VertexBufferSize - lastbatch.vertexPos);
+		m_bufferState.indexSpace		= std::min<uint32>(static_cast<uint32>(m_indexArray.size() - m_indexArrayWritePos), IndexBufferSize - lastbatch.indexPos);
+		m_bufferState.batchVertexPos	= lastbatch.vertexPos;
+		m_bufferState.batchIndexPos		= lastbatch.indexPos;
+	}
 }
@@ -14,6 +14,7 @@
 # include <d3d11.h>
 # include <Siv3D/Array.hpp>
 # include <Siv3D/Vertex2D.hpp>
+# include <Renderer2D/Vertex2DBuilder.hpp>
 # include "D3D11Renderer2DCommand.hpp"
 
 namespace s3d
@@ -40,6 +41,18 @@ namespace s3d
 			uint32 indexPos = 0;
 		};
 
+		// 16-bit インデックスのバッチに収まらない図形の、配列上の位置
+		struct LargeDraw
+		{
+			uint32 vertexPos = 0;
+
+			uint32 vertexSize = 0;
+
+			uint32 indexPos = 0;
+
+			uint32 indexSize = 0;
+		};
+
 		ID3D11Device* m_device = nullptr;
 		ID3D11DeviceContext* m_context = nullptr;
 
@@ -57,6 +70,27 @@ namespace s3d
 
 		Array<BatchBufferPos> m_batches;
 
+		// 32-bit インデックスの専用バッファ。足りなくなったときだけ作り直す
+		ComPtr<ID3D11Buffer> m_largeVertexBuffer;
+		uint32 m_largeVertexBufferSize = 0;
+
+		ComPtr<ID3D11Buffer> m_largeIndexBuffer;
+		uint32 m_largeIndexBufferSize = 0;
+
+		Array<Vertex2D> m_largeVertexArray;
+		uint32 m_largeVertexArrayWritePos = 0;
+
+		Array<uint32> m_largeIndexArray;
+		uint32 m_largeIndexArrayWritePos = 0;
+
+		Array<LargeDraw> m_largeDraws;
+
+		// BufferCreator が getBuffer() を経由せずに書き込むための状態
+		Vertex2DBufferState m_bufferState;
+
+		// 現在のフレームで GPU に転送したバイト数
+		size_t m_uploadedBytes = 0;
+
 		static constexpr uint32 InitialVertexArraySize	= 4096;
 		static constexpr uint32 InitialIndexArraySize	= 4096 * 8; // 32768
 
@@ -66,20 +100,36 @@ namespace s3d
 		static constexpr uint32 VertexBufferSize		= 65535;// 65535;
 		static constexpr uint32 IndexBufferSize			= (VertexBufferSize + 1) * 4; // 524,288
 
+		// BufferCreator による書き込みを書き込み位置とバッチに反映する
+		void syncBufferState() noexcept;
+
+		// 書き込み位置とバッチから BufferCreator 用の状態を更新する
+		void updateBufferState() noexcept;
+
 	public:
 
 		D3D11SpriteBatch();
 
 		[[nodiscard]] bool init(ID3D11Device* device, ID3D11DeviceContext* context);
 
-		[[nodiscard]] std::tuple<Vertex2D*, IndexType*, IndexType> getBuffer(const uint16 vertexSize, const uint32 indexSize, D3D11Renderer2DCommand& command);
+		[[nodiscard]] BufferCreator::BufferType getBuffer(const uint16 vertexSize, const uint32 indexSize, D3D11Renderer2DCommand& command);
+
+		// 書き込み先と、D3D11Renderer2DCommand::pushDrawLarge() に渡すインデックスを返す
+		[[nodiscard]] std::tuple<Vertex2D*, uint32*, uint32> getLargeBuffer(uint32 vertexSize, uint32 indexSize);
 
 		[[nodiscard]] size_t num_batches() const noexcept;
 
+		[[nodiscard]] Vertex2DBufferState& getBufferState() noexcept;
+
+		[[nodiscard]] size_t getUploadedBytes() const noexcept;
+
 		void reset();
 
 		void setBuffers();
 
 		[[nodiscard]] BatchInfo updateBuffers(size_t batchIndex);
+
+		// 専用のバッファに転送してセットし、インデックスの数を返す
+		[[nodiscard]] uint32 updateLargeBuffers(size_t largeDrawIndex);
 	};
 }
@@ -106,6 +106,18 @@ namespace s3d
 		return m_audios.add(std::move(audio));
 	}
 
+	AudioID CAudio_AL::createCompact(CompactWave&& wave)
+	{
+		// [Siv3D ToDo] CompactWave のまま再生する
+		return create(wave.toWave());
+	}
+
+	AudioID CAudio_AL::createStreaming(const FilePath& path)
+	{
+		// [Siv3D ToDo] ストリーミング再生に対応する
+		return create(Wave(path));
+	}
+
 	void CAudio_AL::release(const AudioID handleID)
 	{
 		m_audios.erase(handleID);
@@ -184,11 +196,28 @@ namespace s3d
 		return m_audios[handleID]->getStream().samplesPlayed();
 	}
 
+	bool CAudio_AL::isStreaming(const AudioID)
+	{
+		return false;
+	}
+
+	size_t CAudio_AL::residentBytes(const AudioID handleID)
+	{
+		return m_audios[handleID]->getWave().size_bytes();
+	}
+
 	const Wave& CAudio_AL::getWave(AudioID handleID)
 	{
 		return m_audios[handleID]->getWave();
 	}
 
+	const CompactWave& CAudio_AL::getCompactWave(const AudioID)
+	{
+		static const CompactWave wave;
+
+		return wave;
+	}
+
 	void CAudio_AL::setPosSample(const AudioID handleID, const int64 sample)
 	{
 		const auto& audio = m_audios[handleID];
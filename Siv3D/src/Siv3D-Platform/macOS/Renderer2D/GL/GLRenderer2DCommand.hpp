@@ -90,6 +90,9 @@ namespace s3d
 		SDFParam,
 		
 		InternalPSConstants,
+		
+		// 32-bit インデックスの専用バッファを使う Draw（ステートではないので CurrentBatchStateChanges には記録しない）
+		DrawLarge,
 	};
 	
 	class CurrentBatchStateChanges
@@ -150,6 +153,7 @@ namespace s3d
 		CurrentBatchStateChanges m_changes;
 		
 		Array<DrawCommand> m_draws;
+		size_t m_numLargeDraws = 0;
 		Array<__m128> m_constants;
 		Array<CBCommand> m_CBs;
 
@@ -188,6 +192,12 @@ namespace s3d
 		HashTable<PixelShaderID, PixelShader> m_reservedPSs;
 		HashTable<TextureID, Texture> m_reservedTextures;
 		
+		// compact() で使う作業用のバッファ
+		Array<std::pair<RendererCommand, uint32>> m_compactedCommands;
+		Array<RendererCommand> m_pendingStates;
+		
+		[[nodiscard]] bool isSameState(RendererCommand command, uint32 a, uint32 b) const;
+		
 	public:
 		
 		GLRenderer2DCommand();
@@ -196,11 +206,19 @@ namespace s3d
 		
 		void flush();
 		
+		// 記録済みのコマンド列から効果の無いステート変更を取り除き、隣接する Draw をまとめる
+		void compact();
+		
+		[[nodiscard]] size_t num_draws() const noexcept;
+		
 		const Array<std::pair<RendererCommand, uint32>>& getList() const;
 		
 		void pushDraw(uint16 indexCount);
 		const DrawCommand& getDraw(uint32 index);
 		
+		// 直前までの Draw を確定させてから、スプライトバッチの largeDrawIndex 番目の Draw を記録する
+		void pushDrawLarge(uint32 largeDrawIndex);
+		
 		void pushUpdateBuffers(uint32 batchIndex);
 		
 		void pushColorMul(const Float4& color);
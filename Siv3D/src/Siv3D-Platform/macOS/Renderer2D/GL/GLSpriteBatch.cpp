@@ -34,11 +34,32 @@ namespace s3d
 		, m_indexArray(InitialIndexArraySize)
 		, m_batches(1)
 	{
-	
+		updateBufferState();
 	}
 	
 	GLSpriteBatch::~GLSpriteBatch()
 	{
+		m_vertexStream.release();
+		m_indexStream.release();
+		
+		if (m_largeIndexBuffer)
+		{
+			::glDeleteBuffers(1, &m_largeIndexBuffer);
+			m_largeIndexBuffer = 0;
+		}
+		
+		if (m_largeVertexBuffer)
+		{
+			::glDeleteBuffers(1, &m_largeVertexBuffer);
+			m_largeVertexBuffer = 0;
+		}
+		
+		if (m_largeVao)
+		{
+			::glDeleteVertexArrays(1, &m_largeVao);
+			m_largeVao = 0;
+		}
+		
 		if (m_indexBuffer)
 		{
 			::glDeleteBuffers(1, &m_indexBuffer);
@@ -65,10 +86,23 @@ namespace s3d
 		
 		::glGenVertexArrays(1, &m_vao);
 		
+		m_streaming = GLStreamingBuffer::IsAvailable();
+		
 		::glBindVertexArray(m_vao);
 		{
 			::glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
-			::glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex2D) * VertexBufferSize, nullptr, GL_DYNAMIC_DRAW);
+			
+			if (m_streaming)
+			{
+				if (!m_vertexStream.init(GL_ARRAY_BUFFER, sizeof(Vertex2D), VertexBufferSize))
+				{
+					return false;
+				}
+			}
+			else
+			{
+				::glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex2D) * VertexBufferSize, nullptr, GL_DYNAMIC_DRAW);
+			}
 			
 			::glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 32, (GLubyte*)0);
 			::glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 32, (GLubyte*)8);
@@ -79,15 +113,52 @@ namespace s3d
 			::glEnableVertexAttribArray(2);
 			
 			::glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexBuffer);
-			::glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint32) * IndexBufferSize, nullptr, GL_DYNAMIC_DRAW);
+			
+			if (m_streaming)
+			{
+				if (!m_indexStream.init(GL_ELEMENT_ARRAY_BUFFER, sizeof(IndexType), IndexBufferSize))
+				{
+					return false;
+				}
+			}
+			else
+			{
+				::glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint32) * IndexBufferSize, nullptr, GL_DYNAMIC_DRAW);
+			}
+		}
+		::glBindVertexArray(0);
+		
+		::glGenBuffers(1, &m_largeVertexBuffer);
+		::glGenBuffers(1, &m_largeIndexBuffer);
+		
+		::glGenVertexArrays(1, &m_largeVao);
+		
+		::glBindVertexArray(m_largeVao);
+		{
+			::glBindBuffer(GL_ARRAY_BUFFER, m_largeVertexBuffer);
+			
+			::glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 32, (GLubyte*)0);
+			::glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 32, (GLubyte*)8);
+			::glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, 32, (GLubyte*)16);
+			
+			::glEnableVertexAttribArray(0);
+			::glEnableVertexAttribArray(1);
+			::glEnableVertexAttribArray(2);
+			
+			::glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_largeIndexBuffer);
 		}
 		::glBindVertexArray(0);
+		
+		LOG_INFO(m_streaming ? U"ℹ️ GLSpriteBatch: Using persistently mapped streaming buffers"
+					: U"ℹ️ GLSpriteBatch: GL_ARB_buffer_storage is not available. Falling back to glMapBufferRange");
 
 		return true;
 	}
 	
-	std::tuple<Vertex2D*, IndexType*, IndexType> GLSpriteBatch::getBuffer(const uint16 vertexSize, const uint32 indexSize, GLRenderer2DCommand& command)
+	BufferCreator::BufferType GLSpriteBatch::getBuffer(const uint16 vertexSize, const uint32 indexSize, GLRenderer2DCommand& command)
 	{
+		syncBufferState();
+		
 		// VB
 		if (const uint32 vertexArrayWritePosTarget = m_vertexArrayWritePos + vertexSize;
 			m_vertexArray.size() < vertexArrayWritePosTarget)
@@ -124,7 +195,7 @@ namespace s3d
 		}
 		
 		auto& lastbatch = m_batches.back();
-		const std::tuple<Vertex2D*, IndexType*, IndexType> result{
+		const BufferCreator::BufferType result{
 			m_vertexArray.data() + m_vertexArrayWritePos
 			, m_indexArray.data() + m_indexArrayWritePos
 			, lastbatch.vertexPos };
@@ -135,6 +206,44 @@ namespace s3d
 		lastbatch.vertexPos	+= vertexSize;
 		lastbatch.indexPos	+= indexSize;
 		
+		updateBufferState();
+		
+		return result;
+	}
+	
+	std::tuple<Vertex2D*, uint32*, uint32> GLSpriteBatch::getLargeBuffer(const uint32 vertexSize, const uint32 indexSize)
+	{
+		const uint32 vertexArrayWritePosTarget = m_largeVertexArrayWritePos + vertexSize;
+		const uint32 indexArrayWritePosTarget = m_largeIndexArrayWritePos + indexSize;
+		
+		if ((MaxVertexArraySize < vertexArrayWritePosTarget)
+			|| (MaxIndexArraySize < indexArrayWritePosTarget))
+		{
+			return{ nullptr, nullptr, 0 };
+		}
+		
+		if (m_largeVertexArray.size() < vertexArrayWritePosTarget)
+		{
+			LOG_DEBUG(U"ℹ️ Resized GLSpriteBatch::m_largeVertexArray (size: {} -> {})"_fmt(m_largeVertexArray.size(), vertexArrayWritePosTarget));
+			m_largeVertexArray.resize(vertexArrayWritePosTarget);
+		}
+		
+		if (m_largeIndexArray.size() < indexArrayWritePosTarget)
+		{
+			LOG_DEBUG(U"ℹ️ Resized GLSpriteBatch::m_largeIndexArray (size: {} -> {})"_fmt(m_largeIndexArray.size(), indexArrayWritePosTarget));
+			m_largeIndexArray.resize(indexArrayWritePosTarget);
+		}
+		
+		const std::tuple<Vertex2D*, uint32*, uint32> result{
+			m_largeVertexArray.data() + m_largeVertexArrayWritePos
+			, m_largeIndexArray.data() + m_largeIndexArrayWritePos
+			, static_cast<uint32>(m_largeDraws.size()) };
+		
+		m_largeDraws.push_back({ m_largeVertexArrayWritePos, vertexSize, m_largeIndexArrayWritePos, indexSize });
+		
+		m_largeVertexArrayWritePos	= vertexArrayWritePosTarget;
+		m_largeIndexArrayWritePos	= indexArrayWritePosTarget;
+		
 		return result;
 	}
 	
@@ -143,6 +252,11 @@ namespace s3d
 		return m_batches.size();
 	}
 	
+	Vertex2DBufferState& GLSpriteBatch::getBufferState() noexcept
+	{
+		return m_bufferState;
+	}
+	
 	void GLSpriteBatch::reset()
 	{
 		m_batches.clear();
@@ -150,17 +264,31 @@ namespace s3d
 		
 		m_vertexArrayWritePos	= 0;
 		m_indexArrayWritePos	= 0;
+		
+		m_largeDraws.clear();
+		
+		m_largeVertexArrayWritePos	= 0;
+		m_largeIndexArrayWritePos	= 0;
+		
+		m_uploadedBytes = 0;
+		
+		updateBufferState();
+	}
+	
+	size_t GLSpriteBatch::getUploadedBytes() const noexcept
+	{
+		return m_uploadedBytes;
 	}
 	
-	/*
 	void GLSpriteBatch::setBuffers()
 	{
-		
+		::glBindVertexArray(m_vao);
 	}
-	 */
 	
 	BatchInfo GLSpriteBatch::updateBuffers(const size_t batchIndex)
 	{
+		syncBufferState();
+		
 		assert(batchIndex < m_batches.size());
 		
 		size_t vertexArrayReadPos	= 0;
@@ -183,19 +311,28 @@ namespace s3d
 		{
 			const Vertex2D* pSrc = m_vertexArray.data() + vertexArrayReadPos;
 			
-			if (VertexBufferSize < (m_vertexBufferWritePos + vertexSize))
+			m_uploadedBytes += (sizeof(Vertex2D) * vertexSize);
+			
+			if (m_streaming)
 			{
-				m_vertexBufferWritePos = 0;
-				::glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex2D) * VertexBufferSize, nullptr, GL_DYNAMIC_DRAW);
+				batchInfo.baseVertexLocation = m_vertexStream.write(pSrc, vertexSize);
+			}
+			else
+			{
+				if (VertexBufferSize < (m_vertexBufferWritePos + vertexSize))
+				{
+					m_vertexBufferWritePos = 0;
+					::glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex2D) * VertexBufferSize, nullptr, GL_DYNAMIC_DRAW);
+				}
+				
+				void* pDst = ::glMapBufferRange(GL_ARRAY_BUFFER, sizeof(Vertex2D) * m_vertexBufferWritePos, sizeof(Vertex2D) * vertexSize,
+												GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+				std::memcpy(pDst, pSrc, sizeof(Vertex2D) * vertexSize);
+				::glUnmapBuffer(GL_ARRAY_BUFFER);
+				
+				batchInfo.baseVertexLocation = m_vertexBufferWritePos;
+				m_vertexBufferWritePos += vertexSize;
 			}
-			
-			void* pDst = ::glMapBufferRange(GL_ARRAY_BUFFER, sizeof(Vertex2D) * m_vertexBufferWritePos, sizeof(Vertex2D) * vertexSize,
-											GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
-			std::memcpy(pDst, pSrc, sizeof(Vertex2D) * vertexSize);
-			::glUnmapBuffer(GL_ARRAY_BUFFER);
-			
-			batchInfo.baseVertexLocation = m_vertexBufferWritePos;
-			m_vertexBufferWritePos += vertexSize;
 		}
 		
 		// IB
@@ -203,22 +340,73 @@ namespace s3d
 		{
 			const IndexType* pSrc	= m_indexArray.data() + indexArrayReadPos;
 			
-			if (IndexBufferSize < (m_indexBufferWritePos + indexSize))
+			m_uploadedBytes += (sizeof(IndexType) * indexSize);
+			
+			if (m_streaming)
 			{
-				m_indexBufferWritePos = 0;
-				::glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(IndexType) * IndexBufferSize, nullptr, GL_DYNAMIC_DRAW);
+				batchInfo.startIndexLocation = m_indexStream.write(pSrc, indexSize);
+			}
+			else
+			{
+				if (IndexBufferSize < (m_indexBufferWritePos + indexSize))
+				{
+					m_indexBufferWritePos = 0;
+					::glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(IndexType) * IndexBufferSize, nullptr, GL_DYNAMIC_DRAW);
+				}
+				
+				void* pDst = ::glMapBufferRange(GL_ELEMENT_ARRAY_BUFFER, sizeof(IndexType) * m_indexBufferWritePos, sizeof(IndexType) * indexSize,
+												GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+				std::memcpy(pDst, pSrc, sizeof(IndexType) * indexSize);
+				::glUnmapBuffer(GL_ELEMENT_ARRAY_BUFFER);
+				
+				batchInfo.startIndexLocation = m_indexBufferWritePos;
+				m_indexBufferWritePos += indexSize;
 			}
-			
-			void* pDst = ::glMapBufferRange(GL_ELEMENT_ARRAY_BUFFER, sizeof(IndexType) * m_indexBufferWritePos, sizeof(IndexType) * indexSize,
-											GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
-			std::memcpy(pDst, pSrc, sizeof(IndexType) * indexSize);
-			::glUnmapBuffer(GL_ELEMENT_ARRAY_BUFFER);
 			
 			batchInfo.indexCount = indexSize;
-			batchInfo.startIndexLocation = m_indexBufferWritePos;
-			m_indexBufferWritePos += indexSize;
 		}
 		
 		return batchInfo;
 	}
+	
+	uint32 GLSpriteBatch::updateLargeBuffers(const size_t largeDrawIndex)
+	{
+		assert(largeDrawIndex < m_largeDraws.size());
+		
+		const LargeDraw& largeDraw = m_largeDraws[largeDrawIndex];
+		
+		::glBindVertexArray(m_largeVao);
+		::glBindBuffer(GL_ARRAY_BUFFER, m_largeVertexBuffer);
+		
+		// 領域ごと確保し直すので、前の Draw が読み終えるのを待たずに済む
+		::glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex2D) * largeDraw.vertexSize, m_largeVertexArray.data() + largeDraw.vertexPos, GL_STREAM_DRAW);
+		::glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint32) * largeDraw.indexSize, m_largeIndexArray.data() + largeDraw.indexPos, GL_STREAM_DRAW);
+		
+		m_uploadedBytes += (sizeof(Vertex2D) * largeDraw.vertexSize + sizeof(uint32) * largeDraw.indexSize);
+		
+		return largeDraw.indexSize;
+	}
+	
+	void GLSpriteBatch::syncBufferState() noexcept
+	{
+		auto& lastbatch = m_batches.back();
+		
+		m_vertexArrayWritePos	+= (m_bufferState.batchVertexPos - lastbatch.vertexPos);
+		m_indexArrayWritePos	+= (m_bufferState.batchIndexPos - lastbatch.indexPos);
+		
+		lastbatch.vertexPos	= m_bufferState.batchVertexPos;
+		lastbatch.indexPos	= m_bufferState.batchIndexPos;
+	}
+	
+	void GLSpriteBatch::updateBufferState() noexcept
+	{
+		const auto& lastbatch = m_batches.back();
+		
+		m_bufferState.pVertex			= m_vertexArray.data() + m_vertexArrayWritePos;
+		m_bufferState.pIndex			= m_indexArray.data() + m_indexArrayWritePos;
+		m_bufferState.vertexSpace		= std::min<uint32>(static_cast<uint32>(m_vertexArray.size() - m_vertexArrayWritePos), VertexBufferSize - lastbatch.vertexPos);
+		m_bufferState.indexSpace		= std::min<uint32>(static_cast<uint32>(m_indexArray.size() - m_indexArrayWritePos), IndexBufferSize - lastbatch.indexPos);
+		m_bufferState.batchVertexPos	= lastbatch.vertexPos;
+		m_bufferState.batchIndexPos		= lastbatch.indexPos;
+	}
 }
@@ -0,0 +1,66 @@
+//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <array>
+# include <GL/glew.h>
+# include <GLFW/glfw3.h>
+# include <Siv3D/Fwd.hpp>
+
+namespace s3d
+{
+	/// <summary>
+	/// 永続的にマップされたリングバッファ (GL_ARB_buffer_storage)
+	/// </summary>
+	/// <remarks>
+	/// バッファをいくつかのセクションに分け、セクションを使い終えるたびにフェンスを置く。
+	/// 書き込みが再び同じセクションに入るときは、GPU がそのセクションを読み終えるのを待つ。
+	/// </remarks>
+	class GLStreamingBuffer
+	{
+	private:
+
+		static constexpr size_t NumSections = 4;
+
+		uint8* m_data = nullptr;
+
+		uint32 m_elementSize = 0;
+
+		uint32 m_sectionSize = 0;
+
+		uint32 m_writePos = 0;
+
+		size_t m_currentSection = 0;
+
+		std::array<GLsync, NumSections> m_fences{};
+
+		void fenceSection(size_t section);
+
+		void waitSection(size_t section);
+
+	public:
+
+		GLStreamingBuffer() = default;
+
+		~GLStreamingBuffer();
+
+		[[nodiscard]] static bool IsAvailable();
+
+		// target にバインドされているバッファの領域を確保してマップする
+		[[nodiscard]] bool init(GLenum target, uint32 elementSize, uint32 sectionSize);
+
+		void release();
+
+		// count 個の要素を書き込み、書き込んだ位置（要素単位）を返す
+		// *count は sectionSize 以下であること
+		[[nodiscard]] uint32 write(const void* src, uint32 count);
+	};
+}
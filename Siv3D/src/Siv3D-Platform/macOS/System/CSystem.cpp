@@ -11,6 +11,7 @@
 
 # include <Siv3D/EngineLog.hpp>
 # include <Siv3D/Cursor.hpp>
+# include <Siv3D/FrameProfiler.hpp>
 # include <Siv3DEngine.hpp>
 # include <LicenseManager/ILicenseManager.hpp>
 # include <CPU/ICPU.hpp>
@@ -103,6 +104,8 @@ namespace s3d
 
 	bool CSystem::update()
 	{
+		SIV3D_PROFILE_ZONE(U"System::Update");
+
 		if (!std::exchange(m_updateSucceeded, false))
 		{
 			return false;
@@ -0,0 +1,290 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/Threading.hpp>
+# include <Siv3D/Time.hpp>
+# include <Siv3D/EngineLog.hpp>
+# include "AssetLoader.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		// ディスク I/O が律速になるため、ワーカー数は少数に制限する
+		constexpr size_t MaxAssetLoaderThreads = 4;
+	}
+
+	AssetLoadingJob::AssetLoadingJob(std::function<bool()>&& _loader, const int32 _priority)
+		: m_loader(std::move(_loader))
+		, m_priority(_priority)
+		, m_queuedTimeUs(Time::GetMicrosec())
+	{
+
+	}
+
+	AssetLoadingJob::Status AssetLoadingJob::getStatus() const noexcept
+	{
+		return m_status.load();
+	}
+
+	bool AssetLoadingJob::isFinished() const noexcept
+	{
+		const Status status = m_status.load();
+
+		return (status == Status::Done) || (status == Status::Canceled);
+	}
+
+	bool AssetLoadingJob::getResult() const noexcept
+	{
+		return m_result;
+	}
+
+	AssetLoadingTime AssetLoadingJob::getLoadingTime() const noexcept
+	{
+		if (m_status.load() != Status::Done)
+		{
+			return AssetLoadingTime{};
+		}
+
+		return AssetLoadingTime{
+			MicrosecondsF(static_cast<double>(m_startTimeUs - m_queuedTimeUs)),
+			MicrosecondsF(static_cast<double>(m_finishTimeUs - m_startTimeUs)) };
+	}
+
+	AssetLoader::AssetLoader()
+		: AssetLoader(std::clamp<size_t>(Threading::GetConcurrency() - 1, 1, detail::MaxAssetLoaderThreads)) {}
+
+	AssetLoader::AssetLoader(const size_t maxThreads)
+		: m_maxThreads(Max<size_t>(maxThreads, 1))
+	{
+
+	}
+
+	AssetLoader::~AssetLoader()
+	{
+		{
+			std::lock_guard lock(m_mutex);
+
+			m_abort = true;
+		}
+
+		cancelAll();
+
+		m_queueCondition.notify_all();
+
+		for (auto& thread : m_threads)
+		{
+			thread.join();
+		}
+	}
+
+	std::shared_ptr<AssetLoadingJob> AssetLoader::submit(std::function<bool()>&& loader, const int32 priority)
+	{
+		auto job = std::make_shared<AssetLoadingJob>(std::move(loader), priority);
+
+		{
+			std::lock_guard lock(m_mutex);
+
+			m_queue.push(Entry{ priority, m_sequence++, job });
+
+			++m_numQueued;
+
+			// ワーカーは必要になった時点で上限まで起動する
+			if ((m_threads.size() < m_maxThreads)
+				&& (m_threads.size() < (m_numQueued + m_numRunning)))
+			{
+				m_threads.emplace_back(&AssetLoader::run, this);
+
+				LOG_DEBUG(U"AssetLoader: Launched worker thread #{}"_fmt(m_threads.size()));
+			}
+		}
+
+		m_queueCondition.notify_one();
+
+		return job;
+	}
+
+	void AssetLoader::prioritize(const std::shared_ptr<AssetLoadingJob>& job, const int32 priority)
+	{
+		if (!job)
+		{
+			return;
+		}
+
+		std::lock_guard lock(m_mutex);
+
+		if ((job->m_status != AssetLoadingJob::Status::Queued)
+			|| (priority <= job->m_priority))
+		{
+			return;
+		}
+
+		job->m_priority = priority;
+
+		m_queue.push(Entry{ priority, m_sequence++, job });
+	}
+
+	bool AssetLoader::cancel(const std::shared_ptr<AssetLoadingJob>& job)
+	{
+		if (!job)
+		{
+			return false;
+		}
+
+		{
+			std::lock_guard lock(m_mutex);
+
+			if (job->m_status != AssetLoadingJob::Status::Queued)
+			{
+				return false;
+			}
+
+			job->m_status = AssetLoadingJob::Status::Canceled;
+
+			--m_numQueued;
+		}
+
+		m_finishCondition.notify_all();
+
+		return true;
+	}
+
+	void AssetLoader::cancelAll()
+	{
+		{
+			std::lock_guard lock(m_mutex);
+
+			while (!m_queue.empty())
+			{
+				auto& job = *m_queue.top().job;
+
+				if (job.m_status == AssetLoadingJob::Status::Queued)
+				{
+					job.m_status = AssetLoadingJob::Status::Canceled;
+
+					--m_numQueued;
+				}
+
+				m_queue.pop();
+			}
+		}
+
+		m_finishCondition.notify_all();
+	}
+
+	bool AssetLoader::wait(const std::shared_ptr<AssetLoadingJob>& job)
+	{
+		if (!job)
+		{
+			return false;
+		}
+
+		std::unique_lock lock(m_mutex);
+
+		// まだ開始されていないジョブは、ワーカーを待たずに呼び出し元のスレッドで実行する
+		if (job->m_status == AssetLoadingJob::Status::Queued)
+		{
+			job->m_status = AssetLoadingJob::Status::Running;
+			job->m_startTimeUs = Time::GetMicrosec();
+
+			--m_numQueued;
+			++m_numRunning;
+
+			lock.unlock();
+
+			execute(*job);
+
+			return job->m_result;
+		}
+
+		m_finishCondition.wait(lock, [&job]() { return job->isFinished(); });
+
+		return job->m_result;
+	}
+
+	size_t AssetLoader::getQueueDepth() const
+	{
+		std::lock_guard lock(m_mutex);
+
+		return m_numQueued;
+	}
+
+	size_t AssetLoader::getRunningCount() const
+	{
+		std::lock_guard lock(m_mutex);
+
+		return m_numRunning;
+	}
+
+	void AssetLoader::run()
+	{
+		for (;;)
+		{
+			std::shared_ptr<AssetLoadingJob> job;
+			{
+				std::unique_lock lock(m_mutex);
+
+				m_queueCondition.wait(lock, [this]() { return (m_abort || (m_numQueued != 0)); });
+
+				if (m_abort)
+				{
+					return;
+				}
+
+				while (!m_queue.empty())
+				{
+					Entry entry = m_queue.top();
+
+					m_queue.pop();
+
+					// 実行・キャンセル済みのジョブ、優先度変更前の古いエントリは読み飛ばす
+					if ((entry.job->m_status != AssetLoadingJob::Status::Queued)
+						|| (entry.priority != entry.job->m_priority))
+					{
+						continue;
+					}
+
+					job = std::move(entry.job);
+					job->m_status = AssetLoadingJob::Status::Running;
+					job->m_startTimeUs = Time::GetMicrosec();
+
+					--m_numQueued;
+					++m_numRunning;
+
+					break;
+				}
+			}
+
+			if (job)
+			{
+				execute(*job);
+			}
+		}
+	}
+
+	void AssetLoader::execute(AssetLoadingJob& job)
+	{
+		const bool result = job.m_loader();
+
+		{
+			std::lock_guard lock(m_mutex);
+
+			job.m_result = result;
+			job.m_finishTimeUs = Time::GetMicrosec();
+			job.m_status = AssetLoadingJob::Status::Done;
+			job.m_loader = nullptr;
+
+			--m_numRunning;
+		}
+
+		m_finishCondition.notify_all();
+	}
+}
@@ -0,0 +1,145 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <memory>
+# include <functional>
+# include <atomic>
+# include <mutex>
+# include <condition_variable>
+# include <thread>
+# include <queue>
+# include <Siv3D/Array.hpp>
+# include <Siv3D/Asset.hpp>
+
+namespace s3d
+{
+	class AssetLoadingJob
+	{
+	public:
+
+		enum class Status : uint8
+		{
+			Queued,
+
+			Running,
+
+			Done,
+
+			Canceled,
+		};
+
+		AssetLoadingJob(std::function<bool()>&& _loader, int32 _priority);
+
+		[[nodiscard]] Status getStatus() const noexcept;
+
+		[[nodiscard]] bool isFinished() const noexcept;
+
+		[[nodiscard]] bool getResult() const noexcept;
+
+		[[nodiscard]] AssetLoadingTime getLoadingTime() const noexcept;
+
+	private:
+
+		friend class AssetLoader;
+
+		std::function<bool()> m_loader;
+
+		// 以下は AssetLoader::m_mutex で保護される
+		std::atomic<Status> m_status = Status::Queued;
+
+		int32 m_priority = 0;
+
+		bool m_result = false;
+
+		uint64 m_queuedTimeUs = 0;
+
+		uint64 m_startTimeUs = 0;
+
+		uint64 m_finishTimeUs = 0;
+	};
+
+	/// <summary>
+	/// アセットの非同期ロードを行う、エンジンが所有する有限個のワーカースレッド
+	/// </summary>
+	class AssetLoader
+	{
+	private:
+
+		struct Entry
+		{
+			int32 priority;
+
+			uint64 sequence;
+
+			std::shared_ptr<AssetLoadingJob> job;
+
+			// priority が高いもの、同じ priority であれば先に追加されたものを優先する
+			[[nodiscard]] bool operator <(const Entry& other) const noexcept
+			{
+				if (priority != other.priority)
+				{
+					return (priority < other.priority);
+				}
+
+				return (sequence > other.sequence);
+			}
+		};
+
+		// 優先度を変更したジョブは新しいエントリとして再追加し、古いエントリは取り出し時に読み飛ばす
+		std::priority_queue<Entry> m_queue;
+
+		size_t m_numQueued = 0;
+
+		size_t m_numRunning = 0;
+
+		uint64 m_sequence = 0;
+
+		size_t m_maxThreads = 1;
+
+		Array<std::thread> m_threads;
+
+		mutable std::mutex m_mutex;
+
+		std::condition_variable m_queueCondition;
+
+		std::condition_variable m_finishCondition;
+
+		bool m_abort = false;
+
+		void run();
+
+		void execute(AssetLoadingJob& job);
+
+	public:
+
+		AssetLoader();
+
+		// ワーカースレッドの数を指定する（テスト用）
+		explicit AssetLoader(size_t maxThreads);
+
+		~AssetLoader();
+
+		[[nodiscard]] std::shared_ptr<AssetLoadingJob> submit(std::function<bool()>&& loader, int32 priority);
+
+		void prioritize(const std::shared_ptr<AssetLoadingJob>& job, int32 priority);
+
+		bool cancel(const std::shared_ptr<AssetLoadingJob>& job);
+
+		void cancelAll();
+
+		bool wait(const std::shared_ptr<AssetLoadingJob>& job);
+
+		[[nodiscard]] size_t getQueueDepth() const;
+
+		[[nodiscard]] size_t getRunningCount() const;
+	};
+}
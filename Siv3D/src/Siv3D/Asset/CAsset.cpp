@@ -9,9 +9,11 @@
 //
 //-----------------------------------------------
 
+# include <thread>
 # include <Siv3DEngine.hpp>
 # include <Texture/ITexture.hpp>
 # include <Siv3D/EngineLog.hpp>
+# include <Siv3D/FrameProfiler.hpp>
 # include "CAsset.hpp"
 
 namespace s3d
@@ -43,6 +45,17 @@ namespace s3d
 	{
 		LOG_TRACE(U"CAsset::~CAsset()");
 
+		// まだ開始されていないロードは取り消す
+		m_loader.cancelAll();
+
+		// ロード中のテクスチャ作成要求をすべて処理する
+		while (m_loader.getRunningCount())
+		{
+			Siv3DEngine::Get<ISiv3DTexture>()->updateAsync(Largest<size_t>);
+
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+
 		Siv3DEngine::Get<ISiv3DTexture>()->updateAsync(Largest<size_t>);
 		
 		// wait for all
@@ -64,6 +77,8 @@ namespace s3d
 
 	void CAsset::update()
 	{
+		SIV3D_PROFILE_ZONE(U"Asset::update");
+
 		Siv3DEngine::Get<ISiv3DTexture>()->updateAsync(4);
 	}
 
@@ -113,6 +128,9 @@ namespace s3d
 
 		if (!pAsset->isPreloaded())
 		{
+			// 非同期ロード待ちのアセットが要求されたら、優先してロードする
+			pAsset->prioritize();
+
 			if (pAsset->isLoadingAsync())
 			{
 				return nullptr;
@@ -176,6 +194,8 @@ namespace s3d
 
 		IAsset* pAsset = it->second.get();
 
+		pAsset->cancelLoading();
+
 		pAsset->wait();
 
 		pAsset->release();
@@ -189,6 +209,8 @@ namespace s3d
 
 		for (auto& asset : assetList)
 		{
+			asset.second->cancelLoading();
+
 			asset.second->wait();
 
 			asset.second->release();
@@ -210,6 +232,8 @@ namespace s3d
 
 		IAsset* pAsset = it->second.get();
 
+		pAsset->cancelLoading();
+
 		pAsset->wait();
 
 		pAsset->release();
@@ -225,6 +249,8 @@ namespace s3d
 
 		for (auto& asset : assetList)
 		{
+			asset.second->cancelLoading();
+
 			asset.second->wait();
 
 			asset.second->release();
@@ -248,4 +274,30 @@ namespace s3d
 
 		return it->second->isReady();
 	}
+
+	AssetLoader& CAsset::getLoader()
+	{
+		return m_loader;
+	}
+
+	size_t CAsset::getLoadingQueueDepth() const
+	{
+		return m_loader.getQueueDepth();
+	}
+
+	Optional<AssetLoadingTime> CAsset::getLoadingTime(const AssetType assetType, const String& name) const
+	{
+		const auto& assetList = m_assetLists[static_cast<size_t>(assetType)];
+
+		const auto it = assetList.find(name);
+
+		if (it == assetList.end())
+		{
+			LOG_FAIL_ONCE(U"❌ CAsset::getLoadingTime(): Unregistered {}Asset: \"{}\""_fmt(detail::GetAssetTypeName(assetType), name));
+
+			return none;
+		}
+
+		return it->second->getLoadingTime();
+	}
 }
@@ -14,6 +14,7 @@
 # include <Siv3D/String.hpp>
 # include <Siv3D/Asset.hpp>
 # include "IAsset.hpp"
+# include "AssetLoader.hpp"
 
 namespace s3d
 {
@@ -21,6 +22,9 @@ namespace s3d
 	{
 	private:
 
+		// アセットより先に破棄されないよう、m_assetLists より前に宣言する
+		AssetLoader m_loader;
+
 		std::array<HashTable<String, std::unique_ptr<IAsset>>, 3> m_assetLists;
 	
 	public:
@@ -50,5 +54,11 @@ namespace s3d
 		void unregisterAll(AssetType assetType) override;
 
 		bool isReady(AssetType assetType, const String& name) const override;
+
+		AssetLoader& getLoader() override;
+
+		size_t getLoadingQueueDepth() const override;
+
+		Optional<AssetLoadingTime> getLoadingTime(AssetType assetType, const String& name) const override;
 	};
 }
@@ -12,9 +12,12 @@
 # pragma once
 # include <memory>
 # include <Siv3D/Fwd.hpp>
+# include <Siv3D/Asset.hpp>
 
 namespace s3d
 {
+	class AssetLoader;
+
 	enum class AssetType
 	{
 		Audio,
@@ -53,5 +56,11 @@ namespace s3d
 		virtual void unregisterAll(AssetType assetType) = 0;
 
 		virtual bool isReady(AssetType assetType, const String& name) const = 0;
+
+		virtual AssetLoader& getLoader() = 0;
+
+		virtual size_t getLoadingQueueDepth() const = 0;
+
+		virtual Optional<AssetLoadingTime> getLoadingTime(AssetType assetType, const String& name) const = 0;
 	};
 }
@@ -10,10 +10,18 @@
 //-----------------------------------------------
 
 # include <functional>
+# include <Siv3DEngine.hpp>
+# include "IAsset.hpp"
 # include "IAssetDetail.hpp"
 
 namespace s3d
 {
+	namespace detail
+	{
+		// 初めて要求されたアセットのロードは、キューの先頭に移動する
+		constexpr int32 RequestedAssetPriority = Largest<int32>;
+	}
+
 	IAsset::IAssetDetail::IAssetDetail()
 	{
 
@@ -27,7 +35,11 @@ namespace s3d
 
 	IAsset::IAssetDetail::~IAssetDetail()
 	{
-
+		// 所有者の破棄後にロード関数が呼ばれないよう、未開始のジョブは取り消す
+		if (m_loadingJob)
+		{
+			m_loader->cancel(m_loadingJob);
+		}
 	}
 
 	void IAsset::IAssetDetail::setState(const State state)
@@ -42,12 +54,12 @@ namespace s3d
 
 	bool IAsset::IAssetDetail::isReady() const
 	{
-		if (!m_loadingThread)
+		if (!m_loadingJob)
 		{
 			return true;
 		}
 
-		return m_loadingThread->is_done();
+		return m_loadingJob->isFinished();
 	}
 
 	void IAsset::IAssetDetail::wait()
@@ -57,9 +69,9 @@ namespace s3d
 			return;
 		}
 
-		m_state = m_loadingThread->get() ? State::LoadSucceeded : State::LoadFailed;
+		m_loader->wait(m_loadingJob);
 
-		m_loadingThread.reset();
+		onLoadingFinished();
 	}
 
 	bool IAsset::IAssetDetail::isLoadingAsync()
@@ -71,9 +83,7 @@ namespace s3d
 
 		if (isReady())
 		{
-			m_state = m_loadingThread->get() ? State::LoadSucceeded : State::LoadFailed;
-
-			m_loadingThread.reset();
+			onLoadingFinished();
 		}
 
 		return false;
@@ -96,6 +106,57 @@ namespace s3d
 
 	void IAsset::IAssetDetail::launchLoading(std::function<bool()>&& loader)
 	{
-		m_loadingThread = std::make_unique<ConcurrentTask<bool>>(CreateConcurrentTask(std::move(loader)));
+		m_loader = &Siv3DEngine::Get<ISiv3DAsset>()->getLoader();
+
+		m_loadingJob = m_loader->submit(std::move(loader), m_parameter.loadPriority);
+
+		m_loadingTime.reset();
+	}
+
+	void IAsset::IAssetDetail::prioritize()
+	{
+		if (!m_loadingJob)
+		{
+			return;
+		}
+
+		m_loader->prioritize(m_loadingJob, detail::RequestedAssetPriority);
+	}
+
+	bool IAsset::IAssetDetail::cancelLoading()
+	{
+		if ((m_state != State::PreloadingAsync)
+			|| (!m_loader->cancel(m_loadingJob)))
+		{
+			return false;
+		}
+
+		m_loadingJob.reset();
+
+		m_state = State::Uninitialized;
+
+		return true;
+	}
+
+	const Optional<AssetLoadingTime>& IAsset::IAssetDetail::getLoadingTime() const
+	{
+		return m_loadingTime;
+	}
+
+	void IAsset::IAssetDetail::onLoadingFinished()
+	{
+		if (m_loadingJob->getStatus() == AssetLoadingJob::Status::Done)
+		{
+			m_state = m_loadingJob->getResult() ? State::LoadSucceeded : State::LoadFailed;
+
+			m_loadingTime = m_loadingJob->getLoadingTime();
+		}
+		else
+		{
+			// 取り消されたジョブ
+			m_state = State::LoadFailed;
+		}
+
+		m_loadingJob.reset();
 	}
 }
@@ -10,9 +10,8 @@
 //-----------------------------------------------
 
 # pragma once
-# define SIV3D_CONCURRENT
-# include <Siv3D/ConcurrentTask.hpp>
 # include <Siv3D/Asset.hpp>
+# include "AssetLoader.hpp"
 
 namespace s3d
 {
@@ -22,10 +21,16 @@ namespace s3d
 
 		AssetParameter m_parameter;
 
-		std::unique_ptr<ConcurrentTask<bool>> m_loadingThread;
+		AssetLoader* m_loader = nullptr;
+
+		std::shared_ptr<AssetLoadingJob> m_loadingJob;
+
+		Optional<AssetLoadingTime> m_loadingTime;
 
 		State m_state = State::Uninitialized;
 
+		void onLoadingFinished();
+
 	public:
 
 		IAssetDetail();
@@ -51,5 +56,11 @@ namespace s3d
 		bool uninitialized() const;
 
 		void launchLoading(std::function<bool()>&& loader);
+
+		void prioritize();
+
+		bool cancelLoading();
+
+		const Optional<AssetLoadingTime>& getLoadingTime() const;
 	};
 }
@@ -57,6 +57,15 @@ namespace s3d
 		return parameter;
 	}
 
+	AssetParameter AssetParameter::withPriority(const int32 priority) const
+	{
+		AssetParameter parameter(*this);
+
+		parameter.loadPriority = priority;
+
+		return parameter;
+	}
+
 	IAsset::IAsset()
 		: pImpl(std::make_shared<IAssetDetail>())
 	{
@@ -104,6 +113,21 @@ namespace s3d
 		return pImpl->loadSucceeded();
 	}
 
+	void IAsset::prioritize()
+	{
+		pImpl->prioritize();
+	}
+
+	bool IAsset::cancelLoading()
+	{
+		return pImpl->cancelLoading();
+	}
+
+	const Optional<AssetLoadingTime>& IAsset::getLoadingTime() const
+	{
+		return pImpl->getLoadingTime();
+	}
+
 	void  IAsset::setState(const State state)
 	{
 		pImpl->setState(state);
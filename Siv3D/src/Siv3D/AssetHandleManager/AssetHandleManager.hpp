@@ -12,93 +12,233 @@
 # pragma once
 # include <memory>
 # include <mutex>
-# include <Siv3D/HashTable.hpp>
+# include <atomic>
+# include <array>
+# include <deque>
+# include <Siv3D/Array.hpp>
 # include <Siv3D/String.hpp>
 # include <Siv3D/EngineLog.hpp>
 # include "AssetReport.hpp"
 
 namespace s3d
 {
-	template <class IDType, class Data>
+	//
+	//	世代付きスロットマップ
+	//
+	//	ID の値は [世代 (上位 32 - IndexBits ビット)][スロット番号 (下位 IndexBits ビット)] で構成される。
+	//	スロットはチャンク単位で確保され、一度確保されたチャンクは移動しないため、
+	//	operator[] はロックを取らず、アトミックな読み込みのみで完了する (wait-free)。
+	//	add() / erase() / destroy() は内部の mutex で排他される。
+	//	IndexBits はテストでスロット数を減らすためにのみ変更する。
+	//
+	template <class IDType, class Data, uint32 IndexBits = 20>
 	class AssetHandleManager
 	{
 	private:
 
-		using MapType = HashTable<IDType, std::unique_ptr<Data>>;
+		using ValueType = typename IDType::ValueType;
 
-		MapType m_data;
+		static constexpr ValueType IndexMask = (ValueType(1) << IndexBits) - 1;
 
-		String m_assetTypeName;
+		static constexpr ValueType GenerationMask = (ValueType(1) << (32 - IndexBits)) - 1;
+
+		static constexpr size_t ChunkBits = 10;
+
+		static constexpr size_t ChunkSize = (size_t(1) << ChunkBits);
+
+		static_assert((ChunkBits <= IndexBits) && (IndexBits < 32));
+
+		static constexpr size_t MaxChunks = ((size_t(1) << IndexBits) / ChunkSize);
+
+		// スロット番号の最大値 (ID が InvalidID と一致しないよう 1 つ減らす)
+		static constexpr ValueType MaxIndex = IndexMask - 1;
+
+		// 空きスロットがこの数を超えるまでは新しいスロットを使う
+		static constexpr size_t MinimumFreeIndices = 1024;
+
+		struct Slot
+		{
+			// 現在このスロットを使用している ID の値 (空きスロットでは InvalidID)
+			std::atomic<ValueType> id = IDType::InvalidID;
+
+			std::atomic<Data*> data = nullptr;
+
+			// m_dense 内での位置 (mutex 下でのみアクセス)
+			size_t denseIndex = 0;
+
+			// 次に割り当てる世代 (mutex 下でのみアクセス)
+			ValueType generation = 0;
+		};
 
-		typename IDType::ValueType m_idCount = 0;
+		using DenseType = Array<std::pair<IDType, std::unique_ptr<Data>>>;
 
-		bool m_idFilled = false;
+		std::array<std::atomic<Slot*>, MaxChunks> m_chunks = {};
+
+		DenseType m_dense;
+
+		std::deque<ValueType> m_freeIndices;
+
+		ValueType m_nextIndex = 1;
+
+		String m_assetTypeName;
 
 		std::mutex m_mutex;
 
+		[[nodiscard]] static constexpr ValueType MakeID(const ValueType index, const ValueType generation) noexcept
+		{
+			return ((generation << IndexBits) | index);
+		}
+
+		[[nodiscard]] Slot* getSlot(const ValueType index) const noexcept
+		{
+			Slot* const chunk = m_chunks[index >> ChunkBits].load(std::memory_order_acquire);
+
+			if (!chunk)
+			{
+				return nullptr;
+			}
+
+			return &chunk[index & (ChunkSize - 1)];
+		}
+
+		[[nodiscard]] Slot* getOrAllocateSlot(const ValueType index)
+		{
+			auto& chunk = m_chunks[index >> ChunkBits];
+
+			Slot* p = chunk.load(std::memory_order_relaxed);
+
+			if (!p)
+			{
+				p = new Slot[ChunkSize];
+
+				chunk.store(p, std::memory_order_release);
+			}
+
+			return &p[index & (ChunkSize - 1)];
+		}
+
+		// 戻り値の Data は呼び出し側で破棄する (ログ出力・解放順を制御するため)
+		std::unique_ptr<Data> release(const ValueType index)
+		{
+			Slot* const slot = getSlot(index);
+
+			// 先に ID を無効化し、以降の読み出しが古い Data を参照しないようにする
+			slot->id.store(IDType::InvalidID, std::memory_order_release);
+			slot->data.store(nullptr, std::memory_order_release);
+
+			const size_t denseIndex = slot->denseIndex;
+			std::unique_ptr<Data> data = std::move(m_dense[denseIndex].second);
+
+			if (denseIndex != (m_dense.size() - 1))
+			{
+				m_dense[denseIndex] = std::move(m_dense.back());
+				getSlot(m_dense[denseIndex].first.value() & IndexMask)->denseIndex = denseIndex;
+			}
+
+			m_dense.pop_back();
+
+			if (index != 0)
+			{
+				m_freeIndices.push_back(index);
+			}
+
+			return data;
+		}
+
 	public:
 
-		using iterator			= typename MapType::iterator;
-		using const_iterator	= typename MapType::const_iterator;
+		using iterator			= typename DenseType::iterator;
+		using const_iterator	= typename DenseType::const_iterator;
 
 		explicit AssetHandleManager(const String& name)
 			: m_assetTypeName(name) {}
 
+		~AssetHandleManager()
+		{
+			for (auto& chunk : m_chunks)
+			{
+				delete[] chunk.load(std::memory_order_relaxed);
+			}
+		}
+
+		AssetHandleManager(const AssetHandleManager&) = delete;
+
+		AssetHandleManager& operator =(const AssetHandleManager&) = delete;
+
 		void setNullData(std::unique_ptr<Data>&& data)
 		{
-			m_data.emplace(IDType(IDType::NullAssetID), std::move(data));
+			std::lock_guard lock(m_mutex);
+
+			Slot* const slot = getOrAllocateSlot(0);
+
+			slot->denseIndex = m_dense.size();
+			slot->data.store(data.get(), std::memory_order_relaxed);
+			slot->id.store(IDType::NullAssetID, std::memory_order_release);
+
+			m_dense.emplace_back(IDType(IDType::NullAssetID), std::move(data));
 
 			LOG_DEBUG(U"💠 Created {0}[0(null)]"_fmt(m_assetTypeName));
 		}
 
-		Data* operator [](const IDType id)
+		[[nodiscard]] Data* operator [](const IDType id) const noexcept
 		{
-			std::lock_guard lock(m_mutex);
+			const ValueType value = id.value();
+
+			const Slot* const slot = getSlot(value & IndexMask);
+
+			if (!slot || (slot->id.load(std::memory_order_acquire) != value))
+			{
+				return nullptr;
+			}
 
-			return m_data[id].get();
+			return slot->data.load(std::memory_order_acquire);
 		}
 
 		IDType add(std::unique_ptr<Data>&& data, [[maybe_unused]] const String& info = U"")
 		{
 			std::lock_guard lock(m_mutex);
 
-			if (++m_idCount == IDType::InvalidID)
+			ValueType index;
+
+			if ((m_freeIndices.size() > MinimumFreeIndices)
+				|| ((m_nextIndex > MaxIndex) && !m_freeIndices.empty()))
 			{
-				m_idFilled = true;
-				m_idCount = 0;
+				// 解放済みスロットは古い順に再利用し、同じ ID の早期再出現を避ける
+				index = m_freeIndices.front();
+				m_freeIndices.pop_front();
 			}
-
-			if (!m_idFilled)
+			else if (m_nextIndex <= MaxIndex)
 			{
-				m_data.emplace(m_idCount, std::move(data));
-
-				LOG_DEBUG(U"💠 Created {0}[{1}] {2}"_fmt(m_assetTypeName, m_idCount, info));
-
-				return IDType(m_idCount);
+				index = m_nextIndex++;
 			}
 			else
 			{
-				if (m_data.size() == (IDType::InvalidID - 1))
-				{
-					LOG_FAIL(U"❌ No more {0}s can be created"_fmt(m_assetTypeName));
+				LOG_FAIL(U"❌ No more {0}s can be created"_fmt(m_assetTypeName));
 
-					return IDType(IDType::NullAssetID);
-				}
-
-				while (++m_idCount < IDType::InvalidID)
-				{
-					if (m_data.find(IDType(++m_idCount)) == m_data.end())
-					{
-						m_data.emplace(m_idCount, std::move(data));
+				return IDType(IDType::NullAssetID);
+			}
 
-						LOG_DEBUG(U"💠 Created {0}[{1}] {2}"_fmt(m_assetTypeName, m_idCount, info));
+			Slot* const slot = getOrAllocateSlot(index);
 
-						return IDType(m_idCount);
-					}
-				}
+			// 世代 0 は使わない (ID 0 を NullAssetID 専用にするため)
+			slot->generation = ((slot->generation + 1) & GenerationMask);
 
-				return IDType(IDType::NullAssetID);
+			if (slot->generation == 0)
+			{
+				slot->generation = 1;
 			}
+
+			const ValueType idValue = MakeID(index, slot->generation);
+
+			slot->denseIndex = m_dense.size();
+			slot->data.store(data.get(), std::memory_order_relaxed);
+			slot->id.store(idValue, std::memory_order_release);
+
+			m_dense.emplace_back(IDType(idValue), std::move(data));
+
+			LOG_DEBUG(U"💠 Created {0}[{1}] {2}"_fmt(m_assetTypeName, idValue, info));
+
+			return IDType(idValue);
 		}
 
 		void erase(const IDType id)
@@ -108,15 +248,28 @@ namespace s3d
 				return;
 			}
 
-			std::lock_guard lock(m_mutex);
+			std::unique_ptr<Data> data;
+			{
+				std::lock_guard lock(m_mutex);
+
+				const ValueType value = id.value();
 
-			const auto it = m_data.find(id);
+				const Slot* const slot = getSlot(value & IndexMask);
 
-			assert(it != m_data.end());
+				assert(slot && (slot->id.load(std::memory_order_relaxed) == value));
 
-			LOG_DEBUG(U"♻️ Released {0}[{1}]"_fmt(m_assetTypeName, id.value()));
+				if (!slot || (slot->id.load(std::memory_order_relaxed) != value))
+				{
+					return;
+				}
 
-			m_data.erase(it);
+				LOG_DEBUG(U"♻️ Released {0}[{1}]"_fmt(m_assetTypeName, value));
+
+				data = release(value & IndexMask);
+			}
+
+			// アセットの解放はロックの外で行う
+			data.reset();
 
 			ReportAssetRelease();
 		}
@@ -125,9 +278,11 @@ namespace s3d
 		{
 			std::lock_guard lock(m_mutex);
 
-			for (const auto& data : m_data)
+			while (!m_dense.empty())
 			{
-				if (const auto id = data.first; !id.isNullAsset())
+				const IDType id = m_dense.back().first;
+
+				if (!id.isNullAsset())
 				{
 					LOG_DEBUG(U"♻️ Released {0}[{1}]"_fmt(m_assetTypeName, id.value()));
 				}
@@ -135,29 +290,29 @@ namespace s3d
 				{
 					LOG_DEBUG(U"♻️ Released {0}[0(null)]"_fmt(m_assetTypeName));
 				}
-			}
 
-			m_data.clear();
+				release(id.value() & IndexMask);
+			}
 		}
 
 		iterator begin()
 		{
-			return m_data.begin();
+			return m_dense.begin();
 		}
 
 		iterator end()
 		{
-			return m_data.end();
+			return m_dense.end();
 		}
 
 		const_iterator begin() const
 		{
-			return m_data.cbegin();
+			return m_dense.cbegin();
 		}
 
 		const_iterator end() const
 		{
-			return m_data.cend();
+			return m_dense.cend();
 		}
 	};
 }
@@ -29,6 +29,10 @@ namespace s3d
 
 		virtual AudioID create(Wave&& wave) = 0;
 
+		virtual AudioID createCompact(CompactWave&& wave) = 0;
+
+		virtual AudioID createStreaming(const FilePath& path) = 0;
+
 		virtual void release(AudioID handleID) = 0;
 
 		virtual uint32 samplingRate(AudioID handleID) = 0;
@@ -59,8 +63,14 @@ namespace s3d
 
 		virtual uint64 samplesPlayed(AudioID handleID) = 0;
 
+		virtual bool isStreaming(AudioID handleID) = 0;
+
+		virtual size_t residentBytes(AudioID handleID) = 0;
+
 		virtual const Wave& getWave(AudioID handleID) = 0;
 
+		virtual const CompactWave& getCompactWave(AudioID handleID) = 0;
+
 		virtual void setPosSample(AudioID handleID, int64 sample) = 0;
 
 		virtual void setVolume(AudioID handleID, const std::pair<double, double>& volume) = 0;
@@ -0,0 +1,581 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/Platform.hpp>
+# if SIV3D_WITH_FEATURE(SSE2)
+#	include <emmintrin.h>
+# endif
+# include <Siv3D/Time.hpp>
+# include <Siv3D/FrameProfiler.hpp>
+# include "AudioMixer.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		// 1 回に IMixerSource から読み出す最大のサンプル数
+		constexpr size_t SourceBufferFrames = 4096;
+
+		// dst[n] += src[n] * volume（ステレオ）
+		inline void MixSamples(float* dst, const WaveSample* src, const size_t count, const float volumeL, const float volumeR) noexcept
+		{
+			const float* pSrc = &src->left;
+			size_t i = 0;
+
+		# if SIV3D_WITH_FEATURE(SSE2)
+
+			const __m128 volume = _mm_setr_ps(volumeL, volumeR, volumeL, volumeR);
+
+			for (; (i + 4) <= count; i += 4)
+			{
+				const __m128 s0 = _mm_loadu_ps(pSrc + i * 2);
+				const __m128 s1 = _mm_loadu_ps(pSrc + i * 2 + 4);
+				const __m128 d0 = _mm_loadu_ps(dst + i * 2);
+				const __m128 d1 = _mm_loadu_ps(dst + i * 2 + 4);
+
+				_mm_storeu_ps(dst + i * 2, _mm_add_ps(d0, _mm_mul_ps(s0, volume)));
+				_mm_storeu_ps(dst + i * 2 + 4, _mm_add_ps(d1, _mm_mul_ps(s1, volume)));
+			}
+
+		# endif
+
+			for (; i < count; ++i)
+			{
+				dst[i * 2] += (pSrc[i * 2] * volumeL);
+				dst[i * 2 + 1] += (pSrc[i * 2 + 1] * volumeR);
+			}
+		}
+	}
+
+	WaveMixerSource::WaveMixerSource(Wave&& wave)
+		: m_wave(std::move(wave))
+	{
+
+	}
+
+	uint32 WaveMixerSource::samplingRate() const
+	{
+		return m_wave.samplingRate();
+	}
+
+	size_t WaveMixerSource::size() const
+	{
+		return m_wave.size();
+	}
+
+	const WaveSample* WaveMixerSource::getSamples(const size_t pos, size_t, WaveSample*)
+	{
+		return (m_wave.data() + pos);
+	}
+
+	size_t WaveMixerSource::residentBytes() const
+	{
+		return m_wave.size_bytes();
+	}
+
+	const Wave& WaveMixerSource::getWave() const noexcept
+	{
+		return m_wave;
+	}
+
+	CompactMixerSource::CompactMixerSource(CompactWave&& wave)
+		: m_wave(std::move(wave))
+	{
+
+	}
+
+	uint32 CompactMixerSource::samplingRate() const
+	{
+		return m_wave.samplingRate();
+	}
+
+	size_t CompactMixerSource::size() const
+	{
+		return m_wave.samples();
+	}
+
+	const WaveSample* CompactMixerSource::getSamples(const size_t pos, const size_t count, WaveSample* buffer)
+	{
+		m_wave.getSamples(pos, count, buffer);
+
+		return buffer;
+	}
+
+	size_t CompactMixerSource::residentBytes() const
+	{
+		return m_wave.size_bytes();
+	}
+
+	const CompactWave& CompactMixerSource::getCompactWave() const noexcept
+	{
+		return m_wave;
+	}
+
+	AudioMixer::AudioMixer()
+		: m_mixBuffer(BlockFrames * 2)
+		, m_sourceBuffer(detail::SourceBufferFrames)
+	{
+
+	}
+
+	AudioMixer::~AudioMixer()
+	{
+		stop();
+	}
+
+	void AudioMixer::start(std::unique_ptr<IAudioOutput>&& output)
+	{
+		stop();
+
+		m_samplingRate = output->samplingRate();
+
+		m_output = std::move(output);
+
+		m_abort = false;
+
+		m_thread = std::thread(&AudioMixer::run, this);
+	}
+
+	void AudioMixer::stop()
+	{
+		m_abort = true;
+
+		if (m_thread.joinable())
+		{
+			m_thread.join();
+		}
+
+		m_output.reset();
+	}
+
+	uint32 AudioMixer::samplingRate() const noexcept
+	{
+		return m_samplingRate;
+	}
+
+	void AudioMixer::mix(float* output, const size_t frames)
+	{
+		SIV3D_PROFILE_ZONE(U"Audio::mix");
+
+		std::fill_n(output, (frames * 2), 0.0f);
+
+		{
+			std::lock_guard lock(m_mutex);
+
+			const uint64 startTime = Time::GetMicrosec();
+
+			for (auto it = m_voices.begin(); it != m_voices.end(); ++it)
+			{
+				Voice& voice = it.value();
+
+				if (voice.state != VoiceState::Playing)
+				{
+					continue;
+				}
+
+				mixVoice(voice, output, frames);
+
+				if (voice.oneShot && (voice.state == VoiceState::Stopped))
+				{
+					m_finishedVoices << it->first;
+				}
+
+				if (voice.source->isStreaming())
+				{
+					m_prefetchSources << voice.source;
+				}
+			}
+
+			for (const auto voiceID : m_finishedVoices)
+			{
+				m_voices.erase(voiceID);
+			}
+
+			m_finishedVoices.clear();
+
+			const uint64 mixTime = (Time::GetMicrosec() - startTime);
+
+			m_mixedFrames += frames;
+			++m_numBlocks;
+			m_totalMixMicrosec += mixTime;
+			m_maxMixMicrosec = std::max(m_maxMixMicrosec, mixTime);
+		}
+
+		// デコードに時間がかかっても、メインスレッドからのボイスの操作を待たせない
+		for (const auto& source : m_prefetchSources)
+		{
+			source->prefetch();
+		}
+
+		m_prefetchSources.clear();
+	}
+
+	AudioMixer::VoiceID AudioMixer::createVoice(const std::shared_ptr<IMixerSource>& source)
+	{
+		std::lock_guard lock(m_mutex);
+
+		const VoiceID voiceID = m_nextVoiceID++;
+
+		m_voices[voiceID].source = source;
+
+		return voiceID;
+	}
+
+	AudioMixer::VoiceID AudioMixer::playOneShot(const std::shared_ptr<IMixerSource>& source, const double volume, const double speed)
+	{
+		std::lock_guard lock(m_mutex);
+
+		const VoiceID voiceID = m_nextVoiceID++;
+
+		Voice& voice = m_voices[voiceID];
+		voice.source	= source;
+		voice.speed		= Clamp(speed, MinSpeed, MaxSpeed);
+		voice.volumeL	= voice.volumeR = static_cast<float>(volume);
+		voice.state		= VoiceState::Playing;
+		voice.oneShot	= true;
+
+		return voiceID;
+	}
+
+	void AudioMixer::removeVoice(const VoiceID voiceID)
+	{
+		std::lock_guard lock(m_mutex);
+
+		m_voices.erase(voiceID);
+	}
+
+	void AudioMixer::removeVoices(const Array<VoiceID>& voiceIDs)
+	{
+		std::lock_guard lock(m_mutex);
+
+		for (const auto voiceID : voiceIDs)
+		{
+			m_voices.erase(voiceID);
+		}
+	}
+
+	bool AudioMixer::hasVoice(const VoiceID voiceID) const
+	{
+		std::lock_guard lock(m_mutex);
+
+		return (findVoice(voiceID) != nullptr);
+	}
+
+	void AudioMixer::play(const VoiceID voiceID)
+	{
+		std::lock_guard lock(m_mutex);
+
+		if (Voice* voice = findVoice(voiceID))
+		{
+			voice->state = VoiceState::Playing;
+			voice->reachedEnd = false;
+		}
+	}
+
+	void AudioMixer::pause(const VoiceID voiceID)
+	{
+		std::lock_guard lock(m_mutex);
+
+		if (Voice* voice = findVoice(voiceID); voice && (voice->state == VoiceState::Playing))
+		{
+			voice->state = VoiceState::Paused;
+		}
+	}
+
+	void AudioMixer::stop(const VoiceID voiceID)
+	{
+		std::lock_guard lock(m_mutex);
+
+		if (Voice* voice = findVoice(voiceID))
+		{
+			voice->state = VoiceState::Stopped;
+			voice->pos = 0.0;
+		}
+	}
+
+	bool AudioMixer::isPlaying(const VoiceID voiceID) const
+	{
+		std::lock_guard lock(m_mutex);
+
+		const Voice* voice = findVoice(voiceID);
+
+		return (voice && (voice->state == VoiceState::Playing));
+	}
+
+	bool AudioMixer::isPaused(const VoiceID voiceID) const
+	{
+		std::lock_guard lock(m_mutex);
+
+		const Voice* voice = findVoice(voiceID);
+
+		return (voice && (voice->state == VoiceState::Paused));
+	}
+
+	uint64 AudioMixer::posSample(const VoiceID voiceID) const
+	{
+		std::lock_guard lock(m_mutex);
+
+		const Voice* voice = findVoice(voiceID);
+
+		return voice ? static_cast<uint64>(voice->pos) : 0;
+	}
+
+	void AudioMixer::setPosSample(const VoiceID voiceID, int64 posSample)
+	{
+		std::lock_guard lock(m_mutex);
+
+		Voice* voice = findVoice(voiceID);
+
+		if (!voice)
+		{
+			return;
+		}
+
+		if (voice->loop && (posSample >= voice->loop->endPos))
+		{
+			posSample = (voice->loop->endPos - 1);
+		}
+
+		posSample = std::min<int64>(posSample, static_cast<int64>(voice->source->size()) - 1);
+
+		voice->pos = static_cast<double>(std::max<int64>(posSample, 0));
+	}
+
+	uint64 AudioMixer::samplesPlayed(const VoiceID voiceID) const
+	{
+		std::lock_guard lock(m_mutex);
+
+		const Voice* voice = findVoice(voiceID);
+
+		return voice ? voice->samplesPlayed : 0;
+	}
+
+	void AudioMixer::setVolume(const VoiceID voiceID, const double left, const double right)
+	{
+		std::lock_guard lock(m_mutex);
+
+		if (Voice* voice = findVoice(voiceID))
+		{
+			voice->volumeL = static_cast<float>(left);
+			voice->volumeR = static_cast<float>(right);
+		}
+	}
+
+	void AudioMixer::setSpeed(const VoiceID voiceID, const double speed)
+	{
+		std::lock_guard lock(m_mutex);
+
+		if (Voice* voice = findVoice(voiceID))
+		{
+			voice->speed = Clamp(speed, MinSpeed, MaxSpeed);
+		}
+	}
+
+	void AudioMixer::setLoop(const VoiceID voiceID, const Optional<AudioLoopTiming>& loop)
+	{
+		std::lock_guard lock(m_mutex);
+
+		if (Voice* voice = findVoice(voiceID))
+		{
+			voice->loop = loop;
+		}
+	}
+
+	AudioMixerStats AudioMixer::getStats() const
+	{
+		std::lock_guard lock(m_mutex);
+
+		AudioMixerStats stats;
+		stats.num_voices	= m_voices.size();
+		stats.mixedFrames	= m_mixedFrames;
+		stats.num_blocks	= m_numBlocks;
+
+		for (const auto& voice : m_voices)
+		{
+			if (voice.second.state == VoiceState::Playing)
+			{
+				++stats.num_activeVoices;
+			}
+		}
+
+		if (m_numBlocks)
+		{
+			stats.averageMixMillisec = (m_totalMixMicrosec / 1000.0 / m_numBlocks);
+			stats.maxMixMillisec = (m_maxMixMicrosec / 1000.0);
+		}
+
+		if (m_output)
+		{
+			stats.latencyMillisec = (m_output->latencySec() * 1000.0);
+			stats.num_underruns = m_output->num_underruns();
+		}
+
+		return stats;
+	}
+
+	void AudioMixer::ConvertToS16(const float* src, int16* dst, const size_t count)
+	{
+		size_t i = 0;
+
+	# if SIV3D_WITH_FEATURE(SSE2)
+
+		const __m128 minValue = _mm_set1_ps(-1.0f);
+		const __m128 maxValue = _mm_set1_ps(1.0f);
+		const __m128 scale = _mm_set1_ps(32767.0f);
+
+		for (; (i + 8) <= count; i += 8)
+		{
+			const __m128 a = _mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i), minValue), maxValue), scale);
+			const __m128 b = _mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i + 4), minValue), maxValue), scale);
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packs_epi32(_mm_cvttps_epi32(a), _mm_cvttps_epi32(b)));
+		}
+
+	# endif
+
+		for (; i < count; ++i)
+		{
+			dst[i] = static_cast<int16>(Clamp(src[i], -1.0f, 1.0f) * 32767.0f);
+		}
+	}
+
+	void AudioMixer::run()
+	{
+		// 1 ブロックの 1/4 の時間ごとに、出力に空きがあるかを調べる
+		const auto interval = std::chrono::microseconds(BlockFrames * 1'000'000 / m_samplingRate / 4);
+
+		while (!m_abort)
+		{
+			const size_t frames = m_output->framesWanted();
+
+			if (frames < BlockFrames)
+			{
+				std::this_thread::sleep_for(interval);
+
+				continue;
+			}
+
+			for (size_t i = 0; (i + BlockFrames) <= frames; i += BlockFrames)
+			{
+				mix(m_mixBuffer.data(), BlockFrames);
+
+				m_output->submit(m_mixBuffer.data(), BlockFrames);
+			}
+		}
+	}
+
+	void AudioMixer::mixVoice(Voice& voice, float* output, const size_t frames)
+	{
+		IMixerSource& source = *voice.source;
+		const size_t sourceSize = source.size();
+		const double step = (voice.speed * source.samplingRate() / m_samplingRate);
+
+		size_t loopBegin = 0, loopEnd = sourceSize;
+		const bool hasLoop = voice.loop
+			&& (voice.loop->beginPos >= 0)
+			&& (voice.loop->beginPos < std::min<int64>(voice.loop->endPos, sourceSize));
+
+		if (hasLoop)
+		{
+			loopBegin = static_cast<size_t>(voice.loop->beginPos);
+			loopEnd = static_cast<size_t>(std::min<int64>(voice.loop->endPos, sourceSize));
+		}
+
+		size_t written = 0;
+
+		while (written < frames)
+		{
+			if (voice.pos >= loopEnd)
+			{
+				if (!hasLoop)
+				{
+					voice.state = VoiceState::Stopped;
+					voice.reachedEnd = true;
+					voice.pos = 0.0;
+
+					return;
+				}
+
+				voice.pos -= (loopEnd - loopBegin);
+
+				if ((voice.pos < loopBegin) || (loopEnd <= voice.pos))
+				{
+					voice.pos = static_cast<double>(loopBegin);
+				}
+			}
+
+			float* const pDst = (output + written * 2);
+			const size_t remaining = (frames - written);
+			const size_t readPos = static_cast<size_t>(voice.pos);
+
+			if ((step == 1.0) && (voice.pos == readPos))
+			{
+				// 同じサンプリングレートで等速: 補間せずに足し込む
+				const size_t count = std::min({ remaining, (loopEnd - readPos), detail::SourceBufferFrames });
+				const WaveSample* pSrc = source.getSamples(readPos, count, m_sourceBuffer.data());
+
+				detail::MixSamples(pDst, pSrc, count, voice.volumeL, voice.volumeR);
+
+				voice.pos += count;
+				voice.samplesPlayed += count;
+				written += count;
+
+				continue;
+			}
+
+			// 線形補間: 次のサンプルも含めて、必要な分だけ読み出す
+			const size_t wanted = (static_cast<size_t>(remaining * step) + 2);
+			const size_t available = std::min({ (loopEnd - readPos), wanted, detail::SourceBufferFrames });
+			const WaveSample* pSrc = source.getSamples(readPos, available, m_sourceBuffer.data());
+			const float volumeL = voice.volumeL, volumeR = voice.volumeR;
+
+			double offset = (voice.pos - readPos);
+			size_t count = 0;
+
+			for (; count < remaining; ++count)
+			{
+				const size_t i = static_cast<size_t>(offset);
+
+				if (i >= available)
+				{
+					break;
+				}
+
+				const float t = static_cast<float>(offset - i);
+				const WaveSample& s0 = pSrc[i];
+				const WaveSample& s1 = ((i + 1) < available) ? pSrc[i + 1] : s0;
+
+				pDst[count * 2] += ((s0.left + (s1.left - s0.left) * t) * volumeL);
+				pDst[count * 2 + 1] += ((s0.right + (s1.right - s0.right) * t) * volumeR);
+
+				offset += step;
+			}
+
+			voice.pos = (readPos + offset);
+			voice.samplesPlayed += (static_cast<size_t>(voice.pos) - readPos);
+			written += count;
+		}
+	}
+
+	AudioMixer::Voice* AudioMixer::findVoice(const VoiceID voiceID)
+	{
+		const auto it = m_voices.find(voiceID);
+
+		return (it == m_voices.end()) ? nullptr : &it.value();
+	}
+
+	const AudioMixer::Voice* AudioMixer::findVoice(const VoiceID voiceID) const
+	{
+		const auto it = m_voices.find(voiceID);
+
+		return (it == m_voices.end()) ? nullptr : &it->second;
+	}
+}
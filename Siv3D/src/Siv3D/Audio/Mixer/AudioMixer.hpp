@@ -0,0 +1,310 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <mutex>
+# include <thread>
+# include <atomic>
+# include <Siv3D/Fwd.hpp>
+# include <Siv3D/Array.hpp>
+# include <Siv3D/Audio.hpp>
+# include <Siv3D/Wave.hpp>
+# include <Siv3D/CompactWave.hpp>
+# include <Siv3D/HashTable.hpp>
+# include "IAudioOutput.hpp"
+
+namespace s3d
+{
+	/// <summary>
+	/// AudioMixer のボイスが読み出すサンプル列
+	/// </summary>
+	class IMixerSource
+	{
+	public:
+
+		virtual ~IMixerSource() = default;
+
+		[[nodiscard]] virtual uint32 samplingRate() const = 0;
+
+		[[nodiscard]] virtual size_t size() const = 0;
+
+		/// <summary>
+		/// pos から count サンプルを返します。
+		/// </summary>
+		/// <param name="buffer">
+		/// 必要に応じてサンプルを書き込む、count サンプル以上の作業領域
+		/// </param>
+		/// <returns>
+		/// サンプルの先頭。メモリ上にそのまま並んでいる場合は buffer を使わずにその位置を返す
+		/// </returns>
+		[[nodiscard]] virtual const WaveSample* getSamples(size_t pos, size_t count, WaveSample* buffer) = 0;
+
+		/// <summary>
+		/// サンプルを保持するために確保しているバイト数
+		/// </summary>
+		[[nodiscard]] virtual size_t residentBytes() const = 0;
+
+		/// <summary>
+		/// 再生中に prefetch() を呼ぶ必要があるか
+		/// </summary>
+		[[nodiscard]] virtual bool isStreaming() const
+		{
+			return false;
+		}
+
+		/// <summary>
+		/// 次に読み出すサンプルを用意します。
+		/// </summary>
+		/// <remarks>
+		/// 合成スレッドが、ブロックを合成するたびにミキサーのロックの外で呼ぶ
+		/// </remarks>
+		virtual void prefetch() {}
+	};
+
+	/// <summary>
+	/// Wave をそのまま読み出す IMixerSource
+	/// </summary>
+	class WaveMixerSource : public IMixerSource
+	{
+	private:
+
+		Wave m_wave;
+
+	public:
+
+		explicit WaveMixerSource(Wave&& wave);
+
+		[[nodiscard]] uint32 samplingRate() const override;
+
+		[[nodiscard]] size_t size() const override;
+
+		[[nodiscard]] const WaveSample* getSamples(size_t pos, size_t count, WaveSample* buffer) override;
+
+		[[nodiscard]] size_t residentBytes() const override;
+
+		[[nodiscard]] const Wave& getWave() const noexcept;
+	};
+
+	/// <summary>
+	/// CompactWave のサンプルを、読み出すときに float のステレオに変換する IMixerSource
+	/// </summary>
+	class CompactMixerSource : public IMixerSource
+	{
+	private:
+
+		CompactWave m_wave;
+
+	public:
+
+		explicit CompactMixerSource(CompactWave&& wave);
+
+		[[nodiscard]] uint32 samplingRate() const override;
+
+		[[nodiscard]] size_t size() const override;
+
+		[[nodiscard]] const WaveSample* getSamples(size_t pos, size_t count, WaveSample* buffer) override;
+
+		[[nodiscard]] size_t residentBytes() const override;
+
+		[[nodiscard]] const CompactWave& getCompactWave() const noexcept;
+	};
+
+	struct AudioMixerStats
+	{
+		size_t num_voices = 0;
+
+		size_t num_activeVoices = 0;
+
+		uint64 mixedFrames = 0;
+
+		uint64 num_blocks = 0;
+
+		// 1 ブロックの合成にかかった時間
+		double averageMixMillisec = 0.0;
+
+		double maxMixMillisec = 0.0;
+
+		// 出力の遅延
+		double latencyMillisec = 0.0;
+
+		size_t num_underruns = 0;
+	};
+
+	/// <summary>
+	/// すべてのボイスを 1 つのスレッドで合成し、IAudioOutput に書き込むソフトウェアミキサー
+	/// </summary>
+	/// <remarks>
+	/// ボイスの音量（左右）・再生速度・ループはブロックごとに同じパスで適用する。
+	/// ボイスの操作と合成は 1 つのミューテックスで排他し、合成中は 1 ブロックの間だけロックする。
+	/// </remarks>
+	class AudioMixer
+	{
+	public:
+
+		using VoiceID = uint32;
+
+		static constexpr VoiceID NullVoice = 0;
+
+		// 1 回の合成で書き込むフレーム数
+		static constexpr size_t BlockFrames = 512;
+
+		static constexpr double MinSpeed = (1.0 / 1024.0);
+
+		static constexpr double MaxSpeed = 2.0;
+
+	private:
+
+		enum class VoiceState
+		{
+			Stopped,
+
+			Playing,
+
+			Paused,
+		};
+
+		struct Voice
+		{
+			std::shared_ptr<IMixerSource> source;
+
+			// 読み出し位置（入力のサンプル単位）
+			double pos = 0.0;
+
+			double speed = 1.0;
+
+			float volumeL = 1.0f;
+
+			float volumeR = 1.0f;
+
+			Optional<AudioLoopTiming> loop;
+
+			VoiceState state = VoiceState::Stopped;
+
+			// 最後まで再生して止まった
+			bool reachedEnd = false;
+
+			// 再生し終えたら自動で削除する
+			bool oneShot = false;
+
+			uint64 samplesPlayed = 0;
+		};
+
+		mutable std::mutex m_mutex;
+
+		HashTable<VoiceID, Voice> m_voices;
+
+		VoiceID m_nextVoiceID = 1;
+
+		uint32 m_samplingRate = 44100;
+
+		Array<float> m_mixBuffer;
+
+		Array<WaveSample> m_sourceBuffer;
+
+		Array<VoiceID> m_finishedVoices;
+
+		// ロックの外で prefetch() を呼ぶ、再生中のストリーミングのソース
+		Array<std::shared_ptr<IMixerSource>> m_prefetchSources;
+
+		std::unique_ptr<IAudioOutput> m_output;
+
+		std::thread m_thread;
+
+		std::atomic<bool> m_abort = { false };
+
+		uint64 m_mixedFrames = 0;
+
+		uint64 m_numBlocks = 0;
+
+		uint64 m_totalMixMicrosec = 0;
+
+		uint64 m_maxMixMicrosec = 0;
+
+		void run();
+
+		void mixVoice(Voice& voice, float* output, size_t frames);
+
+		[[nodiscard]] Voice* findVoice(VoiceID voiceID);
+
+		[[nodiscard]] const Voice* findVoice(VoiceID voiceID) const;
+
+	public:
+
+		AudioMixer();
+
+		~AudioMixer();
+
+		/// <summary>
+		/// 合成スレッドを開始して、output に書き込みます。
+		/// </summary>
+		void start(std::unique_ptr<IAudioOutput>&& output);
+
+		/// <summary>
+		/// 合成スレッドを終了します。
+		/// </summary>
+		void stop();
+
+		[[nodiscard]] uint32 samplingRate() const noexcept;
+
+		/// <summary>
+		/// 合成スレッドを使わずに frames フレームを合成して output に書き込みます。
+		/// </summary>
+		/// <param name="output">
+		/// frames * 2 個の float を書き込める領域
+		/// </param>
+		void mix(float* output, size_t frames);
+
+		[[nodiscard]] VoiceID createVoice(const std::shared_ptr<IMixerSource>& source);
+
+		/// <summary>
+		/// 再生し終えると自動で削除されるボイスを作成して再生します。
+		/// </summary>
+		VoiceID playOneShot(const std::shared_ptr<IMixerSource>& source, double volume, double speed);
+
+		void removeVoice(VoiceID voiceID);
+
+		void removeVoices(const Array<VoiceID>& voiceIDs);
+
+		[[nodiscard]] bool hasVoice(VoiceID voiceID) const;
+
+		void play(VoiceID voiceID);
+
+		void pause(VoiceID voiceID);
+
+		/// <summary>
+		/// 再生を止めて、再生位置を先頭に戻します。
+		/// </summary>
+		void stop(VoiceID voiceID);
+
+		[[nodiscard]] bool isPlaying(VoiceID voiceID) const;
+
+		[[nodiscard]] bool isPaused(VoiceID voiceID) const;
+
+		[[nodiscard]] uint64 posSample(VoiceID voiceID) const;
+
+		void setPosSample(VoiceID voiceID, int64 posSample);
+
+		[[nodiscard]] uint64 samplesPlayed(VoiceID voiceID) const;
+
+		void setVolume(VoiceID voiceID, double left, double right);
+
+		void setSpeed(VoiceID voiceID, double speed);
+
+		void setLoop(VoiceID voiceID, const Optional<AudioLoopTiming>& loop);
+
+		[[nodiscard]] AudioMixerStats getStats() const;
+
+		/// <summary>
+		/// float のサンプルを、範囲 [-1.0, 1.0] に丸めて int16 に変換します。
+		/// </summary>
+		static void ConvertToS16(const float* src, int16* dst, size_t count);
+	};
+}
@@ -0,0 +1,65 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/Time.hpp>
+# include "AudioOutput_Null.hpp"
+
+namespace s3d
+{
+	AudioOutput_Null::AudioOutput_Null(const uint32 samplingRate, const size_t bufferFrames)
+		: m_samplingRate(samplingRate)
+		, m_bufferFrames(bufferFrames)
+	{
+
+	}
+
+	uint32 AudioOutput_Null::samplingRate() const
+	{
+		return m_samplingRate;
+	}
+
+	size_t AudioOutput_Null::framesWanted()
+	{
+		// 最初に書き込まれるまでは再生を始めない
+		if (m_submittedFrames == 0)
+		{
+			m_startMicrosec = Time::GetMicrosec();
+		}
+
+		const uint64 elapsedMicrosec = (Time::GetMicrosec() - m_startMicrosec);
+		const uint64 playedFrames = (elapsedMicrosec * m_samplingRate / 1'000'000);
+
+		// 再生位置が書き込んだ位置を追い越した
+		if (playedFrames > m_submittedFrames)
+		{
+			++m_underruns;
+
+			m_submittedFrames = playedFrames;
+		}
+
+		return static_cast<size_t>(playedFrames + m_bufferFrames - m_submittedFrames);
+	}
+
+	void AudioOutput_Null::submit(const float*, const size_t frames)
+	{
+		m_submittedFrames += frames;
+	}
+
+	double AudioOutput_Null::latencySec() const
+	{
+		return (static_cast<double>(m_bufferFrames) / m_samplingRate);
+	}
+
+	size_t AudioOutput_Null::num_underruns() const
+	{
+		return m_underruns;
+	}
+}
@@ -0,0 +1,53 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <atomic>
+# include "IAudioOutput.hpp"
+
+namespace s3d
+{
+	/// <summary>
+	/// 書き込まれたサンプルを捨てる IAudioOutput
+	/// </summary>
+	/// <remarks>
+	/// オーディオデバイスが無い環境で、実時間と同じ速さでサンプルを受け取る。
+	/// </remarks>
+	class AudioOutput_Null : public IAudioOutput
+	{
+	private:
+
+		uint32 m_samplingRate = 44100;
+
+		// 先行して受け取るフレーム数
+		size_t m_bufferFrames = 0;
+
+		uint64 m_startMicrosec = 0;
+
+		uint64 m_submittedFrames = 0;
+
+		std::atomic<size_t> m_underruns = { 0 };
+
+	public:
+
+		AudioOutput_Null(uint32 samplingRate, size_t bufferFrames);
+
+		[[nodiscard]] uint32 samplingRate() const override;
+
+		[[nodiscard]] size_t framesWanted() override;
+
+		void submit(const float* samples, size_t frames) override;
+
+		[[nodiscard]] double latencySec() const override;
+
+		[[nodiscard]] size_t num_underruns() const override;
+	};
+}
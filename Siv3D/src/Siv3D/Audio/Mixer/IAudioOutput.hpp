@@ -0,0 +1,48 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/Fwd.hpp>
+
+namespace s3d
+{
+	/// <summary>
+	/// AudioMixer が合成したサンプルの出力先
+	/// </summary>
+	class IAudioOutput
+	{
+	public:
+
+		virtual ~IAudioOutput() = default;
+
+		[[nodiscard]] virtual uint32 samplingRate() const = 0;
+
+		/// <summary>
+		/// 今書き込めるフレーム数を返します。
+		/// </summary>
+		[[nodiscard]] virtual size_t framesWanted() = 0;
+
+		/// <summary>
+		/// ステレオ（L, R の順）の float サンプルを書き込みます。
+		/// </summary>
+		virtual void submit(const float* samples, size_t frames) = 0;
+
+		/// <summary>
+		/// 書き込んでから聞こえるまでの最大の遅延（秒）
+		/// </summary>
+		[[nodiscard]] virtual double latencySec() const = 0;
+
+		/// <summary>
+		/// 書き込みが間に合わず、出力が途切れた回数
+		/// </summary>
+		[[nodiscard]] virtual size_t num_underruns() const = 0;
+	};
+}
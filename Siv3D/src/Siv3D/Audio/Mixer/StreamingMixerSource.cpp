@@ -0,0 +1,295 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <cstring>
+# include "StreamingMixerSource.hpp"
+
+namespace s3d
+{
+	StreamingMixerSource::StreamingMixerSource(std::unique_ptr<IAudioStreamDecoder>&& decoder)
+		: m_decoder(std::move(decoder))
+		, m_samplingRate(m_decoder->samplingRate())
+		, m_size(m_decoder->size())
+		, m_scratch(ChunkFrames)
+		, m_loopEnd(m_size)
+		, m_ring(RingFrames)
+		, m_streamEnd(m_size)
+	{
+		std::lock_guard decodeLock(m_decodeMutex);
+
+		fill();
+	}
+
+	uint32 StreamingMixerSource::samplingRate() const
+	{
+		return m_samplingRate;
+	}
+
+	size_t StreamingMixerSource::size() const
+	{
+		return m_size;
+	}
+
+	const WaveSample* StreamingMixerSource::getSamples(const size_t pos, const size_t count, WaveSample* buffer)
+	{
+		std::lock_guard lock(m_mutex);
+
+		m_readPos = pos;
+
+		const size_t headEnd = (m_headBegin + m_head.size());
+		const size_t ringEnd = (m_ringBegin + m_ringFrames);
+		size_t i = 0;
+
+		while (i < count)
+		{
+			const size_t p = (pos + i);
+			size_t n = 0;
+
+			if ((m_headBegin <= p) && (p < headEnd))
+			{
+				n = std::min((count - i), (headEnd - p));
+
+				std::memcpy(buffer + i, m_head.data() + (p - m_headBegin), n * sizeof(WaveSample));
+			}
+			else if ((m_ringBegin <= p) && (p < ringEnd))
+			{
+				const size_t index = (p % RingFrames);
+
+				n = std::min({ (count - i), (ringEnd - p), (RingFrames - index) });
+
+				std::memcpy(buffer + i, m_ring.data() + index, n * sizeof(WaveSample));
+			}
+			else
+			{
+				// 読み出し位置がデコードに追いついた。シーク直後の読み出しは数えない
+				if ((p == ringEnd) && (p < m_streamEnd))
+				{
+					++m_numUnderruns;
+				}
+
+				std::fill(buffer + i, buffer + count, WaveSample::Zero());
+
+				break;
+			}
+
+			i += n;
+		}
+
+		return buffer;
+	}
+
+	size_t StreamingMixerSource::residentBytes() const
+	{
+		std::lock_guard lock(m_mutex);
+
+		return ((m_head.capacity() + m_ring.capacity() + m_scratch.capacity()) * sizeof(WaveSample) + m_decoderBytes);
+	}
+
+	bool StreamingMixerSource::isStreaming() const
+	{
+		return true;
+	}
+
+	void StreamingMixerSource::prefetch()
+	{
+		std::unique_lock decodeLock(m_decodeMutex, std::try_to_lock);
+
+		if (!decodeLock)
+		{
+			return;
+		}
+
+		fill();
+	}
+
+	void StreamingMixerSource::seek(const size_t pos)
+	{
+		std::lock_guard decodeLock(m_decodeMutex);
+
+		{
+			std::lock_guard lock(m_mutex);
+
+			m_readPos = pos;
+		}
+
+		fill();
+	}
+
+	void StreamingMixerSource::setLoop(const Optional<AudioLoopTiming>& loop)
+	{
+		std::lock_guard decodeLock(m_decodeMutex);
+
+		if (loop && (loop->beginPos >= 0) && (loop->beginPos < std::min<int64>(loop->endPos, m_size)))
+		{
+			m_loopBegin = static_cast<size_t>(loop->beginPos);
+			m_loopEnd = static_cast<size_t>(std::min<int64>(loop->endPos, m_size));
+		}
+		else
+		{
+			m_loopBegin = 0;
+			m_loopEnd = m_size;
+		}
+
+		fill();
+	}
+
+	size_t StreamingMixerSource::num_underruns() const
+	{
+		std::lock_guard lock(m_mutex);
+
+		return m_numUnderruns;
+	}
+
+	void StreamingMixerSource::fill()
+	{
+		size_t headBegin = 0, headSize = 0, readPos = 0;
+		{
+			std::lock_guard lock(m_mutex);
+
+			headBegin = m_headBegin;
+			headSize = m_head.size();
+			readPos = m_readPos;
+		}
+
+		if ((headSize == 0) || (headBegin != m_loopBegin))
+		{
+			decodeHead();
+
+			headBegin = m_loopBegin;
+			headSize = (m_decodePos - m_loopBegin);
+		}
+
+		// 常駐させたサンプルを読み出している間は、その続きを用意する
+		if ((headBegin <= readPos) && (readPos < (headBegin + headSize)))
+		{
+			readPos = (headBegin + headSize);
+		}
+
+		size_t ringEnd = 0;
+		{
+			std::lock_guard lock(m_mutex);
+
+			if ((readPos < m_ringBegin) || ((m_ringBegin + m_ringFrames) < readPos))
+			{
+				m_ringBegin = readPos;
+				m_ringFrames = 0;
+			}
+			else
+			{
+				// 読み出し終えたサンプルを捨てる
+				m_ringFrames -= (readPos - m_ringBegin);
+				m_ringBegin = readPos;
+			}
+
+			ringEnd = (m_ringBegin + m_ringFrames);
+		}
+
+		if ((ringEnd != m_decodePos) && !m_decoder->seek(ringEnd))
+		{
+			return;
+		}
+
+		m_decodePos = ringEnd;
+
+		// ループの終わりより先は読み出されない
+		const size_t end = (readPos < m_loopEnd) ? m_loopEnd : m_size;
+
+		for (;;)
+		{
+			size_t count = 0;
+			{
+				std::lock_guard lock(m_mutex);
+
+				count = std::min({ (RingFrames - m_ringFrames), ChunkFrames, (end - std::min(end, m_decodePos)) });
+			}
+
+			if (count == 0)
+			{
+				break;
+			}
+
+			const size_t decoded = decode(m_scratch.data(), count);
+
+			std::lock_guard lock(m_mutex);
+
+			for (size_t i = 0; i < decoded;)
+			{
+				const size_t index = ((m_ringBegin + m_ringFrames) % RingFrames);
+				const size_t n = std::min((decoded - i), (RingFrames - index));
+
+				std::memcpy(m_ring.data() + index, m_scratch.data() + i, n * sizeof(WaveSample));
+
+				m_ringFrames += n;
+				i += n;
+			}
+
+			if (decoded < count)
+			{
+				break;
+			}
+		}
+
+		const size_t decoderBytes = m_decoder->residentBytes();
+
+		std::lock_guard lock(m_mutex);
+
+		m_decoderBytes = decoderBytes;
+	}
+
+	void StreamingMixerSource::decodeHead()
+	{
+		const size_t headSize = std::min(HeadFrames, (m_loopEnd - m_loopBegin));
+
+		Array<WaveSample> head(headSize);
+
+		if (m_decoder->seek(m_loopBegin))
+		{
+			m_decodePos = m_loopBegin;
+
+			head.resize(decode(head.data(), headSize));
+		}
+		else
+		{
+			head.clear();
+		}
+
+		std::lock_guard lock(m_mutex);
+
+		m_head.swap(head);
+
+		m_headBegin = m_loopBegin;
+	}
+
+	size_t StreamingMixerSource::decode(WaveSample* dst, const size_t count)
+	{
+		size_t decoded = 0;
+
+		while (decoded < count)
+		{
+			const size_t n = m_decoder->read(dst + decoded, (count - decoded));
+
+			if (n == 0)
+			{
+				std::lock_guard lock(m_mutex);
+
+				m_streamEnd = (m_decodePos + decoded);
+
+				break;
+			}
+
+			decoded += n;
+		}
+
+		m_decodePos += decoded;
+
+		return decoded;
+	}
+}
@@ -0,0 +1,126 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <mutex>
+# include <Siv3D/Fwd.hpp>
+# include <Siv3D/Array.hpp>
+# include <Siv3D/Audio.hpp>
+# include <AudioFormat/IAudioStreamDecoder.hpp>
+# include "AudioMixer.hpp"
+
+namespace s3d
+{
+	/// <summary>
+	/// IAudioStreamDecoder から少しずつデコードしながら読み出す IMixerSource
+	/// </summary>
+	/// <remarks>
+	/// 読み出し位置から先の RingFrames サンプルをリングバッファに、ループの先頭から HeadFrames サンプルを常駐させる。
+	/// ループで先頭に戻ったときは常駐させたサンプルを読み出している間に、その続きをデコードする。
+	/// デコードは prefetch() で行い、getSamples() は用意できていないサンプルを無音にして返す。
+	/// </remarks>
+	class StreamingMixerSource : public IMixerSource
+	{
+	public:
+
+		static constexpr size_t RingFrames = 32768;
+
+		static constexpr size_t HeadFrames = 16384;
+
+		// 1 回にデコードする最大のサンプル数
+		static constexpr size_t ChunkFrames = 4096;
+
+	private:
+
+		std::unique_ptr<IAudioStreamDecoder> m_decoder;
+
+		uint32 m_samplingRate = 0;
+
+		size_t m_size = 0;
+
+		// m_decoder と m_scratch, m_decodePos, m_loopBegin, m_loopEnd を保護する
+		std::mutex m_decodeMutex;
+
+		Array<WaveSample> m_scratch;
+
+		// 次に m_decoder から読み出す位置
+		size_t m_decodePos = 0;
+
+		size_t m_loopBegin = 0;
+
+		size_t m_loopEnd = 0;
+
+		// 以下は getSamples() と共有する
+		mutable std::mutex m_mutex;
+
+		Array<WaveSample> m_head;
+
+		size_t m_headBegin = 0;
+
+		// 位置 p のサンプルは m_ring[p % RingFrames] にある
+		Array<WaveSample> m_ring;
+
+		size_t m_ringBegin = 0;
+
+		size_t m_ringFrames = 0;
+
+		// デコーダが返した終端（size() より短いことがある）
+		size_t m_streamEnd = 0;
+
+		// 最後に getSamples() で読み出した位置
+		size_t m_readPos = 0;
+
+		size_t m_numUnderruns = 0;
+
+		// m_decoder が確保している作業領域
+		size_t m_decoderBytes = 0;
+
+		void fill();
+
+		void decodeHead();
+
+		size_t decode(WaveSample* dst, size_t count);
+
+	public:
+
+		explicit StreamingMixerSource(std::unique_ptr<IAudioStreamDecoder>&& decoder);
+
+		[[nodiscard]] uint32 samplingRate() const override;
+
+		[[nodiscard]] size_t size() const override;
+
+		[[nodiscard]] const WaveSample* getSamples(size_t pos, size_t count, WaveSample* buffer) override;
+
+		[[nodiscard]] size_t residentBytes() const override;
+
+		[[nodiscard]] bool isStreaming() const override;
+
+		/// <summary>
+		/// 別のスレッドがデコード中の場合は何もしません。
+		/// </summary>
+		void prefetch() override;
+
+		/// <summary>
+		/// 読み出し位置を pos に移して、その先のサンプルをデコードします。
+		/// </summary>
+		void seek(size_t pos);
+
+		/// <summary>
+		/// ループの範囲を設定して、ループの先頭のサンプルをデコードします。
+		/// </summary>
+		void setLoop(const Optional<AudioLoopTiming>& loop);
+
+		/// <summary>
+		/// デコードが間に合わず、無音で補った回数
+		/// </summary>
+		[[nodiscard]] size_t num_underruns() const;
+	};
+}
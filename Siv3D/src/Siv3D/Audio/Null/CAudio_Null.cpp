@@ -41,6 +41,16 @@ namespace s3d
 		return AudioID::NullAsset();
 	}
 
+	AudioID CAudio_Null::createCompact(CompactWave&&)
+	{
+		return AudioID::NullAsset();
+	}
+
+	AudioID CAudio_Null::createStreaming(const FilePath&)
+	{
+		return AudioID::NullAsset();
+	}
+
 	void CAudio_Null::release(const AudioID)
 	{
 
@@ -125,6 +135,16 @@ namespace s3d
 		return 0;
 	}
 
+	bool CAudio_Null::isStreaming(const AudioID)
+	{
+		return false;
+	}
+
+	size_t CAudio_Null::residentBytes(const AudioID)
+	{
+		return 0;
+	}
+
 	const Wave& CAudio_Null::getWave(const AudioID)
 	{
 		// [Siv3D ToDo]
@@ -132,6 +152,13 @@ namespace s3d
 		return wave;
 	}
 
+	const CompactWave& CAudio_Null::getCompactWave(const AudioID)
+	{
+		static const CompactWave wave;
+
+		return wave;
+	}
+
 	void CAudio_Null::setPosSample(const AudioID, const int64)
 	{
 		// [Siv3D ToDo]
@@ -209,6 +209,60 @@ namespace s3d
 		setLoop(loopBegin, loopEnd);
 	}
 
+	Audio::Audio(FileStreaming, const FilePath& path)
+		: m_handle(std::make_shared<AudioHandle>(Siv3DEngine::Get<ISiv3DAudio>()->createStreaming(path)))
+	{
+		ReportAssetCreation();
+	}
+
+	Audio::Audio(const FileStreaming streaming, const FilePath& path, const Arg::loop_<bool> loop)
+		: Audio(streaming, path)
+	{
+		if (*loop)
+		{
+			setLoop(true);
+		}
+	}
+
+	Audio::Audio(const FileStreaming streaming, const FilePath& path, const Arg::loopBegin_<uint64> loopBegin)
+		: Audio(streaming, path)
+	{
+		setLoop(loopBegin);
+	}
+
+	Audio::Audio(const FileStreaming streaming, const FilePath& path, const Arg::loopBegin_<uint64> loopBegin, const Arg::loopEnd_<uint64> loopEnd)
+		: Audio(streaming, path)
+	{
+		setLoop(loopBegin, loopEnd);
+	}
+
+	Audio::Audio(CompactWave&& wave)
+		: m_handle(std::make_shared<AudioHandle>(Siv3DEngine::Get<ISiv3DAudio>()->createCompact(std::move(wave))))
+	{
+		ReportAssetCreation();
+	}
+
+	Audio::Audio(CompactWave&& wave, const Arg::loop_<bool> loop)
+		: Audio(std::move(wave))
+	{
+		if (*loop)
+		{
+			setLoop(true);
+		}
+	}
+
+	Audio::Audio(const CompactWave& wave)
+		: Audio(CompactWave(wave))
+	{
+
+	}
+
+	Audio::Audio(const CompactWave& wave, const Arg::loop_<bool> loop)
+		: Audio(CompactWave(wave), loop)
+	{
+
+	}
+
 	Audio::Audio(const GMInstrument instrumrnt, const uint8 key, const Duration& duration, const double velocity, const Arg::samplingRate_<uint32> samplingRate, const float silenceValue)
 		: Audio(Wave(instrumrnt, key, duration, velocity, samplingRate, silenceValue))
 	{
@@ -397,11 +451,26 @@ namespace s3d
 		return static_cast<double>(samples()) / samplingRate();
 	}
 
+	bool Audio::isStreaming() const
+	{
+		return Siv3DEngine::Get<ISiv3DAudio>()->isStreaming(m_handle->id());
+	}
+
+	size_t Audio::residentBytes() const
+	{
+		return Siv3DEngine::Get<ISiv3DAudio>()->residentBytes(m_handle->id());
+	}
+
 	const Wave& Audio::getWave() const
 	{
 		return Siv3DEngine::Get<ISiv3DAudio>()->getWave(m_handle->id());
 	}
 
+	const CompactWave& Audio::getCompactWave() const
+	{
+		return Siv3DEngine::Get<ISiv3DAudio>()->getCompactWave(m_handle->id());
+	}
+
 	void Audio::setPosSec(const double posSec) const
 	{
 		const int64 sample = static_cast<int64>(posSec * samplingRate());
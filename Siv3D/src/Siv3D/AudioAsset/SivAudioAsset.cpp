@@ -208,4 +208,9 @@ namespace s3d
 	{
 		return Siv3DEngine::Get<ISiv3DAsset>()->isReady(AssetType::Audio, name);
 	}
+
+	Optional<AssetLoadingTime> AudioAsset::GetLoadingTime(const AssetName& name)
+	{
+		return Siv3DEngine::Get<ISiv3DAsset>()->getLoadingTime(AssetType::Audio, name);
+	}
 }
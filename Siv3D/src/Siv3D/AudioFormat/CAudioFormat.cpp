@@ -163,6 +163,50 @@ namespace s3d
 		return (*it)->decode(reader);
 	}
 
+	std::unique_ptr<IAudioStreamDecoder> CAudioFormat::openStream(const FilePath& path) const
+	{
+		auto reader = std::make_unique<BinaryReader>(path);
+
+		const auto it = findFormat(*reader, path);
+
+		if (it == m_audioFormats.end())
+		{
+			return nullptr;
+		}
+
+		switch ((*it)->format())
+		{
+		case AudioFormat::OggVorbis:
+			if (const AudioFormat_OggVorbis* ogg = dynamic_cast<AudioFormat_OggVorbis*>(it->get()))
+			{
+				return ogg->openStream(std::move(reader));
+			}
+			break;
+
+	# if SIV3D_PLATFORM(LINUX)
+
+		case AudioFormat::MP3:
+			if (const AudioFormat_MP3* mp3 = dynamic_cast<AudioFormat_MP3*>(it->get()))
+			{
+				return mp3->openStream(std::move(reader));
+			}
+			break;
+		case AudioFormat::AAC:
+			if (const AudioFormat_AAC* aac = dynamic_cast<AudioFormat_AAC*>(it->get()))
+			{
+				return aac->openStream(std::move(reader));
+			}
+			break;
+
+	# endif
+
+		default:
+			break;
+		}
+
+		return nullptr;
+	}
+
 	bool CAudioFormat::encodeWAVE(IWriter& writer, const Wave& wave, const WAVEFormat format) const
 	{
 		const auto p = findFormat(AudioFormat::WAVE);
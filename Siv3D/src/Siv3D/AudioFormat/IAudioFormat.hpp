@@ -11,6 +11,7 @@
 
 # pragma once
 # include <Siv3D/Fwd.hpp>
+# include "IAudioStreamDecoder.hpp"
 
 namespace s3d
 {
@@ -32,6 +33,11 @@ namespace s3d
 
 		virtual Wave decode(IReader&& reader, AudioFormat format) const = 0;
 
+		/// <summary>
+		/// ファイルを少しずつデコードするデコーダを作成します。対応していない形式の場合は nullptr を返します。
+		/// </summary>
+		virtual std::unique_ptr<IAudioStreamDecoder> openStream(const FilePath& path) const = 0;
+
 		virtual bool encodeWAVE(IWriter& writer, const Wave& wave, WAVEFormat format) const = 0;
 
 		virtual bool encodeOggVorbis(IWriter& writer, const Wave& wave, int32 quality) const = 0;
@@ -0,0 +1,52 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/Fwd.hpp>
+# include <Siv3D/Wave.hpp>
+
+namespace s3d
+{
+	/// <summary>
+	/// 音声ファイルを先頭から少しずつデコードするデコーダ
+	/// </summary>
+	class IAudioStreamDecoder
+	{
+	public:
+
+		virtual ~IAudioStreamDecoder() = default;
+
+		[[nodiscard]] virtual uint32 samplingRate() const = 0;
+
+		/// <summary>
+		/// 全体のサンプル数
+		/// </summary>
+		[[nodiscard]] virtual size_t size() const = 0;
+
+		/// <summary>
+		/// 現在の位置から最大 count サンプルをデコードします。
+		/// </summary>
+		/// <returns>
+		/// デコードしたサンプル数。終端に達した場合は 0
+		/// </returns>
+		virtual size_t read(WaveSample* dst, size_t count) = 0;
+
+		/// <summary>
+		/// 次に read() でデコードする位置を変更します。
+		/// </summary>
+		virtual bool seek(size_t pos) = 0;
+
+		/// <summary>
+		/// デコーダが確保している作業領域のバイト数（ライブラリ内部の確保は含まない）
+		/// </summary>
+		[[nodiscard]] virtual size_t residentBytes() const = 0;
+	};
+}
@@ -83,6 +83,123 @@ namespace s3d
 		return static_cast<long>(reader->getPos());
 	}
 
+	namespace detail
+	{
+		class OggVorbisStreamDecoder : public IAudioStreamDecoder
+		{
+		private:
+
+			std::unique_ptr<IReader> m_reader;
+
+			OggVorbis_File m_vf;
+
+			bool m_opened = false;
+
+			uint32 m_samplingRate = Wave::DefaultSamplingRate;
+
+			size_t m_size = 0;
+
+			int32 m_channels = 0;
+
+		public:
+
+			explicit OggVorbisStreamDecoder(std::unique_ptr<IReader>&& reader)
+				: m_reader(std::move(reader))
+			{
+				if (!m_reader || !m_reader->isOpen())
+				{
+					return;
+				}
+
+				ov_callbacks callbacks;
+				callbacks.read_func = ReadOgg_Callback;
+				callbacks.seek_func = SeekOgg_Callback;
+				callbacks.close_func = CloseOgg_Callback;
+				callbacks.tell_func = TellOgg_Callback;
+
+				if (::ov_open_callbacks(m_reader.get(), &m_vf, nullptr, -1, callbacks) != 0)
+				{
+					return;
+				}
+
+				m_opened = true;
+
+				const vorbis_info* vi = ::ov_info(&m_vf, -1);
+				const ogg_int64_t samples = ::ov_pcm_total(&m_vf, -1);
+
+				if (!vi || (samples <= 0) || ((vi->channels != 1) && (vi->channels != 2)))
+				{
+					return;
+				}
+
+				m_samplingRate = (vi->rate ? static_cast<uint32>(vi->rate) : Wave::DefaultSamplingRate);
+				m_size = static_cast<size_t>(samples);
+				m_channels = vi->channels;
+			}
+
+			~OggVorbisStreamDecoder() override
+			{
+				if (m_opened)
+				{
+					::ov_clear(&m_vf);
+				}
+			}
+
+			[[nodiscard]] bool isOpen() const noexcept
+			{
+				return (m_size != 0);
+			}
+
+			uint32 samplingRate() const override
+			{
+				return m_samplingRate;
+			}
+
+			size_t size() const override
+			{
+				return m_size;
+			}
+
+			size_t read(WaveSample* dst, const size_t count) override
+			{
+				size_t written = 0;
+				int current_sec = 0;
+
+				while (written < count)
+				{
+					float** pcm = nullptr;
+					const int32 wanted = static_cast<int32>(std::min<size_t>((count - written), 4096));
+					const long samples_read = ::ov_read_float(&m_vf, &pcm, wanted, &current_sec);
+
+					if (samples_read <= 0)
+					{
+						break;
+					}
+
+					const float* pLeft = pcm[0];
+					const float* pRight = (m_channels == 2) ? pcm[1] : pcm[0];
+
+					for (long i = 0; i < samples_read; ++i)
+					{
+						dst[written++].set(pLeft[i], pRight[i]);
+					}
+				}
+
+				return written;
+			}
+
+			bool seek(const size_t pos) override
+			{
+				return (::ov_pcm_seek(&m_vf, static_cast<ogg_int64_t>(pos)) == 0);
+			}
+
+			size_t residentBytes() const override
+			{
+				return sizeof(OggVorbis_File);
+			}
+		};
+	}
+
 	AudioFormat AudioFormat_OggVorbis::format() const
 	{
 		return AudioFormat::OggVorbis;
@@ -237,6 +354,18 @@ namespace s3d
 			return wave;
 	}
 
+	std::unique_ptr<IAudioStreamDecoder> AudioFormat_OggVorbis::openStream(std::unique_ptr<IReader>&& reader) const
+	{
+		auto decoder = std::make_unique<detail::OggVorbisStreamDecoder>(std::move(reader));
+
+		if (!decoder->isOpen())
+		{
+			return nullptr;
+		}
+
+		return decoder;
+	}
+
 	bool AudioFormat_OggVorbis::encode(const Wave& wave, int32 quality, IWriter& writer) const
 	{
 		if (!wave || !writer.isOpen())
@@ -12,6 +12,7 @@
 # pragma once
 # include <Siv3D/Wave.hpp>
 # include <Siv3D/AudioFormat.hpp>
+# include <AudioFormat/IAudioStreamDecoder.hpp>
 
 namespace s3d
 {
@@ -30,5 +31,10 @@ namespace s3d
 		Wave decode(IReader& reader) const override;
 
 		bool encode(const Wave& wave, int32 quality, IWriter& writer) const;
+
+		/// <summary>
+		/// reader から少しずつデコードするデコーダを作成します。
+		/// </summary>
+		[[nodiscard]] std::unique_ptr<IAudioStreamDecoder> openStream(std::unique_ptr<IReader>&& reader) const;
 	};
 }
@@ -0,0 +1,89 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/EngineLog.hpp>
+# include "CompressionDictionaryDetail.hpp"
+
+namespace s3d
+{
+	CompressionDictionary::CompressionDictionaryDetail::CompressionDictionaryDetail()
+	{
+
+	}
+
+	CompressionDictionary::CompressionDictionaryDetail::~CompressionDictionaryDetail()
+	{
+		ZSTD_freeCDict(m_cDict);
+
+		ZSTD_freeDDict(m_dDict);
+	}
+
+	bool CompressionDictionary::CompressionDictionaryDetail::init(const ByteArrayView dictionary, const int32 compressionLevel)
+	{
+		if (dictionary.empty())
+		{
+			return false;
+		}
+
+		m_data.assign(dictionary.begin(), dictionary.end());
+
+		m_compressionLevel = compressionLevel;
+
+		m_cDict = ZSTD_createCDict(m_data.data(), m_data.size(), compressionLevel);
+
+		m_dDict = ZSTD_createDDict(m_data.data(), m_data.size());
+
+		if (!m_cDict || !m_dDict)
+		{
+			LOG_FAIL(U"CompressionDictionary: Failed to create a dictionary");
+
+			ZSTD_freeCDict(m_cDict);
+			ZSTD_freeDDict(m_dDict);
+			m_cDict = nullptr;
+			m_dDict = nullptr;
+			m_data.release();
+
+			return false;
+		}
+
+		return true;
+	}
+
+	bool CompressionDictionary::CompressionDictionaryDetail::isEmpty() const
+	{
+		return (m_cDict == nullptr);
+	}
+
+	uint32 CompressionDictionary::CompressionDictionaryDetail::id() const
+	{
+		return m_dDict ? ZSTD_getDictID_fromDDict(m_dDict) : 0;
+	}
+
+	int32 CompressionDictionary::CompressionDictionaryDetail::compressionLevel() const
+	{
+		return m_compressionLevel;
+	}
+
+	ByteArrayView CompressionDictionary::CompressionDictionaryDetail::view() const
+	{
+		return ByteArrayView(m_data.data(), m_data.size());
+	}
+
+	const ZSTD_CDict* CompressionDictionary::CompressionDictionaryDetail::getCDict() const
+	{
+		return m_cDict;
+	}
+
+	const ZSTD_DDict* CompressionDictionary::CompressionDictionaryDetail::getDDict() const
+	{
+		return m_dDict;
+	}
+}
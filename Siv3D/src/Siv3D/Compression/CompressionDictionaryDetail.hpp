@@ -0,0 +1,50 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <zstd/zstd.h>
+# include <Siv3D/CompressionDictionary.hpp>
+
+namespace s3d
+{
+	class CompressionDictionary::CompressionDictionaryDetail
+	{
+	private:
+
+		Array<Byte> m_data;
+
+		int32 m_compressionLevel = Compression::DefaultCompressionLevel;
+
+		ZSTD_CDict* m_cDict = nullptr;
+
+		ZSTD_DDict* m_dDict = nullptr;
+
+	public:
+
+		CompressionDictionaryDetail();
+
+		~CompressionDictionaryDetail();
+
+		bool init(ByteArrayView dictionary, int32 compressionLevel);
+
+		[[nodiscard]] bool isEmpty() const;
+
+		[[nodiscard]] uint32 id() const;
+
+		[[nodiscard]] int32 compressionLevel() const;
+
+		[[nodiscard]] ByteArrayView view() const;
+
+		[[nodiscard]] const ZSTD_CDict* getCDict() const;
+
+		[[nodiscard]] const ZSTD_DDict* getDDict() const;
+	};
+}
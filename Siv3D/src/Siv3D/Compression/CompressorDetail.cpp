@@ -0,0 +1,308 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/ByteArray.hpp>
+# include <Siv3D/MemoryWriter.hpp>
+# include <Siv3D/ReaderView.hpp>
+# include <Siv3D/EngineLog.hpp>
+# include "CompressorDetail.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		static void SetNumWorkers(ZSTD_CCtx* cctx, const size_t numWorkers)
+		{
+			if (numWorkers == 0)
+			{
+				return;
+			}
+
+			// ZSTD_MULTITHREAD が定義されていない場合は失敗し、呼び出し元のスレッドで圧縮する
+			if (ZSTD_isError(ZSTD_CCtx_setParameter(cctx, ZSTD_c_nbWorkers, static_cast<int>(numWorkers))))
+			{
+				LOG_FAIL(U"Compressor: Multithreaded compression is not supported");
+			}
+		}
+	}
+
+	Compressor::CompressorDetail::CompressorDetail()
+	{
+
+	}
+
+	Compressor::CompressorDetail::~CompressorDetail()
+	{
+		ZSTD_freeCCtx(m_cctx);
+	}
+
+	bool Compressor::CompressorDetail::init(const int32 compressionLevel, const size_t numWorkers)
+	{
+		if (m_cctx = ZSTD_createCCtx(); !m_cctx)
+		{
+			return false;
+		}
+
+		ZSTD_CCtx_setParameter(m_cctx, ZSTD_c_compressionLevel, compressionLevel);
+
+		detail::SetNumWorkers(m_cctx, numWorkers);
+
+		return true;
+	}
+
+	bool Compressor::CompressorDetail::init(const CompressionDictionary& dictionary, const ZSTD_CDict* cDict, const size_t numWorkers)
+	{
+		if (!init(dictionary.compressionLevel(), numWorkers))
+		{
+			return false;
+		}
+
+		if (cDict)
+		{
+			m_dictionary = dictionary;
+
+			ZSTD_CCtx_refCDict(m_cctx, cDict);
+		}
+
+		return true;
+	}
+
+	bool Compressor::CompressorDetail::isOpen() const
+	{
+		return (m_cctx != nullptr);
+	}
+
+	ByteArray Compressor::CompressorDetail::compress(const ByteArrayViewAdapter view)
+	{
+		if (!m_cctx)
+		{
+			return ByteArray();
+		}
+
+		Array<Byte> buffer(ZSTD_compressBound(view.size()));
+
+		// パラメータと辞書は保持したまま、前回の圧縮の状態だけを破棄する
+		ZSTD_CCtx_reset(m_cctx, ZSTD_reset_session_only);
+
+		const size_t result = ZSTD_compress2(m_cctx, buffer.data(), buffer.size(), view.data(), view.size());
+
+		if (ZSTD_isError(result))
+		{
+			return ByteArray();
+		}
+
+		buffer.resize(result);
+
+		buffer.shrink_to_fit();
+
+		return ByteArray(std::move(buffer));
+	}
+
+	bool Compressor::CompressorDetail::compress(IReader& reader, IWriter& writer)
+	{
+		if (!m_cctx || !reader.isOpen() || !writer.isOpen())
+		{
+			return false;
+		}
+
+		ZSTD_CCtx_reset(m_cctx, ZSTD_reset_session_only);
+
+		if (const int64 remaining = (reader.size() - reader.getPos());
+			0 <= remaining)
+		{
+			// フレームに元のサイズを記録する
+			ZSTD_CCtx_setPledgedSrcSize(m_cctx, static_cast<unsigned long long>(remaining));
+		}
+
+		const size_t inputBufferSize = ZSTD_CStreamInSize();
+		const auto pInputBuffer = std::make_unique<Byte[]>(inputBufferSize);
+
+		const size_t outputBufferSize = ZSTD_CStreamOutSize();
+		const auto pOutputBuffer = std::make_unique<Byte[]>(outputBufferSize);
+
+		for (;;)
+		{
+			const int64 read = reader.read(pInputBuffer.get(), static_cast<int64>(inputBufferSize));
+
+			if (read < 0)
+			{
+				return false;
+			}
+
+			const bool lastChunk = (static_cast<size_t>(read) < inputBufferSize);
+			const ZSTD_EndDirective mode = lastChunk ? ZSTD_e_end : ZSTD_e_continue;
+
+			ZSTD_inBuffer input = { pInputBuffer.get(), static_cast<size_t>(read), 0 };
+
+			for (;;)
+			{
+				ZSTD_outBuffer output = { pOutputBuffer.get(), outputBufferSize, 0 };
+
+				const size_t remaining = ZSTD_compressStream2(m_cctx, &output, &input, mode);
+
+				if (ZSTD_isError(remaining))
+				{
+					return false;
+				}
+
+				if (writer.write(pOutputBuffer.get(), output.pos) != static_cast<int64>(output.pos))
+				{
+					return false;
+				}
+
+				// 最後はフレームの書き出しが終わるまで、それ以外は入力を使い切るまで
+				if (lastChunk ? (remaining == 0) : (input.pos == input.size))
+				{
+					break;
+				}
+			}
+
+			if (lastChunk)
+			{
+				return true;
+			}
+		}
+	}
+
+	Decompressor::DecompressorDetail::DecompressorDetail()
+	{
+
+	}
+
+	Decompressor::DecompressorDetail::~DecompressorDetail()
+	{
+		ZSTD_freeDCtx(m_dctx);
+	}
+
+	bool Decompressor::DecompressorDetail::init()
+	{
+		m_dctx = ZSTD_createDCtx();
+
+		return (m_dctx != nullptr);
+	}
+
+	bool Decompressor::DecompressorDetail::init(const CompressionDictionary& dictionary, const ZSTD_DDict* dDict)
+	{
+		if (!init())
+		{
+			return false;
+		}
+
+		if (dDict)
+		{
+			m_dictionary = dictionary;
+
+			m_dDict = dDict;
+
+			ZSTD_DCtx_refDDict(m_dctx, dDict);
+		}
+
+		return true;
+	}
+
+	bool Decompressor::DecompressorDetail::isOpen() const
+	{
+		return (m_dctx != nullptr);
+	}
+
+	ByteArray Decompressor::DecompressorDetail::decompress(const ByteArrayView view)
+	{
+		if (!m_dctx)
+		{
+			return ByteArray();
+		}
+
+		const unsigned long long originalSize = ZSTD_getFrameContentSize(view.data(), view.size());
+
+		if (originalSize == ZSTD_CONTENTSIZE_ERROR)
+		{
+			return ByteArray();
+		}
+
+		// 元のサイズが記録されていないフレームは、ストリームとして展開する
+		if (originalSize == ZSTD_CONTENTSIZE_UNKNOWN)
+		{
+			ReaderView reader(view.data(), view.size());
+
+			MemoryWriter writer;
+
+			if (!decompress(reader, writer))
+			{
+				return ByteArray();
+			}
+
+			return writer.retrieve();
+		}
+
+		Array<Byte> outputBuffer(static_cast<size_t>(originalSize));
+
+		ZSTD_DCtx_reset(m_dctx, ZSTD_reset_session_only);
+
+		const size_t decompressedSize = m_dDict
+			? ZSTD_decompress_usingDDict(m_dctx, outputBuffer.data(), outputBuffer.size(), view.data(), view.size(), m_dDict)
+			: ZSTD_decompressDCtx(m_dctx, outputBuffer.data(), outputBuffer.size(), view.data(), view.size());
+
+		if (decompressedSize != originalSize)
+		{
+			return ByteArray();
+		}
+
+		return ByteArray(std::move(outputBuffer));
+	}
+
+	bool Decompressor::DecompressorDetail::decompress(IReader& reader, IWriter& writer)
+	{
+		if (!m_dctx || !reader.isOpen() || !writer.isOpen())
+		{
+			return false;
+		}
+
+		ZSTD_DCtx_reset(m_dctx, ZSTD_reset_session_only);
+
+		const size_t inputBufferSize = ZSTD_DStreamInSize();
+		const auto pInputBuffer = std::make_unique<Byte[]>(inputBufferSize);
+
+		const size_t outputBufferSize = ZSTD_DStreamOutSize();
+		const auto pOutputBuffer = std::make_unique<Byte[]>(outputBufferSize);
+
+		// 0 になったらフレームの終わり
+		size_t lastResult = 1;
+
+		while (const int64 read = reader.read(pInputBuffer.get(), static_cast<int64>(inputBufferSize)))
+		{
+			if (read < 0)
+			{
+				return false;
+			}
+
+			ZSTD_inBuffer input = { pInputBuffer.get(), static_cast<size_t>(read), 0 };
+
+			while (input.pos < input.size)
+			{
+				ZSTD_outBuffer output = { pOutputBuffer.get(), outputBufferSize, 0 };
+
+				lastResult = ZSTD_decompressStream(m_dctx, &output, &input);
+
+				if (ZSTD_isError(lastResult))
+				{
+					return false;
+				}
+
+				if (writer.write(pOutputBuffer.get(), output.pos) != static_cast<int64>(output.pos))
+				{
+					return false;
+				}
+			}
+		}
+
+		return (lastResult == 0);
+	}
+}
@@ -0,0 +1,71 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <zstd/zstd.h>
+# include <Siv3D/Compressor.hpp>
+# include <Siv3D/CompressionDictionary.hpp>
+
+namespace s3d
+{
+	class Compressor::CompressorDetail
+	{
+	private:
+
+		ZSTD_CCtx* m_cctx = nullptr;
+
+		// 参照している CDict を解放させないために保持する
+		CompressionDictionary m_dictionary;
+
+	public:
+
+		CompressorDetail();
+
+		~CompressorDetail();
+
+		bool init(int32 compressionLevel, size_t numWorkers);
+
+		bool init(const CompressionDictionary& dictionary, const ZSTD_CDict* cDict, size_t numWorkers);
+
+		[[nodiscard]] bool isOpen() const;
+
+		[[nodiscard]] ByteArray compress(ByteArrayViewAdapter view);
+
+		bool compress(IReader& reader, IWriter& writer);
+	};
+
+	class Decompressor::DecompressorDetail
+	{
+	private:
+
+		ZSTD_DCtx* m_dctx = nullptr;
+
+		CompressionDictionary m_dictionary;
+
+		const ZSTD_DDict* m_dDict = nullptr;
+
+	public:
+
+		DecompressorDetail();
+
+		~DecompressorDetail();
+
+		bool init();
+
+		bool init(const CompressionDictionary& dictionary, const ZSTD_DDict* dDict);
+
+		[[nodiscard]] bool isOpen() const;
+
+		[[nodiscard]] ByteArray decompress(ByteArrayView view);
+
+		bool decompress(IReader& reader, IWriter& writer);
+	};
+}
@@ -0,0 +1,135 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <zstd/dictBuilder/zdict.h>
+# include <Siv3D/CompressionDictionary.hpp>
+# include <Siv3D/BinaryReader.hpp>
+# include <Siv3D/BinaryWriter.hpp>
+# include <Siv3D/EngineLog.hpp>
+# include "CompressionDictionaryDetail.hpp"
+
+namespace s3d
+{
+	CompressionDictionary::CompressionDictionary()
+		: pImpl(std::make_shared<CompressionDictionaryDetail>())
+	{
+
+	}
+
+	CompressionDictionary::CompressionDictionary(const ByteArrayView dictionary, const int32 compressionLevel)
+		: CompressionDictionary()
+	{
+		pImpl->init(dictionary, compressionLevel);
+	}
+
+	CompressionDictionary::CompressionDictionary(const FilePathView path, const int32 compressionLevel)
+		: CompressionDictionary()
+	{
+		BinaryReader reader(path);
+
+		if (!reader)
+		{
+			return;
+		}
+
+		Array<Byte> data(static_cast<size_t>(reader.size()));
+
+		if (reader.read(data.data(), reader.size()) != reader.size())
+		{
+			return;
+		}
+
+		pImpl->init(ByteArrayView(data.data(), data.size()), compressionLevel);
+	}
+
+	CompressionDictionary::~CompressionDictionary()
+	{
+
+	}
+
+	bool CompressionDictionary::isEmpty() const
+	{
+		return pImpl->isEmpty();
+	}
+
+	CompressionDictionary::operator bool() const
+	{
+		return !isEmpty();
+	}
+
+	uint32 CompressionDictionary::id() const
+	{
+		return pImpl->id();
+	}
+
+	int32 CompressionDictionary::compressionLevel() const
+	{
+		return pImpl->compressionLevel();
+	}
+
+	ByteArrayView CompressionDictionary::view() const
+	{
+		return pImpl->view();
+	}
+
+	bool CompressionDictionary::save(const FilePathView path) const
+	{
+		if (isEmpty())
+		{
+			return false;
+		}
+
+		BinaryWriter writer(path);
+
+		if (!writer)
+		{
+			return false;
+		}
+
+		const ByteArrayView data = view();
+
+		return (writer.write(data.data(), data.size()) == static_cast<int64>(data.size()));
+	}
+
+	CompressionDictionary CompressionDictionary::Train(const Array<ByteArrayView>& samples, const size_t dictionarySize, const int32 compressionLevel)
+	{
+		if (samples.isEmpty() || (dictionarySize == 0))
+		{
+			return CompressionDictionary();
+		}
+
+		// ZDICT はサンプルを連結したバッファと、それぞれのサイズを受け取る
+		Array<Byte> samplesBuffer;
+		Array<size_t> sampleSizes;
+		sampleSizes.reserve(samples.size());
+
+		for (const auto& sample : samples)
+		{
+			samplesBuffer.insert(samplesBuffer.end(), sample.begin(), sample.end());
+			sampleSizes.push_back(sample.size());
+		}
+
+		Array<Byte> dictionary(dictionarySize);
+
+		const size_t result = ZDICT_trainFromBuffer(dictionary.data(), dictionary.size(),
+			samplesBuffer.data(), sampleSizes.data(), static_cast<unsigned>(sampleSizes.size()));
+
+		if (ZDICT_isError(result))
+		{
+			LOG_FAIL(U"CompressionDictionary::Train(): {}"_fmt(Unicode::Widen(ZDICT_getErrorName(result))));
+			return CompressionDictionary();
+		}
+
+		dictionary.resize(result);
+
+		return CompressionDictionary(ByteArrayView(dictionary.data(), dictionary.size()), compressionLevel);
+	}
+}
@@ -0,0 +1,92 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/Compressor.hpp>
+# include <Siv3D/ByteArray.hpp>
+# include "CompressorDetail.hpp"
+# include "CompressionDictionaryDetail.hpp"
+
+namespace s3d
+{
+	Compressor::Compressor(const int32 compressionLevel, const size_t numWorkers)
+		: pImpl(std::make_shared<CompressorDetail>())
+	{
+		pImpl->init(compressionLevel, numWorkers);
+	}
+
+	Compressor::Compressor(const CompressionDictionary& dictionary, const size_t numWorkers)
+		: pImpl(std::make_shared<CompressorDetail>())
+	{
+		pImpl->init(dictionary, dictionary.pImpl->getCDict(), numWorkers);
+	}
+
+	Compressor::~Compressor()
+	{
+
+	}
+
+	bool Compressor::isOpen() const
+	{
+		return pImpl->isOpen();
+	}
+
+	Compressor::operator bool() const
+	{
+		return isOpen();
+	}
+
+	ByteArray Compressor::compress(const ByteArrayViewAdapter view)
+	{
+		return pImpl->compress(view);
+	}
+
+	bool Compressor::compress(IReader& reader, IWriter& writer)
+	{
+		return pImpl->compress(reader, writer);
+	}
+
+	Decompressor::Decompressor()
+		: pImpl(std::make_shared<DecompressorDetail>())
+	{
+		pImpl->init();
+	}
+
+	Decompressor::Decompressor(const CompressionDictionary& dictionary)
+		: pImpl(std::make_shared<DecompressorDetail>())
+	{
+		pImpl->init(dictionary, dictionary.pImpl->getDDict());
+	}
+
+	Decompressor::~Decompressor()
+	{
+
+	}
+
+	bool Decompressor::isOpen() const
+	{
+		return pImpl->isOpen();
+	}
+
+	Decompressor::operator bool() const
+	{
+		return isOpen();
+	}
+
+	ByteArray Decompressor::decompress(const ByteArrayView view)
+	{
+		return pImpl->decompress(view);
+	}
+
+	bool Decompressor::decompress(IReader& reader, IWriter& writer)
+	{
+		return pImpl->decompress(reader, writer);
+	}
+}
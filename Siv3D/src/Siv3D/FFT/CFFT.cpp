@@ -9,14 +9,126 @@
 //
 //-----------------------------------------------
 
+# include <Siv3D/Platform.hpp>
+# if SIV3D_WITH_FEATURE(SSE2)
+#	include <emmintrin.h>
+# endif
 # include <Siv3D/FFT.hpp>
 # include <Siv3D/Wave.hpp>
+# include <Siv3D/CompactWave.hpp>
 # include <Siv3D/AlignedMemory.hpp>
+# include <Siv3D/MathConstants.hpp>
+# include <Siv3D/Threading.hpp>
 # include <Siv3D/EngineLog.hpp>
 # include "CFFT.hpp"
 
 namespace s3d
 {
+	namespace detail
+	{
+		constexpr size_t MaxFFTSamples = 16384;
+
+		// スレッドごとの FFT の作業領域
+		class FFTWorkspace
+		{
+		private:
+
+			float* m_inoutBuffer = nullptr;
+
+			float* m_workBuffer = nullptr;
+
+		public:
+
+			FFTWorkspace()
+				: m_inoutBuffer(AlignedMalloc<float, 16>(MaxFFTSamples))
+				, m_workBuffer(AlignedMalloc<float, 16>(MaxFFTSamples)) {}
+
+			FFTWorkspace(const FFTWorkspace&) = delete;
+
+			FFTWorkspace& operator =(const FFTWorkspace&) = delete;
+
+			~FFTWorkspace()
+			{
+				AlignedFree(m_workBuffer);
+
+				AlignedFree(m_inoutBuffer);
+			}
+
+			[[nodiscard]] float* inoutBuffer() noexcept
+			{
+				return m_inoutBuffer;
+			}
+
+			[[nodiscard]] float* workBuffer() noexcept
+			{
+				return m_workBuffer;
+			}
+		};
+
+		[[nodiscard]] static FFTWorkspace& GetWorkspace()
+		{
+			thread_local FFTWorkspace workspace;
+
+			return workspace;
+		}
+
+		// STFT で重ねたときに振幅がそろう、周期的な窓関数
+		static void MakeWindow(const FFTWindow window, const size_t size, float* dst)
+		{
+			for (size_t i = 0; i < size; ++i)
+			{
+				const double t = (Math::TwoPi * i / size);
+
+				switch (window)
+				{
+				case FFTWindow::Hann:
+					dst[i] = static_cast<float>(0.5 - 0.5 * std::cos(t));
+					break;
+				case FFTWindow::Hamming:
+					dst[i] = static_cast<float>(0.54 - 0.46 * std::cos(t));
+					break;
+				case FFTWindow::Blackman:
+					dst[i] = static_cast<float>(0.42 - 0.5 * std::cos(t) + 0.08 * std::cos(2.0 * t));
+					break;
+				default:
+					dst[i] = 1.0f;
+					break;
+				}
+			}
+		}
+
+		// pffft の出力 (re, im) の組から、振幅 / bins を求める
+		static void ToMagnitudes(const float* src, const size_t bins, float* dst) noexcept
+		{
+			const float m = (1.0f / bins);
+			size_t i = 0;
+
+		# if SIV3D_WITH_FEATURE(SSE2)
+
+			const __m128 scale = _mm_set1_ps(m);
+
+			for (; (i + 4) <= bins; i += 4)
+			{
+				const __m128 a = _mm_loadu_ps(src + i * 2);
+				const __m128 b = _mm_loadu_ps(src + i * 2 + 4);
+				const __m128 re = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+				const __m128 im = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+				const __m128 power = _mm_add_ps(_mm_mul_ps(re, re), _mm_mul_ps(im, im));
+
+				_mm_storeu_ps(dst + i, _mm_mul_ps(_mm_sqrt_ps(power), scale));
+			}
+
+		# endif
+
+			for (; i < bins; ++i)
+			{
+				const float f0 = src[i * 2];
+				const float f1 = src[i * 2 + 1];
+				dst[i] = std::sqrt(f0 * f0 + f1 * f1) * m;
+			}
+		}
+	}
+
 	CFFT::CFFT()
 	{
 		m_setups.fill(nullptr);
@@ -26,10 +138,6 @@ namespace s3d
 	{
 		LOG_TRACE(U"CFFT::~CFFT()");
 
-		AlignedFree(m_workBuffer);
-
-		AlignedFree(m_inoutBuffer);
-
 		for (auto& setup : m_setups)
 		{
 			if (setup)
@@ -52,10 +160,6 @@ namespace s3d
 			setup = ::pffft_new_setup(256 << i++, PFFFT_REAL);
 		}
 
-		m_inoutBuffer = AlignedMalloc<float, 16>(16384);
-
-		m_workBuffer = AlignedMalloc<float, 16>(16384);
-
 		LOG_INFO(U"ℹ️ CFFT initialized");
 	}
 
@@ -66,7 +170,8 @@ namespace s3d
 		const int32 end = std::min(begin + samples, static_cast<int32>(wave.samples()));
 		const int32 fillCount = end - begin;
 
-		float* pDst = m_inoutBuffer;
+		float* const inout = detail::GetWorkspace().inoutBuffer();
+		float* pDst = inout;
 
 		if (fillCount)
 		{
@@ -85,14 +190,28 @@ namespace s3d
 			*pDst++ = 0.0f;
 		}
 
-		doFFT(result, wave.samplingRate(), sampleLength);
+		doFFT(result, inout, wave.samplingRate(), sampleLength);
+	}
+
+	void CFFT::fft(FFTResult& result, const CompactWave& wave, const uint32 pos, const FFTSampleLength sampleLength)
+	{
+		const int32 samples = 256 << static_cast<int32>(sampleLength);
+		const int32 begin = std::max(static_cast<int32>(pos) - 1 - samples, 0);
+
+		float* const inout = detail::GetWorkspace().inoutBuffer();
+
+		// 波形の範囲外は 0 で埋まる
+		wave.getMonoSamples(begin, samples, inout);
+
+		doFFT(result, inout, wave.samplingRate(), sampleLength);
 	}
 
 	void CFFT::fft(FFTResult& result, const Array<WaveSampleS16>& wave, uint32 pos, const uint32 samplingRate, const FFTSampleLength sampleLength)
 	{
 		const int32 samples = 256 << static_cast<int32>(sampleLength);
 
-		float* pDst = m_inoutBuffer;
+		float* const inout = detail::GetWorkspace().inoutBuffer();
+		float* pDst = inout;
 
 		for (size_t samplesLeft = samples; samplesLeft; --samplesLeft)
 		{
@@ -106,34 +225,112 @@ namespace s3d
 			*pDst++ = (static_cast<int32>(sample.left) + static_cast<int32>(sample.right)) / (32768.0f * 2);
 		}
 
-		doFFT(result, samplingRate, sampleLength);
+		doFFT(result, inout, samplingRate, sampleLength);
 	}
 
 	void CFFT::fft(FFTResult& result, const float* input, size_t size, const uint32 samplingRate, const FFTSampleLength sampleLength)
 	{
-		std::memcpy(m_inoutBuffer, input, sizeof(float) * size);
+		float* const inout = detail::GetWorkspace().inoutBuffer();
+
+		std::memcpy(inout, input, sizeof(float) * size);
 
-		doFFT(result, samplingRate, sampleLength);
+		doFFT(result, inout, samplingRate, sampleLength);
 	}
 
-	void CFFT::doFFT(FFTResult& result, const uint32 samplingRate, const FFTSampleLength sampleLength)
+	void CFFT::stft(Spectrogram& result, const float* input, const size_t length, const uint32 samplingRate, const STFTDesc& desc)
 	{
-		result.buffer.resize(128 << static_cast<int32>(sampleLength));
+		doSTFT(result, length, samplingRate, desc, [input, length](const size_t pos, const size_t count, float* dst)
+		{
+			const size_t fillCount = (pos < length) ? std::min(count, length - pos) : 0;
 
-		::pffft_transform_ordered(m_setups[static_cast<size_t>(sampleLength)], m_inoutBuffer, m_inoutBuffer, m_workBuffer, PFFFT_FORWARD);
+			std::memcpy(dst, input + std::min(pos, length), sizeof(float) * fillCount);
 
-		const float m = 1.0f / result.buffer.size();
-		const float* pSrc = m_inoutBuffer;
-		float* pDst = result.buffer.data();
+			std::fill(dst + fillCount, dst + count, 0.0f);
+		});
+	}
 
-		for (size_t i = 0; i < result.buffer.size(); ++i)
+	void CFFT::stft(Spectrogram& result, const Wave& wave, const STFTDesc& desc)
+	{
+		doSTFT(result, wave.size(), wave.samplingRate(), desc, [&wave](const size_t pos, const size_t count, float* dst)
 		{
-			const float f0 = *pSrc++;
-			const float f1 = *pSrc++;
-			*pDst++ = std::sqrt(f0 * f0 + f1 * f1) * m;
-		}
+			const size_t fillCount = (pos < wave.size()) ? std::min(count, wave.size() - pos) : 0;
+
+			for (size_t i = 0; i < fillCount; ++i)
+			{
+				const WaveSample& sample = wave[pos + i];
+
+				dst[i] = (sample.left + sample.right) / 2;
+			}
+
+			std::fill(dst + fillCount, dst + count, 0.0f);
+		});
+	}
+
+	void CFFT::stft(Spectrogram& result, const CompactWave& wave, const STFTDesc& desc)
+	{
+		doSTFT(result, wave.samples(), wave.samplingRate(), desc, [&wave](const size_t pos, const size_t count, float* dst)
+		{
+			wave.getMonoSamples(pos, count, dst);
+		});
+	}
+
+	void CFFT::doFFT(FFTResult& result, float* inout, const uint32 samplingRate, const FFTSampleLength sampleLength)
+	{
+		result.buffer.resize(128 << static_cast<int32>(sampleLength));
+
+		::pffft_transform_ordered(m_setups[static_cast<size_t>(sampleLength)], inout, inout, detail::GetWorkspace().workBuffer(), PFFFT_FORWARD);
+
+		detail::ToMagnitudes(inout, result.buffer.size(), result.buffer.data());
 
 		result.samplingRate = samplingRate;
 		result.resolution = static_cast<double>(samplingRate) / (256 << static_cast<int32>(sampleLength));
 	}
+
+	template <class FillFrame>
+	void CFFT::doSTFT(Spectrogram& result, const size_t length, const uint32 samplingRate, const STFTDesc& desc, FillFrame fillFrame)
+	{
+		const size_t samples = (size_t(256) << static_cast<int32>(desc.sampleLength));
+		const size_t bins = (samples / 2);
+		const uint32 hopSize = std::max(desc.hopSize, 1u);
+		const size_t num_frames = FFT::STFTFrameCount(length, hopSize);
+
+		// 同じ大きさなら確保済みのメモリを使う
+		result.magnitudes.resize(bins, num_frames);
+		result.samplingRate = samplingRate;
+		result.hopSize = hopSize;
+		result.resolution = static_cast<double>(samplingRate) / samples;
+
+		Array<float> window(samples);
+
+		detail::MakeWindow(desc.window, samples, window.data());
+
+		PFFFT_Setup* const setup = m_setups[static_cast<size_t>(desc.sampleLength)];
+		const bool applyWindow = (desc.window != FFTWindow::Rectangular);
+
+		// pffft の setup は読み取るだけなので、作業領域だけをスレッドごとに分ける
+		auto processFrames = [&](const size_t first, const size_t last)
+		{
+			detail::FFTWorkspace& workspace = detail::GetWorkspace();
+			float* const inout = workspace.inoutBuffer();
+
+			for (size_t frame = first; frame < last; ++frame)
+			{
+				fillFrame(frame * hopSize, samples, inout);
+
+				if (applyWindow)
+				{
+					for (size_t i = 0; i < samples; ++i)
+					{
+						inout[i] *= window[i];
+					}
+				}
+
+				::pffft_transform_ordered(setup, inout, inout, workspace.workBuffer(), PFFFT_FORWARD);
+
+				detail::ToMagnitudes(inout, bins, result.magnitudes[frame]);
+			}
+		};
+
+		detail::ParallelForRange(0, num_frames, processFrames, 0);
+	}
 }
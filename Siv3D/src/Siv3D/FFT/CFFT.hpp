@@ -22,11 +22,10 @@ namespace s3d
 
 		std::array<PFFFT_Setup*, 7> m_setups;
 
-		float* m_inoutBuffer = nullptr;
+		void doFFT(FFTResult& result, float* inout, uint32 samplingRate, FFTSampleLength sampleLength);
 
-		float* m_workBuffer = nullptr;
-
-		void doFFT(FFTResult& result, uint32 samplingRate, FFTSampleLength sampleLength);
+		template <class FillFrame>
+		void doSTFT(Spectrogram& result, size_t length, uint32 samplingRate, const STFTDesc& desc, FillFrame fillFrame);
 
 	public:
 
@@ -38,8 +37,16 @@ namespace s3d
 
 		void fft(FFTResult& result, const Wave& wave, uint32 pos, FFTSampleLength sampleLength) override;
 
+		void fft(FFTResult& result, const CompactWave& wave, uint32 pos, FFTSampleLength sampleLength) override;
+
 		void fft(FFTResult& result, const Array<WaveSampleS16>& wave, uint32 pos, uint32 samplingRate, FFTSampleLength sampleLength) override;
 
 		void fft(FFTResult& result, const float* input, size_t size, uint32 samplingRate, FFTSampleLength sampleLength) override;
+
+		void stft(Spectrogram& result, const float* input, size_t length, uint32 samplingRate, const STFTDesc& desc) override;
+
+		void stft(Spectrogram& result, const Wave& wave, const STFTDesc& desc) override;
+
+		void stft(Spectrogram& result, const CompactWave& wave, const STFTDesc& desc) override;
 	};
 }
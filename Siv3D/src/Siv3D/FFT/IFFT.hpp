@@ -13,6 +13,7 @@
 # include <Siv3D/Fwd.hpp>
 # include <Siv3D/Array.hpp>
 # include <Siv3D/WaveSample.hpp>
+# include <Siv3D/CompactWave.hpp>
 
 namespace s3d
 {
@@ -28,8 +29,16 @@ namespace s3d
 
 		virtual void fft(FFTResult& result, const Wave& wave, uint32 pos, FFTSampleLength sampleLength) = 0;
 
+		virtual void fft(FFTResult& result, const CompactWave& wave, uint32 pos, FFTSampleLength sampleLength) = 0;
+
 		virtual void fft(FFTResult& result, const Array<WaveSampleS16>& wave, const uint32 pos, uint32 samplingRate, FFTSampleLength sampleLength) = 0;
 
 		virtual void fft(FFTResult& result, const float* input, size_t size, uint32 samplingRate, FFTSampleLength sampleLength) = 0;
+
+		virtual void stft(Spectrogram& result, const float* input, size_t length, uint32 samplingRate, const STFTDesc& desc) = 0;
+
+		virtual void stft(Spectrogram& result, const Wave& wave, const STFTDesc& desc) = 0;
+
+		virtual void stft(Spectrogram& result, const CompactWave& wave, const STFTDesc& desc) = 0;
 	};
 }
@@ -29,7 +29,16 @@ namespace s3d
 
 			const int32 offset = static_cast<int32>(audio.samplingRate() * offsetTimeSec);
 
-			Analyze(result, audio.getWave(), Max(static_cast<int32>(audio.posSample()) + samples / 2 + offset, 0), sampleLength);
+			const uint32 pos = Max(static_cast<int32>(audio.posSample()) + samples / 2 + offset, 0);
+
+			if (const CompactWave& compact = audio.getCompactWave())
+			{
+				Analyze(result, compact, pos, sampleLength);
+			}
+			else
+			{
+				Analyze(result, audio.getWave(), pos, sampleLength);
+			}
 		}
 
 		void Analyze(FFTResult& result, const Wave& wave, const uint32 pos, const FFTSampleLength sampleLength)
@@ -37,6 +46,11 @@ namespace s3d
 			Siv3DEngine::Get<ISiv3DFFT>()->fft(result, wave, pos, sampleLength);
 		}
 
+		void Analyze(FFTResult& result, const CompactWave& wave, const uint32 pos, const FFTSampleLength sampleLength)
+		{
+			Siv3DEngine::Get<ISiv3DFFT>()->fft(result, wave, pos, sampleLength);
+		}
+
 		void Analyze(FFTResult& result, const Array<WaveSampleS16>& wave, uint32 pos, uint32 samplingRate, const FFTSampleLength sampleLength)
 		{
 			Siv3DEngine::Get<ISiv3DFFT>()->fft(result, wave, pos, samplingRate, sampleLength);
@@ -46,5 +60,32 @@ namespace s3d
 		{
 			Siv3DEngine::Get<ISiv3DFFT>()->fft(result, input, length, samplingRate, sampleLength);
 		}
+
+		void STFT(Spectrogram& result, const float* input, const size_t length, const uint32 samplingRate, const STFTDesc& desc)
+		{
+			Siv3DEngine::Get<ISiv3DFFT>()->stft(result, input, length, samplingRate, desc);
+		}
+
+		void STFT(Spectrogram& result, const Wave& wave, const STFTDesc& desc)
+		{
+			Siv3DEngine::Get<ISiv3DFFT>()->stft(result, wave, desc);
+		}
+
+		void STFT(Spectrogram& result, const CompactWave& wave, const STFTDesc& desc)
+		{
+			Siv3DEngine::Get<ISiv3DFFT>()->stft(result, wave, desc);
+		}
+
+		size_t STFTFrameCount(const size_t length, const uint32 hopSize) noexcept
+		{
+			if (length == 0)
+			{
+				return 0;
+			}
+
+			const size_t hop = Max(hopSize, 1u);
+
+			return ((length + hop - 1) / hop);
+		}
 	}
 }
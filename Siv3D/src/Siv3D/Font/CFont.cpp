@@ -336,17 +336,17 @@ namespace s3d
 		}
 	}
 
-	FontID CFont::create(const Typeface typeface, const int32 fontSize, const FontStyle style)
+	FontID CFont::create(const Typeface typeface, const int32 fontSize, const FontStyle style, const FontAtlasDesc& atlas)
 	{
-		return create(detail::GetEngineFontPath(typeface), fontSize, style);
+		return create(detail::GetEngineFontPath(typeface), fontSize, style, atlas);
 	}
 
-	FontID CFont::create(const FilePath& path, const int32 fontSize, const FontStyle style)
+	FontID CFont::create(const FilePath& path, const int32 fontSize, const FontStyle style, const FontAtlasDesc& atlas)
 	{
 		const FilePath emojiPath = detail::GetEngineFontDirectory()
 			+ detail::StandardFontNames[FromEnum(detail::StandardFont::NotoEmojiRegular)];
 
-		auto font = std::make_unique<FontData>(m_freeType, path, emojiPath, fontSize, style);
+		auto font = std::make_unique<FontData>(m_freeType, path, emojiPath, fontSize, style, atlas);
 
 		if (!font->isInitialized())
 		{
@@ -408,6 +408,11 @@ namespace s3d
 		return m_fonts[handleID]->getTexture();
 	}
 
+	FontAtlasStats CFont::getAtlasStats(const FontID handleID)
+	{
+		return m_fonts[handleID]->getAtlasStats();
+	}
+
 	RectF CFont::getBoundingRect(const FontID handleID, const String& codePoints, const double lineSpacingScale)
 	{
 		return m_fonts[handleID]->getBoundingRect(codePoints, lineSpacingScale);
@@ -52,9 +52,9 @@ namespace s3d
 
 		Optional<const FontFace&> getAwesomeIconFontFaceFotCode(uint16 code) const override;
 
-		FontID create(Typeface typeface, int32 fontSize, FontStyle style) override;
+		FontID create(Typeface typeface, int32 fontSize, FontStyle style, const FontAtlasDesc& atlas) override;
 
-		FontID create(const FilePath& path, int32 fontSize, FontStyle style) override;
+		FontID create(const FilePath& path, int32 fontSize, FontStyle style, const FontAtlasDesc& atlas) override;
 
 		void release(FontID handleID) override;
 
@@ -76,6 +76,8 @@ namespace s3d
 
 		const Texture& getTexture(FontID handleID) override;
 
+		FontAtlasStats getAtlasStats(FontID handleID) override;
+
 		RectF getBoundingRect(FontID handleID, const String& codePoints, double lineSpacingScale) override;
 
 		RectF getRegion(FontID handleID, const String& codePoints, double lineSpacingScale) override;
@@ -0,0 +1,298 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/Scene.hpp>
+# include <Siv3D/EngineLog.hpp>
+# include "FontAtlas.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		constexpr int32 MinAtlasPageSize = 256;
+
+		constexpr int32 MaxAtlasPageSize = 4096;
+	}
+
+	FontAtlas::FontAtlas(const FontAtlasDesc& desc)
+	{
+		if (desc.pageSize <= 0)
+		{
+			return;
+		}
+
+		m_pageSize = Clamp(desc.pageSize, detail::MinAtlasPageSize, detail::MaxAtlasPageSize);
+
+		m_maxPages = static_cast<size_t>(Max(desc.maxPages, 1));
+	}
+
+	FontAtlas::operator bool() const noexcept
+	{
+		return (m_pageSize != 0);
+	}
+
+	int32 FontAtlas::pageSize() const noexcept
+	{
+		return m_pageSize;
+	}
+
+	size_t FontAtlas::num_pages() const noexcept
+	{
+		return m_pages.size();
+	}
+
+	Optional<FontAtlas::Allocation> FontAtlas::allocate(const Size& size, Optional<uint32>& evictedPage)
+	{
+		evictedPage.reset();
+
+		if ((size.x > m_pageSize) || (size.y > m_pageSize))
+		{
+			return none;
+		}
+
+		Rect rect(0);
+
+		for (uint32 i = 0; i < m_pages.size(); ++i)
+		{
+			if (allocateInPage(m_pages[i], size, rect))
+			{
+				return Allocation{ i, rect };
+			}
+		}
+
+		uint32 pageIndex = static_cast<uint32>(m_pages.size());
+
+		if (m_pages.size() < m_maxPages)
+		{
+			m_pages.emplace_back();
+		}
+		else if (const auto evictable = findEvictablePage())
+		{
+			pageIndex = evictable.value();
+
+			clearPage(m_pages[pageIndex]);
+
+			evictedPage = pageIndex;
+
+			++m_numEvictions;
+		}
+		else
+		{
+			// すべてのページがこのフレームで使われているので、上限を超えてページを追加する
+			m_pages.emplace_back();
+
+			LOG_DEBUG(U"ℹ️ Font atlas exceeded the page limit ({0} pages)"_fmt(m_pages.size()));
+		}
+
+		Page& page = m_pages[pageIndex];
+
+		if (page.pixels.isEmpty())
+		{
+			page.pixels.resize(static_cast<size_t>(m_pageSize) * m_pageSize, 0);
+		}
+
+		if (!allocateInPage(page, size, rect))
+		{
+			return none;
+		}
+
+		return Allocation{ pageIndex, rect };
+	}
+
+	uint8* FontAtlas::data(const uint32 page)
+	{
+		return m_pages[page].pixels.data();
+	}
+
+	void FontAtlas::touch(const uint32 page)
+	{
+		m_pages[page].lastUsedFrame = Scene::FrameCount();
+	}
+
+	void FontAtlas::upload()
+	{
+		// 転送用の RGBA 画像。保持し続けると 1 バイトのページで減らした分を打ち消してしまうので、転送の間だけ確保する
+		Image staging;
+
+		for (auto& page : m_pages)
+		{
+			if (!page.hasDirty)
+			{
+				continue;
+			}
+
+			if (!page.texture)
+			{
+				page.texture = DynamicTexture(Size(m_pageSize, m_pageSize), ColorF(1.0, 0.0));
+
+				m_uploadedBytes += (static_cast<size_t>(m_pageSize) * m_pageSize * sizeof(Color));
+
+				LOG_DEBUG(U"ℹ️ Created font atlas page (size: {0}x{0})"_fmt(m_pageSize));
+			}
+
+			if (!staging)
+			{
+				staging.resize(m_pageSize, m_pageSize, Color(255, 0));
+			}
+
+			const Rect& dirty = page.dirty;
+
+			for (int32 y = dirty.y; y < (dirty.y + dirty.h); ++y)
+			{
+				const uint8* pSrc = page.pixels.data() + (static_cast<size_t>(y) * m_pageSize + dirty.x);
+				Color* pDst = staging[y] + dirty.x;
+
+				for (int32 x = 0; x < dirty.w; ++x)
+				{
+					pDst[x].a = pSrc[x];
+				}
+			}
+
+			page.texture.fillRegion(staging, dirty);
+
+			m_uploadedBytes += (static_cast<size_t>(dirty.area()) * sizeof(Color));
+
+			++m_numUploads;
+
+			page.hasDirty = false;
+		}
+	}
+
+	const Texture& FontAtlas::getTexture(const uint32 page) const
+	{
+		return m_pages[page].texture;
+	}
+
+	FontAtlasStats FontAtlas::getStats() const
+	{
+		FontAtlasStats stats;
+		stats.num_pages		= m_pages.size();
+		stats.uploadedBytes	= m_uploadedBytes;
+		stats.num_uploads	= m_numUploads;
+		stats.num_evictions	= m_numEvictions;
+
+		size_t usedPixels = 0;
+
+		for (const auto& page : m_pages)
+		{
+			stats.num_glyphs += page.num_glyphs;
+			stats.imageBytes += page.pixels.size_bytes();
+			usedPixels += page.usedPixels;
+		}
+
+		if (const size_t capacity = (m_pages.size() * m_pageSize * m_pageSize))
+		{
+			stats.occupancy = (static_cast<double>(usedPixels) / capacity);
+		}
+
+		return stats;
+	}
+
+	bool FontAtlas::allocateInPage(Page& page, const Size& size, Rect& rect) const
+	{
+		if (page.pixels.isEmpty())
+		{
+			return false;
+		}
+
+		// 高さが近く、空きのある棚のうち最も低いもの
+		Shelf* pShelf = nullptr;
+
+		for (auto& shelf : page.shelves)
+		{
+			if ((size.y <= shelf.height)
+				&& (shelf.height <= (size.y + size.y / 4 + 2))
+				&& ((shelf.x + size.x) <= m_pageSize)
+				&& (!pShelf || (shelf.height < pShelf->height)))
+			{
+				pShelf = &shelf;
+			}
+		}
+
+		if (!pShelf)
+		{
+			if ((page.bottom + size.y) > m_pageSize)
+			{
+				return false;
+			}
+
+			page.shelves.push_back(Shelf{ page.bottom, size.y, 0 });
+
+			page.bottom += size.y;
+
+			pShelf = &page.shelves.back();
+		}
+
+		rect.set(pShelf->x, pShelf->y, size);
+
+		pShelf->x += size.x;
+
+		page.usedPixels += rect.area();
+
+		++page.num_glyphs;
+
+		page.lastUsedFrame = Scene::FrameCount();
+
+		// パディングも含めて転送し、追い出す前のグリフが残らないようにする
+		if (page.hasDirty)
+		{
+			const Rect& dirty = page.dirty;
+			const int32 left	= Min(dirty.x, rect.x);
+			const int32 top		= Min(dirty.y, rect.y);
+			const int32 right	= Max(dirty.x + dirty.w, rect.x + rect.w);
+			const int32 bottom	= Max(dirty.y + dirty.h, rect.y + rect.h);
+
+			page.dirty.set(left, top, (right - left), (bottom - top));
+		}
+		else
+		{
+			page.dirty = rect;
+			page.hasDirty = true;
+		}
+
+		return true;
+	}
+
+	void FontAtlas::clearPage(Page& page)
+	{
+		std::fill(page.pixels.begin(), page.pixels.end(), uint8(0));
+
+		page.shelves.clear();
+		page.bottom		= 0;
+		page.usedPixels	= 0;
+		page.num_glyphs	= 0;
+		page.hasDirty	= false;
+	}
+
+	Optional<uint32> FontAtlas::findEvictablePage() const
+	{
+		const int32 currentFrame = Scene::FrameCount();
+
+		Optional<uint32> result;
+
+		for (uint32 i = 0; i < m_pages.size(); ++i)
+		{
+			const int32 lastUsedFrame = m_pages[i].lastUsedFrame;
+
+			if (lastUsedFrame == currentFrame)
+			{
+				continue;
+			}
+
+			if (!result || (lastUsedFrame < m_pages[result.value()].lastUsedFrame))
+			{
+				result = i;
+			}
+		}
+
+		return result;
+	}
+}
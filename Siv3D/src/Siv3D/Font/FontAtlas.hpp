@@ -0,0 +1,127 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/Fwd.hpp>
+# include <Siv3D/Array.hpp>
+# include <Siv3D/Image.hpp>
+# include <Siv3D/Font.hpp>
+# include <Siv3D/DynamicTexture.hpp>
+
+namespace s3d
+{
+	/// <summary>
+	/// グリフを書き込む、固定サイズのページの集まり
+	/// </summary>
+	/// <remarks>
+	/// グリフの画像は 1 ピクセル 1 バイト（カバレッジのみ）で保持し、テクスチャへの転送時に RGBA に展開する。
+	/// ページ内は棚（高さの近いグリフを横に並べる行）で詰める。
+	/// ページを使い切ると、最も長い間使われていないページを空にして再利用する。
+	/// </remarks>
+	class FontAtlas
+	{
+	public:
+
+		struct Allocation
+		{
+			uint32 page = 0;
+
+			Rect rect{ 0 };
+		};
+
+	private:
+
+		struct Shelf
+		{
+			int32 y = 0;
+
+			int32 height = 0;
+
+			int32 x = 0;
+		};
+
+		struct Page
+		{
+			Array<uint8> pixels;
+
+			Array<Shelf> shelves;
+
+			int32 bottom = 0;
+
+			size_t usedPixels = 0;
+
+			size_t num_glyphs = 0;
+
+			// 最後に使われたフレーム
+			int32 lastUsedFrame = 0;
+
+			Rect dirty{ 0 };
+
+			bool hasDirty = false;
+
+			DynamicTexture texture;
+		};
+
+		int32 m_pageSize = 0;
+
+		size_t m_maxPages = 0;
+
+		Array<Page> m_pages;
+
+		size_t m_uploadedBytes = 0;
+
+		size_t m_numUploads = 0;
+
+		size_t m_numEvictions = 0;
+
+		bool allocateInPage(Page& page, const Size& size, Rect& rect) const;
+
+		void clearPage(Page& page);
+
+		Optional<uint32> findEvictablePage() const;
+
+	public:
+
+		FontAtlas() = default;
+
+		explicit FontAtlas(const FontAtlasDesc& desc);
+
+		[[nodiscard]] explicit operator bool() const noexcept;
+
+		[[nodiscard]] int32 pageSize() const noexcept;
+
+		[[nodiscard]] size_t num_pages() const noexcept;
+
+		/// <summary>
+		/// size の大きさの領域を確保します。確保した領域は 0 で埋められています。
+		/// </summary>
+		/// <param name="evictedPage">
+		/// 空にして再利用したページがあれば、その番号
+		/// </param>
+		[[nodiscard]] Optional<Allocation> allocate(const Size& size, Optional<uint32>& evictedPage);
+
+		[[nodiscard]] uint8* data(uint32 page);
+
+		/// <summary>
+		/// ページが現在のフレームで使われたことを記録します。現在のフレームで使われたページは空にされません。
+		/// </summary>
+		void touch(uint32 page);
+
+		/// <summary>
+		/// 前回の転送以降に書き込まれた領域をテクスチャに転送します。
+		/// </summary>
+		void upload();
+
+		[[nodiscard]] const Texture& getTexture(uint32 page) const;
+
+		[[nodiscard]] FontAtlasStats getStats() const;
+	};
+}
@@ -19,6 +19,8 @@
 # include <Siv3D/TextureRegion.hpp>
 # include <Siv3D/BinaryReader.hpp>
 # include <Siv3D/EngineLog.hpp>
+# include <Siv3DEngine.hpp>
+# include <Renderer2D/IRenderer2D.hpp>
 
 namespace s3d
 {
@@ -92,7 +94,8 @@ namespace s3d
 		m_initialized = true;
 	}
 
-	FontData::FontData(const FT_Library library, const FilePath& filePath, const FilePath& emojiFilePath, const int32 fontSize, const FontStyle style)
+	FontData::FontData(const FT_Library library, const FilePath& filePath, const FilePath& emojiFilePath, const int32 fontSize, const FontStyle style, const FontAtlasDesc& atlas)
+		: m_atlas(atlas)
 	{
 		if (!InRange(fontSize, 1, Font::MaxSize))
 		{
@@ -273,7 +276,7 @@ namespace s3d
 			{
 				const char32VH indexVH = codePoint | Horizontal;
 				const auto& glyphInfo	= m_glyphs[m_glyphVHIndexTable[indexVH]];
-				glyph.texture			= m_texture(glyphInfo.bitmapRect);
+				glyph.texture			= getGlyphTexture(glyphInfo);
 				glyph.offset			= glyphInfo.offset;
 				glyph.bearingY			= glyphInfo.bearingY;
 				glyph.xAdvance			= glyphInfo.xAdvance;
@@ -322,7 +325,7 @@ namespace s3d
 			{
 				const char32VH indexVH = codePoint | Vertical;
 				const auto& glyphInfo = m_glyphs[m_glyphVHIndexTable[indexVH]];
-				glyph.texture = m_texture(glyphInfo.bitmapRect);
+				glyph.texture = getGlyphTexture(glyphInfo);
 				glyph.offset = glyphInfo.offset;
 				glyph.bearingY = glyphInfo.bearingY;
 				glyph.xAdvance = glyphInfo.xAdvance;
@@ -391,9 +394,36 @@ namespace s3d
 	{
 		renderIfDirty();
 
+		if (m_atlas && m_atlas.num_pages())
+		{
+			return m_atlas.getTexture(0);
+		}
+
 		return m_texture;
 	}
 
+	FontAtlasStats FontData::getAtlasStats() const
+	{
+		if (m_atlas)
+		{
+			return m_atlas.getStats();
+		}
+
+		FontAtlasStats stats;
+		stats.num_pages		= (m_texture ? 1 : 0);
+		stats.num_glyphs	= (m_glyphs.size() - m_freeGlyphIndices.size());
+		stats.imageBytes	= m_image.size_bytes();
+		stats.uploadedBytes	= m_uploadedBytes;
+		stats.num_uploads	= m_numUploads;
+
+		if (m_image)
+		{
+			stats.occupancy = (static_cast<double>(m_usedPixels) / m_image.num_pixels());
+		}
+
+		return stats;
+	}
+
 	RectF FontData::getBoundingRect(const String& codePoints, const double lineSpacingScale)
 	{
 		if (!render(codePoints))
@@ -444,6 +474,11 @@ namespace s3d
 
 	RectF FontData::getRegion(const String& codePoints, const double lineSpacingScale)
 	{
+		if (const TextLayout* layout = m_layoutCache.find(codePoints, lineSpacingScale))
+		{
+			return layout->region;
+		}
+
 		if (!render(codePoints))
 		{
 			return RectF(0);
@@ -529,6 +564,11 @@ namespace s3d
 
 	RectF FontData::draw(const String& codePoints, const Vec2& pos, const ColorF& color, double lineSpacingScale)
 	{
+		if (const TextLayout* layout = getLayout(codePoints, lineSpacingScale))
+		{
+			return drawLayout(*layout, pos, color);
+		}
+
 		if (!render(codePoints))
 		{
 			return RectF(pos, 0);
@@ -564,7 +604,7 @@ namespace s3d
 
 				const char32VH indexVH = codePoint | Horizontal;
 				const auto& glyphInfo = m_glyphs[m_glyphVHIndexTable[indexVH]];
-				const RectF region = m_texture(glyphInfo.bitmapRect).draw(penPos + glyphInfo.offset, color);
+				const RectF region = getGlyphTexture(glyphInfo).draw(penPos + glyphInfo.offset, color);
 				const int32 characterWidth = glyphInfo.xAdvance;
 				maxPosX = std::max(maxPosX, region.x + characterWidth);
 				penPos.x += glyphInfo.xAdvance;
@@ -763,7 +803,7 @@ namespace s3d
 
 				const char32VH indexVH = codePoint | Horizontal;
 				const auto& glyphInfo = m_glyphs[m_glyphVHIndexTable[indexVH]];
-				m_texture(glyphInfo.bitmapRect).draw(penPos + glyphInfo.offset, color);
+				getGlyphTexture(glyphInfo).draw(penPos + glyphInfo.offset, color);
 				penPos.x += glyphInfo.xAdvance;
 			}
 		}
@@ -948,8 +988,10 @@ namespace s3d
 		{
 			const char32VH indexVH = codePoint | Horizontal;
 
-			if (m_glyphVHIndexTable.find(indexVH) != m_glyphVHIndexTable.end())
+			if (const auto it = m_glyphVHIndexTable.find(indexVH); it != m_glyphVHIndexTable.end())
 			{
+				touchGlyph(it->second);
+
 				continue;
 			}
 
@@ -967,10 +1009,12 @@ namespace s3d
 
 					m_hasDirty = true;
 
-					m_tofuIndex = static_cast<CommonGlyphIndex>(m_glyphs.size() - 1);
+					m_tofuIndex = m_lastGlyphIndex;
 				}
 
 				m_glyphVHIndexTable.emplace(indexVH, m_tofuIndex.value());
+
+				touchGlyph(m_tofuIndex.value());
 			}
 			else
 			{
@@ -981,7 +1025,7 @@ namespace s3d
 
 				m_hasDirty = true;
 
-				m_glyphVHIndexTable.emplace(indexVH, static_cast<uint32>(m_glyphs.size() - 1));
+				m_glyphVHIndexTable.emplace(indexVH, m_lastGlyphIndex);
 			}
 		}
 
@@ -1004,8 +1048,10 @@ namespace s3d
 		{
 			const char32VH indexVH = codePoint | Vertical;
 
-			if (m_glyphVHIndexTable.find(indexVH) != m_glyphVHIndexTable.end())
+			if (const auto it = m_glyphVHIndexTable.find(indexVH); it != m_glyphVHIndexTable.end())
 			{
+				touchGlyph(it->second);
+
 				continue;
 			}
 
@@ -1024,10 +1070,12 @@ namespace s3d
 
 					m_hasDirty = true;
 
-					m_tofuIndex = static_cast<CommonGlyphIndex>(m_glyphs.size() - 1);
+					m_tofuIndex = m_lastGlyphIndex;
 				}
 
 				m_glyphVHIndexTable.emplace(indexVH, m_tofuIndex.value());
+
+				touchGlyph(m_tofuIndex.value());
 			}
 			else if (isEmoji)
 			{
@@ -1039,7 +1087,7 @@ namespace s3d
 
 					m_hasDirty = true;
 
-					const CommonGlyphIndex index = static_cast<uint32>(m_glyphs.size() - 1);
+					const CommonGlyphIndex index = m_lastGlyphIndex;
 
 					m_glyphVHIndexTable.emplace(codePoint | Horizontal, index);
 					m_glyphVHIndexTable.emplace(codePoint | Vertical, index);
@@ -1048,6 +1096,8 @@ namespace s3d
 				{
 					const CommonGlyphIndex index = it->second;
 					m_glyphVHIndexTable.emplace(codePoint | Vertical, index);
+
+					touchGlyph(index);
 				}
 			}
 			else
@@ -1061,7 +1111,7 @@ namespace s3d
 
 					m_hasDirty = true;
 
-					const CommonGlyphIndex index = static_cast<uint32>(m_glyphs.size() - 1);
+					const CommonGlyphIndex index = m_lastGlyphIndex;
 
 					m_glyphVHIndexTable.emplace(codePoint | Vertical, index);
 				}
@@ -1075,7 +1125,7 @@ namespace s3d
 
 						m_hasDirty = true;
 
-						const CommonGlyphIndex index = static_cast<uint32>(m_glyphs.size() - 1);
+						const CommonGlyphIndex index = m_lastGlyphIndex;
 
 						m_glyphVHIndexTable.emplace(codePoint | Horizontal, index);
 						m_glyphVHIndexTable.emplace(codePoint | Vertical, index);
@@ -1084,6 +1134,8 @@ namespace s3d
 					{
 						const CommonGlyphIndex index = it->second;
 						m_glyphVHIndexTable.emplace(codePoint | Vertical, index);
+
+						touchGlyph(index);
 					}
 				}
 			}
@@ -1124,6 +1176,81 @@ namespace s3d
 			isBitmap = true;
 		}
 
+		const int32 bitmapWidth = slot->bitmap.width;
+		const int32 bitmapHeight = slot->bitmap.rows;
+		const int32 bitmapStride = slot->bitmap.pitch;
+		const uint8* bitmapBuffer = slot->bitmap.buffer;
+
+		GlyphInfo info;
+		info.offset.set(slot->bitmap_left, m_ascender - slot->bitmap_top);
+		info.bearingY = static_cast<int32>(slot->bitmap_top);
+		info.xAdvance = static_cast<int32>(slot->metrics.horiAdvance / 64);
+		info.yAdvance = static_cast<int32>(slot->metrics.vertAdvance / 64);
+
+		const auto copyBitmap = [&](auto setPixel)
+		{
+			if (isBitmap)
+			{
+				const uint8* pSrcLine = bitmapBuffer;
+
+				for (int32 y = 0; y < bitmapHeight; ++y)
+				{
+					for (int32 x = 0; x < bitmapWidth; ++x)
+					{
+						const uint32 offsetI = x / 8;
+						const uint32 offsetB = 7 - x % 8;
+
+						setPixel(x, y, ((pSrcLine[offsetI] >> offsetB) & 0x1) ? 255 : 0);
+					}
+
+					pSrcLine += bitmapStride;
+				}
+			}
+			else
+			{
+				for (int32 y = 0; y < bitmapHeight; ++y)
+				{
+					for (int32 x = 0; x < bitmapWidth; ++x)
+					{
+						setPixel(x, y, bitmapBuffer[y * bitmapWidth + x]);
+					}
+				}
+			}
+		};
+
+		if (m_atlas)
+		{
+			Optional<uint32> evictedPage;
+
+			const auto allocation = m_atlas.allocate(Size(bitmapWidth + padding * 2, bitmapHeight + padding * 2), evictedPage);
+
+			if (evictedPage)
+			{
+				evictPage(evictedPage.value());
+			}
+
+			if (!allocation)
+			{
+				return false;
+			}
+
+			const Point pos = allocation->rect.pos + Point(padding, padding);
+			const size_t pageSize = m_atlas.pageSize();
+			uint8* const pDst = m_atlas.data(allocation->page);
+
+			info.page = allocation->page;
+			info.bitmapRect.set(pos, bitmapWidth, bitmapHeight);
+
+			copyBitmap([=](const int32 x, const int32 y, const uint8 value)
+			{
+				pDst[(pos.y + y) * pageSize + (pos.x + x)] = value;
+			});
+
+			storeGlyph(info);
+
+			return true;
+		}
+
 		if (!m_image)
 		{
 			const int32 baseWidth =
@@ -1136,10 +1263,6 @@ namespace s3d
 		}
 
 		m_penPos.x += padding;
-	
-		const int32 bitmapWidth = slot->bitmap.width;
-		const int32 bitmapHeight = slot->bitmap.rows;
-		const int32 bitmapStride = slot->bitmap.pitch;
 
 		if (m_penPos.x + (bitmapWidth + padding) > m_image.width())
 		{
@@ -1162,48 +1285,221 @@ namespace s3d
 			m_image.resizeRows(newHeight, Color(255, 0));
 		}
 
-		GlyphInfo info;
 		info.bitmapRect.set(m_penPos, bitmapWidth, bitmapHeight);
-		info.offset.set(slot->bitmap_left, m_ascender - slot->bitmap_top);
-		info.bearingY = static_cast<int32>(slot->bitmap_top);
-		info.xAdvance = static_cast<int32>(slot->metrics.horiAdvance / 64);
-		info.yAdvance = static_cast<int32>(slot->metrics.vertAdvance / 64);
 
-		const uint8* bitmapBuffer = slot->bitmap.buffer;
+		copyBitmap([this](const int32 x, const int32 y, const uint8 value)
+		{
+			m_image[m_penPos.y + y][m_penPos.x + x] = Color(255, value);
+		});
 
-		if (isBitmap)
+		m_penPos.x += bitmapWidth + padding;
+
+		m_usedPixels += static_cast<size_t>(bitmapWidth + padding * 2) * (bitmapHeight + padding * 2);
+
+		storeGlyph(info);
+
+		return true;
+	}
+
+	void FontData::storeGlyph(const GlyphInfo& info)
+	{
+		// 追い出されたグリフの番号があれば再利用する
+		if (m_freeGlyphIndices)
 		{
-			const uint8* pSrcLine = bitmapBuffer;
+			m_lastGlyphIndex = m_freeGlyphIndices.back();
 
-			for (int32 y = 0; y < bitmapHeight; ++y)
+			m_freeGlyphIndices.pop_back();
+
+			m_glyphs[m_lastGlyphIndex] = info;
+		}
+		else
+		{
+			m_lastGlyphIndex = static_cast<CommonGlyphIndex>(m_glyphs.size());
+
+			m_glyphs.push_back(info);
+		}
+	}
+
+	void FontData::touchGlyph(const CommonGlyphIndex index)
+	{
+		if (!m_atlas)
+		{
+			return;
+		}
+
+		if (const uint32 page = m_glyphs[index].page; page != InvalidPage)
+		{
+			m_atlas.touch(page);
+		}
+	}
+
+	void FontData::evictPage(const uint32 page)
+	{
+		for (auto it = m_glyphVHIndexTable.begin(); it != m_glyphVHIndexTable.end();)
+		{
+			if (m_glyphs[it->second].page == page)
 			{
-				for (int32 x = 0; x < bitmapWidth; ++x)
-				{
-					const uint32 offsetI = x / 8;
-					const uint32 offsetB = 7 - x % 8;
+				it = m_glyphVHIndexTable.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
 
-					m_image[m_penPos.y + y][m_penPos.x + x] = Color(255, ((pSrcLine[offsetI] >> offsetB) & 0x1) ? 255: 0);
-				}
+		// 配置のキャッシュはグリフの位置を含むので、すべて作り直す
+		m_layoutCache.clear();
 
-				pSrcLine += bitmapStride;
+		if (m_tofuIndex && (m_glyphs[m_tofuIndex.value()].page == page))
+		{
+			m_tofuIndex.reset();
+		}
+
+		for (CommonGlyphIndex i = 0; i < m_glyphs.size(); ++i)
+		{
+			if (m_glyphs[i].page == page)
+			{
+				m_glyphs[i].page = InvalidPage;
+
+				m_freeGlyphIndices << i;
 			}
 		}
-		else
+	}
+
+	TextureRegion FontData::getGlyphTexture(const GlyphInfo& info) const
+	{
+		if (m_atlas && (info.page != InvalidPage))
 		{
-			for (int32 y = 0; y < bitmapHeight; ++y)
+			return m_atlas.getTexture(info.page)(info.bitmapRect);
+		}
+
+		return m_texture(info.bitmapRect);
+	}
+
+	const TextLayout* FontData::getLayout(const String& codePoints, const double lineSpacingScale)
+	{
+		if (const TextLayout* layout = m_layoutCache.find(codePoints, lineSpacingScale))
+		{
+			if (m_atlas)
 			{
-				for (int32 x = 0; x < bitmapWidth; ++x)
+				for (const auto page : layout->pages)
 				{
-					m_image[m_penPos.y + y][m_penPos.x + x] = Color(255, bitmapBuffer[y * bitmapWidth + x]);
+					m_atlas.touch(page);
 				}
 			}
+
+			return layout;
 		}
 
-		m_penPos.x += bitmapWidth + padding;
+		if (codePoints.size() > TextLayoutCache::MaxTextLength)
+		{
+			return nullptr;
+		}
 
-		m_glyphs.push_back(info);
+		if (!render(codePoints))
+		{
+			return nullptr;
+		}
 
-		return true;
+		renderIfDirty();
+
+		return &m_layoutCache.insert(buildLayout(codePoints, lineSpacingScale));
+	}
+
+	TextLayout FontData::buildLayout(const String& codePoints, const double lineSpacingScale)
+	{
+		TextLayout layout;
+		layout.text = codePoints;
+		layout.lineSpacingScale = lineSpacingScale;
+		layout.rects.reserve(codePoints.size());
+		layout.uvs.reserve(codePoints.size());
+
+		Vec2 penPos(0, 0);
+		double maxDrawX = DBL_MIN;
+		double maxRegionX = DBL_MIN;
+		bool hasRegion = false;
+		int32 lineCount = 0;
+
+		// draw() と getRegion() と同じ計算をして、両方の結果を記録する
+		for (const auto codePoint : codePoints)
+		{
+			if (codePoint == U'\n')
+			{
+				penPos.x = 0;
+				penPos.y += m_lineSpacing * lineSpacingScale;
+				++lineCount;
+			}
+			else if (codePoint == U'\t')
+			{
+				maxDrawX = std::max(maxDrawX, penPos.x + m_tabWidth);
+				maxRegionX = std::max(maxRegionX, penPos.x + m_tabWidth);
+				hasRegion = true;
+				penPos.x += m_tabWidth;
+			}
+			else if (!IsControl(codePoint))
+			{
+				if (lineCount == 0)
+				{
+					++lineCount;
+				}
+
+				const char32VH indexVH = codePoint | Horizontal;
+				const auto& glyphInfo = m_glyphs[m_glyphVHIndexTable[indexVH]];
+				const TextureRegion textureRegion = getGlyphTexture(glyphInfo);
+				const FloatRect& uv = textureRegion.uvRect;
+
+				if (!layout.runs || (layout.runs.back().texture.id() != textureRegion.texture.id()))
+				{
+					layout.runs.push_back(TextLayout::Run{ textureRegion.texture, layout.rects.size(), 0 });
+				}
+
+				++layout.runs.back().count;
+
+				layout.rects.emplace_back(penPos + glyphInfo.offset, textureRegion.size);
+				layout.uvs.emplace_back(uv.left, uv.top, (uv.right - uv.left), (uv.bottom - uv.top));
+
+				if (m_atlas && (glyphInfo.page != InvalidPage) && !layout.pages.includes(glyphInfo.page))
+				{
+					layout.pages << glyphInfo.page;
+				}
+
+				maxDrawX = std::max(maxDrawX, layout.rects.back().x + glyphInfo.xAdvance);
+				maxRegionX = std::max(maxRegionX, penPos.x + glyphInfo.xAdvance);
+				hasRegion = true;
+				penPos.x += glyphInfo.xAdvance;
+			}
+		}
+
+		if (lineCount)
+		{
+			layout.drawRegion.set(0, 0, maxDrawX, lineCount * m_lineSpacing * lineSpacingScale);
+		}
+
+		if (hasRegion)
+		{
+			layout.region.set(0, 0, maxRegionX, lineCount * m_lineSpacing * lineSpacingScale);
+		}
+
+		return layout;
+	}
+
+	RectF FontData::drawLayout(const TextLayout& layout, const Vec2& pos, const ColorF& color)
+	{
+		m_layoutRects.resize(layout.rects.size());
+
+		for (size_t i = 0; i < layout.rects.size(); ++i)
+		{
+			m_layoutRects[i] = layout.rects[i].movedBy(pos);
+		}
+
+		const auto pRenderer = Siv3DEngine::Get<ISiv3DRenderer2D>();
+
+		for (const auto& run : layout.runs)
+		{
+			pRenderer->addTextureRegions(run.texture, m_layoutRects.data() + run.offset, layout.uvs.data() + run.offset, run.count, &color, 0);
+		}
+
+		return layout.drawRegion.movedBy(pos);
 	}
 
 	void FontData::paintGlyph(FT_Face face, FT_UInt glyphIndex, Image& image, Image& tmpImage, const bool overwrite, const Point& penPos, const Color& color, int32& width, int32& xAdvance) const
@@ -1301,6 +1597,19 @@ namespace s3d
 			return;
 		}
 
+		if (m_atlas)
+		{
+			m_atlas.upload();
+
+			m_hasDirty = false;
+
+			return;
+		}
+
+		m_uploadedBytes += m_image.size_bytes();
+
+		++m_numUploads;
+
 		if (m_image.size() == m_texture.size())
 		{
 			m_texture.fill(m_image);
@@ -1313,6 +1622,8 @@ namespace s3d
 
 			m_texture = DynamicTexture(m_image);
 
+			m_layoutCache.clear();
+
 			if (hasTexture)
 			{
 				LOG_DEBUG(U"ℹ️ Font texture resized ({0}x{1} -> {2}x{3})"_fmt(previousSize.x, previousSize.y, newSize.x, newSize.y));
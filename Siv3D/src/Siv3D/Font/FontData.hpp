@@ -23,6 +23,8 @@
 # include <Siv3D/ByteArray.hpp>
 # include <Siv3D/DynamicTexture.hpp>
 # include "FontFace.hpp"
+# include "FontAtlas.hpp"
+# include "TextLayoutCache.hpp"
 
 # if SIV3D_PLATFORM(WINDOWS)
 
@@ -95,6 +97,9 @@ namespace s3d
 		int32 yAdvance = 0;
 
 		int32 width = 0;
+
+		// FontAtlas のページ
+		uint32 page = 0;
 	};
 
 	class FontData
@@ -109,6 +114,9 @@ namespace s3d
 
 		using CommonGlyphIndex = uint32;
 
+		// 追い出されて空いている GlyphInfo
+		static constexpr uint32 InvalidPage = Largest<uint32>;
+
 	# if SIV3D_PLATFORM(WINDOWS)
 
 		FontResourceHolder m_resource;
@@ -127,6 +135,11 @@ namespace s3d
 
 		Array<GlyphInfo> m_glyphs;
 
+		// 最後に renderGlyph() で書き込んだグリフ
+		CommonGlyphIndex m_lastGlyphIndex = 0;
+
+		Array<CommonGlyphIndex> m_freeGlyphIndices;
+
 		Optional<CommonGlyphIndex> m_tofuIndex;
 
 		static constexpr int32 padding = 2;
@@ -159,6 +172,21 @@ namespace s3d
 
 		DynamicTexture m_texture;
 
+		// ページを使う場合のアトラス。使わない場合は m_image と m_texture を拡張していく
+		FontAtlas m_atlas;
+
+		// 同じ文字列を繰り返し描くときのための、グリフの配置のキャッシュ
+		TextLayoutCache m_layoutCache;
+
+		// drawLayout() で使う作業領域
+		Array<RectF> m_layoutRects;
+
+		size_t m_usedPixels = 0;
+
+		size_t m_uploadedBytes = 0;
+
+		size_t m_numUploads = 0;
+
 		bool m_initialized = false;
 
 		void generateVerticalTable();
@@ -169,6 +197,20 @@ namespace s3d
 
 		bool renderGlyph(FT_Face face, FT_UInt glyphIndex);
 
+		void storeGlyph(const GlyphInfo& info);
+
+		void touchGlyph(CommonGlyphIndex index);
+
+		void evictPage(uint32 page);
+
+		TextureRegion getGlyphTexture(const GlyphInfo& info) const;
+
+		const TextLayout* getLayout(const String& codePoints, double lineSpacingScale);
+
+		TextLayout buildLayout(const String& codePoints, double lineSpacingScale);
+
+		RectF drawLayout(const TextLayout& layout, const Vec2& pos, const ColorF& color);
+
 		void paintGlyph(FT_Face face, FT_UInt glyphIndex, Image& image, Image& tmpImage, bool overwrite, const Point& penPos, const Color& color, int32& width, int32& xAdvance) const;
 
 		void renderIfDirty();
@@ -181,7 +223,7 @@ namespace s3d
 
 		FontData(Null, FT_Library library);
 
-		FontData(FT_Library library, const FilePath& filePath, const FilePath& emojiFilePath, const int32 fontSize, FontStyle style);
+		FontData(FT_Library library, const FilePath& filePath, const FilePath& emojiFilePath, const int32 fontSize, FontStyle style, const FontAtlasDesc& atlas);
 
 		~FontData();
 
@@ -205,6 +247,8 @@ namespace s3d
 
 		const Texture& getTexture();
 
+		FontAtlasStats getAtlasStats() const;
+
 		RectF getBoundingRect(const String& codePoints, double lineSpacingScale);
 
 		RectF getRegion(const String& codePoints, double lineSpacingScale);
@@ -35,9 +35,9 @@ namespace s3d
 
 		virtual Optional<const FontFace&> getAwesomeIconFontFaceFotCode(uint16 code) const = 0;
 
-		virtual FontID create(Typeface typeface, int32 fontSize, FontStyle style) = 0;
+		virtual FontID create(Typeface typeface, int32 fontSize, FontStyle style, const FontAtlasDesc& atlas) = 0;
 
-		virtual FontID create(const FilePath& path, int32 fontSize, FontStyle style) = 0;
+		virtual FontID create(const FilePath& path, int32 fontSize, FontStyle style, const FontAtlasDesc& atlas) = 0;
 
 		virtual void release(FontID handleID) = 0;
 
@@ -59,6 +59,8 @@ namespace s3d
 
 		virtual const Texture& getTexture(FontID handleID) = 0;
 
+		virtual FontAtlasStats getAtlasStats(FontID handleID) = 0;
+
 		virtual RectF getBoundingRect(FontID handleID, const String& codePoints, double lineSpacingScale) = 0;
 
 		virtual RectF getRegion(FontID handleID, const String& codePoints, double lineSpacingScale) = 0;
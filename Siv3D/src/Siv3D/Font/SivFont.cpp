@@ -59,13 +59,25 @@ namespace s3d
 	}
 
 	Font::Font(const int32 fontSize, const Typeface typeface, const FontStyle style)
-		: m_handle(std::make_shared<FontHandle>(Siv3DEngine::Get<ISiv3DFont>()->create(typeface, fontSize, style)))
+		: m_handle(std::make_shared<FontHandle>(Siv3DEngine::Get<ISiv3DFont>()->create(typeface, fontSize, style, FontAtlasDesc())))
 	{
 		ReportAssetCreation();
 	}
 
 	Font::Font(const int32 fontSize, const FilePath& path, const FontStyle style)
-		: m_handle(std::make_shared<FontHandle>(Siv3DEngine::Get<ISiv3DFont>()->create(path, fontSize, style)))
+		: m_handle(std::make_shared<FontHandle>(Siv3DEngine::Get<ISiv3DFont>()->create(path, fontSize, style, FontAtlasDesc())))
+	{
+		ReportAssetCreation();
+	}
+
+	Font::Font(const int32 fontSize, const Typeface typeface, const FontStyle style, const FontAtlasDesc& atlas)
+		: m_handle(std::make_shared<FontHandle>(Siv3DEngine::Get<ISiv3DFont>()->create(typeface, fontSize, style, atlas)))
+	{
+		ReportAssetCreation();
+	}
+
+	Font::Font(const int32 fontSize, const FilePath& path, const FontStyle style, const FontAtlasDesc& atlas)
+		: m_handle(std::make_shared<FontHandle>(Siv3DEngine::Get<ISiv3DFont>()->create(path, fontSize, style, atlas)))
 	{
 		ReportAssetCreation();
 	}
@@ -170,6 +182,11 @@ namespace s3d
 		return Siv3DEngine::Get<ISiv3DFont>()->getTexture(m_handle->id());
 	}
 
+	FontAtlasStats Font::getAtlasStats() const
+	{
+		return Siv3DEngine::Get<ISiv3DFont>()->getAtlasStats(m_handle->id());
+	}
+
 
 	GlyphIterator::GlyphIterator(const Font& font, String::const_iterator it, int32 index)
 		: m_font(font)
@@ -0,0 +1,109 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/Hash.hpp>
+# include "TextLayoutCache.hpp"
+
+namespace s3d
+{
+	uint64 TextLayoutCache::MakeKey(const String& text, const double lineSpacingScale) noexcept
+	{
+		const uint64 textHash = Hash::FNV1a(text.data(), text.size_bytes());
+
+		const uint64 scaleHash = Hash::FNV1a(&lineSpacingScale, sizeof(lineSpacingScale));
+
+		return (textHash ^ (scaleHash + 0x9e3779b97f4a7c15 + (textHash << 6) + (textHash >> 2)));
+	}
+
+	TextLayout* TextLayoutCache::find(const String& text, const double lineSpacingScale)
+	{
+		const auto it = m_layouts.find(MakeKey(text, lineSpacingScale));
+
+		if (it == m_layouts.end())
+		{
+			return nullptr;
+		}
+
+		TextLayout& layout = it.value();
+
+		// ハッシュ値の衝突
+		if ((layout.lineSpacingScale != lineSpacingScale) || (layout.text != text))
+		{
+			return nullptr;
+		}
+
+		layout.lastUsed = ++m_clock;
+
+		return &layout;
+	}
+
+	const TextLayout& TextLayoutCache::insert(TextLayout&& layout)
+	{
+		if ((m_layouts.size() >= MaxLayouts) || (m_numQuads >= MaxQuads))
+		{
+			trim();
+		}
+
+		TextLayout& stored = m_layouts[MakeKey(layout.text, layout.lineSpacingScale)];
+
+		// キーが衝突した古い配置は上書きする
+		m_numQuads -= stored.rects.size();
+		m_numQuads += layout.rects.size();
+
+		stored = std::move(layout);
+		stored.lastUsed = ++m_clock;
+
+		return stored;
+	}
+
+	void TextLayoutCache::clear()
+	{
+		m_layouts.clear();
+
+		m_numQuads = 0;
+	}
+
+	size_t TextLayoutCache::size() const noexcept
+	{
+		return m_layouts.size();
+	}
+
+	void TextLayoutCache::trim()
+	{
+		Array<uint64> lastUsed;
+		lastUsed.reserve(m_layouts.size());
+
+		for (const auto& layout : m_layouts)
+		{
+			lastUsed << layout.second.lastUsed;
+		}
+
+		const auto middle = lastUsed.begin() + (lastUsed.size() / 2);
+
+		std::nth_element(lastUsed.begin(), middle, lastUsed.end());
+
+		const uint64 threshold = *middle;
+
+		for (auto it = m_layouts.begin(); it != m_layouts.end();)
+		{
+			if (it->second.lastUsed < threshold)
+			{
+				m_numQuads -= it->second.rects.size();
+
+				it = m_layouts.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+	}
+}
@@ -0,0 +1,100 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/Fwd.hpp>
+# include <Siv3D/Array.hpp>
+# include <Siv3D/String.hpp>
+# include <Siv3D/Rectangle.hpp>
+# include <Siv3D/Texture.hpp>
+# include <Siv3D/HashTable.hpp>
+
+namespace s3d
+{
+	/// <summary>
+	/// 位置 (0, 0) に描いたときの文字列のグリフの配置
+	/// </summary>
+	struct TextLayout
+	{
+		// 同じテクスチャを使う、連続したグリフの範囲
+		struct Run
+		{
+			Texture texture;
+
+			size_t offset = 0;
+
+			size_t count = 0;
+		};
+
+		String text;
+
+		double lineSpacingScale = 1.0;
+
+		Array<Run> runs;
+
+		Array<RectF> rects;
+
+		Array<RectF> uvs;
+
+		// グリフが書き込まれている FontAtlas のページ
+		Array<uint32> pages;
+
+		// FontData::draw() が返す領域
+		RectF drawRegion{ 0 };
+
+		// FontData::getRegion() が返す領域
+		RectF region{ 0 };
+
+		uint64 lastUsed = 0;
+	};
+
+	/// <summary>
+	/// 文字列と行間の倍率をキーにした TextLayout のキャッシュ
+	/// </summary>
+	/// <remarks>
+	/// 上限を超えると、最も長い間使われていない半分を捨てる。
+	/// グリフの位置やテクスチャが変わったときは clear() で全て捨てる。
+	/// </remarks>
+	class TextLayoutCache
+	{
+	private:
+
+		HashTable<uint64, TextLayout> m_layouts;
+
+		size_t m_numQuads = 0;
+
+		uint64 m_clock = 0;
+
+		static uint64 MakeKey(const String& text, double lineSpacingScale) noexcept;
+
+		void trim();
+
+	public:
+
+		// これより長い文字列はキャッシュしない
+		static constexpr size_t MaxTextLength = 256;
+
+		static constexpr size_t MaxLayouts = 8192;
+
+		static constexpr size_t MaxQuads = 262144;
+
+		[[nodiscard]] TextLayout* find(const String& text, double lineSpacingScale);
+
+		/// <summary>
+		/// 配置を追加し、追加した配置への参照を返します。
+		/// </summary>
+		const TextLayout& insert(TextLayout&& layout);
+
+		void clear();
+
+		[[nodiscard]] size_t size() const noexcept;
+	};
+}
@@ -222,4 +222,9 @@ namespace s3d
 	{
 		return Siv3DEngine::Get<ISiv3DAsset>()->isReady(AssetType::Font, name);
 	}
+
+	Optional<AssetLoadingTime> FontAsset::GetLoadingTime(const AssetName& name)
+	{
+		return Siv3DEngine::Get<ISiv3DAsset>()->getLoadingTime(AssetType::Font, name);
+	}
 }
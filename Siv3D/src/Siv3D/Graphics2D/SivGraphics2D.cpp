@@ -12,6 +12,8 @@
 # include <Siv3D/Graphics2D.hpp>
 # include <Siv3D/Color.hpp>
 # include <Siv3D/PointVector.hpp>
+# include <Siv3D/Circle.hpp>
+# include <Siv3D/Texture.hpp>
 # include <Siv3DEngine.hpp>
 # include <Renderer2D/IRenderer2D.hpp>
 # include <Graphics/IGraphics.hpp>
@@ -152,6 +154,68 @@ namespace s3d
 			Siv3DEngine::Get<ISiv3DRenderer2D>()->flush();
 		}
 
+		void SetCommandCompactionEnabled(const bool enabled)
+		{
+			Siv3DEngine::Get<ISiv3DRenderer2D>()->setCommandCompactionEnabled(enabled);
+		}
+
+		bool IsCommandCompactionEnabled()
+		{
+			return Siv3DEngine::Get<ISiv3DRenderer2D>()->isCommandCompactionEnabled();
+		}
+
+		void DrawRects(const Array<RectF>& rects, const ColorF& color)
+		{
+			if (rects.isEmpty())
+			{
+				return;
+			}
+
+			Siv3DEngine::Get<ISiv3DRenderer2D>()->addRects(rects.data(), rects.size(), &color, 0);
+		}
+
+		void DrawRects(const Array<RectF>& rects, const Array<ColorF>& colors)
+		{
+			if (const size_t count = std::min(rects.size(), colors.size()))
+			{
+				Siv3DEngine::Get<ISiv3DRenderer2D>()->addRects(rects.data(), count, colors.data(), 1);
+			}
+		}
+
+		void DrawCircles(const Array<Circle>& circles, const ColorF& color)
+		{
+			if (circles.isEmpty())
+			{
+				return;
+			}
+
+			Siv3DEngine::Get<ISiv3DRenderer2D>()->addCircles(circles.data(), circles.size(), &color, 0);
+		}
+
+		void DrawCircles(const Array<Circle>& circles, const Array<ColorF>& colors)
+		{
+			if (const size_t count = std::min(circles.size(), colors.size()))
+			{
+				Siv3DEngine::Get<ISiv3DRenderer2D>()->addCircles(circles.data(), count, colors.data(), 1);
+			}
+		}
+
+		void DrawTextureRegions(const Texture& texture, const Array<RectF>& rects, const Array<RectF>& uvRects, const ColorF& diffuse)
+		{
+			if (const size_t count = std::min(rects.size(), uvRects.size()))
+			{
+				Siv3DEngine::Get<ISiv3DRenderer2D>()->addTextureRegions(texture, rects.data(), uvRects.data(), count, &diffuse, 0);
+			}
+		}
+
+		void DrawTextureRegions(const Texture& texture, const Array<RectF>& rects, const Array<RectF>& uvRects, const Array<ColorF>& colors)
+		{
+			if (const size_t count = std::min({ rects.size(), uvRects.size(), colors.size() }))
+			{
+				Siv3DEngine::Get<ISiv3DRenderer2D>()->addTextureRegions(texture, rects.data(), uvRects.data(), count, colors.data(), 1);
+			}
+		}
+
 		namespace Internal
 		{
 			void SetColorMul(const ColorF& color)
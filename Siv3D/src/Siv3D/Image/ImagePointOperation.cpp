@@ -0,0 +1,339 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <cassert>
+# include <Siv3D/Platform.hpp>
+# if SIV3D_WITH_FEATURE(SSE2)
+#	include <smmintrin.h>
+# endif
+# include <Siv3D/Image.hpp>
+# include <Siv3D/Threading.hpp>
+# include "ImagePointOperation.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		// これより画素数が少ない画像は、呼び出し元のスレッドだけで処理する
+		constexpr size_t ParallelThreshold = (512 * 512);
+
+		// 1 つのタスクが処理する画素数の目安
+		constexpr size_t PixelsPerTask = (128 * 1024);
+
+		template <class Kernel>
+		static void ForEachRows(const Image& src, Image& dst, Kernel kernel)
+		{
+			assert(src.size() == dst.size());
+
+			const size_t width = src.width();
+			const size_t height = src.height();
+			const size_t num_pixels = (width * height);
+
+			const Color* const pSrc = src.data();
+			Color* const pDst = dst.data();
+
+			if ((num_pixels < ParallelThreshold) || (Threading::GetWorkerCount() == 0))
+			{
+				kernel(pSrc, pDst, num_pixels);
+				return;
+			}
+
+			const size_t rowsPerTask = std::max<size_t>(1, PixelsPerTask / width);
+			const size_t numTasks = ((height + rowsPerTask - 1) / rowsPerTask);
+
+			Threading::ParallelFor(0, numTasks, [=, &kernel](const size_t i)
+			{
+				const size_t firstRow = (i * rowsPerTask);
+				const size_t rows = std::min(rowsPerTask, height - firstRow);
+				const size_t offset = (firstRow * width);
+
+				kernel(pSrc + offset, pDst + offset, rows * width);
+			}, 1);
+		}
+
+		// 1000 倍した輝度 (0.299R + 0.587G + 0.114B) を整数で計算する
+		[[nodiscard]] inline constexpr int32 Luma1000(const Color& c) noexcept
+		{
+			return (299 * c.r + 587 * c.g + 114 * c.b);
+		}
+
+		[[nodiscard]] inline constexpr uint8 SepiaChannel(const int32 value1000) noexcept
+		{
+			return (value1000 <= 0) ? 0 : static_cast<uint8>(std::min(value1000 / 1000, 255));
+		}
+
+	# if SIV3D_WITH_FEATURE(SSE2)
+
+		[[nodiscard]] inline __m128i Load4(const Color* p) noexcept
+		{
+			return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+		}
+
+		inline void Store4(Color* p, const __m128i v) noexcept
+		{
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+		}
+
+		// 4 画素の Luma1000()
+		[[nodiscard]] inline __m128i Luma1000_4(const __m128i pixels) noexcept
+		{
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i coef = _mm_setr_epi16(299, 587, 114, 0, 299, 587, 114, 0);
+			const __m128i lo = _mm_madd_epi16(_mm_unpacklo_epi8(pixels, zero), coef);
+			const __m128i hi = _mm_madd_epi16(_mm_unpackhi_epi8(pixels, zero), coef);
+			return _mm_hadd_epi32(lo, hi); // SSSE3
+		}
+
+		// [0, 600000] の範囲では、0.001f を掛けて切り捨てた値と、1000 で割った値は一致する
+		[[nodiscard]] inline __m128i Div1000_4(const __m128i v) noexcept
+		{
+			return _mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(v), _mm_set1_ps(0.001f)));
+		}
+
+	# endif
+
+		static void NegateKernel(const Color* pSrc, Color* pDst, const size_t num_pixels)
+		{
+			size_t i = 0;
+
+		# if SIV3D_WITH_FEATURE(SSE2)
+
+			const __m128i mask = _mm_set1_epi32(0x00FFffFF);
+
+			for (; (i + 4) <= num_pixels; i += 4)
+			{
+				Store4(pDst + i, _mm_xor_si128(Load4(pSrc + i), mask));
+			}
+
+		# endif
+
+			for (; i < num_pixels; ++i)
+			{
+				pDst[i] = ~pSrc[i];
+			}
+		}
+
+		static void GrayscaleKernel(const Color* pSrc, Color* pDst, const size_t num_pixels)
+		{
+			size_t i = 0;
+
+		# if SIV3D_WITH_FEATURE(SSE2)
+
+			const __m128i alphaMask = _mm_set1_epi32(0xFF000000);
+			const __m128i rgbOnes = _mm_set1_epi32(0x00010101);
+
+			for (; (i + 4) <= num_pixels; i += 4)
+			{
+				const __m128i pixels = Load4(pSrc + i);
+				const __m128i y = Div1000_4(Luma1000_4(pixels));
+				const __m128i gray = _mm_mullo_epi32(y, rgbOnes); // SSE4.1
+				Store4(pDst + i, _mm_or_si128(gray, _mm_and_si128(pixels, alphaMask)));
+			}
+
+		# endif
+
+			for (; i < num_pixels; ++i)
+			{
+				const uint8 y = static_cast<uint8>(Luma1000(pSrc[i]) / 1000);
+				pDst[i].set(y, y, y, pSrc[i].a);
+			}
+		}
+
+		static void SepiaKernel(const Color* pSrc, Color* pDst, const size_t num_pixels, const int32 levr, const int32 levg, const int32 levb)
+		{
+			size_t i = 0;
+
+		# if SIV3D_WITH_FEATURE(SSE2)
+
+			const __m128i alphaMask = _mm_set1_epi32(0xFF000000);
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i c255 = _mm_set1_epi32(255);
+			const __m128i vlevr = _mm_set1_epi32(levr);
+			const __m128i vlevg = _mm_set1_epi32(levg);
+			const __m128i vlevb = _mm_set1_epi32(levb);
+
+			for (; (i + 4) <= num_pixels; i += 4)
+			{
+				const __m128i pixels = Load4(pSrc + i);
+				const __m128i y = Luma1000_4(pixels);
+				const __m128i r = _mm_min_epi32(_mm_max_epi32(Div1000_4(_mm_add_epi32(y, vlevr)), zero), c255); // SSE4.1
+				const __m128i g = _mm_min_epi32(_mm_max_epi32(Div1000_4(_mm_add_epi32(y, vlevg)), zero), c255);
+				const __m128i b = _mm_min_epi32(_mm_max_epi32(Div1000_4(_mm_add_epi32(y, vlevb)), zero), c255);
+				const __m128i rgb = _mm_or_si128(_mm_or_si128(r, _mm_slli_epi32(g, 8)), _mm_slli_epi32(b, 16));
+				Store4(pDst + i, _mm_or_si128(rgb, _mm_and_si128(pixels, alphaMask)));
+			}
+
+		# endif
+
+			for (; i < num_pixels; ++i)
+			{
+				const int32 y = Luma1000(pSrc[i]);
+				pDst[i].set(SepiaChannel(y + levr), SepiaChannel(y + levg), SepiaChannel(y + levb), pSrc[i].a);
+			}
+		}
+
+		static void TableKernel(const Color* pSrc, Color* pDst, const size_t num_pixels, const uint8* table)
+		{
+			// SSE には 8-bit のテーブル引きが無いため、スカラーで処理する
+			for (size_t i = 0; i < num_pixels; ++i)
+			{
+				const Color c = pSrc[i];
+				pDst[i].set(table[c.r], table[c.g], table[c.b], c.a);
+			}
+		}
+
+		static void BrightenKernel(const Color* pSrc, Color* pDst, const size_t num_pixels, const int32 level)
+		{
+			size_t i = 0;
+
+		# if SIV3D_WITH_FEATURE(SSE2)
+
+			const __m128i v = _mm_set1_epi32(std::abs(level) * 0x00010101);
+
+			if (level < 0)
+			{
+				for (; (i + 4) <= num_pixels; i += 4)
+				{
+					Store4(pDst + i, _mm_subs_epu8(Load4(pSrc + i), v));
+				}
+			}
+			else
+			{
+				for (; (i + 4) <= num_pixels; i += 4)
+				{
+					Store4(pDst + i, _mm_adds_epu8(Load4(pSrc + i), v));
+				}
+			}
+
+		# endif
+
+			for (; i < num_pixels; ++i)
+			{
+				const Color c = pSrc[i];
+				pDst[i].set(static_cast<uint8>(Clamp(c.r + level, 0, 255)),
+							static_cast<uint8>(Clamp(c.g + level, 0, 255)),
+							static_cast<uint8>(Clamp(c.b + level, 0, 255)),
+							c.a);
+			}
+		}
+
+		static void ThresholdKernel(const Color* pSrc, Color* pDst, const size_t num_pixels, const int32 threshold1000, const uint32 a, const uint32 b)
+		{
+			size_t i = 0;
+
+		# if SIV3D_WITH_FEATURE(SSE2)
+
+			const __m128i alphaMask = _mm_set1_epi32(0xFF000000);
+			const __m128i vthreshold = _mm_set1_epi32(threshold1000);
+			const __m128i va = _mm_set1_epi32(a);
+			const __m128i vb = _mm_set1_epi32(b);
+
+			for (; (i + 4) <= num_pixels; i += 4)
+			{
+				const __m128i pixels = Load4(pSrc + i);
+				const __m128i mask = _mm_cmpgt_epi32(Luma1000_4(pixels), vthreshold);
+				const __m128i rgb = _mm_or_si128(_mm_and_si128(mask, va), _mm_andnot_si128(mask, vb));
+				Store4(pDst + i, _mm_or_si128(rgb, _mm_and_si128(pixels, alphaMask)));
+			}
+
+		# endif
+
+			for (; i < num_pixels; ++i)
+			{
+				const uint32 rgb = (threshold1000 < Luma1000(pSrc[i])) ? a : b;
+				*static_cast<uint32*>(static_cast<void*>(pDst + i)) = (rgb | (pSrc[i].a << 24));
+			}
+		}
+
+		static void SwapRBKernel(const Color* pSrc, Color* pDst, const size_t num_pixels)
+		{
+			size_t i = 0;
+
+		# if SIV3D_WITH_FEATURE(SSE2)
+
+			const __m128i shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+
+			for (; (i + 4) <= num_pixels; i += 4)
+			{
+				Store4(pDst + i, _mm_shuffle_epi8(Load4(pSrc + i), shuffle)); // SSSE3
+			}
+
+		# endif
+
+			for (; i < num_pixels; ++i)
+			{
+				const Color c = pSrc[i];
+				pDst[i].set(c.b, c.g, c.r, c.a);
+			}
+		}
+	}
+
+	namespace ImagePointOperation
+	{
+		void Negate(const Image& src, Image& dst)
+		{
+			detail::ForEachRows(src, dst, detail::NegateKernel);
+		}
+
+		void Grayscale(const Image& src, Image& dst)
+		{
+			detail::ForEachRows(src, dst, detail::GrayscaleKernel);
+		}
+
+		void Sepia(const Image& src, Image& dst, const int32 level)
+		{
+			const int32 levn = Clamp(level, 0, 255);
+			const int32 levr = (956 * levn);
+			const int32 levg = (274 * levn);
+			const int32 levb = (-1108 * levn);
+
+			detail::ForEachRows(src, dst, [=](const Color* pSrc, Color* pDst, const size_t num_pixels)
+			{
+				detail::SepiaKernel(pSrc, pDst, num_pixels, levr, levg, levb);
+			});
+		}
+
+		void ApplyTable(const Image& src, Image& dst, const uint8 table[256])
+		{
+			detail::ForEachRows(src, dst, [=](const Color* pSrc, Color* pDst, const size_t num_pixels)
+			{
+				detail::TableKernel(pSrc, pDst, num_pixels, table);
+			});
+		}
+
+		void Brighten(const Image& src, Image& dst, const int32 level)
+		{
+			const int32 levn = Clamp(level, -255, 255);
+
+			detail::ForEachRows(src, dst, [=](const Color* pSrc, Color* pDst, const size_t num_pixels)
+			{
+				detail::BrightenKernel(pSrc, pDst, num_pixels, levn);
+			});
+		}
+
+		void Threshold(const Image& src, Image& dst, const uint8 threshold, const bool inverse)
+		{
+			const int32 threshold1000 = (threshold * 1000);
+			const uint32 a = inverse ? 0 : 0x00FFffFF;
+			const uint32 b = inverse ? 0x00FFffFF : 0;
+
+			detail::ForEachRows(src, dst, [=](const Color* pSrc, Color* pDst, const size_t num_pixels)
+			{
+				detail::ThresholdKernel(pSrc, pDst, num_pixels, threshold1000, a, b);
+			});
+		}
+
+		void SwapRB(const Image& src, Image& dst)
+		{
+			detail::ForEachRows(src, dst, detail::SwapRBKernel);
+		}
+	}
+}
@@ -0,0 +1,41 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/Fwd.hpp>
+
+namespace s3d
+{
+	/// <summary>
+	/// 画素ごとに独立した画像処理
+	/// </summary>
+	/// <remarks>
+	/// src と dst は同じ大きさであること。src と dst に同じ画像を渡すと、その画像を書き換える。
+	/// 大きな画像は行ごとに分割して、複数のスレッドで処理する。
+	/// </remarks>
+	namespace ImagePointOperation
+	{
+		void Negate(const Image& src, Image& dst);
+
+		void Grayscale(const Image& src, Image& dst);
+
+		void Sepia(const Image& src, Image& dst, int32 level);
+
+		// R, G, B 成分をそれぞれテーブルで変換する
+		void ApplyTable(const Image& src, Image& dst, const uint8 table[256]);
+
+		void Brighten(const Image& src, Image& dst, int32 level);
+
+		void Threshold(const Image& src, Image& dst, uint8 threshold, bool inverse);
+
+		void SwapRB(const Image& src, Image& dst);
+	}
+}
@@ -25,6 +25,7 @@
 # include <Siv3DEngine.hpp>
 # include <ImageFormat/IImageFormat.hpp>
 # include <ObjectDetection/IObjectDetection.hpp>
+# include "ImagePointOperation.hpp"
 
 # include <opencv2/imgproc.hpp>
 # include <opencv2/photo.hpp>
@@ -55,17 +56,6 @@ namespace s3d
 			}
 		}
 
-		static void MakeSepia(const double levr, const double levg, const double levb, Color& pixel)
-		{
-			const double y = (0.299 * pixel.r + 0.587 * pixel.g + 0.114 * pixel.b);
-			const double r = levr + y;
-			const double g = levg + y;
-			const double b = levb + y;
-			pixel.r = r >= 255.0 ? 255 : r <= 0.0 ? 0 : static_cast<uint8>(r);
-			pixel.g = g >= 255.0 ? 255 : g <= 0.0 ? 0 : static_cast<uint8>(g);
-			pixel.b = b >= 255.0 ? 255 : b <= 0.0 ? 0 : static_cast<uint8>(b);
-		}
-
 		static void SetupPosterizeTable(const int32 level, uint8 table[256])
 		{
 			const int32 levN = Clamp(level, 2, 256) - 1;
@@ -675,12 +665,7 @@ namespace s3d
 
 	Image& Image::swapRB()
 	{
-		for (auto& pixel : m_data)
-		{
-			const uint32 t = pixel.r;
-			pixel.r = pixel.b;
-			pixel.b = t;
-		}
+		ImagePointOperation::SwapRB(*this, *this);
 
 		return *this;
 	}
@@ -994,10 +979,7 @@ namespace s3d
 
 		// 2. 処理
 		{
-			for (auto& pixel : m_data)
-			{
-				pixel = ~pixel;
-			}
+			ImagePointOperation::Negate(*this, *this);
 		}
 
 		return *this;
@@ -1013,12 +995,9 @@ namespace s3d
 			}
 		}
 
-		Image image(*this);
+		Image image(m_width, m_height);
 
-		for (auto& pixel : image)
-		{
-			pixel = ~pixel;
-		}
+		ImagePointOperation::Negate(*this, image);
 
 		return image;
 	}
@@ -1035,10 +1014,7 @@ namespace s3d
 
 		// 2. 処理
 		{
-			for (auto& pixel : m_data)
-			{
-				pixel.r = pixel.g = pixel.b = pixel.grayscale0_255();
-			}
+			ImagePointOperation::Grayscale(*this, *this);
 		}
 
 		return *this;
@@ -1054,12 +1030,9 @@ namespace s3d
 			}
 		}
 
-		Image image(*this);
+		Image image(m_width, m_height);
 
-		for (auto& pixel : image)
-		{
-			pixel.r = pixel.g = pixel.b = pixel.grayscale0_255();
-		}
+		ImagePointOperation::Grayscale(*this, image);
 
 		return image;
 	}
@@ -1076,15 +1049,7 @@ namespace s3d
 
 		// 2. 処理
 		{
-			const double levn = Clamp(level, 0, 255);
-			const double levr = 0.956 * levn;
-			const double levg = 0.274 * levn;
-			const double levb = -1.108 * levn;
-
-			for (auto& pixel : m_data)
-			{
-				detail::MakeSepia(levr, levg, levb, pixel);
-			}
+			ImagePointOperation::Sepia(*this, *this, level);
 		}
 
 		return *this;
@@ -1100,17 +1065,9 @@ namespace s3d
 			}
 		}
 
-		Image image(*this);
+		Image image(m_width, m_height);
 
-		const double levn = Clamp(level, 0, 255);
-		const double levr = 0.956 * levn;
-		const double levg = 0.274 * levn;
-		const double levb = -1.108 * levn;
-
-		for (auto& pixel : image)
-		{
-			detail::MakeSepia(levr, levg, levb, pixel);
-		}
+		ImagePointOperation::Sepia(*this, image, level);
 
 		return image;
 	}
@@ -1131,12 +1088,7 @@ namespace s3d
 
 			detail::SetupPosterizeTable(level, colorTable);
 
-			for (auto& pixel : m_data)
-			{
-				pixel.r = colorTable[pixel.r];
-				pixel.g = colorTable[pixel.g];
-				pixel.b = colorTable[pixel.b];
-			}
+			ImagePointOperation::ApplyTable(*this, *this, colorTable);
 		}
 
 		return *this;
@@ -1152,18 +1104,13 @@ namespace s3d
 			}
 		}
 
-		Image image(*this);
+		Image image(m_width, m_height);
 
 		uint8 colorTable[256];
 
 		detail::SetupPosterizeTable(level, colorTable);
 
-		for (auto& pixel : image)
-		{
-			pixel.r = colorTable[pixel.r];
-			pixel.g = colorTable[pixel.g];
-			pixel.b = colorTable[pixel.b];
-		}
+		ImagePointOperation::ApplyTable(*this, image, colorTable);
 
 		return image;
 	}
@@ -1180,23 +1127,9 @@ namespace s3d
 
 		// 2. 処理
 		{
-			if (level < 0)
+			if (level != 0)
 			{
-				for (auto& pixel : m_data)
-				{
-					pixel.r = std::max(static_cast<int32>(pixel.r) + level, 0);
-					pixel.g = std::max(static_cast<int32>(pixel.g) + level, 0);
-					pixel.b = std::max(static_cast<int32>(pixel.b) + level, 0);
-				}
-			}
-			else if (level > 0)
-			{
-				for (auto& pixel : m_data)
-				{
-					pixel.r = std::min(static_cast<int32>(pixel.r) + level, 255);
-					pixel.g = std::min(static_cast<int32>(pixel.g) + level, 255);
-					pixel.b = std::min(static_cast<int32>(pixel.b) + level, 255);
-				}
+				ImagePointOperation::Brighten(*this, *this, level);
 			}
 		}
 
@@ -1213,26 +1146,9 @@ namespace s3d
 			}
 		}
 
-		Image image(*this);
+		Image image(m_width, m_height);
 
-		if (level < 0)
-		{
-			for (auto& pixel : image)
-			{
-				pixel.r = std::max(static_cast<int32>(pixel.r) + level, 0);
-				pixel.g = std::max(static_cast<int32>(pixel.g) + level, 0);
-				pixel.b = std::max(static_cast<int32>(pixel.b) + level, 0);
-			}
-		}
-		else if (level > 0)
-		{
-			for (auto& pixel : image)
-			{
-				pixel.r = std::min(static_cast<int32>(pixel.r) + level, 255);
-				pixel.g = std::min(static_cast<int32>(pixel.g) + level, 255);
-				pixel.b = std::min(static_cast<int32>(pixel.b) + level, 255);
-			}
-		}
+		ImagePointOperation::Brighten(*this, image, level);
 
 		return image;
 	}
@@ -1513,12 +1429,7 @@ namespace s3d
 
 			detail::SetupGammmaTable(gamma, colorTable);
 
-			for (auto& pixel : m_data)
-			{
-				pixel.r = colorTable[pixel.r];
-				pixel.g = colorTable[pixel.g];
-				pixel.b = colorTable[pixel.b];
-			}
+			ImagePointOperation::ApplyTable(*this, *this, colorTable);
 		}
 
 		return *this;
@@ -1534,18 +1445,13 @@ namespace s3d
 			}
 		}
 
-		Image image(*this);
+		Image image(m_width, m_height);
 
 		uint8 colorTable[256];
 
 		detail::SetupGammmaTable(gamma, colorTable);
 
-		for (auto& pixel : image)
-		{
-			pixel.r = colorTable[pixel.r];
-			pixel.g = colorTable[pixel.g];
-			pixel.b = colorTable[pixel.b];
-		}
+		ImagePointOperation::ApplyTable(*this, image, colorTable);
 
 		return image;
 	}
@@ -1562,20 +1468,7 @@ namespace s3d
 
 		// 2. 処理
 		{
-			const uint32 a = inverse ? 0 : 0x00FFffFF, b = inverse ? 0x00FFffFF : 0;
-
-			Color* pDst = data();
-
-			const Color* pDstEnd = pDst + num_pixels();
-
-			const double thresholdF = threshold / 255.0;
-
-			while (pDst != pDstEnd)
-			{
-				*static_cast<uint32*>(static_cast<void*>(pDst)) = (thresholdF < pDst->grayscale() ? a : b) | (pDst->a << 24);
-
-				++pDst;
-			}
+			ImagePointOperation::Threshold(*this, *this, threshold, inverse);
 		}
 
 		return *this;
@@ -1591,22 +1484,9 @@ namespace s3d
 			}
 		}
 
-		Image image(*this);
-
-		const unsigned a = inverse ? 0 : 0x00FFffFF, b = inverse ? 0x00FFffFF : 0;
-
-		Color* pDst = image.data();
-
-		const Color* pDstEnd = pDst + num_pixels();
-
-		const double thresholdF = threshold / 255.0;
-
-		while (pDst != pDstEnd)
-		{
-			*static_cast<uint32*>(static_cast<void*>(pDst)) = (thresholdF < pDst->grayscale() ? a : b) | (pDst->a << 24);
+		Image image(m_width, m_height);
 
-			++pDst;
-		}
+		ImagePointOperation::Threshold(*this, image, threshold, inverse);
 
 		return image;
 	}
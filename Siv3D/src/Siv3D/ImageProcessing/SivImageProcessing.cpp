@@ -11,6 +11,7 @@
 
 # include <Siv3D/ImageProcessing.hpp>
 # include <Siv3D/Number.hpp>
+# include <Siv3D/Threading.hpp>
 
 namespace s3d
 {
@@ -72,244 +73,241 @@ namespace s3d
 			return result;
 		}
 
-		struct SDFPixel
-		{
-			Point border;
-			
-			float distance;
-			
-			bool white;
-		};
+		// 距離場を計算していない（境界が見つからない）ことを表す値
+		constexpr float SDFInfinity = std::numeric_limits<float>::infinity();
+
+		// 1 つのタスクが処理する列の数
+		constexpr size_t SDFColumnsPerTask = 64;
+
+		// 1 つのタスクが処理する画素数の目安
+		constexpr size_t SDFPixelsPerTask = (64 * 1024);
 
-		inline float CalcDistance(const int32 x, const int32 y, const Point pos) noexcept
+		[[nodiscard]] inline bool IsWhite(const Color& color) noexcept
 		{
-			return std::sqrt(static_cast<float>((x - pos.x) * (x - pos.x) + (y - pos.y) * (y - pos.y)));
+			return (color.r == 255);
 		}
-	}
 
-	namespace ImageProcessing
-	{
-		Array<Image> GenerateMips(const Image& src)
+		// 白い画素のうち、上下左右に白くない画素があるものを境界とする
+		[[nodiscard]] inline bool IsSDFBorder(const Color* pSrc, const int32 x, const int32 y, const int32 width, const int32 height) noexcept
 		{
-			const uint32 mipCount = CalculateMipCount(src.width(), src.height()) - 1;
-
-			if (mipCount == 0)
-			{
-				return Array<Image>();
-			}
-
-			Array<Image> mipImages(mipCount);
-
-			mipImages[0] = detail::GenerateMip(src);
-
-			for (uint32 i = 1; i < mipCount; ++i)
+			if (!IsWhite(*pSrc))
 			{
-				mipImages[i] = detail::GenerateMip(mipImages[i - 1]);
+				return false;
 			}
 
-			return mipImages;
+			return ((0 < x) && !IsWhite(*(pSrc - 1)))
+				|| ((x < width - 1) && !IsWhite(*(pSrc + 1)))
+				|| ((0 < y) && !IsWhite(*(pSrc - width)))
+				|| ((y < height - 1) && !IsWhite(*(pSrc + width)));
 		}
 
-		Image GenerateSDF(const Image& image, const uint32 scale, const double spread)
+		// 各列について、同じ列にある最も近い境界までの距離の 2 乗を求める
+		static void SDFColumnPass(const Image& image, Array<float>& field, const int32 xBegin, const int32 xEnd)
 		{
-			if (!image)
+			const int32 width = image.width();
+			const int32 height = image.height();
+			const Color* const pSrc = image.data();
+			float* const pField = field.data();
+
+			for (int32 y = 0; y < height; ++y)
 			{
-				return Image();
-			}
+				const size_t offset = (static_cast<size_t>(y) * width);
 
-			const size_t num_pixels = image.num_pixels();
-			const int32 imageWidth = image.width();
-			const int32 imageHeight = image.height();
-			const int32 resultWidth = imageWidth / scale;
-			const int32 resultHeight = imageHeight / scale;
+				for (int32 x = xBegin; x < xEnd; ++x)
+				{
+					if (IsSDFBorder(pSrc + offset + x, x, y, width, height))
+					{
+						pField[offset + x] = 0.0f;
+					}
+					else
+					{
+						pField[offset + x] = (0 < y) ? (pField[offset - width + x] + 1.0f) : SDFInfinity;
+					}
+				}
+			}
 
-			Array<detail::SDFPixel> pixels(num_pixels);
+			for (int32 y = (height - 2); y >= 0; --y)
 			{
-				const Color* pSrc = image.data();
-				const Color* const pSrcEnd = pSrc + num_pixels;
-				detail::SDFPixel* pDst = pixels.data();
+				const size_t offset = (static_cast<size_t>(y) * width);
 
-				while (pSrc != pSrcEnd)
+				for (int32 x = xBegin; x < xEnd; ++x)
 				{
-					pDst->distance = Largest<float>;
-					pDst->border.set(-1, -1);
-					pDst->white = (pSrc->r == 255);
-
-					++pSrc;
-					++pDst;
+					pField[offset + x] = std::min(pField[offset + x], pField[offset + width + x] + 1.0f);
 				}
 			}
 
+			for (int32 y = 0; y < height; ++y)
 			{
-				detail::SDFPixel* pDst = pixels.data();
+				const size_t offset = (static_cast<size_t>(y) * width);
 
-				for (int32 y = 0; y < imageHeight; ++y)
+				for (int32 x = xBegin; x < xEnd; ++x)
 				{
-					for (int32 x = 0; x < imageWidth; ++x)
-					{
-						const bool center = pDst->white;
-						const bool isEdge = (center &&
-							(((0 < x) && (pDst - 1)->white != center)
-								|| ((x < imageWidth - 1) && (pDst + 1)->white != center)
-								|| ((0 < y) && (pDst - imageWidth)->white != center)
-								|| ((y < imageHeight - 1) && (pDst + imageWidth)->white != center)
-								));
-
-						if (isEdge)
-						{
-							pDst->distance = 0.0f;
-							pDst->border.set(x, y);
-						}
-
-						++pDst;
-					}
+					pField[offset + x] *= pField[offset + x];
 				}
 			}
+		}
 
-			{
-				constexpr float sqrt2 = Math::Constants::Sqrt2_v<float>;
-				detail::SDFPixel* pixel = pixels.data();
+		// 放物線の下側包絡線を求めて、1 行分の 2 乗距離を更新する (Felzenszwalb & Huttenlocher)
+		// 2 乗距離は整数なので、放物線の交点 z は分数 (zNum / zDen) のまま比較する
+		static void SDFRowPass(float* pRow, const int32 width, Array<int64>& g, Array<int32>& v, Array<int64>& zNum, Array<int64>& zDen)
+		{
+			int32 k = -1;
 
-				for (int32 y = 0; y < imageHeight; ++y)
+			for (int32 q = 0; q < width; ++q)
+			{
+				if (pRow[q] == SDFInfinity)
 				{
-					const bool y0 = (0 < y);
+					continue;
+				}
 
-					for (int32 x = 0; x < imageWidth; ++x)
-					{
-						{
-							const detail::SDFPixel* offsetPixel = (pixel - imageWidth - 1);
+				g[q] = static_cast<int64>(pRow[q]) + static_cast<int64>(q) * q;
 
-							if ((0 < x) && y0 && (offsetPixel->distance + sqrt2) < pixel->distance)
-							{
-								pixel->border = offsetPixel->border;
-								pixel->distance = detail::CalcDistance(x, y, pixel->border);
-							}
-						}
+				int64 sNum = 0, sDen = 1;
 
-						{
-							const detail::SDFPixel* offsetPixel = (pixel - imageWidth);
+				// z[0] は -∞ なので、v[0] は取り除かれない
+				while (0 < k)
+				{
+					const int32 r = v[k];
+					sNum = (g[q] - g[r]);
+					sDen = (2 * (q - r));
 
-							if (y0 && (offsetPixel->distance + 1.0f) < pixel->distance)
-							{
-								pixel->border = offsetPixel->border;
-								pixel->distance = detail::CalcDistance(x, y, pixel->border);
-							}
-						}
+					if (zNum[k] * sDen < sNum * zDen[k])
+					{
+						break;
+					}
 
-						{
-							const detail::SDFPixel* offsetPixel = (pixel - imageWidth + 1);
+					--k;
+				}
 
-							if ((x < imageWidth - 1) && y0 && (offsetPixel->distance + sqrt2) < pixel->distance)
-							{
-								pixel->border = offsetPixel->border;
-								pixel->distance = detail::CalcDistance(x, y, pixel->border);
-							}
-						}
+				if (k == 0)
+				{
+					const int32 r = v[0];
+					sNum = (g[q] - g[r]);
+					sDen = (2 * (q - r));
+				}
 
-						{
-							const detail::SDFPixel* offsetPixel = (pixel - 1);
+				++k;
+				v[k] = q;
+				zNum[k] = sNum;
+				zDen[k] = sDen;
+			}
 
-							if ((0 < x) && (offsetPixel->distance + 1.0f) < pixel->distance)
-							{
-								pixel->border = offsetPixel->border;
-								pixel->distance = detail::CalcDistance(x, y, pixel->border);
-							}
-						}
+			if (k < 0)
+			{
+				return;
+			}
 
-						++pixel;
-					}
+			for (int32 q = 0, j = 0; q < width; ++q)
+			{
+				while ((j < k) && (zNum[j + 1] < q * zDen[j + 1]))
+				{
+					++j;
 				}
 
-				pixel = pixels.data() + num_pixels - 1;
+				const int64 r = v[j];
+				pRow[q] = static_cast<float>(g[r] - r * r + (q - r) * (q - r));
+			}
+		}
+	}
 
-				for (int32 y = imageHeight - 1; y >= 0; --y)
-				{
-					const bool yH = (y < imageHeight - 1);
+	namespace ImageProcessing
+	{
+		Array<Image> GenerateMips(const Image& src)
+		{
+			const uint32 mipCount = CalculateMipCount(src.width(), src.height()) - 1;
 
-					for (int32 x = imageWidth - 1; x >= 0; --x)
-					{
-						{
-							const detail::SDFPixel* offsetPixel = (pixel + 1);
+			if (mipCount == 0)
+			{
+				return Array<Image>();
+			}
 
-							if ((x < imageWidth - 1) && (offsetPixel->distance + 1.0f) < pixel->distance)
-							{
-								pixel->border = offsetPixel->border;
-								pixel->distance = detail::CalcDistance(x, y, pixel->border);
-							}
-						}
+			Array<Image> mipImages(mipCount);
 
-						{
-							const detail::SDFPixel* offsetPixel = (pixel + imageWidth - 1);
+			mipImages[0] = detail::GenerateMip(src);
 
-							if ((0 < x) && yH && (offsetPixel->distance + sqrt2) < pixel->distance)
-							{
-								pixel->border = offsetPixel->border;
-								pixel->distance = detail::CalcDistance(x, y, pixel->border);
-							}
-						}
+			for (uint32 i = 1; i < mipCount; ++i)
+			{
+				mipImages[i] = detail::GenerateMip(mipImages[i - 1]);
+			}
 
-						{
-							const detail::SDFPixel* offsetPixel = (pixel + imageWidth);
+			return mipImages;
+		}
 
-							if (yH && (offsetPixel->distance + 1.0f) < pixel->distance)
-							{
-								pixel->border = offsetPixel->border;
-								pixel->distance = detail::CalcDistance(x, y, pixel->border);
-							}
-						}
+		Image GenerateSDF(const Image& image, const uint32 scale, const double spread)
+		{
+			if (!image)
+			{
+				return Image();
+			}
 
-						{
-							const detail::SDFPixel* offsetPixel = (pixel + imageWidth + 1);
+			const int32 imageWidth = image.width();
+			const int32 imageHeight = image.height();
+			const int32 resultWidth = imageWidth / scale;
+			const int32 resultHeight = imageHeight / scale;
 
-							if ((x < imageWidth - 1) && yH && (offsetPixel->distance + sqrt2) < pixel->distance)
-							{
-								pixel->border = offsetPixel->border;
-								pixel->distance = detail::CalcDistance(x, y, pixel->border);
-							}
-						}
+			// 最も近い境界までの距離の 2 乗
+			Array<float> field(image.num_pixels());
 
-						--pixel;
-					}
-				}
+			// 1. 列ごと
+			{
+				const size_t numTasks = ((imageWidth + detail::SDFColumnsPerTask - 1) / detail::SDFColumnsPerTask);
+
+				Threading::ParallelFor(0, numTasks, [&](const size_t i)
+				{
+					const int32 xBegin = static_cast<int32>(i * detail::SDFColumnsPerTask);
+					const int32 xEnd = std::min(xBegin + static_cast<int32>(detail::SDFColumnsPerTask), imageWidth);
+
+					detail::SDFColumnPass(image, field, xBegin, xEnd);
+				}, 1);
 			}
 
+			// 2. 行ごと
 			{
-				detail::SDFPixel* pDst = pixels.data();
-				detail::SDFPixel* const pDstEnd = pDst + num_pixels;
+				const size_t rowsPerTask = std::max<size_t>(1, detail::SDFPixelsPerTask / imageWidth);
+				const size_t numTasks = ((imageHeight + rowsPerTask - 1) / rowsPerTask);
 
-				while (pDst != pDstEnd)
+				Threading::ParallelFor(0, numTasks, [&](const size_t i)
 				{
-					if (!pDst->white)
+					Array<int64> g(imageWidth);
+					Array<int32> v(imageWidth);
+					Array<int64> zNum(imageWidth), zDen(imageWidth);
+
+					const size_t yBegin = (i * rowsPerTask);
+					const size_t yEnd = std::min(yBegin + rowsPerTask, static_cast<size_t>(imageHeight));
+
+					for (size_t y = yBegin; y < yEnd; ++y)
 					{
-						pDst->distance = -pDst->distance;
+						detail::SDFRowPass(field.data() + y * imageWidth, imageWidth, g, v, zNum, zDen);
 					}
-
-					++pDst;
-				}
+				}, 1);
 			}
 
+			// 3. 縮小して符号付き距離を格納する
 			Image result(resultWidth, resultHeight, Color(255, 255));
 			{
 				const float div = 1.0f / (scale * scale * static_cast<float>(spread));
-				const detail::SDFPixel* pSrcLine = pixels.data();
-				Color* pDst = result.data();
 
-				for (int32 y = 0; y < imageHeight; y += scale)
+				Threading::ParallelFor(0, resultHeight, [&](const size_t resultY)
 				{
-					for (int32 x = 0; x < imageWidth; x += scale)
-					{
-						const detail::SDFPixel* pSrc = pSrcLine + x;
+					const size_t y = (resultY * scale);
+					Color* pDst = result[resultY];
 
+					for (int32 x = 0; x < (resultWidth * static_cast<int32>(scale)); x += scale)
+					{
 						float sum = 0.0f;
 
 						for (size_t dy = 0u; dy < scale; ++dy)
 						{
+							const size_t offset = ((y + dy) * imageWidth + x);
+							const float* pSrc = field.data() + offset;
+							const Color* pColor = image.data() + offset;
+
 							for (size_t dx = 0u; dx < scale; ++dx)
 							{
-								sum += pSrc[dx].distance;
-							}
+								const float distance = std::sqrt(pSrc[dx]);
 
-							pSrc += imageWidth;
+								sum += detail::IsWhite(pColor[dx]) ? distance : -distance;
+							}
 						}
 
 						const float d = sum * div;
@@ -318,9 +316,7 @@ namespace s3d
 
 						(pDst++)->a = sd;
 					}
-
-					pSrcLine += (imageWidth * scale);
-				}
+				});
 			}
 
 			return result;
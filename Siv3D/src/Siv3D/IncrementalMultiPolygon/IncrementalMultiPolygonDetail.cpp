@@ -0,0 +1,295 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <boost/geometry/algorithms/intersection.hpp>
+# include <boost/geometry/algorithms/union.hpp>
+# include <boost/geometry/algorithms/difference.hpp>
+# include <boost/geometry/strategies/strategies.hpp>
+# include <Siv3D/Threading.hpp>
+# include "IncrementalMultiPolygonDetail.hpp"
+
+namespace s3d
+{
+	IncrementalMultiPolygon::IncrementalMultiPolygonDetail::IncrementalMultiPolygonDetail(const double tileSize)
+		: m_tileSize((tileSize > 0.0) ? tileSize : DefaultTileSize)
+	{
+
+	}
+
+	uint32 IncrementalMultiPolygon::IncrementalMultiPolygonDetail::add(const Polygon& polygon)
+	{
+		return addShape(polygon, false);
+	}
+
+	uint32 IncrementalMultiPolygon::IncrementalMultiPolygonDetail::subtract(const Polygon& polygon)
+	{
+		return addShape(polygon, true);
+	}
+
+	bool IncrementalMultiPolygon::IncrementalMultiPolygonDetail::replace(const uint32 id, const Polygon& polygon)
+	{
+		const auto it = m_shapes.find(id);
+
+		if (it == m_shapes.end())
+		{
+			return false;
+		}
+
+		Shape& shape = it->second;
+
+		eraseShape(id, shape.tiles);
+
+		if (polygon.isEmpty())
+		{
+			shape.polygon = gPolygon();
+			shape.tiles = Rect(0);
+
+			return true;
+		}
+
+		shape.polygon = polygon._detail()->getPolygon();
+		shape.tiles = getTileRange(polygon.boundingRect());
+
+		insertShape(id, shape.tiles);
+
+		return true;
+	}
+
+	bool IncrementalMultiPolygon::IncrementalMultiPolygonDetail::remove(const uint32 id)
+	{
+		const auto it = m_shapes.find(id);
+
+		if (it == m_shapes.end())
+		{
+			return false;
+		}
+
+		eraseShape(id, it->second.tiles);
+
+		m_shapes.erase(it);
+
+		return true;
+	}
+
+	void IncrementalMultiPolygon::IncrementalMultiPolygonDetail::clear()
+	{
+		m_shapes.clear();
+
+		m_tiles.clear();
+
+		m_dirtyTiles.clear();
+
+		m_multiPolygon = MultiPolygon();
+	}
+
+	size_t IncrementalMultiPolygon::IncrementalMultiPolygonDetail::update()
+	{
+		if (m_dirtyTiles.isEmpty())
+		{
+			return 0;
+		}
+
+		Array<Tile*> tiles(m_dirtyTiles.size());
+
+		for (size_t i = 0; i < m_dirtyTiles.size(); ++i)
+		{
+			tiles[i] = &m_tiles[m_dirtyTiles[i]];
+		}
+
+		// タイル同士は独立しているので、並列に計算できる
+		Threading::ParallelFor(0, tiles.size(), [&](const size_t i)
+		{
+			tiles[i]->pieces = buildTile(m_dirtyTiles[i], *tiles[i]);
+		}, 1);
+
+		for (size_t i = 0; i < m_dirtyTiles.size(); ++i)
+		{
+			if (tiles[i]->shapeIDs.isEmpty())
+			{
+				m_tiles.erase(m_dirtyTiles[i]);
+			}
+			else
+			{
+				tiles[i]->dirty = false;
+			}
+		}
+
+		const size_t numUpdated = m_dirtyTiles.size();
+
+		m_dirtyTiles.clear();
+
+		// 結果が毎回同じ順番に並ぶよう、タイルの位置で並べる
+		Array<std::pair<Point, const Tile*>> sortedTiles;
+		sortedTiles.reserve(m_tiles.size());
+
+		for (const auto& [pos, tile] : m_tiles)
+		{
+			sortedTiles.emplace_back(pos, &tile);
+		}
+
+		std::sort(sortedTiles.begin(), sortedTiles.end(), [](const auto& a, const auto& b)
+		{
+			return (a.first.y != b.first.y) ? (a.first.y < b.first.y) : (a.first.x < b.first.x);
+		});
+
+		Array<Polygon> polygons;
+
+		for (const auto& tile : sortedTiles)
+		{
+			polygons.append(tile.second->pieces);
+		}
+
+		m_multiPolygon = MultiPolygon(std::move(polygons));
+
+		return numUpdated;
+	}
+
+	bool IncrementalMultiPolygon::IncrementalMultiPolygonDetail::hasChanges() const
+	{
+		return !m_dirtyTiles.isEmpty();
+	}
+
+	const MultiPolygon& IncrementalMultiPolygon::IncrementalMultiPolygonDetail::getMultiPolygon() const
+	{
+		return m_multiPolygon;
+	}
+
+	double IncrementalMultiPolygon::IncrementalMultiPolygonDetail::tileSize() const
+	{
+		return m_tileSize;
+	}
+
+	size_t IncrementalMultiPolygon::IncrementalMultiPolygonDetail::num_tiles() const
+	{
+		return m_tiles.size();
+	}
+
+	Rect IncrementalMultiPolygon::IncrementalMultiPolygonDetail::getTileRange(const RectF& rect) const
+	{
+		const int32 x0 = static_cast<int32>(std::floor(rect.x / m_tileSize));
+		const int32 y0 = static_cast<int32>(std::floor(rect.y / m_tileSize));
+		const int32 x1 = static_cast<int32>(std::floor((rect.x + rect.w) / m_tileSize));
+		const int32 y1 = static_cast<int32>(std::floor((rect.y + rect.h) / m_tileSize));
+
+		return Rect(x0, y0, (x1 - x0 + 1), (y1 - y0 + 1));
+	}
+
+	void IncrementalMultiPolygon::IncrementalMultiPolygonDetail::markDirty(const Point& tile)
+	{
+		Tile& data = m_tiles[tile];
+
+		if (!data.dirty)
+		{
+			data.dirty = true;
+
+			m_dirtyTiles << tile;
+		}
+	}
+
+	void IncrementalMultiPolygon::IncrementalMultiPolygonDetail::insertShape(const uint32 id, const Rect& tiles)
+	{
+		for (int32 y = tiles.y; y < (tiles.y + tiles.h); ++y)
+		{
+			for (int32 x = tiles.x; x < (tiles.x + tiles.w); ++x)
+			{
+				const Point tile(x, y);
+
+				markDirty(tile);
+
+				Array<uint32>& shapeIDs = m_tiles[tile].shapeIDs;
+
+				shapeIDs.insert(std::lower_bound(shapeIDs.begin(), shapeIDs.end(), id), id);
+			}
+		}
+	}
+
+	void IncrementalMultiPolygon::IncrementalMultiPolygonDetail::eraseShape(const uint32 id, const Rect& tiles)
+	{
+		for (int32 y = tiles.y; y < (tiles.y + tiles.h); ++y)
+		{
+			for (int32 x = tiles.x; x < (tiles.x + tiles.w); ++x)
+			{
+				const Point tile(x, y);
+
+				markDirty(tile);
+
+				Array<uint32>& shapeIDs = m_tiles[tile].shapeIDs;
+
+				if (const auto it = std::lower_bound(shapeIDs.begin(), shapeIDs.end(), id);
+					(it != shapeIDs.end()) && (*it == id))
+				{
+					shapeIDs.erase(it);
+				}
+			}
+		}
+	}
+
+	uint32 IncrementalMultiPolygon::IncrementalMultiPolygonDetail::addShape(const Polygon& polygon, const bool subtract)
+	{
+		if (polygon.isEmpty())
+		{
+			return 0;
+		}
+
+		const uint32 id = m_nextID++;
+
+		Shape& shape = m_shapes[id];
+		shape.polygon	= polygon._detail()->getPolygon();
+		shape.tiles		= getTileRange(polygon.boundingRect());
+		shape.subtract	= subtract;
+
+		insertShape(id, shape.tiles);
+
+		return id;
+	}
+
+	Array<Polygon> IncrementalMultiPolygon::IncrementalMultiPolygonDetail::buildTile(const Point& tile, const Tile& data) const
+	{
+		const gBox box(Vec2(tile.x * m_tileSize, tile.y * m_tileSize), Vec2((tile.x + 1) * m_tileSize, (tile.y + 1) * m_tileSize));
+
+		gMultiPolygon result;
+
+		for (const uint32 id : data.shapeIDs)
+		{
+			const Shape& shape = m_shapes.at(id);
+
+			// 何も無いところをくり抜いても結果は変わらない
+			if (shape.subtract && result.empty())
+			{
+				continue;
+			}
+
+			gMultiPolygon clipped;
+
+			boost::geometry::intersection(box, shape.polygon, clipped);
+
+			if (clipped.empty())
+			{
+				continue;
+			}
+
+			gMultiPolygon merged;
+
+			if (shape.subtract)
+			{
+				boost::geometry::difference(result, clipped, merged);
+			}
+			else
+			{
+				boost::geometry::union_(result, clipped, merged);
+			}
+
+			result = std::move(merged);
+		}
+
+		return detail::ToPolygons(result);
+	}
+}
@@ -0,0 +1,92 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <map>
+# include <Siv3D/IncrementalMultiPolygon.hpp>
+# include <Siv3D/HashTable.hpp>
+# include "../Polygon/PolygonDetail.hpp"
+
+namespace s3d
+{
+	class IncrementalMultiPolygon::IncrementalMultiPolygonDetail
+	{
+	private:
+
+		struct Shape
+		{
+			gPolygon polygon;
+
+			// 重なっているタイルの範囲
+			Rect tiles{ 0 };
+
+			bool subtract = false;
+		};
+
+		struct Tile
+		{
+			// 演算の順番（ID の昇順）に並ぶ
+			Array<uint32> shapeIDs;
+
+			Array<Polygon> pieces;
+
+			bool dirty = false;
+		};
+
+		double m_tileSize = DefaultTileSize;
+
+		std::map<uint32, Shape> m_shapes;
+
+		uint32 m_nextID = 1;
+
+		HashTable<Point, Tile> m_tiles;
+
+		Array<Point> m_dirtyTiles;
+
+		MultiPolygon m_multiPolygon;
+
+		Rect getTileRange(const RectF& rect) const;
+
+		void markDirty(const Point& tile);
+
+		void insertShape(uint32 id, const Rect& tiles);
+
+		void eraseShape(uint32 id, const Rect& tiles);
+
+		uint32 addShape(const Polygon& polygon, bool subtract);
+
+		Array<Polygon> buildTile(const Point& tile, const Tile& data) const;
+
+	public:
+
+		explicit IncrementalMultiPolygonDetail(double tileSize);
+
+		uint32 add(const Polygon& polygon);
+
+		uint32 subtract(const Polygon& polygon);
+
+		bool replace(uint32 id, const Polygon& polygon);
+
+		bool remove(uint32 id);
+
+		void clear();
+
+		size_t update();
+
+		bool hasChanges() const;
+
+		const MultiPolygon& getMultiPolygon() const;
+
+		double tileSize() const;
+
+		size_t num_tiles() const;
+	};
+}
@@ -0,0 +1,83 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/IncrementalMultiPolygon.hpp>
+# include "IncrementalMultiPolygonDetail.hpp"
+
+namespace s3d
+{
+	IncrementalMultiPolygon::IncrementalMultiPolygon()
+		: IncrementalMultiPolygon(DefaultTileSize)
+	{
+
+	}
+
+	IncrementalMultiPolygon::IncrementalMultiPolygon(const double tileSize)
+		: pImpl(std::make_shared<IncrementalMultiPolygonDetail>(tileSize))
+	{
+
+	}
+
+	IncrementalMultiPolygon::~IncrementalMultiPolygon()
+	{
+
+	}
+
+	uint32 IncrementalMultiPolygon::add(const Polygon& polygon)
+	{
+		return pImpl->add(polygon);
+	}
+
+	uint32 IncrementalMultiPolygon::subtract(const Polygon& polygon)
+	{
+		return pImpl->subtract(polygon);
+	}
+
+	bool IncrementalMultiPolygon::replace(const uint32 id, const Polygon& polygon)
+	{
+		return pImpl->replace(id, polygon);
+	}
+
+	bool IncrementalMultiPolygon::remove(const uint32 id)
+	{
+		return pImpl->remove(id);
+	}
+
+	void IncrementalMultiPolygon::clear()
+	{
+		pImpl->clear();
+	}
+
+	size_t IncrementalMultiPolygon::update()
+	{
+		return pImpl->update();
+	}
+
+	bool IncrementalMultiPolygon::hasChanges() const
+	{
+		return pImpl->hasChanges();
+	}
+
+	const MultiPolygon& IncrementalMultiPolygon::getMultiPolygon() const
+	{
+		return pImpl->getMultiPolygon();
+	}
+
+	double IncrementalMultiPolygon::tileSize() const
+	{
+		return pImpl->tileSize();
+	}
+
+	size_t IncrementalMultiPolygon::num_tiles() const
+	{
+		return pImpl->num_tiles();
+	}
+}
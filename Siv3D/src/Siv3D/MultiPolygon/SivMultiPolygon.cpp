@@ -10,6 +10,7 @@
 //-----------------------------------------------
 
 # include <Siv3D/MultiPolygon.hpp>
+# include "../Polygon/PolygonDetail.hpp"
 
 namespace s3d
 {
@@ -275,6 +276,16 @@ namespace s3d
 		return MultiPolygon(map([=](const Polygon& p) { return p.simplified(maxDistance); }));
 	}
 
+	MultiPolygon MultiPolygon::calculateBuffer(const double distance) const
+	{
+		return MultiPolygon(detail::ToPolygons(detail::BufferAll(*this, distance, false)));
+	}
+
+	MultiPolygon MultiPolygon::calculateRoundBuffer(const double distance) const
+	{
+		return MultiPolygon(detail::ToPolygons(detail::BufferAll(*this, distance, true)));
+	}
+
 	bool MultiPolygon::leftClicked() const
 	{
 		return any([](const Polygon& p) { return p.leftClicked(); });
@@ -10,10 +10,27 @@
 //-----------------------------------------------
 
 # include <Siv3D/EngineLog.hpp>
+# include <Siv3D/Threading.hpp>
 # include "NavMeshDetail.hpp"
 
 namespace s3d
 {
+	namespace detail
+	{
+		constexpr Float3 QueryExtent(2.0f, 4.0f, 2.0f);
+
+		constexpr int32 MaxQueryNodes = 2048;
+
+		constexpr int32 MaxPathPolys = 8192;
+
+		constexpr int32 MaxPathVertices = 8192;
+
+		// dtPolyRef の 22 ビットをタイルとポリゴンの番号で分け合う
+		constexpr uint32 TileAndPolyBits = 22;
+
+		constexpr uint32 MaxTileBits = 14;
+	}
+
 	NavMesh::NavMeshDetail::NavMeshDetail()
 	{
 	
@@ -21,13 +38,35 @@ namespace s3d
 
 	NavMesh::NavMeshDetail::~NavMeshDetail()
 	{
-		destroy();
+		if (m_rebuildTask.valid())
+		{
+			m_rebuildTask.wait();
+		}
 	}
 
 	bool NavMesh::NavMeshDetail::build(const Array<Float3>& vertices, const Array<uint16>& indices, const Array<uint8>& areaIDs, const NavMeshConfig& config)
 	{
+		// 前のメッシュの再構築はメンバを読むので、終わるのを待ってから結果を捨てる
+		if (m_rebuildTask.valid())
+		{
+			m_rebuildTask.wait();
+
+			m_rebuildTask = {};
+		}
+
 		m_built = false;
 
+		// 前のメッシュのエリアは引き継がない。ID は使い回さない
+		m_areas.clear();
+
+		m_dirtyTiles.clear();
+
+		m_numDirtyTiles = 0;
+
+		std::fill(std::begin(m_bmin), std::end(m_bmin), FLT_MAX);
+
+		std::fill(std::begin(m_bmax), std::end(m_bmax), -FLT_MAX);
+
 		if (vertices.isEmpty() || indices.isEmpty() || areaIDs.isEmpty())
 		{
 			return false;
@@ -43,6 +82,11 @@ namespace s3d
 			return false;
 		}
 
+		if (config.tileSize < 0)
+		{
+			return false;
+		}
+
 		m_vertices = vertices;
 
 		m_indices = indices;
@@ -56,183 +100,278 @@ namespace s3d
 
 		try
 		{
-			build(config);
+			return build(config);
 		}
 		catch (...)
 		{
 			return false;
 		}
-
-		return true;
 	}
 
 	Array<Vec3> NavMesh::NavMeshDetail::query(const Float3& start, const Float3& end) const
 	{
-		if (!m_built)
+		std::unique_ptr<NavMeshQueryContext> context = acquireQuery();
+
+		if (!context)
 		{
 			return{};
 		}
 
-		Float3 extent(2.0f, 4.0f, 2.0f);
+		Array<Vec3> path;
 
-		dtNavMeshQuery navmeshquery;
+		dtPolyRef startPoly, endPoly;
 
-		if (dtStatusFailed(navmeshquery.init(m_navmesh.get(), 2048)))
+		if (findEndPolys(*context, start, end, startPoly, endPoly))
 		{
-			return{};
+			int32 numPolys = 0;
+
+			if (dtStatus status = context->query->findPath(startPoly, endPoly, &start.x, &end.x, &context->filter,
+				context->polys.data(), &numPolys, static_cast<int32>(context->polys.size())); dtStatusSucceed(status))
+			{
+				path = findStraightPath(*context, start, end, endPoly, numPolys);
+			}
 		}
 
-		dtPolyRef startpoly, endpoly;
-		dtQueryFilter filter;
+		releaseQuery(std::move(context));
+
+		return path;
+	}
+
+	Array<Array<Vec3>> NavMesh::NavMeshDetail::queryBatch(const Array<std::pair<Vec3, Vec3>>& startEnds) const
+	{
+		Array<Array<Vec3>> paths(startEnds.size());
 
-		if (dtStatusFailed(navmeshquery.findNearestPoly(&start.x, &extent.x, &filter, &startpoly, 0)))
+		if (!m_built)
 		{
-			return{};
+			return paths;
 		}
 
-		if (dtStatusFailed(navmeshquery.findNearestPoly(&end.x, &extent.x, &filter, &endpoly, 0)))
+		// 各スレッドはプールから自分用の dtNavMeshQuery を取り出して使う
+		Threading::ParallelFor(0, startEnds.size(), [&](const size_t i)
 		{
-			return{};
-		}
+			paths[i] = query(startEnds[i].first, startEnds[i].second);
+		});
 
-		if (startpoly == 0)
+		return paths;
+	}
+
+	uint32 NavMesh::NavMeshDetail::addArea(const AABB& box, const uint8 areaID)
+	{
+		if (!m_built || (RC_WALKABLE_AREA < areaID))
 		{
-			return{};
+			return 0;
 		}
 
-		if (endpoly == 0)
+		NavMeshArea area;
+		area.bmin	= (box.center - box.size * 0.5);
+		area.bmax	= (box.center + box.size * 0.5);
+		area.areaID	= areaID;
+
+		// 壁と同じように、エージェントの中心が半径より近づかないようにする
+		if (areaID == RC_NULL_AREA)
 		{
-			return{};
+			area.bmin.x -= m_agentRadius;
+			area.bmin.z -= m_agentRadius;
+			area.bmax.x += m_agentRadius;
+			area.bmax.z += m_agentRadius;
 		}
 
-		constexpr int32 buffersize = 8192;
+		const uint32 id = m_nextAreaID++;
 
-		int32 npolys = 0;
+		m_areas.emplace(id, area);
 
-		Array<dtPolyRef> polys(buffersize);
+		markDirty(area);
 
-		if (dtStatus status = navmeshquery.findPath(startpoly, endpoly, &start.x, &end.x, &filter, polys.data(), &npolys, buffersize); dtStatusFailed(status))
-		{
-			return{};
-		}
+		return id;
+	}
+
+	bool NavMesh::NavMeshDetail::removeArea(const uint32 id)
+	{
+		const auto it = m_areas.find(id);
 
-		if (npolys <= 0)
+		if (it == m_areas.end())
 		{
-			return{};
+			return false;
 		}
 
-		float end2[3] = { end.x, end.y, end.z };
+		markDirty(it->second);
+
+		m_areas.erase(it);
 
-		if (polys[npolys - 1] != endpoly)
+		return true;
+	}
+
+	size_t NavMesh::NavMeshDetail::update(const bool waitForRebuild)
+	{
+		size_t numSwappedTiles = 0;
+
+		for (;;)
 		{
-			bool posOverPoly;
-			navmeshquery.closestPointOnPoly(polys[npolys - 1], &end.x, end2, &posOverPoly);
-		}
+			if (m_rebuildTask.valid())
+			{
+				if (!waitForRebuild
+					&& (m_rebuildTask.wait_for(std::chrono::seconds(0)) != std::future_status::ready))
+				{
+					return numSwappedTiles;
+				}
 
-		constexpr int32 maxvertices = 8192;
+				Array<NavMeshTileData> tiles = m_rebuildTask.get();
 
-		Array<Float3> buffer(maxvertices);
+				numSwappedTiles += swapTiles(tiles);
+			}
 
-		int32 nvertices = 0;
+			if (m_numDirtyTiles == 0)
+			{
+				return numSwappedTiles;
+			}
 
-		navmeshquery.findStraightPath(&start.x, end2, polys.data(), npolys, &buffer[0].x, 0, 0, &nvertices, maxvertices);
+			Array<int32> dirtyTiles;
 
-		Array<Vec3> vertices(nvertices);
+			dirtyTiles.reserve(m_numDirtyTiles);
 
-		for (int32 i = 0; i < nvertices; ++i)
-		{
-			vertices[i] = buffer[i];
-		}
+			for (size_t i = 0; i < m_dirtyTiles.size(); ++i)
+			{
+				if (m_dirtyTiles[i])
+				{
+					dirtyTiles.push_back(static_cast<int32>(i));
 
-		return vertices;
-	}
+					m_dirtyTiles[i] = false;
+				}
+			}
 
-	void NavMesh::NavMeshDetail::updateAABB(const Float3& v)
-	{
-		m_bmin[0] = std::min(m_bmin[0], v.x);
-		m_bmin[1] = std::min(m_bmin[1], v.y);
-		m_bmin[2] = std::min(m_bmin[2], v.z);
+			m_numDirtyTiles = 0;
 
-		m_bmax[0] = std::max(m_bmax[0], v.x);
-		m_bmax[1] = std::max(m_bmax[1], v.y);
-		m_bmax[2] = std::max(m_bmax[2], v.z);
+			// 再構築中に変更されたタイルは、次の再構築に回る
+			m_rebuildTask = std::async(std::launch::async, [this, tiles = std::move(dirtyTiles), areas = getAreas()]()
+			{
+				return buildTiles(tiles, areas);
+			});
+
+			if (!waitForRebuild)
+			{
+				return numSwappedTiles;
+			}
+		}
 	}
 
-	void NavMesh::NavMeshDetail::destroy()
+	bool NavMesh::NavMeshDetail::isRebuilding() const
 	{
-		m_navmesh.reset();
+		return (m_rebuildTask.valid() || (m_numDirtyTiles != 0));
+	}
 
-		if (m_dmesh)
+	std::unique_ptr<NavMeshQueryContext> NavMesh::NavMeshDetail::acquireQuery() const
+	{
+		if (!m_built)
 		{
-			rcFreePolyMeshDetail(m_dmesh);
-			m_dmesh = nullptr;
+			return nullptr;
 		}
 
-		if (m_mesh)
 		{
-			rcFreePolyMesh(m_mesh);
-			m_mesh = nullptr;
-		}
+			std::lock_guard lock(m_queryPoolMutex);
 
-		if (m_cset)
-		{
-			rcFreeContourSet(m_cset);
-			m_cset = nullptr;
-		}
+			if (m_queryPool)
+			{
+				std::unique_ptr<NavMeshQueryContext> context = std::move(m_queryPool.back());
 
-		if (m_chf)
-		{
-			rcFreeCompactHeightfield(m_chf);
-			m_chf = nullptr;
+				m_queryPool.pop_back();
+
+				return context;
+			}
 		}
 
-		if (m_hf)
+		auto context = std::make_unique<NavMeshQueryContext>();
+
+		if (!context->query
+			|| dtStatusFailed(context->query->init(m_navmesh.get(), detail::MaxQueryNodes)))
 		{
-			rcFreeHeightField(m_hf);
-			m_hf = nullptr;
+			return nullptr;
 		}
+
+		context->navMesh = m_navmesh;
+
+		context->polys.resize(detail::MaxPathPolys);
+
+		context->straightPath.resize(detail::MaxPathVertices);
+
+		return context;
 	}
 
-	void NavMesh::NavMeshDetail::create()
+	void NavMesh::NavMeshDetail::releaseQuery(std::unique_ptr<NavMeshQueryContext>&& context) const
 	{
-		try
+		if (!isCurrent(*context))
 		{
-			m_hf = rcAllocHeightfield();
+			context.reset();
 
-			if (!m_hf) throw std::bad_alloc();
+			return;
+		}
 
-			m_chf = rcAllocCompactHeightfield();
+		std::lock_guard lock(m_queryPoolMutex);
 
-			if (!m_chf) throw std::bad_alloc();
+		m_queryPool.push_back(std::move(context));
+	}
 
-			m_cset = rcAllocContourSet();
+	bool NavMesh::NavMeshDetail::isCurrent(const NavMeshQueryContext& context) const
+	{
+		return (m_built && (context.navMesh == m_navmesh));
+	}
 
-			if (!m_cset) throw std::bad_alloc();
+	bool NavMesh::NavMeshDetail::findEndPolys(NavMeshQueryContext& context, const Float3& start, const Float3& end, dtPolyRef& startPoly, dtPolyRef& endPoly) const
+	{
+		startPoly = endPoly = 0;
 
-			m_mesh = rcAllocPolyMesh();
+		if (dtStatusFailed(context.query->findNearestPoly(&start.x, &detail::QueryExtent.x, &context.filter, &startPoly, 0)))
+		{
+			return false;
+		}
 
-			if (!m_mesh) throw std::bad_alloc();
+		if (dtStatusFailed(context.query->findNearestPoly(&end.x, &detail::QueryExtent.x, &context.filter, &endPoly, 0)))
+		{
+			return false;
+		}
 
-			m_dmesh = rcAllocPolyMeshDetail();
+		return ((startPoly != 0) && (endPoly != 0));
+	}
 
-			if (!m_dmesh) throw std::bad_alloc();
+	Array<Vec3> NavMesh::NavMeshDetail::findStraightPath(NavMeshQueryContext& context, const Float3& start, const Float3& end, const dtPolyRef endPoly, const int32 numPolys) const
+	{
+		if (numPolys <= 0)
+		{
+			return{};
+		}
 
-			m_navmesh = std::shared_ptr<dtNavMesh>(dtAllocNavMesh(), dtFreeNavMesh);
+		float end2[3] = { end.x, end.y, end.z };
 
-			if (!m_navmesh) throw std::bad_alloc();
+		// 終点まで届かない場合は、最後のポリゴン上の最も近い点で止まる
+		if (context.polys[numPolys - 1] != endPoly)
+		{
+			bool posOverPoly;
+			context.query->closestPointOnPoly(context.polys[numPolys - 1], &end.x, end2, &posOverPoly);
 		}
-		catch (...)
+
+		int32 numVertices = 0;
+
+		context.query->findStraightPath(&start.x, end2, context.polys.data(), numPolys,
+			&context.straightPath[0].x, 0, 0, &numVertices, static_cast<int32>(context.straightPath.size()));
+
+		Array<Vec3> vertices(numVertices);
+
+		for (int32 i = 0; i < numVertices; ++i)
 		{
-			destroy();
-			throw;
+			vertices[i] = context.straightPath[i];
 		}
+
+		return vertices;
 	}
 
-	void NavMesh::NavMeshDetail::reset()
+	void NavMesh::NavMeshDetail::updateAABB(const Float3& v)
 	{
-		destroy();
+		m_bmin[0] = std::min(m_bmin[0], v.x);
+		m_bmin[1] = std::min(m_bmin[1], v.y);
+		m_bmin[2] = std::min(m_bmin[2], v.z);
 
-		create();
+		m_bmax[0] = std::max(m_bmax[0], v.x);
+		m_bmax[1] = std::max(m_bmax[1], v.y);
+		m_bmax[2] = std::max(m_bmax[2], v.z);
 	}
 
 	bool NavMesh::NavMeshDetail::build(const NavMeshConfig& config)
@@ -250,7 +389,8 @@ namespace s3d
 		constexpr float regionMinSize			= 8.0f;
 		constexpr float regionMergeSize			= 20.0f;
 
-		rcConfig cfg = {};
+		rcConfig& cfg = m_cfg;
+		cfg = {};
 		cfg.cs = cellSize;
 		cfg.ch = cellHeight;
 		cfg.walkableSlopeAngle = agentMaxSlope;
@@ -265,113 +405,355 @@ namespace s3d
 		cfg.detailSampleDist = (detailSampleDist < 0.9f) ? 0 : cellSize * detailSampleDist;
 		cfg.detailSampleMaxError = cellHeight * detailSampleMaxError;
 
-		rcVcopy(cfg.bmin, m_bmin);
-		rcVcopy(cfg.bmax, m_bmax);
-		cfg.bmin[0] -= cfg.borderSize * cellSize;
-		cfg.bmin[2] -= cfg.borderSize * cellSize;
-		cfg.bmax[0] += cfg.borderSize * cellSize;
-		cfg.bmax[2] += cfg.borderSize * cellSize;
+		m_agentRadius = agentRadius;
+
+		const int32 gridWidth	= static_cast<int32>((m_bmax[0] - m_bmin[0]) / cellSize + 1);
+		const int32 gridHeight	= static_cast<int32>((m_bmax[2] - m_bmin[2]) / cellSize + 1);
+
+		if (config.tileSize == 0)
+		{
+			cfg.width	= gridWidth;
+			cfg.height	= gridHeight;
+
+			m_tileCountX = m_tileCountZ = 1;
+		}
+		else
+		{
+			// 隣のタイルとの継ぎ目でポリゴンが揃うよう、周りの領域も含めてボクセル化する
+			cfg.tileSize	= config.tileSize;
+			cfg.borderSize	= (cfg.walkableRadius + 3);
+			cfg.width		= (cfg.tileSize + cfg.borderSize * 2);
+			cfg.height		= (cfg.tileSize + cfg.borderSize * 2);
 
-		rcCalcGridSize(cfg.bmin, cfg.bmax, cellSize, &cfg.width, &cfg.height);
+			m_tileCountX = ((gridWidth + cfg.tileSize - 1) / cfg.tileSize);
+			m_tileCountZ = ((gridHeight + cfg.tileSize - 1) / cfg.tileSize);
+		}
 
-		//if (cfg.maxVertsPerPoly > DT_VERTS_PER_POLYGON)
-		//{
-		//	return false;
-		//}
+		m_tileWorldSize[0] = (cfg.width - cfg.borderSize * 2) * cellSize;
+		m_tileWorldSize[1] = (cfg.height - cfg.borderSize * 2) * cellSize;
 
-		cfg.width	= static_cast<int32>((cfg.bmax[0] - cfg.bmin[0]) / cellSize + 1);
-		cfg.height	= static_cast<int32>((cfg.bmax[2] - cfg.bmin[2]) / cellSize + 1);
+		const uint32 numTiles = (m_tileCountX * m_tileCountZ);
 
-		reset();
+		const uint32 tileBits = dtIlog2(dtNextPow2(numTiles));
 
-		if (!rcCreateHeightfield(&m_ctx, *m_hf, cfg.width, cfg.height, cfg.bmin, cfg.bmax, cfg.cs, cfg.ch))
+		if (detail::MaxTileBits < tileBits)
 		{
+			LOG_FAIL(U"❌ NavMesh::build(): Too many tiles ({})"_fmt(numTiles));
+
 			return false;
 		}
 
-		const int32 flagMergeThreshold = 0;
+		dtNavMeshParams params = {};
+		rcVcopy(params.orig, m_bmin);
+		params.tileWidth	= m_tileWorldSize[0];
+		params.tileHeight	= m_tileWorldSize[1];
+		params.maxTiles		= (1 << tileBits);
+		params.maxPolys		= (1 << (detail::TileAndPolyBits - tileBits));
 
-		rcRasterizeTriangles(&m_ctx, &m_vertices[0].x, static_cast<int32>(m_vertices.size()),
-			m_indices.data(), m_areaIDs.data(), static_cast<int32>(m_areaIDs.size()), *m_hf, flagMergeThreshold);
+		// プールの dtNavMeshQuery は前のメッシュを指しているので捨てる
+		{
+			std::lock_guard lock(m_queryPoolMutex);
 
-		rcFilterLowHangingWalkableObstacles(&m_ctx, cfg.walkableClimb, *m_hf);
-		rcFilterLedgeSpans(&m_ctx, cfg.walkableHeight, cfg.walkableClimb, *m_hf);
-		rcFilterWalkableLowHeightSpans(&m_ctx, cfg.walkableHeight, *m_hf);
+			m_queryPool.clear();
+		}
 
-		if (!rcBuildCompactHeightfield(&m_ctx, cfg.walkableHeight, cfg.walkableClimb, *m_hf, *m_chf))
+		m_navmesh = std::shared_ptr<dtNavMesh>(dtAllocNavMesh(), dtFreeNavMesh);
+
+		if (!m_navmesh)
 		{
-			return false;
+			throw std::bad_alloc();
 		}
 
-		if (!rcErodeWalkableArea(&m_ctx, cfg.walkableRadius, *m_chf))
+		if (dtStatusFailed(m_navmesh->init(&params)))
 		{
 			return false;
 		}
 
-		if (!rcBuildDistanceField(&m_ctx, *m_chf))
+		assignTriangles();
+
+		m_dirtyTiles.assign(numTiles, false);
+
+		Array<int32> tiles(numTiles);
+
+		for (uint32 i = 0; i < numTiles; ++i)
 		{
-			return false;
+			tiles[i] = static_cast<int32>(i);
 		}
 
-		if (!rcBuildRegions(&m_ctx, *m_chf, 0 /* border size */, cfg.minRegionArea, cfg.mergeRegionArea))
+		Array<NavMeshTileData> builtTiles = buildTiles(tiles, {});
+
+		swapTiles(builtTiles);
+
+		m_built = true;
+
+		return true;
+	}
+
+	void NavMesh::NavMeshDetail::assignTriangles()
+	{
+		m_tileTriangles.assign(m_tileCountX * m_tileCountZ, Array<uint32>());
+
+		const size_t numTriangles = (m_indices.size() / 3);
+
+		for (size_t i = 0; i < numTriangles; ++i)
 		{
-			return false;
+			float bmin[3], bmax[3];
+
+			rcVcopy(bmin, &m_vertices[m_indices[i * 3]].x);
+			rcVcopy(bmax, bmin);
+
+			for (size_t k = 1; k < 3; ++k)
+			{
+				rcVmin(bmin, &m_vertices[m_indices[i * 3 + k]].x);
+				rcVmax(bmax, &m_vertices[m_indices[i * 3 + k]].x);
+			}
+
+			int32 minX, minZ, maxX, maxZ;
+
+			getTileRange(bmin, bmax, minX, minZ, maxX, maxZ);
+
+			for (int32 z = minZ; z <= maxZ; ++z)
+			{
+				for (int32 x = minX; x <= maxX; ++x)
+				{
+					m_tileTriangles[z * m_tileCountX + x].push_back(static_cast<uint32>(i));
+				}
+			}
 		}
+	}
+
+	void NavMesh::NavMeshDetail::getTileRange(const float* bmin, const float* bmax, int32& minX, int32& minZ, int32& maxX, int32& maxZ) const
+	{
+		const float border = (m_cfg.borderSize * m_cfg.cs);
 
-		if (!rcBuildContours(&m_ctx, *m_chf, cfg.maxSimplificationError, cfg.maxEdgeLen, *m_cset))
+		minX = std::max(static_cast<int32>(std::floor((bmin[0] - m_bmin[0] - border) / m_tileWorldSize[0])), 0);
+		minZ = std::max(static_cast<int32>(std::floor((bmin[2] - m_bmin[2] - border) / m_tileWorldSize[1])), 0);
+		maxX = std::min(static_cast<int32>(std::floor((bmax[0] - m_bmin[0] + border) / m_tileWorldSize[0])), m_tileCountX - 1);
+		maxZ = std::min(static_cast<int32>(std::floor((bmax[2] - m_bmin[2] + border) / m_tileWorldSize[1])), m_tileCountZ - 1);
+	}
+
+	void NavMesh::NavMeshDetail::markDirty(const NavMeshArea& area)
+	{
+		int32 minX, minZ, maxX, maxZ;
+
+		getTileRange(&area.bmin.x, &area.bmax.x, minX, minZ, maxX, maxZ);
+
+		for (int32 z = minZ; z <= maxZ; ++z)
 		{
-			return false;
+			for (int32 x = minX; x <= maxX; ++x)
+			{
+				const size_t index = (z * m_tileCountX + x);
+
+				if (!m_dirtyTiles[index])
+				{
+					m_dirtyTiles[index] = true;
+
+					++m_numDirtyTiles;
+				}
+			}
 		}
+	}
+
+	Array<NavMeshArea> NavMesh::NavMeshDetail::getAreas() const
+	{
+		Array<NavMeshArea> areas;
+
+		areas.reserve(m_areas.size());
 
-		if (!rcBuildPolyMesh(&m_ctx, *m_cset, cfg.maxVertsPerPoly, *m_mesh))
+		// 後から追加したものが優先されるよう、ID の順に並べる
+		for (const auto& area : m_areas)
 		{
-			return false;
+			areas.push_back(area.second);
 		}
 
-		if (!rcBuildPolyMeshDetail(&m_ctx, *m_mesh, *m_chf, cfg.detailSampleDist, cfg.detailSampleMaxError, *m_dmesh))
+		return areas;
+	}
+
+	NavMeshTileData NavMesh::NavMeshDetail::buildTile(const int32 x, const int32 z, const Array<NavMeshArea>& areas) const
+	{
+		NavMeshTileData tile;
+		tile.x = x;
+		tile.z = z;
+
+		const Array<uint32>& triangles = m_tileTriangles[z * m_tileCountX + x];
+
+		if (!triangles)
 		{
-			return false;
+			return tile;
+		}
+
+		rcConfig cfg = m_cfg;
+		cfg.bmin[0] = m_bmin[0] + x * m_tileWorldSize[0] - cfg.borderSize * cfg.cs;
+		cfg.bmin[1] = m_bmin[1];
+		cfg.bmin[2] = m_bmin[2] + z * m_tileWorldSize[1] - cfg.borderSize * cfg.cs;
+		cfg.bmax[0] = m_bmin[0] + (x + 1) * m_tileWorldSize[0] + cfg.borderSize * cfg.cs;
+		cfg.bmax[1] = m_bmax[1];
+		cfg.bmax[2] = m_bmin[2] + (z + 1) * m_tileWorldSize[1] + cfg.borderSize * cfg.cs;
+
+		Array<int32> indices(triangles.size() * 3);
+
+		Array<uint8> areaIDs(triangles.size());
+
+		for (size_t i = 0; i < triangles.size(); ++i)
+		{
+			const uint32 triangle = triangles[i];
+
+			indices[i * 3 + 0] = m_indices[triangle * 3 + 0];
+			indices[i * 3 + 1] = m_indices[triangle * 3 + 1];
+			indices[i * 3 + 2] = m_indices[triangle * 3 + 2];
+
+			areaIDs[i] = m_areaIDs[triangle];
+		}
+
+		// ログとタイマーを使わなければ、スレッドごとに用意する必要は無い
+		rcContext ctx(false);
+
+		std::unique_ptr<rcHeightfield, decltype(&rcFreeHeightField)> hf(rcAllocHeightfield(), rcFreeHeightField);
+		std::unique_ptr<rcCompactHeightfield, decltype(&rcFreeCompactHeightfield)> chf(rcAllocCompactHeightfield(), rcFreeCompactHeightfield);
+		std::unique_ptr<rcContourSet, decltype(&rcFreeContourSet)> cset(rcAllocContourSet(), rcFreeContourSet);
+		std::unique_ptr<rcPolyMesh, decltype(&rcFreePolyMesh)> mesh(rcAllocPolyMesh(), rcFreePolyMesh);
+		std::unique_ptr<rcPolyMeshDetail, decltype(&rcFreePolyMeshDetail)> dmesh(rcAllocPolyMeshDetail(), rcFreePolyMeshDetail);
+
+		if (!hf || !chf || !cset || !mesh || !dmesh)
+		{
+			throw std::bad_alloc();
+		}
+
+		if (!rcCreateHeightfield(&ctx, *hf, cfg.width, cfg.height, cfg.bmin, cfg.bmax, cfg.cs, cfg.ch))
+		{
+			return tile;
+		}
+
+		const int32 flagMergeThreshold = 0;
+
+		rcRasterizeTriangles(&ctx, &m_vertices[0].x, static_cast<int32>(m_vertices.size()),
+			indices.data(), areaIDs.data(), static_cast<int32>(areaIDs.size()), *hf, flagMergeThreshold);
+
+		rcFilterLowHangingWalkableObstacles(&ctx, cfg.walkableClimb, *hf);
+		rcFilterLedgeSpans(&ctx, cfg.walkableHeight, cfg.walkableClimb, *hf);
+		rcFilterWalkableLowHeightSpans(&ctx, cfg.walkableHeight, *hf);
+
+		if (!rcBuildCompactHeightfield(&ctx, cfg.walkableHeight, cfg.walkableClimb, *hf, *chf))
+		{
+			return tile;
+		}
+
+		hf.reset();
+
+		if (!rcErodeWalkableArea(&ctx, cfg.walkableRadius, *chf))
+		{
+			return tile;
+		}
+
+		for (const auto& area : areas)
+		{
+			rcMarkBoxArea(&ctx, &area.bmin.x, &area.bmax.x, area.areaID, *chf);
+		}
+
+		if (!rcBuildDistanceField(&ctx, *chf))
+		{
+			return tile;
+		}
+
+		if (!rcBuildRegions(&ctx, *chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea))
+		{
+			return tile;
+		}
+
+		if (!rcBuildContours(&ctx, *chf, cfg.maxSimplificationError, cfg.maxEdgeLen, *cset))
+		{
+			return tile;
+		}
+
+		if (!rcBuildPolyMesh(&ctx, *cset, cfg.maxVertsPerPoly, *mesh))
+		{
+			return tile;
 		}
 
-		for (int32 i = 0; i < m_mesh->npolys; ++i)
+		if (!rcBuildPolyMeshDetail(&ctx, *mesh, *chf, cfg.detailSampleDist, cfg.detailSampleMaxError, *dmesh))
 		{
-			m_mesh->flags[i] = 1;
+			return tile;
+		}
+
+		if (mesh->npolys == 0)
+		{
+			return tile;
+		}
+
+		for (int32 i = 0; i < mesh->npolys; ++i)
+		{
+			mesh->flags[i] = 1;
 		}
 
 		dtNavMeshCreateParams params;
 		memset(&params, 0, sizeof(params));
 
-		params.verts		= m_mesh->verts;
-		params.vertCount	= m_mesh->nverts;
-		params.polys		= m_mesh->polys;
-		params.polyAreas	= m_mesh->areas;
-		params.polyFlags	= m_mesh->flags;
-		params.polyCount	= m_mesh->npolys;
-		params.nvp			= m_mesh->nvp;
+		params.verts		= mesh->verts;
+		params.vertCount	= mesh->nverts;
+		params.polys		= mesh->polys;
+		params.polyAreas	= mesh->areas;
+		params.polyFlags	= mesh->flags;
+		params.polyCount	= mesh->npolys;
+		params.nvp			= mesh->nvp;
 
-		params.detailMeshes		= m_dmesh->meshes;
-		params.detailVerts		= m_dmesh->verts;
-		params.detailVertsCount = m_dmesh->nverts;
-		params.detailTris		= m_dmesh->tris;
-		params.detailTriCount	= m_dmesh->ntris;
+		params.detailMeshes		= dmesh->meshes;
+		params.detailVerts		= dmesh->verts;
+		params.detailVertsCount = dmesh->nverts;
+		params.detailTris		= dmesh->tris;
+		params.detailTriCount	= dmesh->ntris;
 
 		params.walkableHeight	= static_cast<float>(cfg.walkableHeight);
 		params.walkableClimb	= static_cast<float>(cfg.walkableClimb);
-		rcVcopy(params.bmin, m_mesh->bmin);
-		rcVcopy(params.bmax, m_mesh->bmax);
+		params.tileX		= x;
+		params.tileY		= z;
+		params.tileLayer	= 0;
+		rcVcopy(params.bmin, mesh->bmin);
+		rcVcopy(params.bmax, mesh->bmax);
 		params.cs = cfg.cs;
 		params.ch = cfg.ch;
 		params.buildBvTree = true;
 
-		if (!dtCreateNavMeshData(&params, &m_navData, &m_navDataSize))
+		unsigned char* data = nullptr;
+
+		if (!dtCreateNavMeshData(&params, &data, &tile.dataSize))
 		{
-			return false;
+			return tile;
 		}
 
-		m_navmesh->init(m_navData, m_navDataSize, DT_TILE_FREE_DATA);
+		tile.data.reset(data);
 
-		m_built = true;
+		return tile;
+	}
 
-		return true;
+	Array<NavMeshTileData> NavMesh::NavMeshDetail::buildTiles(const Array<int32>& tiles, const Array<NavMeshArea>& areas) const
+	{
+		Array<NavMeshTileData> builtTiles(tiles.size());
+
+		Threading::ParallelFor(0, tiles.size(), [&](const size_t i)
+		{
+			builtTiles[i] = buildTile(tiles[i] % m_tileCountX, tiles[i] / m_tileCountX, areas);
+		});
+
+		return builtTiles;
+	}
+
+	size_t NavMesh::NavMeshDetail::swapTiles(Array<NavMeshTileData>& tiles)
+	{
+		for (auto& tile : tiles)
+		{
+			if (const dtTileRef ref = m_navmesh->getTileRefAt(tile.x, tile.z, 0))
+			{
+				m_navmesh->removeTile(ref, nullptr, nullptr);
+			}
+
+			if (tile.data
+				&& dtStatusSucceed(m_navmesh->addTile(tile.data.get(), tile.dataSize, DT_TILE_FREE_DATA, 0, nullptr)))
+			{
+				// 以後は dtNavMesh が解放する
+				tile.data.release();
+			}
+		}
+
+		return tiles.size();
 	}
 }
@@ -11,6 +11,9 @@
 
 # pragma once
 # include <cfloat>
+# include <mutex>
+# include <future>
+# include <map>
 # include <Siv3D/NavMesh.hpp>
 # include <Siv3D/Array.hpp>
 # include <Siv3D/PointVector.hpp>
@@ -23,31 +26,71 @@
 
 namespace s3d
 {
+	struct NavMeshDataDeleter
+	{
+		void operator()(unsigned char* data) const
+		{
+			dtFree(data);
+		}
+	};
+
+	// 1 つのタイルの構築結果。歩ける場所が無い場合 data は空
+	struct NavMeshTileData
+	{
+		int32 x = 0;
+
+		int32 z = 0;
+
+		std::unique_ptr<unsigned char, NavMeshDataDeleter> data;
+
+		int32 dataSize = 0;
+	};
+
+	struct NavMeshArea
+	{
+		Float3 bmin;
+
+		Float3 bmax;
+
+		uint8 areaID = 0;
+	};
+
+	// 経路探索の作業領域。同時に探索するスレッドの数だけ作られ、使い回される
+	struct NavMeshQueryContext
+	{
+		std::unique_ptr<dtNavMeshQuery, decltype(&dtFreeNavMeshQuery)> query{ dtAllocNavMeshQuery(), dtFreeNavMeshQuery };
+
+		// query の初期化に使ったメッシュ。スライス探索の途中で作り直されても解放されないよう保持する
+		std::shared_ptr<dtNavMesh> navMesh;
+
+		// dtNavMeshQuery はスライス探索の間 filter へのポインタを保持する
+		dtQueryFilter filter;
+
+		Array<dtPolyRef> polys;
+
+		Array<Float3> straightPath;
+	};
+
 	class NavMesh::NavMeshDetail
 	{
 	private:
 
-		rcContext m_ctx;
-		
-		rcHeightfield* m_hf = nullptr;
-		
-		rcCompactHeightfield* m_chf = nullptr;
-		
-		rcContourSet* m_cset = nullptr;
-		
-		rcPolyMesh* m_mesh = nullptr;
-		
-		rcPolyMeshDetail* m_dmesh = nullptr;
-		
+		// タイルに共通の設定。bmin, bmax, width, height はタイルごとに決める
+		rcConfig m_cfg = {};
+
 		std::shared_ptr<dtNavMesh> m_navmesh;
 
 		float m_bmin[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
 		
 		float m_bmax[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
 
-		unsigned char* m_navData = nullptr;
+		float m_agentRadius = 0.0f;
+
+		float m_tileWorldSize[2] = { 0.0f, 0.0f };
 
-		int32 m_navDataSize = 0;
+		int32 m_tileCountX = 0;
+
+		int32 m_tileCountZ = 0;
 
 		bool m_built = false;
 
@@ -57,16 +100,43 @@ namespace s3d
 
 		Array<uint8> m_areaIDs;
 
-		void updateAABB(const Float3& v);
+		// タイル（境界を含む）と重なる三角形の番号
+		Array<Array<uint32>> m_tileTriangles;
+
+		std::map<uint32, NavMeshArea> m_areas;
+
+		uint32 m_nextAreaID = 1;
+
+		Array<bool> m_dirtyTiles;
 
-		void destroy();
+		size_t m_numDirtyTiles = 0;
 
-		void create();
+		// バックグラウンドでの再構築。読むのは構築後に変更されないメンバと、開始時に渡した引数だけ
+		std::future<Array<NavMeshTileData>> m_rebuildTask;
 
-		void reset();
+		mutable std::mutex m_queryPoolMutex;
+
+		mutable Array<std::unique_ptr<NavMeshQueryContext>> m_queryPool;
+
+		void updateAABB(const Float3& v);
 
 		bool build(const NavMeshConfig& config);
 
+		void assignTriangles();
+
+		// 範囲（タイル境界を含む）と重なるタイルの範囲を返す
+		void getTileRange(const float* bmin, const float* bmax, int32& minX, int32& minZ, int32& maxX, int32& maxZ) const;
+
+		void markDirty(const NavMeshArea& area);
+
+		[[nodiscard]] Array<NavMeshArea> getAreas() const;
+
+		[[nodiscard]] NavMeshTileData buildTile(int32 x, int32 z, const Array<NavMeshArea>& areas) const;
+
+		[[nodiscard]] Array<NavMeshTileData> buildTiles(const Array<int32>& tiles, const Array<NavMeshArea>& areas) const;
+
+		size_t swapTiles(Array<NavMeshTileData>& tiles);
+
 	public:
 
 		NavMeshDetail();
@@ -76,5 +146,30 @@ namespace s3d
 		bool build(const Array<Float3>& vertices, const Array<uint16>& indices, const Array<uint8>& areaIDs, const NavMeshConfig& config);
 
 		Array<Vec3> query(const Float3& start, const Float3& end) const;
+
+		Array<Array<Vec3>> queryBatch(const Array<std::pair<Vec3, Vec3>>& startEnds) const;
+
+		// areaID が RC_NULL_AREA の場合は、エージェントの半径だけ広げた障害物になる
+		uint32 addArea(const AABB& box, uint8 areaID);
+
+		bool removeArea(uint32 id);
+
+		size_t update(bool waitForRebuild);
+
+		[[nodiscard]] bool isRebuilding() const;
+
+		// 構築されていない場合は nullptr を返す
+		[[nodiscard]] std::unique_ptr<NavMeshQueryContext> acquireQuery() const;
+
+		// 作り直す前のメッシュのものは、プールに戻さずに捨てる
+		void releaseQuery(std::unique_ptr<NavMeshQueryContext>&& context) const;
+
+		// context が現在のメッシュで探索できるかを返す
+		[[nodiscard]] bool isCurrent(const NavMeshQueryContext& context) const;
+
+		[[nodiscard]] bool findEndPolys(NavMeshQueryContext& context, const Float3& start, const Float3& end, dtPolyRef& startPoly, dtPolyRef& endPoly) const;
+
+		// context.polys の先頭 numPolys 個の経路に沿った頂点列を返す
+		[[nodiscard]] Array<Vec3> findStraightPath(NavMeshQueryContext& context, const Float3& start, const Float3& end, dtPolyRef endPoly, int32 numPolys) const;
 	};
 }
@@ -0,0 +1,125 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/Stopwatch.hpp>
+# include "NavMeshSlicedQueryDetail.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		// updateFor() で経過時間を確かめる間隔
+		constexpr int32 IterationsPerCheck = 32;
+	}
+
+	NavMeshSlicedQuery::NavMeshSlicedQueryDetail::NavMeshSlicedQueryDetail(const std::shared_ptr<const NavMesh::NavMeshDetail>& navMesh, const Float3& start, const Float3& end)
+		: m_navMesh(navMesh)
+		, m_context(navMesh->acquireQuery())
+		, m_start(start)
+		, m_end(end)
+	{
+		if (!m_context)
+		{
+			return;
+		}
+
+		dtPolyRef startPoly;
+
+		if (!m_navMesh->findEndPolys(*m_context, m_start, m_end, startPoly, m_endPoly))
+		{
+			finish(false);
+
+			return;
+		}
+
+		if (dtStatusFailed(m_context->query->initSlicedFindPath(startPoly, m_endPoly, &m_start.x, &m_end.x, &m_context->filter)))
+		{
+			finish(false);
+		}
+	}
+
+	NavMeshSlicedQuery::NavMeshSlicedQueryDetail::~NavMeshSlicedQueryDetail()
+	{
+		if (m_context)
+		{
+			m_navMesh->releaseQuery(std::move(m_context));
+		}
+	}
+
+	bool NavMeshSlicedQuery::NavMeshSlicedQueryDetail::update(const int32 maxIterations)
+	{
+		if (!m_context)
+		{
+			return true;
+		}
+
+		// 探索の途中で NavMesh が作り直された
+		if (!m_navMesh->isCurrent(*m_context))
+		{
+			finish(false);
+
+			return true;
+		}
+
+		int32 doneIterations = 0;
+
+		const dtStatus status = m_context->query->updateSlicedFindPath(maxIterations, &doneIterations);
+
+		if (dtStatusInProgress(status))
+		{
+			return false;
+		}
+
+		finish(dtStatusSucceed(status));
+
+		return true;
+	}
+
+	bool NavMeshSlicedQuery::NavMeshSlicedQueryDetail::updateFor(const Duration& budget)
+	{
+		const Stopwatch stopwatch(true);
+
+		while (!update(detail::IterationsPerCheck))
+		{
+			if (budget <= stopwatch.elapsed())
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool NavMeshSlicedQuery::NavMeshSlicedQueryDetail::isDone() const
+	{
+		return !m_context;
+	}
+
+	const Array<Vec3>& NavMeshSlicedQuery::NavMeshSlicedQueryDetail::getPath() const
+	{
+		return m_path;
+	}
+
+	void NavMeshSlicedQuery::NavMeshSlicedQueryDetail::finish(const bool succeeded)
+	{
+		if (succeeded)
+		{
+			int32 numPolys = 0;
+
+			if (dtStatusSucceed(m_context->query->finalizeSlicedFindPath(m_context->polys.data(), &numPolys, static_cast<int32>(m_context->polys.size()))))
+			{
+				m_path = m_navMesh->findStraightPath(*m_context, m_start, m_end, m_endPoly, numPolys);
+			}
+		}
+
+		m_navMesh->releaseQuery(std::move(m_context));
+	}
+}
@@ -0,0 +1,53 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/NavMesh.hpp>
+# include "NavMeshDetail.hpp"
+
+namespace s3d
+{
+	class NavMeshSlicedQuery::NavMeshSlicedQueryDetail
+	{
+	private:
+
+		std::shared_ptr<const NavMesh::NavMeshDetail> m_navMesh;
+
+		// 探索中だけプールから借りる
+		std::unique_ptr<NavMeshQueryContext> m_context;
+
+		Float3 m_start = Float3(0, 0, 0);
+
+		Float3 m_end = Float3(0, 0, 0);
+
+		dtPolyRef m_endPoly = 0;
+
+		Array<Vec3> m_path;
+
+		void finish(bool succeeded);
+
+	public:
+
+		NavMeshSlicedQueryDetail() = default;
+
+		NavMeshSlicedQueryDetail(const std::shared_ptr<const NavMesh::NavMeshDetail>& navMesh, const Float3& start, const Float3& end);
+
+		~NavMeshSlicedQueryDetail();
+
+		bool update(int32 maxIterations);
+
+		bool updateFor(const Duration& budget);
+
+		[[nodiscard]] bool isDone() const;
+
+		[[nodiscard]] const Array<Vec3>& getPath() const;
+	};
+}
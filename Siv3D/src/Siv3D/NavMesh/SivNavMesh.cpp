@@ -11,9 +11,47 @@
 
 # include <Siv3D/NavMesh.hpp>
 # include "NavMeshDetail.hpp"
+# include "NavMeshSlicedQueryDetail.hpp"
 
 namespace s3d
 {
+	NavMeshSlicedQuery::NavMeshSlicedQuery()
+		: pImpl(std::make_shared<NavMeshSlicedQueryDetail>())
+	{
+
+	}
+
+	NavMeshSlicedQuery::NavMeshSlicedQuery(const std::shared_ptr<NavMeshSlicedQueryDetail>& detail)
+		: pImpl(detail)
+	{
+
+	}
+
+	NavMeshSlicedQuery::~NavMeshSlicedQuery()
+	{
+
+	}
+
+	bool NavMeshSlicedQuery::update(const int32 maxIterations)
+	{
+		return pImpl->update(maxIterations);
+	}
+
+	bool NavMeshSlicedQuery::updateFor(const Duration& budget)
+	{
+		return pImpl->updateFor(budget);
+	}
+
+	bool NavMeshSlicedQuery::isDone() const
+	{
+		return pImpl->isDone();
+	}
+
+	const Array<Vec3>& NavMeshSlicedQuery::getPath() const
+	{
+		return pImpl->getPath();
+	}
+
 	NavMesh::NavMesh()
 	{
 
@@ -45,4 +83,69 @@ namespace s3d
 
 		return pImpl->query(start, end);
 	}
+
+	Array<Array<Vec3>> NavMesh::queryBatch(const Array<std::pair<Vec3, Vec3>>& startEnds) const
+	{
+		if (!pImpl)
+		{
+			return Array<Array<Vec3>>(startEnds.size());
+		}
+
+		return pImpl->queryBatch(startEnds);
+	}
+
+	NavMeshSlicedQuery NavMesh::querySliced(const Vec3& start, const Vec3& end) const
+	{
+		if (!pImpl)
+		{
+			return NavMeshSlicedQuery();
+		}
+
+		return NavMeshSlicedQuery(std::make_shared<NavMeshSlicedQuery::NavMeshSlicedQueryDetail>(pImpl, start, end));
+	}
+
+	uint32 NavMesh::addObstacle(const AABB& box)
+	{
+		return addArea(box, RC_NULL_AREA);
+	}
+
+	uint32 NavMesh::addArea(const AABB& box, const uint8 areaID)
+	{
+		if (!pImpl)
+		{
+			return 0;
+		}
+
+		return pImpl->addArea(box, areaID);
+	}
+
+	bool NavMesh::removeArea(const uint32 id)
+	{
+		if (!pImpl)
+		{
+			return false;
+		}
+
+		return pImpl->removeArea(id);
+	}
+
+	size_t NavMesh::update(const bool waitForRebuild)
+	{
+		if (!pImpl)
+		{
+			return 0;
+		}
+
+		return pImpl->update(waitForRebuild);
+	}
+
+	bool NavMesh::isRebuilding() const
+	{
+		if (!pImpl)
+		{
+			return false;
+		}
+
+		return pImpl->isRebuilding();
+	}
 }
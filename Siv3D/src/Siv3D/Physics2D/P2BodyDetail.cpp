@@ -22,6 +22,8 @@ namespace s3d
 		bodyDef.type = static_cast<b2BodyType>(bodyType);
 		bodyDef.position = detail::ToB2Vec2(center);
 		m_body = world.getWorldPtr()->CreateBody(&bodyDef);
+
+		storePreviousTransform();
 	}
 
 	P2Body::P2BodyDetail::~P2BodyDetail()
@@ -120,4 +122,27 @@ namespace s3d
 
 		m_body->SetUserData(static_cast<void*>(data));
 	}
+
+	void P2Body::P2BodyDetail::storePreviousTransform()
+	{
+		assert(m_body);
+
+		m_previousPos = m_body->GetPosition();
+
+		m_previousAngle = m_body->GetAngle();
+	}
+
+	std::pair<Vec2, double> P2Body::P2BodyDetail::getInterpolatedTransform() const
+	{
+		assert(m_body);
+
+		const double alpha = m_world.getInterpolationAlpha();
+
+		const Vec2 previousPos = detail::ToVec2(m_previousPos);
+		const Vec2 currentPos = detail::ToVec2(m_body->GetPosition());
+		const double previousAngle = m_previousAngle;
+		const double currentAngle = m_body->GetAngle();
+
+		return{ previousPos.lerp(currentPos, alpha), previousAngle + (currentAngle - previousAngle) * alpha };
+	}
 }
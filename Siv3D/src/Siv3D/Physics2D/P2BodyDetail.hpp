@@ -27,6 +27,11 @@ namespace s3d
 
 		P2BodyID m_id = 0;
 
+		// P2World::updateFixed() の最後のステップの前の姿勢
+		b2Vec2 m_previousPos = b2Vec2(0.0f, 0.0f);
+
+		float32 m_previousAngle = 0.0f;
+
 	public:
 
 		P2BodyDetail() = default;
@@ -60,5 +65,9 @@ namespace s3d
 		[[nodiscard]] const Array<std::shared_ptr<P2Shape>>& getShapes() const;
 
 		void setUserData(P2BodyDetail* data);
+
+		void storePreviousTransform();
+
+		[[nodiscard]] std::pair<Vec2, double> getInterpolatedTransform() const;
 	};
 }
@@ -9,6 +9,7 @@
 //
 //-----------------------------------------------
 
+# include <cstring>
 # include "P2ContactListner.hpp"
 # include "Physics2DUtility.hpp"
 # include "P2BodyDetail.hpp"
@@ -70,7 +71,8 @@ namespace s3d
 
 		if (auto it = m_collisions.find(pair); it != m_collisions.end())
 		{
-			if (--(it.value()._internal_count) == 0)
+			// 同じ update() の前のサブステップで接触していた組は、次の clearContacts() まで残す
+			if ((--(it.value()._internal_count) == 0) && (it.value().num_contacts == 0))
 			{
 				m_collisions.erase(it);
 			}
@@ -84,13 +86,44 @@ namespace s3d
 
 	void P2ContactListener::clearContacts()
 	{
-		const auto itEnd = m_collisions.end();
-
-		for (auto it = m_collisions.begin(); it != itEnd; ++it)
+		for (auto it = m_collisions.begin(); it != m_collisions.end();)
 		{
+			if (it.value()._internal_count == 0)
+			{
+				it = m_collisions.erase(it);
+				continue;
+			}
+
 			it.value().num_contacts = 0;
 			it.value().contacts[0].clearImpulse();
 			it.value().contacts[1].clearImpulse();
+			++it;
+		}
+	}
+
+	void P2ContactListener::saveCollisions(uint8* dst) const
+	{
+		for (const auto& [pair, collision] : m_collisions)
+		{
+			std::memcpy(dst, &pair, sizeof(P2ContactPair));
+			std::memcpy(dst + sizeof(P2ContactPair), &collision, sizeof(P2Collision));
+			dst += CollisionDataSize;
+		}
+	}
+
+	void P2ContactListener::loadCollisions(const uint8* src, const size_t count)
+	{
+		m_collisions.clear();
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			P2ContactPair pair;
+			P2Collision collision;
+			std::memcpy(&pair, src, sizeof(P2ContactPair));
+			std::memcpy(&collision, src + sizeof(P2ContactPair), sizeof(P2Collision));
+			src += CollisionDataSize;
+
+			m_collisions.emplace(pair, collision);
 		}
 	}
 }
@@ -30,8 +30,17 @@ namespace s3d
 
 	public:
 
+		// スナップショットにおける衝突情報 1 件あたりのバイト数
+		static constexpr size_t CollisionDataSize = sizeof(P2ContactPair) + sizeof(P2Collision);
+
 		const HashTable<P2ContactPair, P2Collision>& getCollisions() const;
 
+		// 接触点と力積を 0 にし、既に離れた組を取り除く。P2World::update() / updateFixed() の呼び出しごとに 1 回呼ぶ
 		void clearContacts();
+
+		// getCollisions().size() * CollisionDataSize バイトを書き込む
+		void saveCollisions(uint8* dst) const;
+
+		void loadCollisions(const uint8* src, size_t count);
 	};
 }
@@ -9,11 +9,111 @@
 //
 //-----------------------------------------------
 
+# include <Siv3D/Circle.hpp>
+# include <Siv3D/Threading.hpp>
 # include "P2WorldDetail.hpp"
+# include "P2BodyDetail.hpp"
 # include "Physics2DUtility.hpp"
 
 namespace s3d
 {
+	namespace detail
+	{
+		// 1 つのタスクで処理するレイの数
+		constexpr size_t RaycastGrainSize = 64;
+
+		[[nodiscard]] inline bool TestFilter(const b2Fixture* fixture, const P2Filter& filter)
+		{
+			return ((fixture->GetFilterData().categoryBits & filter.maskBits) != 0);
+		}
+
+		// filter を通過した fixture について、探索を続けるかを返す関数を呼び出す
+		template <class Fty>
+		class QueryCallback : public b2QueryCallback
+		{
+		private:
+
+			const P2Filter& m_filter;
+
+			Fty& m_function;
+
+		public:
+
+			QueryCallback(const P2Filter& filter, Fty& function)
+				: m_filter(filter)
+				, m_function(function) {}
+
+			bool ReportFixture(b2Fixture* fixture) override
+			{
+				if (!TestFilter(fixture, m_filter))
+				{
+					return true;
+				}
+
+				return m_function(fixture);
+			}
+		};
+
+		// filter を通過した fixture との交差について、レイを切り詰める割合を返す関数を呼び出す
+		template <class Fty>
+		class RaycastCallback : public b2RayCastCallback
+		{
+		private:
+
+			const P2Filter& m_filter;
+
+			Fty& m_function;
+
+		public:
+
+			RaycastCallback(const P2Filter& filter, Fty& function)
+				: m_filter(filter)
+				, m_function(function) {}
+
+			float32 ReportFixture(b2Fixture* fixture, const b2Vec2& point, const b2Vec2& normal, const float32 fraction) override
+			{
+				if (!TestFilter(fixture, m_filter))
+				{
+					return -1.0f;
+				}
+
+				return m_function(fixture, point, normal, fraction);
+			}
+		};
+
+		template <class Fty>
+		inline void QueryFixtures(const b2World& world, const b2AABB& aabb, const P2Filter& filter, Fty function)
+		{
+			QueryCallback<Fty> callback(filter, function);
+
+			world.QueryAABB(&callback, aabb);
+		}
+
+		template <class Fty>
+		inline void RaycastFixtures(const b2World& world, const b2Vec2& start, const b2Vec2& end, const P2Filter& filter, Fty function)
+		{
+			// 長さ 0 のレイは b2DynamicTree::RayCast() で扱えない
+			if (start == end)
+			{
+				return;
+			}
+
+			RaycastCallback<Fty> callback(filter, function);
+
+			world.RayCast(&callback, start, end);
+		}
+
+		[[nodiscard]] inline Array<P2BodyID> SortUnique(Array<P2BodyID>& ids)
+		{
+			// 1 つの物体が複数の形状を持つ場合があるため
+			std::sort(ids.begin(), ids.end());
+
+			ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+
+			return std::move(ids);
+		}
+	}
+
 	P2World::P2WorldDetail::P2WorldDetail(const Vec2& gravity)
 		: m_world(detail::ToB2Vec2(gravity))
 	{
@@ -22,9 +122,63 @@ namespace s3d
 
 	void P2World::P2WorldDetail::update(const double timeStep, const int32 velocityIterations, const int32 positionIterations)
 	{
+		m_profile = P2Profile();
+
 		m_contactListner.clearContacts();
 
-		m_world.Step(static_cast<float32>(timeStep), velocityIterations, positionIterations);
+		step(timeStep, velocityIterations, positionIterations);
+
+		m_interpolationAlpha = 1.0;
+	}
+
+	size_t P2World::P2WorldDetail::updateFixed(const double deltaTime, const double timeStep, const size_t maxSubSteps, const int32 velocityIterations, const int32 positionIterations)
+	{
+		assert(0.0 < timeStep);
+
+		m_profile = P2Profile();
+
+		// 接触はすべてのサブステップの分を集める
+		m_contactListner.clearContacts();
+
+		m_accumulator += deltaTime;
+
+		size_t numSteps = static_cast<size_t>(m_accumulator / timeStep);
+
+		m_accumulator -= (numSteps * timeStep);
+
+		// 処理が追いつかないときは、超えた分の時間を捨てる
+		if (maxSubSteps < numSteps)
+		{
+			numSteps = maxSubSteps;
+		}
+
+		for (size_t i = 0; i < numSteps; ++i)
+		{
+			// 最後のステップの前の姿勢を、描画の補間に使う
+			if ((i + 1) == numSteps)
+			{
+				for (b2Body* body = m_world.GetBodyList(); body; body = body->GetNext())
+				{
+					static_cast<P2Body::P2BodyDetail*>(body->GetUserData())->storePreviousTransform();
+				}
+			}
+
+			step(timeStep, velocityIterations, positionIterations);
+		}
+
+		m_interpolationAlpha = Clamp(m_accumulator / timeStep, 0.0, 1.0);
+
+		return numSteps;
+	}
+
+	double P2World::P2WorldDetail::getInterpolationAlpha() const
+	{
+		return m_interpolationAlpha;
+	}
+
+	const P2Profile& P2World::P2WorldDetail::getProfile() const
+	{
+		return m_profile;
 	}
 
 	P2Body P2World::P2WorldDetail::createDummy(P2World& world, const Vec2& center, const P2BodyType bodyType)
@@ -129,6 +283,232 @@ namespace s3d
 		return m_contactListner.getCollisions();
 	}
 
+	Array<P2BodyID> P2World::P2WorldDetail::queryAABB(const RectF& rect, const P2Filter& filter) const
+	{
+		b2AABB aabb;
+		aabb.lowerBound = detail::ToB2Vec2(rect.tl());
+		aabb.upperBound = detail::ToB2Vec2(rect.br());
+
+		Array<P2BodyID> ids;
+
+		detail::QueryFixtures(m_world, aabb, filter, [&](const b2Fixture* fixture)
+		{
+			const b2Shape* shape = fixture->GetShape();
+			const b2Transform& transform = fixture->GetBody()->GetTransform();
+			const int32 childCount = shape->GetChildCount();
+
+			// 動的木が持つ AABB は余裕を持たせて広げられているため、形状から求め直す
+			for (int32 child = 0; child < childCount; ++child)
+			{
+				b2AABB shapeAABB;
+				shape->ComputeAABB(&shapeAABB, transform, child);
+
+				if (b2TestOverlap(aabb, shapeAABB))
+				{
+					ids.push_back(GetBodyID(fixture));
+					break;
+				}
+			}
+
+			return true;
+		});
+
+		return detail::SortUnique(ids);
+	}
+
+	Array<P2BodyID> P2World::P2WorldDetail::queryOverlap(const Array<const b2Shape*>& shapes, const P2Filter& filter) const
+	{
+		Array<P2BodyID> ids;
+
+		if (shapes.isEmpty())
+		{
+			return ids;
+		}
+
+		b2Transform identity;
+		identity.SetIdentity();
+
+		b2AABB aabb;
+		shapes.front()->ComputeAABB(&aabb, identity, 0);
+
+		for (const auto& shape : shapes)
+		{
+			b2AABB shapeAABB;
+			shape->ComputeAABB(&shapeAABB, identity, 0);
+			aabb.Combine(shapeAABB);
+		}
+
+		detail::QueryFixtures(m_world, aabb, filter, [&](const b2Fixture* fixture)
+		{
+			const b2Shape* fixtureShape = fixture->GetShape();
+			const b2Transform& transform = fixture->GetBody()->GetTransform();
+			const int32 childCount = fixtureShape->GetChildCount();
+
+			for (const auto& shape : shapes)
+			{
+				for (int32 child = 0; child < childCount; ++child)
+				{
+					if (b2TestOverlap(fixtureShape, child, shape, 0, transform, identity))
+					{
+						ids.push_back(GetBodyID(fixture));
+						return true;
+					}
+				}
+			}
+
+			return true;
+		});
+
+		return detail::SortUnique(ids);
+	}
+
+	Optional<P2RaycastHit> P2World::P2WorldDetail::raycast(const Vec2& start, const Vec2& end, const P2Filter& filter) const
+	{
+		Optional<P2RaycastHit> result;
+
+		detail::RaycastFixtures(m_world, detail::ToB2Vec2(start), detail::ToB2Vec2(end), filter,
+			[&](const b2Fixture* fixture, const b2Vec2& point, const b2Vec2& normal, const float32 fraction)
+		{
+			result = MakeHit(fixture, point, normal, fraction);
+
+			// これより遠い交差は報告されなくなる
+			return fraction;
+		});
+
+		return result;
+	}
+
+	Array<Optional<P2RaycastHit>> P2World::P2WorldDetail::raycast(const Array<Line>& rays, const P2Filter& filter) const
+	{
+		Array<Optional<P2RaycastHit>> results(rays.size());
+
+		// b2World::RayCast() は動的木を読むだけなので、複数のスレッドから同時に呼び出せる
+		Threading::ParallelFor(0, rays.size(), [&](const size_t i)
+		{
+			results[i] = raycast(rays[i].begin, rays[i].end, filter);
+		}, detail::RaycastGrainSize);
+
+		return results;
+	}
+
+	Array<P2RaycastHit> P2World::P2WorldDetail::raycastAll(const Vec2& start, const Vec2& end, const P2Filter& filter) const
+	{
+		Array<P2RaycastHit> hits;
+
+		detail::RaycastFixtures(m_world, detail::ToB2Vec2(start), detail::ToB2Vec2(end), filter,
+			[&](const b2Fixture* fixture, const b2Vec2& point, const b2Vec2& normal, const float32 fraction)
+		{
+			hits.push_back(MakeHit(fixture, point, normal, fraction));
+
+			return 1.0f;
+		});
+
+		std::sort(hits.begin(), hits.end(), [](const P2RaycastHit& a, const P2RaycastHit& b) { return a.fraction < b.fraction; });
+
+		return hits;
+	}
+
+	Optional<P2RaycastHit> P2World::P2WorldDetail::circleCast(const Circle& circle, const Vec2& translation, const P2Filter& filter) const
+	{
+		b2CircleShape circleShape;
+		circleShape.m_radius = static_cast<float32>(circle.r);
+
+		b2Transform circleTransform;
+		circleTransform.Set(detail::ToB2Vec2(circle.center), 0.0f);
+
+		const b2Vec2 b2Translation = detail::ToB2Vec2(translation);
+
+		// 移動の始点と終点の円を囲む範囲
+		b2AABB aabb, endAABB;
+		circleShape.ComputeAABB(&aabb, circleTransform, 0);
+		circleShape.ComputeAABB(&endAABB, b2Transform(circleTransform.p + b2Translation, circleTransform.q), 0);
+		aabb.Combine(endAABB);
+
+		Optional<P2RaycastHit> result;
+
+		detail::QueryFixtures(m_world, aabb, filter, [&](const b2Fixture* fixture)
+		{
+			const b2Shape* fixtureShape = fixture->GetShape();
+			const b2Transform& transform = fixture->GetBody()->GetTransform();
+			const int32 childCount = fixtureShape->GetChildCount();
+
+			for (int32 child = 0; child < childCount; ++child)
+			{
+				// 最初から重なっている場合は b2ShapeCast() が失敗するため、先に調べる
+				if (b2TestOverlap(fixtureShape, child, &circleShape, 0, transform, circleTransform))
+				{
+					result = P2RaycastHit{ circle.center, Vec2(0, 0), 0.0, GetBodyID(fixture) };
+
+					// これより手前の接触はない
+					return false;
+				}
+
+				b2ShapeCastInput input;
+				input.proxyA.Set(fixtureShape, child);
+				input.proxyB.Set(&circleShape, 0);
+				input.transformA = transform;
+				input.transformB = circleTransform;
+				input.translationB = b2Translation;
+
+				if (b2ShapeCastOutput output;
+					b2ShapeCast(&output, &input) && (!result || (output.lambda < result->fraction)))
+				{
+					result = MakeHit(fixture, output.point, output.normal, output.lambda);
+				}
+			}
+
+			return true;
+		});
+
+		return result;
+	}
+
+	void P2World::P2WorldDetail::takeSnapshot(P2WorldSnapshot& snapshot) const
+	{
+		Array<uint8>& data = snapshot.m_data;
+
+		// 確保済みの領域をすべて使い、足りないときだけ拡張して保存し直す
+		data.resize(data.capacity());
+
+		size_t worldSize = b2WorldSnapshot::Save(&m_world, data.data(), static_cast<int32>(data.size()));
+
+		if (data.size() < worldSize)
+		{
+			data.resize(worldSize);
+
+			worldSize = b2WorldSnapshot::Save(&m_world, data.data(), static_cast<int32>(data.size()));
+		}
+
+		const size_t collisionsSize = m_contactListner.getCollisions().size() * P2ContactListener::CollisionDataSize;
+
+		data.resize(worldSize + collisionsSize);
+
+		m_contactListner.saveCollisions(data.data() + worldSize);
+
+		snapshot.m_worldSize = worldSize;
+	}
+
+	bool P2World::P2WorldDetail::restoreSnapshot(const P2WorldSnapshot& snapshot)
+	{
+		const Array<uint8>& data = snapshot.m_data;
+
+		if (data.isEmpty()
+			|| ((data.size() - snapshot.m_worldSize) % P2ContactListener::CollisionDataSize) != 0)
+		{
+			return false;
+		}
+
+		if (!b2WorldSnapshot::Restore(&m_world, data.data(), static_cast<int32>(snapshot.m_worldSize)))
+		{
+			return false;
+		}
+
+		m_contactListner.loadCollisions(data.data() + snapshot.m_worldSize,
+			(data.size() - snapshot.m_worldSize) / P2ContactListener::CollisionDataSize);
+
+		return true;
+	}
+
 	b2World& P2World::P2WorldDetail::getData()
 	{
 		return m_world;
@@ -144,8 +524,31 @@ namespace s3d
 		return &m_world;
 	}
 
+	void P2World::P2WorldDetail::step(const double timeStep, const int32 velocityIterations, const int32 positionIterations)
+	{
+		m_world.Step(static_cast<float32>(timeStep), velocityIterations, positionIterations);
+
+		const b2Profile& profile = m_world.GetProfile();
+		m_profile.step			+= profile.step;
+		m_profile.collide		+= profile.collide;
+		m_profile.solve			+= profile.solve;
+		m_profile.broadphase	+= profile.broadphase;
+		m_profile.solveTOI		+= profile.solveTOI;
+		++m_profile.numSteps;
+	}
+
 	P2BodyID P2World::P2WorldDetail::generateNextID()
 	{
 		return ++m_currentID;
 	}
+
+	P2BodyID P2World::P2WorldDetail::GetBodyID(const b2Fixture* fixture)
+	{
+		return static_cast<const P2Body::P2BodyDetail*>(fixture->GetBody()->GetUserData())->id();
+	}
+
+	P2RaycastHit P2World::P2WorldDetail::MakeHit(const b2Fixture* fixture, const b2Vec2& point, const b2Vec2& normal, const float32 fraction)
+	{
+		return{ detail::ToVec2(point), detail::ToVec2(normal), fraction, GetBodyID(fixture) };
+	}
 }
@@ -27,14 +27,33 @@ namespace s3d
 
 		std::atomic<P2BodyID> m_currentID = 0;
 
+		// updateFixed() で持ち越された時間 [秒]
+		double m_accumulator = 0.0;
+
+		double m_interpolationAlpha = 1.0;
+
+		P2Profile m_profile;
+
+		void step(double timeStep, int32 velocityIterations, int32 positionIterations);
+
 		P2BodyID generateNextID();
 
+		[[nodiscard]] static P2BodyID GetBodyID(const b2Fixture* fixture);
+
+		[[nodiscard]] static P2RaycastHit MakeHit(const b2Fixture* fixture, const b2Vec2& point, const b2Vec2& normal, float32 fraction);
+
 	public:
 
 		P2WorldDetail(const Vec2& gravity);
 
 		void update(double timeStep, int32 velocityIterations, int32 positionIterations);
 
+		size_t updateFixed(double deltaTime, double timeStep, size_t maxSubSteps, int32 velocityIterations, int32 positionIterations);
+
+		[[nodiscard]] double getInterpolationAlpha() const;
+
+		[[nodiscard]] const P2Profile& getProfile() const;
+
 		[[nodiscard]] P2Body createDummy(P2World& world, const Vec2& center, P2BodyType bodyType);
 
 		[[nodiscard]] P2Body createLine(P2World& world, const Vec2& center, const Line& line, const P2Material& material, const P2Filter& filter, P2BodyType bodyType);
@@ -63,6 +82,23 @@ namespace s3d
 
 		[[nodiscard]] const HashTable<P2ContactPair, P2Collision>& getCollisions() const;
 
+		[[nodiscard]] Array<P2BodyID> queryAABB(const RectF& rect, const P2Filter& filter) const;
+
+		// shapes はワールド座標の凸多角形または円
+		[[nodiscard]] Array<P2BodyID> queryOverlap(const Array<const b2Shape*>& shapes, const P2Filter& filter) const;
+
+		[[nodiscard]] Optional<P2RaycastHit> raycast(const Vec2& start, const Vec2& end, const P2Filter& filter) const;
+
+		[[nodiscard]] Array<Optional<P2RaycastHit>> raycast(const Array<Line>& rays, const P2Filter& filter) const;
+
+		[[nodiscard]] Array<P2RaycastHit> raycastAll(const Vec2& start, const Vec2& end, const P2Filter& filter) const;
+
+		[[nodiscard]] Optional<P2RaycastHit> circleCast(const Circle& circle, const Vec2& translation, const P2Filter& filter) const;
+
+		void takeSnapshot(P2WorldSnapshot& snapshot) const;
+
+		[[nodiscard]] bool restoreSnapshot(const P2WorldSnapshot& snapshot);
+
 		[[nodiscard]] b2World& getData();
 
 		[[nodiscard]] const b2World& getData() const;
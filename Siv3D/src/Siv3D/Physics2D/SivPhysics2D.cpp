@@ -12,9 +12,12 @@
 # include <Siv3D/Physics2D.hpp>
 # include <Siv3D/Circle.hpp>
 # include <Siv3D/Triangle.hpp>
+# include <Siv3D/Quad.hpp>
 # include <Siv3D/Polygon.hpp>
 # include <Siv3D/Graphics2D.hpp>
 # include <Siv3D/MultiPolygon.hpp>
+# include <Siv3D/Mat3x2.hpp>
+# include <Siv3D/FrameProfiler.hpp>
 # include "Physics2DUtility.hpp"
 # include "P2WorldDetail.hpp"
 # include "P2BodyDetail.hpp"
@@ -26,6 +29,27 @@
 
 namespace s3d
 {
+	namespace detail
+	{
+		// b2PolygonShape::Set() は退化した三角形で assert し、リリースビルドでは代わりに 2x2 の四角形を作ってしまう。
+		// 最も長い辺を底辺とした高さが b2_linearSlop 以下の三角形は作らずに false を返す
+		[[nodiscard]] static bool SetTriangle(b2PolygonShape& shape, const Vec2& p0, const Vec2& p1, const Vec2& p2)
+		{
+			const double longestEdgeSq = Max({ p0.distanceFromSq(p1), p1.distanceFromSq(p2), p2.distanceFromSq(p0) });
+			const double doubleArea = std::abs((p1 - p0).cross(p2 - p0));
+
+			if ((doubleArea * doubleArea) <= (longestEdgeSq * (b2_linearSlop * b2_linearSlop)))
+			{
+				return false;
+			}
+
+			const b2Vec2 points[3] = { ToB2Vec2(p0), ToB2Vec2(p1), ToB2Vec2(p2) };
+			shape.Set(points, 3);
+
+			return true;
+		}
+	}
+
 	std::array<P2Contact, 2>::const_iterator P2Collision::begin() const noexcept
 	{
 		return contacts.begin();
@@ -36,6 +60,29 @@ namespace s3d
 		return contacts.begin() + num_contacts;
 	}
 
+	////////////////////////////////////////////////
+	//
+	// P2WorldSnapshot
+	//
+	////////////////////////////////////////////////
+
+	bool P2WorldSnapshot::isEmpty() const noexcept
+	{
+		return m_data.isEmpty();
+	}
+
+	size_t P2WorldSnapshot::size_bytes() const noexcept
+	{
+		return m_data.size_bytes();
+	}
+
+	void P2WorldSnapshot::clear()
+	{
+		m_data.clear();
+
+		m_worldSize = 0;
+	}
+
 	////////////////////////////////////////////////
 	//
 	// P2World
@@ -86,9 +133,28 @@ namespace s3d
 
 	void P2World::update(const double timeStep, const int32 velocityIterations, const int32 positionIterations) const
 	{
+		SIV3D_PROFILE_ZONE(U"Physics2D::update");
+
 		return pImpl->update(timeStep, velocityIterations, positionIterations);
 	}
 
+	size_t P2World::updateFixed(const double deltaTime, const double timeStep, const size_t maxSubSteps, const int32 velocityIterations, const int32 positionIterations) const
+	{
+		SIV3D_PROFILE_ZONE(U"Physics2D::updateFixed");
+
+		return pImpl->updateFixed(deltaTime, timeStep, maxSubSteps, velocityIterations, positionIterations);
+	}
+
+	double P2World::getInterpolationAlpha() const
+	{
+		return pImpl->getInterpolationAlpha();
+	}
+
+	const P2Profile& P2World::getProfile() const
+	{
+		return pImpl->getProfile();
+	}
+
 	P2Body P2World::createDummy(const Vec2& center, const P2BodyType bodyType)
 	{
 		return pImpl->createDummy(*this, center, bodyType);
@@ -377,6 +443,89 @@ namespace s3d
 		return pImpl->getCollisions();
 	}
 
+	Array<P2BodyID> P2World::queryAABB(const RectF& rect, const P2Filter& filter) const
+	{
+		return pImpl->queryAABB(rect, filter);
+	}
+
+	Array<P2BodyID> P2World::queryOverlap(const Circle& circle, const P2Filter& filter) const
+	{
+		b2CircleShape shape;
+		shape.m_p = detail::ToB2Vec2(circle.center);
+		shape.m_radius = static_cast<float32>(circle.r);
+
+		return pImpl->queryOverlap({ &shape }, filter);
+	}
+
+	Array<P2BodyID> P2World::queryOverlap(const Quad& quad, const P2Filter& filter) const
+	{
+		// 凸包にすると凹んだ Quad を広く判定してしまうため、Quad::intersects() と同じ 2 つの三角形に分けて調べる
+		std::array<b2PolygonShape, 2> triangles;
+		Array<const b2Shape*> shapes;
+
+		if (detail::SetTriangle(triangles[0], quad.p0, quad.p1, quad.p3))
+		{
+			shapes.push_back(&triangles[0]);
+		}
+
+		if (detail::SetTriangle(triangles[1], quad.p1, quad.p2, quad.p3))
+		{
+			shapes.push_back(&triangles[1]);
+		}
+
+		return pImpl->queryOverlap(shapes, filter);
+	}
+
+	Array<P2BodyID> P2World::queryOverlap(const Polygon& polygon, const P2Filter& filter) const
+	{
+		// 凸でない多角形もあるため、三角形ごとに調べる
+		Array<b2PolygonShape> triangles(polygon.num_triangles());
+		Array<const b2Shape*> shapes;
+		shapes.reserve(triangles.size());
+
+		for (size_t i = 0; i < triangles.size(); ++i)
+		{
+			const auto triangle = polygon.triangle(i);
+
+			if (detail::SetTriangle(triangles[i], triangle.p0, triangle.p1, triangle.p2))
+			{
+				shapes.push_back(&triangles[i]);
+			}
+		}
+
+		return pImpl->queryOverlap(shapes, filter);
+	}
+
+	Optional<P2RaycastHit> P2World::raycast(const Vec2& start, const Vec2& end, const P2Filter& filter) const
+	{
+		return pImpl->raycast(start, end, filter);
+	}
+
+	Array<Optional<P2RaycastHit>> P2World::raycast(const Array<Line>& rays, const P2Filter& filter) const
+	{
+		return pImpl->raycast(rays, filter);
+	}
+
+	Array<P2RaycastHit> P2World::raycastAll(const Vec2& start, const Vec2& end, const P2Filter& filter) const
+	{
+		return pImpl->raycastAll(start, end, filter);
+	}
+
+	Optional<P2RaycastHit> P2World::circleCast(const Circle& circle, const Vec2& translation, const P2Filter& filter) const
+	{
+		return pImpl->circleCast(circle, translation, filter);
+	}
+
+	void P2World::takeSnapshot(P2WorldSnapshot& snapshot) const
+	{
+		pImpl->takeSnapshot(snapshot);
+	}
+
+	bool P2World::restoreSnapshot(const P2WorldSnapshot& snapshot)
+	{
+		return pImpl->restoreSnapshot(snapshot);
+	}
+
 	b2World* P2World::getWorldPtr() const
 	{
 		return pImpl->getWorldPtr();
@@ -749,6 +898,41 @@ namespace s3d
 		return{ detail::ToVec2(pImpl->getBody().GetPosition()), pImpl->getBody().GetAngle() };
 	}
 
+	Vec2 P2Body::getInterpolatedPos() const
+	{
+		return getInterpolatedTransform().first;
+	}
+
+	double P2Body::getInterpolatedAngle() const
+	{
+		return getInterpolatedTransform().second;
+	}
+
+	std::pair<Vec2, double> P2Body::getInterpolatedTransform() const
+	{
+		if (isEmpty())
+		{
+			return{ Vec2(0,0), 0.0 };
+		}
+
+		return pImpl->getInterpolatedTransform();
+	}
+
+	Mat3x2 P2Body::getInterpolationMat() const
+	{
+		if (isEmpty())
+		{
+			return Mat3x2::Identity();
+		}
+
+		const auto [currentPos, currentAngle] = getTransform();
+		const auto [interpolatedPos, interpolatedAngle] = getInterpolatedTransform();
+
+		return Mat3x2::Translate(-currentPos)
+			.rotated(interpolatedAngle - currentAngle)
+			.translated(interpolatedPos);
+	}
+
 	P2Body& P2Body::setVelocity(const Vec2& v)
 	{
 		if (isEmpty())
@@ -38,6 +38,7 @@ SIV3D_DISABLE_MSVC_WARNINGS_POP()
 # include <Earcut/earcut.hpp>
 # include <Siv3DEngine.hpp>
 # include <Siv3D/LineString.hpp>
+# include <Siv3D/Threading.hpp>
 # include <Renderer2D/IRenderer2D.hpp>
 
 // Earcut s3d::Vec2 adapter
@@ -112,7 +113,7 @@ namespace s3d
 			return std::abs((p0.x - p2.x) * (p1.y - p0.y) - (p0.x - p1.x) * (p2.y - p0.y)) * 0.5;
 		}
 
-		static void Triangulate(const Array<Vec2>& outer, const Array<Array<Vec2>>& holes, Array<Float2>& dstVertices, Array<uint16>& dstIndices)
+		static void Triangulate(const Array<Vec2>& outer, const Array<Array<Vec2>>& holes, Array<Float2>& dstVertices, std::variant<Array<Polygon::IndexType>, Array<uint32>>& dstIndices)
 		{
 			Array<Vec2> vertices = outer;
 			for (const auto& hole : holes)
@@ -128,7 +129,15 @@ namespace s3d
 			}
 
 			dstVertices.insert(dstVertices.end(), vertices.begin(), vertices.end());
-			dstIndices = mapbox::earcut<uint16>(polygon);
+
+			if (Largest<Polygon::IndexType> < dstVertices.size())
+			{
+				dstIndices.emplace<Array<uint32>>() = mapbox::earcut<uint32>(polygon);
+			}
+			else
+			{
+				dstIndices.emplace<Array<Polygon::IndexType>>() = mapbox::earcut<Polygon::IndexType>(polygon);
+			}
 		}
 	}
 
@@ -166,7 +175,7 @@ namespace s3d
 		detail::Triangulate(m_polygon.outer(), m_holes, m_vertices, m_indices);
 	}
 
-	Polygon::PolygonDetail::PolygonDetail(const Vec2* pOuterVertex, size_t vertexSize, const Array<uint16>& indices, const RectF& boundingRect, const bool checkValidity)
+	Polygon::PolygonDetail::PolygonDetail(const Vec2* pOuterVertex, size_t vertexSize, const Array<IndexType>& indices, const RectF& boundingRect, const bool checkValidity)
 	{
 		if (vertexSize < 3)
 		{
@@ -188,7 +197,7 @@ namespace s3d
 		m_indices = indices;
 	}
 
-	Polygon::PolygonDetail::PolygonDetail(const Float2* const pOuterVertex, const size_t vertexSize, const Array<uint16>& indices, const bool checkValidity)
+	Polygon::PolygonDetail::PolygonDetail(const Float2* const pOuterVertex, const size_t vertexSize, const Array<IndexType>& indices, const bool checkValidity)
 	{
 		if (vertexSize < 3)
 		{
@@ -210,7 +219,7 @@ namespace s3d
 		m_indices = indices;
 	}
 
-	Polygon::PolygonDetail::PolygonDetail(const Array<Vec2>& outer, const Array<Array<Vec2>>& holes, const Array<Float2>& vertices, const Array<uint16>& indices, const RectF& boundingRect, const bool checkValidity)
+	Polygon::PolygonDetail::PolygonDetail(const Array<Vec2>& outer, const Array<Array<Vec2>>& holes, const Array<Float2>& vertices, const Array<IndexType>& indices, const RectF& boundingRect, const bool checkValidity)
 	{
 		if (checkValidity
 			&& !IsValid(outer, holes))
@@ -234,6 +243,24 @@ namespace s3d
 		m_boundingRect = boundingRect;
 	}
 
+	Polygon::PolygonDetail::PolygonDetail(const Vec2* pOuterVertex, const size_t vertexSize, const Array<uint32>& indices, const RectF& boundingRect, const bool checkValidity)
+		: PolygonDetail(pOuterVertex, vertexSize, Array<IndexType>(), boundingRect, checkValidity)
+	{
+		if (m_vertices)
+		{
+			setIndices(indices);
+		}
+	}
+
+	Polygon::PolygonDetail::PolygonDetail(const Array<Vec2>& outer, const Array<Array<Vec2>>& holes, const Array<Float2>& vertices, const Array<uint32>& indices, const RectF& boundingRect, const bool checkValidity)
+		: PolygonDetail(outer, holes, vertices, Array<IndexType>(), boundingRect, checkValidity)
+	{
+		if (m_vertices)
+		{
+			setIndices(indices);
+		}
+	}
+
 	void Polygon::PolygonDetail::copyFrom(const PolygonDetail& other)
 	{
 		m_polygon = other.m_polygon;
@@ -534,25 +561,28 @@ namespace s3d
 
 	double Polygon::PolygonDetail::area() const
 	{
-		const size_t _num_triangles = m_indices.size() / 3;
+		return std::visit([this](const auto& _indices)
+		{
+			const size_t _num_triangles = _indices.size() / 3;
 
-		//const bool _hasHoles = !m_polygon.inners().empty();
+			//const bool _hasHoles = !m_polygon.inners().empty();
 
-		double result = 0.0;
+			double result = 0.0;
 
-		for (size_t index = 0; index < _num_triangles; ++index)
-		{
-			const uint32 indices[3] =
+			for (size_t index = 0; index < _num_triangles; ++index)
 			{
-				m_indices[index * 3 + 0],
-				m_indices[index * 3 + 1],
-				m_indices[index * 3 + 2],
-			};
+				const uint32 indices[3] =
+				{
+					_indices[index * 3 + 0],
+					_indices[index * 3 + 1],
+					_indices[index * 3 + 2],
+				};
 
-			result +=detail::TriangleArea(m_vertices[indices[0]], m_vertices[indices[1]], m_vertices[indices[2]]);
-		}
+				result +=detail::TriangleArea(m_vertices[indices[0]], m_vertices[indices[1]], m_vertices[indices[2]]);
+			}
 
-		return result;
+			return result;
+		}, m_indices);
 	}
 
 	double Polygon::PolygonDetail::perimeter() const
@@ -864,19 +894,57 @@ namespace s3d
 		return m_vertices;
 	}
 
-	const Array<uint16>& Polygon::PolygonDetail::indices() const
+	const Array<Polygon::IndexType>& Polygon::PolygonDetail::indices() const
+	{
+		if (const auto pIndices = std::get_if<Array<IndexType>>(&m_indices))
+		{
+			return *pIndices;
+		}
+
+		static const Array<IndexType> empty;
+
+		return empty;
+	}
+
+	const Array<uint32>& Polygon::PolygonDetail::indices32() const
+	{
+		if (const auto pIndices = std::get_if<Array<uint32>>(&m_indices))
+		{
+			return *pIndices;
+		}
+
+		static const Array<uint32> empty;
+
+		return empty;
+	}
+
+	size_t Polygon::PolygonDetail::num_triangles() const
+	{
+		return std::visit([](const auto& indices) { return indices.size() / 3; }, m_indices);
+	}
+
+	Triangle Polygon::PolygonDetail::triangle(const size_t index) const
 	{
-		return m_indices;
+		return std::visit([this, index](const auto& indices)
+		{
+			return Triangle(m_vertices[indices[index * 3]], m_vertices[indices[index * 3 + 1]], m_vertices[indices[index * 3 + 2]]);
+		}, m_indices);
 	}
 
 	void Polygon::PolygonDetail::draw(const ColorF& color) const
 	{
-		Siv3DEngine::Get<ISiv3DRenderer2D>()->addShape2D(m_vertices, m_indices, none, color.toFloat4());
+		std::visit([&](const auto& indices)
+		{
+			Siv3DEngine::Get<ISiv3DRenderer2D>()->addShape2D(m_vertices, indices, none, color.toFloat4());
+		}, m_indices);
 	}
 
 	void Polygon::PolygonDetail::draw(const Vec2& offset, const ColorF& color) const
 	{
-		Siv3DEngine::Get<ISiv3DRenderer2D>()->addShape2D(m_vertices, m_indices, Float2(offset), color.toFloat4());
+		std::visit([&](const auto& indices)
+		{
+			Siv3DEngine::Get<ISiv3DRenderer2D>()->addShape2D(m_vertices, indices, Float2(offset), color.toFloat4());
+		}, m_indices);
 	}
 
 	void Polygon::PolygonDetail::drawFrame(double thickness, const ColorF& color) const
@@ -947,7 +1015,10 @@ namespace s3d
 
 	void Polygon::PolygonDetail::drawTransformed(const double s, const double c, const Vec2& pos, const ColorF& color) const
 	{
-		Siv3DEngine::Get<ISiv3DRenderer2D>()->addShape2DTransformed(m_vertices, m_indices, static_cast<float>(s), static_cast<float>(c), Float2(pos), color.toFloat4());
+		std::visit([&](const auto& indices)
+		{
+			Siv3DEngine::Get<ISiv3DRenderer2D>()->addShape2DTransformed(m_vertices, indices, static_cast<float>(s), static_cast<float>(c), Float2(pos), color.toFloat4());
+		}, m_indices);
 	}
 
 	const gPolygon& Polygon::PolygonDetail::getPolygon() const
@@ -955,6 +1026,18 @@ namespace s3d
 		return m_polygon;
 	}
 
+	void Polygon::PolygonDetail::setIndices(const Array<uint32>& indices)
+	{
+		if (Largest<IndexType> < m_vertices.size())
+		{
+			m_indices = indices;
+		}
+		else
+		{
+			m_indices = indices.map([](const uint32 index) { return static_cast<IndexType>(index); });
+		}
+	}
+
 	LineString LineString::densified(const double maxDistance) const
 	{
 		gLineString input(begin(), end()), result;
@@ -1043,7 +1126,7 @@ namespace s3d
 
 	namespace detail
 	{
-		static Polygon ToPolygon(const gPolygon& polygon)
+		Polygon ToPolygon(const gPolygon& polygon)
 		{
 			auto& outer = polygon.outer();
 
@@ -1060,6 +1143,146 @@ namespace s3d
 
 			return Polygon(outer, holes);
 		}
+
+		Array<Polygon> ToPolygons(const gMultiPolygon& multiPolygon)
+		{
+			Array<Polygon> results(multiPolygon.size());
+
+			Threading::ParallelFor(0, results.size(), [&](const size_t i)
+			{
+				results[i] = ToPolygon(multiPolygon[i]);
+			}, 1);
+
+			return results;
+		}
+
+		static uint32 ZOrder(uint32 x, uint32 y) noexcept
+		{
+			const auto spread = [](uint32 n)
+			{
+				n = (n | (n << 8)) & 0x00FF00FF;
+				n = (n | (n << 4)) & 0x0F0F0F0F;
+				n = (n | (n << 2)) & 0x33333333;
+				n = (n | (n << 1)) & 0x55555555;
+				return n;
+			};
+
+			return (spread(x) | (spread(y) << 1));
+		}
+
+		// 空でない多角形を、バウンディングボックスの中心の Z 順に並べる
+		static Array<const Polygon*> SortByZOrder(const Array<Polygon>& polygons)
+		{
+			Array<std::pair<uint32, const Polygon*>> sorted;
+
+			double left = Inf<double>, top = Inf<double>, right = -Inf<double>, bottom = -Inf<double>;
+
+			for (const auto& polygon : polygons)
+			{
+				if (polygon.isEmpty())
+				{
+					continue;
+				}
+
+				const RectF& rect = polygon.boundingRect();
+				left	= std::min(left, rect.x);
+				top		= std::min(top, rect.y);
+				right	= std::max(right, rect.x + rect.w);
+				bottom	= std::max(bottom, rect.y + rect.h);
+
+				sorted.emplace_back(0, &polygon);
+			}
+
+			// 近いもの同士が隣り合うので、重なりやすいもの同士が先に合わさる
+			const double sx = (left < right) ? (65535.0 / (right - left)) : 0.0;
+			const double sy = (top < bottom) ? (65535.0 / (bottom - top)) : 0.0;
+
+			for (auto& [key, pPolygon] : sorted)
+			{
+				const Vec2 center = pPolygon->boundingRect().center();
+				key = ZOrder(static_cast<uint32>((center.x - left) * sx), static_cast<uint32>((center.y - top) * sy));
+			}
+
+			std::stable_sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+			return sorted.map([](const auto& p) { return p.second; });
+		}
+
+		static gMultiPolygon ReduceUnion(Array<gMultiPolygon> pieces)
+		{
+			while (pieces.size() > 1)
+			{
+				Array<gMultiPolygon> merged((pieces.size() + 1) / 2);
+
+				Threading::ParallelFor(0, merged.size(), [&](const size_t i)
+				{
+					if ((i * 2 + 1) < pieces.size())
+					{
+						boost::geometry::union_(pieces[i * 2], pieces[i * 2 + 1], merged[i]);
+					}
+					else
+					{
+						merged[i] = std::move(pieces[i * 2]);
+					}
+				}, 1);
+
+				pieces = std::move(merged);
+			}
+
+			if (pieces.isEmpty())
+			{
+				return gMultiPolygon();
+			}
+
+			return std::move(pieces.front());
+		}
+
+		gMultiPolygon UnionAll(const Array<Polygon>& polygons)
+		{
+			const Array<const Polygon*> sorted = SortByZOrder(polygons);
+
+			Array<gMultiPolygon> pieces(sorted.size());
+
+			for (size_t i = 0; i < sorted.size(); ++i)
+			{
+				pieces[i].push_back(sorted[i]->_detail()->getPolygon());
+			}
+
+			return ReduceUnion(std::move(pieces));
+		}
+
+		gMultiPolygon BufferAll(const Array<Polygon>& polygons, const double distance, const bool round)
+		{
+			const Array<const Polygon*> sorted = SortByZOrder(polygons);
+
+			Array<gMultiPolygon> pieces(sorted.size());
+
+			// Polygon::calculateBuffer() と異なり、結果が複数の多角形に分かれても捨てない
+			Threading::ParallelFor(0, sorted.size(), [&](const size_t i)
+			{
+				const boost::geometry::strategy::buffer::distance_symmetric<double> distance_strategy(distance);
+				const boost::geometry::strategy::buffer::end_round end_strategy(0);
+				const boost::geometry::strategy::buffer::point_circle circle_strategy(0);
+				const boost::geometry::strategy::buffer::side_straight side_strategy;
+
+				const gPolygon& polygon = sorted[i]->_detail()->getPolygon();
+
+				if (round)
+				{
+					const boost::geometry::strategy::buffer::join_round_by_divide join_strategy(4);
+
+					boost::geometry::buffer(polygon, pieces[i], distance_strategy, side_strategy, join_strategy, end_strategy, circle_strategy);
+				}
+				else
+				{
+					const boost::geometry::strategy::buffer::join_miter join_strategy;
+
+					boost::geometry::buffer(polygon, pieces[i], distance_strategy, side_strategy, join_strategy, end_strategy, circle_strategy);
+				}
+			}, 1);
+
+			return ReduceUnion(std::move(pieces));
+		}
 	}
 
 	namespace Geometry2D
@@ -1114,6 +1337,29 @@ namespace s3d
 			return results.map(detail::ToPolygon);
 		}
 
+		Array<Polygon> Or(const Array<Polygon>& polygons)
+		{
+			return detail::ToPolygons(detail::UnionAll(polygons));
+		}
+
+		Array<Polygon> Subtract(const Array<Polygon>& a, const Array<Polygon>& b)
+		{
+			const gMultiPolygon unionA = detail::UnionAll(a);
+
+			if (unionA.empty())
+			{
+				return{};
+			}
+
+			const gMultiPolygon unionB = detail::UnionAll(b);
+
+			gMultiPolygon results;
+
+			boost::geometry::difference(unionA, unionB, results);
+
+			return detail::ToPolygons(results);
+		}
+
 		double FrechetDistance(const LineString& a, const LineString& b)
 		{
 			if (a.isEmpty() || b.isEmpty())
@@ -10,6 +10,7 @@
 //-----------------------------------------------
 
 # pragma once
+# include <variant>
 # include <boost/geometry/geometries/geometries.hpp>
 # include <boost/geometry/geometries/register/point.hpp>
 # include <Siv3D/Polygon.hpp>
@@ -24,6 +25,8 @@ namespace s3d
 	using gRing			= boost::geometry::model::ring<Vec2, false, false, Array>;
 	using gLineString	= boost::geometry::model::linestring<Vec2, Array>;
 	using gMultiPoint	= boost::geometry::model::multi_point<Vec2>;
+	using gMultiPolygon	= boost::geometry::model::multi_polygon<gPolygon, Array>;
+	using gBox			= boost::geometry::model::box<Vec2>;
 
 	class Polygon::PolygonDetail
 	{
@@ -37,7 +40,11 @@ namespace s3d
 
 		Array<Float2> m_vertices;
 
-		Array<uint16> m_indices;
+		// 頂点数が 16-bit に収まらない場合だけ 32-bit で持つ
+		std::variant<Array<IndexType>, Array<uint32>> m_indices;
+
+		// m_vertices を設定した後に呼ぶ
+		void setIndices(const Array<uint32>& indices);
 
 	public:
 
@@ -45,11 +52,15 @@ namespace s3d
 
 		PolygonDetail(const Vec2* pVertex, size_t vertexSize, Array<Array<Vec2>> holes, bool checkValidity);
 
-		PolygonDetail(const Vec2* pOuterVertex, size_t vertexSize, const Array<uint16>& indices, const RectF& boundingRect, bool checkValidity);
+		PolygonDetail(const Vec2* pOuterVertex, size_t vertexSize, const Array<IndexType>& indices, const RectF& boundingRect, bool checkValidity);
+
+		PolygonDetail(const Float2* pOuterVertex, size_t vertexSize, const Array<IndexType>& indices, bool checkValidity);
+
+		PolygonDetail(const Array<Vec2>& outer, const Array<Array<Vec2>>& holes, const Array<Float2>& vertices, const Array<IndexType>& indices, const RectF& boundingRect, bool checkValidity);
 
-		PolygonDetail(const Float2* pOuterVertex, size_t vertexSize, const Array<uint16>& indices, bool checkValidity);
+		PolygonDetail(const Vec2* pOuterVertex, size_t vertexSize, const Array<uint32>& indices, const RectF& boundingRect, bool checkValidity);
 
-		PolygonDetail(const Array<Vec2>& outer, const Array<Array<Vec2>>& holes, const Array<Float2>& vertices, const Array<uint16>& indices, const RectF& boundingRect, bool checkValidity);
+		PolygonDetail(const Array<Vec2>& outer, const Array<Array<Vec2>>& holes, const Array<Float2>& vertices, const Array<uint32>& indices, const RectF& boundingRect, bool checkValidity);
 
 		void copyFrom(const PolygonDetail& other);
 
@@ -91,7 +102,13 @@ namespace s3d
 
 		const Array<Float2>& vertices() const;
 
-		const Array<uint16>& indices() const;
+		const Array<IndexType>& indices() const;
+
+		const Array<uint32>& indices32() const;
+
+		size_t num_triangles() const;
+
+		Triangle triangle(size_t index) const;
 
 		void draw(const ColorF& color) const;
 
@@ -105,4 +122,18 @@ namespace s3d
 
 		const gPolygon& getPolygon() const;
 	};
+
+	namespace detail
+	{
+		[[nodiscard]] Polygon ToPolygon(const gPolygon& polygon);
+
+		// 三角形分割を並列に行う
+		[[nodiscard]] Array<Polygon> ToPolygons(const gMultiPolygon& multiPolygon);
+
+		// 近いもの同士から 2 つずつ並列に合わせることを繰り返す
+		[[nodiscard]] gMultiPolygon UnionAll(const Array<Polygon>& polygons);
+
+		// 各多角形を並列に広げてから UnionAll() と同じ方法で合わせる
+		[[nodiscard]] gMultiPolygon BufferAll(const Array<Polygon>& polygons, double distance, bool round);
+	}
 }
@@ -149,13 +149,25 @@ namespace s3d
 
 	}
 
-	Polygon::Polygon(const Array<Vec2>& outer, const Array<uint16>& indices, const RectF& boundingRect, const bool checkValidity)
+	Polygon::Polygon(const Array<Vec2>& outer, const Array<IndexType>& indices, const RectF& boundingRect, const bool checkValidity)
 		: pImpl(std::make_unique<PolygonDetail>(outer.data(), outer.size(), indices, boundingRect, checkValidity))
 	{
 
 	}
 
-	Polygon::Polygon(const Array<Vec2>& outer, const Array<Array<Vec2>>& holes, const Array<Float2>& vertices, const Array<uint16>& indices, const RectF& boundingRect, const bool checkValidity)
+	Polygon::Polygon(const Array<Vec2>& outer, const Array<Array<Vec2>>& holes, const Array<Float2>& vertices, const Array<IndexType>& indices, const RectF& boundingRect, const bool checkValidity)
+		: pImpl(std::make_unique<PolygonDetail>(outer, holes, vertices, indices, boundingRect, checkValidity))
+	{
+
+	}
+
+	Polygon::Polygon(const Array<Vec2>& outer, const Array<uint32>& indices, const RectF& boundingRect, const bool checkValidity)
+		: pImpl(std::make_unique<PolygonDetail>(outer.data(), outer.size(), indices, boundingRect, checkValidity))
+	{
+
+	}
+
+	Polygon::Polygon(const Array<Vec2>& outer, const Array<Array<Vec2>>& holes, const Array<Float2>& vertices, const Array<uint32>& indices, const RectF& boundingRect, const bool checkValidity)
 		: pImpl(std::make_unique<PolygonDetail>(outer, holes, vertices, indices, boundingRect, checkValidity))
 	{
 
@@ -227,11 +239,16 @@ namespace s3d
 		return pImpl->vertices();
 	}
 
-	const Array<uint16>& Polygon::indices() const
+	const Array<Polygon::IndexType>& Polygon::indices() const
 	{
 		return pImpl->indices();
 	}
 
+	const Array<uint32>& Polygon::indices32() const
+	{
+		return pImpl->indices32();
+	}
+
 	const RectF& Polygon::boundingRect() const
 	{
 		return pImpl->boundingRect();
@@ -239,14 +256,12 @@ namespace s3d
 
 	size_t Polygon::num_triangles() const
 	{
-		return pImpl->indices().size() / 3;
+		return pImpl->num_triangles();
 	}
 
 	Triangle Polygon::triangle(const size_t index) const
 	{
-		const auto& vertices = pImpl->vertices();
-		const auto& indices = pImpl->indices();
-		return{ vertices[indices[index * 3]], vertices[indices[index * 3 + 1]], vertices[indices[index * 3 + 2]] };
+		return pImpl->triangle(index);
 	}
 
 	Polygon& Polygon::addHole(const Array<Vec2>& hole)
@@ -514,16 +529,11 @@ namespace s3d
 			return *this;
 		}
 
-		const auto& vertices = pImpl->vertices();
-		const auto& indices = pImpl->indices();
-
-		const size_t num_triangles = indices.size() / 3;
-		const Float2* pVertex = vertices.data();
-		const uint16* pIndex = indices.data();
+		const size_t num_triangles = pImpl->num_triangles();
 
 		for (size_t i = 0; i < num_triangles; ++i)
 		{
-			Triangle(pVertex[pIndex[i * 3]], pVertex[pIndex[i * 3 + 1]], pVertex[pIndex[i * 3 + 2]]).drawFrame(thickness, color);
+			pImpl->triangle(i).drawFrame(thickness, color);
 		}
 
 		return *this;
@@ -541,16 +551,11 @@ namespace s3d
 			return;
 		}
 
-		const auto& vertices = pImpl->vertices();
-		const auto& indices = pImpl->indices();
-
-		const size_t num_triangles = indices.size() / 3;
-		const Float2* pVertex = vertices.data();
-		const uint16* pIndex = indices.data();
+		const size_t num_triangles = pImpl->num_triangles();
 
 		for (size_t i = 0; i < num_triangles; ++i)
 		{
-			Triangle(pVertex[pIndex[i * 3]], pVertex[pIndex[i * 3 + 1]], pVertex[pIndex[i * 3 + 2]])
+			pImpl->triangle(i)
 				.moveBy(pos)
 				.drawFrame(thickness, color);
 		}
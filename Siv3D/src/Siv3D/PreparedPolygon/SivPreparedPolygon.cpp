@@ -0,0 +1,303 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/PreparedPolygon.hpp>
+# include <Siv3D/Rectangle.hpp>
+# include <Siv3D/Mouse.hpp>
+# include <Siv3D/Cursor.hpp>
+
+namespace s3d
+{
+	namespace detail
+	{
+		// 1 つの帯に入る辺の数の目安
+		constexpr size_t EdgesPerBand = 2;
+
+		constexpr size_t MaxBands = (1 << 16);
+
+		// 縦に長い辺が多くの帯に登録されてメモリを使いすぎないよう、登録の総数を辺の数のこの倍までに抑える
+		constexpr double MaxBandsPerEdge = 4.0;
+
+		// 帯の境界付近の交点を取りこぼさないよう、帯の範囲を少し広げる
+		constexpr double BandMargin = 1e-6;
+	}
+
+	PreparedPolygon::PreparedPolygon(const Polygon& polygon)
+		: m_polygon(polygon)
+	{
+		if (!m_polygon)
+		{
+			return;
+		}
+
+		addEdges(m_polygon.outer());
+
+		for (const auto& hole : m_polygon.inners())
+		{
+			addEdges(hole);
+		}
+
+		const RectF& rect = m_polygon.boundingRect();
+
+		double totalHeight = 0.0;
+
+		for (const auto& edge : m_edges)
+		{
+			totalHeight += std::abs(edge.end.y - edge.begin.y);
+		}
+
+		size_t numBands = (m_edges.size() / detail::EdgesPerBand);
+
+		// 1 つの辺が登録される帯の数は、平均して (辺の高さ / 帯の高さ + 1)
+		if (totalHeight > 0.0)
+		{
+			numBands = std::min(numBands, static_cast<size_t>(detail::MaxBandsPerEdge * m_edges.size() * rect.h / totalHeight));
+		}
+
+		numBands = Clamp<size_t>(numBands, 1, detail::MaxBands);
+
+		m_top = rect.y;
+
+		m_bandScale = (rect.h > 0.0) ? (numBands / rect.h) : 0.0;
+
+		// 各帯の辺の数を数えてから、詰めて並べる
+		m_bandOffsets.assign(numBands + 1, 0);
+
+		for (const auto& edge : m_edges)
+		{
+			const size_t first = bandIndex(std::min(edge.begin.y, edge.end.y));
+			const size_t last = bandIndex(std::max(edge.begin.y, edge.end.y));
+
+			for (size_t band = first; band <= last; ++band)
+			{
+				++m_bandOffsets[band + 1];
+			}
+		}
+
+		for (size_t band = 0; band < numBands; ++band)
+		{
+			m_bandOffsets[band + 1] += m_bandOffsets[band];
+		}
+
+		m_bandEdges.resize(m_bandOffsets.back());
+
+		Array<uint32> cursors(m_bandOffsets.begin(), m_bandOffsets.end() - 1);
+
+		for (size_t i = 0; i < m_edges.size(); ++i)
+		{
+			const Line& edge = m_edges[i];
+			const size_t first = bandIndex(std::min(edge.begin.y, edge.end.y));
+			const size_t last = bandIndex(std::max(edge.begin.y, edge.end.y));
+
+			for (size_t band = first; band <= last; ++band)
+			{
+				m_bandEdges[cursors[band]++] = static_cast<uint32>(i);
+			}
+		}
+	}
+
+	bool PreparedPolygon::isEmpty() const noexcept
+	{
+		return m_polygon.isEmpty();
+	}
+
+	const Polygon& PreparedPolygon::polygon() const noexcept
+	{
+		return m_polygon;
+	}
+
+	const RectF& PreparedPolygon::boundingRect() const noexcept
+	{
+		return m_polygon.boundingRect();
+	}
+
+	size_t PreparedPolygon::num_bands() const noexcept
+	{
+		return m_bandOffsets ? (m_bandOffsets.size() - 1) : 0;
+	}
+
+	bool PreparedPolygon::intersects(const Point& point) const
+	{
+		return contains(Vec2(point));
+	}
+
+	bool PreparedPolygon::intersects(const Vec2& point) const
+	{
+		return contains(point);
+	}
+
+	bool PreparedPolygon::intersects(const Line& line) const
+	{
+		if (!m_polygon || !Geometry2D::Intersect(line, m_polygon.boundingRect()))
+		{
+			return false;
+		}
+
+		// 線分全体が内部にある場合
+		if (contains(line.begin))
+		{
+			return true;
+		}
+
+		const double dx = (line.end.x - line.begin.x);
+		const double dy = (line.end.y - line.begin.y);
+		const size_t first = bandIndex(std::min(line.begin.y, line.end.y));
+		const size_t last = bandIndex(std::max(line.begin.y, line.end.y));
+
+		for (size_t band = first; band <= last; ++band)
+		{
+			double minX = std::min(line.begin.x, line.end.x);
+			double maxX = std::max(line.begin.x, line.end.x);
+
+			// 線分のうち、この帯に入る部分の x の範囲に絞る
+			if ((dy != 0.0) && (m_bandScale != 0.0))
+			{
+				const double margin = (detail::BandMargin / m_bandScale);
+				const double y0 = (m_top + band / m_bandScale - margin);
+				const double y1 = (m_top + (band + 1) / m_bandScale + margin);
+				const double t0 = Clamp((y0 - line.begin.y) / dy, 0.0, 1.0);
+				const double t1 = Clamp((y1 - line.begin.y) / dy, 0.0, 1.0);
+				const double x0 = (line.begin.x + dx * t0);
+				const double x1 = (line.begin.x + dx * t1);
+
+				minX = std::min(x0, x1) - margin;
+				maxX = std::max(x0, x1) + margin;
+			}
+
+			if (intersectsBand(band, line, minX, maxX))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	bool PreparedPolygon::contains(const Point& point) const
+	{
+		return contains(Vec2(point));
+	}
+
+	bool PreparedPolygon::contains(const Vec2& point) const
+	{
+		if (!m_polygon || !Geometry2D::Intersect(point, m_polygon.boundingRect()))
+		{
+			return false;
+		}
+
+		const size_t band = bandIndex(point.y);
+		const uint32* it = (m_bandEdges.data() + m_bandOffsets[band]);
+		const uint32* const itEnd = (m_bandEdges.data() + m_bandOffsets[band + 1]);
+
+		bool inside = false;
+
+		// point から +x 方向に伸ばした半直線と交わる辺の数の偶奇。point.y をまたぐ辺は、必ずこの帯に含まれている
+		for (; it != itEnd; ++it)
+		{
+			const Vec2& a = m_edges[*it].begin;
+			const Vec2& b = m_edges[*it].end;
+
+			if (((a.y > point.y) != (b.y > point.y))
+				&& (point.x < ((b.x - a.x) * (point.y - a.y) / (b.y - a.y) + a.x)))
+			{
+				inside = !inside;
+			}
+		}
+
+		return inside;
+	}
+
+	bool PreparedPolygon::leftClicked() const
+	{
+		return MouseL.down() && mouseOver();
+	}
+
+	bool PreparedPolygon::leftPressed() const
+	{
+		return MouseL.pressed() && mouseOver();
+	}
+
+	bool PreparedPolygon::leftReleased() const
+	{
+		return MouseL.up() && mouseOver();
+	}
+
+	bool PreparedPolygon::rightClicked() const
+	{
+		return MouseR.down() && mouseOver();
+	}
+
+	bool PreparedPolygon::rightPressed() const
+	{
+		return MouseR.pressed() && mouseOver();
+	}
+
+	bool PreparedPolygon::rightReleased() const
+	{
+		return MouseR.up() && mouseOver();
+	}
+
+	bool PreparedPolygon::mouseOver() const
+	{
+		return contains(Cursor::PosF());
+	}
+
+	void PreparedPolygon::addEdges(const Array<Vec2>& ring)
+	{
+		if (!ring)
+		{
+			return;
+		}
+
+		for (size_t i = 0; i < ring.size(); ++i)
+		{
+			m_edges.emplace_back(ring[i], ring[(i + 1) % ring.size()]);
+		}
+	}
+
+	size_t PreparedPolygon::bandIndex(const double y) const noexcept
+	{
+		const size_t numBands = (m_bandOffsets.size() - 1);
+
+		const double index = ((y - m_top) * m_bandScale);
+
+		if (index <= 0.0)
+		{
+			return 0;
+		}
+
+		return std::min(static_cast<size_t>(index), numBands - 1);
+	}
+
+	bool PreparedPolygon::intersectsBand(const size_t band, const Line& line, const double minX, const double maxX) const
+	{
+		const uint32* it = (m_bandEdges.data() + m_bandOffsets[band]);
+		const uint32* const itEnd = (m_bandEdges.data() + m_bandOffsets[band + 1]);
+
+		for (; it != itEnd; ++it)
+		{
+			const Line& edge = m_edges[*it];
+
+			if ((std::max(edge.begin.x, edge.end.x) < minX)
+				|| (maxX < std::min(edge.begin.x, edge.end.x)))
+			{
+				continue;
+			}
+
+			if (Geometry2D::Intersect(line, edge))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+}
@@ -13,7 +13,9 @@
 # include <Siv3D/Window.hpp>
 # include <Siv3D/MessageBox.hpp>
 # include <Siv3D/Scene.hpp>
+# include <Siv3D/Time.hpp>
 # include "CProfiler.hpp"
+# include "ProfilerRecorder.hpp"
 
 namespace s3d
 {
@@ -33,11 +35,19 @@ namespace s3d
 
 		m_fpsStopwatch.start();
 
+		// メインスレッドのスレッド番号を 0 にする
+		ProfilerRecorder::RegisterCurrentThread();
+
 		LOG_INFO(U"ℹ️ CProfiler initialized");
 	}
 
 	bool CProfiler::beginFrame()
 	{
+		//
+		// Frame capture
+		//
+		updateCapture();
+
 		//
 		// FPS
 		//
@@ -110,6 +120,18 @@ namespace s3d
 		m_currentStatistics.triangles += triangles;
 	}
 
+	void CProfiler::reportMergedDrawcalls(const size_t mergedDrawcalls)
+	{
+		m_currentStatistics.mergedDrawcalls += mergedDrawcalls;
+	}
+
+	void CProfiler::reportSpriteBatchUploads(const size_t uploadedBytes, const size_t batchSplits)
+	{
+		m_currentStatistics.uploadedBytes += uploadedBytes;
+
+		m_currentStatistics.batchSplits += batchSplits;
+	}
+
 	Statistics CProfiler::getStatistics() const noexcept
 	{
 		return m_previousStatistics;
@@ -124,4 +146,86 @@ namespace s3d
 	{
 		++m_assetReleaseCount[0];
 	}
+
+	void CProfiler::beginCapture(const size_t frames)
+	{
+		m_captureRequestFrames = frames;
+	}
+
+	bool CProfiler::isCapturing() const
+	{
+		return (m_captureRequestFrames || m_captureRemainingFrames);
+	}
+
+	const ProfilerCapture& CProfiler::getCapture()
+	{
+		if (m_capturePending)
+		{
+			finishCapture();
+		}
+
+		return m_capture;
+	}
+
+	void CProfiler::updateCapture()
+	{
+		const uint64 nanosec = Time::GetNanosec();
+
+		if (m_captureRemainingFrames)
+		{
+			ProfilerRecorder::Drain(m_capturing);
+
+			if (--m_captureRemainingFrames)
+			{
+				m_capturing.frameBeginNanosec << nanosec;
+				return;
+			}
+
+			// 最後のフレームの System::Update() の区間はこのあとに終了するので、取り出すのは次の機会にする
+			ProfilerRecorder::SetRecording(false);
+			m_captureEndNanosec = nanosec;
+			m_capturePending = true;
+			return;
+		}
+
+		if (m_capturePending)
+		{
+			finishCapture();
+		}
+
+		if (m_captureRequestFrames)
+		{
+			// 前回の計測の後に終了した区間を捨てる
+			ProfilerRecorder::Clear();
+
+			m_capturing = ProfilerCapture();
+			m_capturing.frameBeginNanosec << nanosec;
+			m_captureRemainingFrames = std::exchange(m_captureRequestFrames, 0);
+
+			ProfilerRecorder::SetRecording(true);
+		}
+	}
+
+	void CProfiler::finishCapture()
+	{
+		ProfilerRecorder::Drain(m_capturing);
+
+		const uint64 beginNanosec = m_capturing.frameBeginNanosec.front();
+		const uint64 endNanosec = m_captureEndNanosec;
+
+		// 計測の開始前に始まった区間と、計測の終了後に始まった区間を除く
+		m_capturing.events.remove_if([=](const ProfilerEvent& event)
+		{
+			return ((event.beginNanosec < beginNanosec) || (endNanosec <= event.beginNanosec));
+		});
+
+		m_capturing.events.stable_sort_by([](const ProfilerEvent& a, const ProfilerEvent& b)
+		{
+			return (a.beginNanosec < b.beginNanosec);
+		});
+
+		m_capture = std::move(m_capturing);
+		m_capturing = ProfilerCapture();
+		m_capturePending = false;
+	}
 }
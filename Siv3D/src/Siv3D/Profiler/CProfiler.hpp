@@ -12,6 +12,7 @@
 # pragma once
 # include <Siv3D/Profiler.hpp>
 # include <Siv3D/Stopwatch.hpp>
+# include <Siv3D/FrameProfiler.hpp>
 # include "IProfiler.hpp"
 
 namespace s3d
@@ -47,6 +48,26 @@ namespace s3d
 
 		std::array<int32, ReportFrameCount> m_assetReleaseCount{};
 
+		//
+		// Frame capture
+		//
+		size_t m_captureRequestFrames = 0;
+
+		size_t m_captureRemainingFrames = 0;
+
+		// 計測は終わったが、最後のフレームの区間をまだ取り出していない
+		bool m_capturePending = false;
+
+		uint64 m_captureEndNanosec = 0;
+
+		ProfilerCapture m_capturing;
+
+		ProfilerCapture m_capture;
+
+		void updateCapture();
+
+		void finishCapture();
+
 	public:
 
 		CProfiler();
@@ -71,6 +92,10 @@ namespace s3d
 		//
 		void reportDrawcalls(size_t drawcalls, size_t triangles) override;
 
+		void reportMergedDrawcalls(size_t mergedDrawcalls) override;
+
+		void reportSpriteBatchUploads(size_t uploadedBytes, size_t batchSplits) override;
+
 		Statistics getStatistics() const noexcept override;
 
 		//
@@ -81,5 +106,14 @@ namespace s3d
 		void reportAssetCreation() override;
 
 		void reportAssetRelease() override;
+
+		//
+		// Frame capture
+		//
+		void beginCapture(size_t frames) override;
+
+		bool isCapturing() const override;
+
+		const ProfilerCapture& getCapture() override;
 	};
 }
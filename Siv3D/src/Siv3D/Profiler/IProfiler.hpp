@@ -34,6 +34,10 @@ namespace s3d
 
 		virtual void reportDrawcalls(size_t drawcalls, size_t triangles) = 0;
 
+		virtual void reportMergedDrawcalls(size_t mergedDrawcalls) = 0;
+
+		virtual void reportSpriteBatchUploads(size_t uploadedBytes, size_t batchSplits) = 0;
+
 		virtual Statistics getStatistics() const noexcept = 0;
 
 		virtual void setAssetCreationWarningEnabled(bool enabled) = 0;
@@ -41,5 +45,11 @@ namespace s3d
 		virtual void reportAssetCreation() = 0;
 
 		virtual void reportAssetRelease() = 0;
+
+		virtual void beginCapture(size_t frames) = 0;
+
+		virtual bool isCapturing() const = 0;
+
+		virtual const ProfilerCapture& getCapture() = 0;
 	};
 }
@@ -0,0 +1,156 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <memory>
+# include <mutex>
+# include <Siv3D/Time.hpp>
+# include "ProfilerRecorder.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		static std::atomic<bool> g_recording = { false };
+
+		static std::mutex g_bufferMutex;
+
+		static Array<std::unique_ptr<ProfilerThreadBuffer>> g_buffers;
+
+		// スレッドの終了時にバッファを返却する
+		struct ProfilerThreadBufferOwner
+		{
+			ProfilerThreadBuffer* buffer = nullptr;
+
+			~ProfilerThreadBufferOwner()
+			{
+				if (buffer)
+				{
+					std::lock_guard lock(g_bufferMutex);
+
+					buffer->inUse = false;
+				}
+			}
+		};
+
+		static thread_local ProfilerThreadBuffer* t_buffer = nullptr;
+
+		static thread_local uint32 t_depth = 0;
+
+		[[nodiscard]] static ProfilerThreadBuffer* AcquireThreadBuffer()
+		{
+			static thread_local ProfilerThreadBufferOwner owner;
+
+			std::lock_guard lock(g_bufferMutex);
+
+			for (auto& buffer : g_buffers)
+			{
+				if (!buffer->inUse)
+				{
+					buffer->inUse = true;
+
+					return (owner.buffer = t_buffer = buffer.get());
+				}
+			}
+
+			auto buffer = std::make_unique<ProfilerThreadBuffer>();
+			buffer->threadIndex = static_cast<uint32>(g_buffers.size());
+			buffer->inUse = true;
+
+			owner.buffer = t_buffer = buffer.get();
+
+			g_buffers.push_back(std::move(buffer));
+
+			return t_buffer;
+		}
+
+		uint64 ProfilerZoneBegin() noexcept
+		{
+			if (!g_recording.load(std::memory_order_relaxed))
+			{
+				return 0;
+			}
+
+			++t_depth;
+
+			return Time::GetNanosec();
+		}
+
+		void ProfilerZoneEnd(const ProfilerZone& zone, const uint64 beginNanosec) noexcept
+		{
+			const uint64 endNanosec = Time::GetNanosec();
+			const uint32 depth = --t_depth;
+
+			ProfilerThreadBuffer* buffer = t_buffer;
+
+			if (!buffer)
+			{
+				try
+				{
+					buffer = AcquireThreadBuffer();
+				}
+				catch (...)
+				{
+					return;
+				}
+			}
+
+			buffer->push(ProfilerEvent{ &zone, beginNanosec, endNanosec, buffer->threadIndex, depth });
+		}
+	}
+
+	namespace ProfilerRecorder
+	{
+		void RegisterCurrentThread()
+		{
+			if (!detail::t_buffer)
+			{
+				(void)detail::AcquireThreadBuffer();
+			}
+		}
+
+		void SetRecording(const bool recording) noexcept
+		{
+			detail::g_recording.store(recording, std::memory_order_relaxed);
+		}
+
+		void Clear()
+		{
+			std::lock_guard lock(detail::g_bufferMutex);
+
+			for (auto& buffer : detail::g_buffers)
+			{
+				buffer->tail.store(buffer->head.load(std::memory_order_acquire), std::memory_order_release);
+
+				buffer->dropped.store(0, std::memory_order_relaxed);
+			}
+		}
+
+		void Drain(ProfilerCapture& capture)
+		{
+			std::lock_guard lock(detail::g_bufferMutex);
+
+			for (auto& buffer : detail::g_buffers)
+			{
+				const size_t head = buffer->head.load(std::memory_order_acquire);
+				size_t tail = buffer->tail.load(std::memory_order_relaxed);
+
+				for (; tail != head; ++tail)
+				{
+					capture.events.push_back(buffer->events[tail % detail::ProfilerThreadBuffer::Capacity]);
+				}
+
+				buffer->tail.store(head, std::memory_order_release);
+
+				capture.num_dropped += buffer->dropped.exchange(0, std::memory_order_relaxed);
+			}
+		}
+	}
+}
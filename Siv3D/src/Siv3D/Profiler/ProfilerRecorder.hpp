@@ -0,0 +1,70 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <array>
+# include <atomic>
+# include <Siv3D/FrameProfiler.hpp>
+
+namespace s3d
+{
+	namespace detail
+	{
+		// 1 スレッドが記録した区間を、メインスレッドが取り出すまで保持するリングバッファ
+		// 書き込みは所有するスレッドだけ、読み出しはメインスレッドだけが行う
+		struct ProfilerThreadBuffer
+		{
+			static constexpr size_t Capacity = 16384;
+
+			std::array<ProfilerEvent, Capacity> events;
+
+			std::atomic<size_t> head = { 0 };
+
+			std::atomic<size_t> tail = { 0 };
+
+			std::atomic<size_t> dropped = { 0 };
+
+			uint32 threadIndex = 0;
+
+			// 終了したスレッドのバッファは、次に登録されたスレッドが再利用する
+			bool inUse = false;
+
+			void push(const ProfilerEvent& event) noexcept
+			{
+				const size_t h = head.load(std::memory_order_relaxed);
+
+				if ((h - tail.load(std::memory_order_acquire)) == Capacity)
+				{
+					dropped.fetch_add(1, std::memory_order_relaxed);
+					return;
+				}
+
+				events[h % Capacity] = event;
+
+				head.store(h + 1, std::memory_order_release);
+			}
+		};
+	}
+
+	namespace ProfilerRecorder
+	{
+		// 現在のスレッドのバッファを確保する（メインスレッドの番号を 0 にするため）
+		void RegisterCurrentThread();
+
+		void SetRecording(bool recording) noexcept;
+
+		// すべてのスレッドのバッファを空にする
+		void Clear();
+
+		// すべてのスレッドのバッファに溜まった区間を capture に移す
+		void Drain(ProfilerCapture& capture);
+	}
+}
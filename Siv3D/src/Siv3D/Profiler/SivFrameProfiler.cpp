@@ -0,0 +1,132 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/FrameProfiler.hpp>
+# include <Siv3D/JSONWriter.hpp>
+# include <Siv3D/Unicode.hpp>
+
+namespace s3d
+{
+	namespace detail
+	{
+		static void WriteChromeTrace(const ProfilerCapture& capture, JSONWriter& json)
+		{
+			uint64 originNanosec = capture.frameBeginNanosec ? capture.frameBeginNanosec.front() : 0;
+			Array<bool> threads;
+
+			for (const auto& event : capture.events)
+			{
+				if (!capture.frameBeginNanosec)
+				{
+					originNanosec = originNanosec ? Min(originNanosec, event.beginNanosec) : event.beginNanosec;
+				}
+
+				if (threads.size() <= event.threadIndex)
+				{
+					threads.resize(event.threadIndex + 1, false);
+				}
+
+				threads[event.threadIndex] = true;
+			}
+
+			// タイムスタンプはマイクロ秒
+			const auto toMicrosec = [=](const uint64 nanosec)
+			{
+				return (static_cast<int64>(nanosec - originNanosec) / 1000.0);
+			};
+
+			json.startObject();
+			{
+				json.key(U"displayTimeUnit").write(U"ns");
+
+				json.key(U"traceEvents").startArray();
+				{
+					for (uint32 threadIndex = 0; threadIndex < threads.size(); ++threadIndex)
+					{
+						if (!threads[threadIndex])
+						{
+							continue;
+						}
+
+						json.startObject();
+						{
+							json.key(U"name").write(U"thread_name");
+							json.key(U"ph").write(U"M");
+							json.key(U"pid").write(1);
+							json.key(U"tid").write(threadIndex);
+							json.key(U"args").startObject();
+							{
+								json.key(U"name").write((threadIndex == 0) ? String(U"Main thread") : U"Thread {}"_fmt(threadIndex));
+							}
+							json.endObject();
+						}
+						json.endObject();
+					}
+
+					for (size_t frame = 0; frame < capture.frameBeginNanosec.size(); ++frame)
+					{
+						json.startObject();
+						{
+							json.key(U"name").write(U"Frame {}"_fmt(frame));
+							json.key(U"ph").write(U"i");
+							json.key(U"s").write(U"g");
+							json.key(U"ts").write(toMicrosec(capture.frameBeginNanosec[frame]));
+							json.key(U"pid").write(1);
+							json.key(U"tid").write(0);
+						}
+						json.endObject();
+					}
+
+					for (const auto& event : capture.events)
+					{
+						json.startObject();
+						{
+							json.key(U"name").write(event.zone->name);
+							json.key(U"cat").write(U"Siv3D");
+							json.key(U"ph").write(U"X");
+							json.key(U"ts").write(toMicrosec(event.beginNanosec));
+							json.key(U"dur").write((event.endNanosec - event.beginNanosec) / 1000.0);
+							json.key(U"pid").write(1);
+							json.key(U"tid").write(event.threadIndex);
+							json.key(U"args").startObject();
+							{
+								json.key(U"file").write(Unicode::Widen(event.zone->file));
+								json.key(U"line").write(event.zone->line);
+							}
+							json.endObject();
+						}
+						json.endObject();
+					}
+				}
+				json.endArray();
+			}
+			json.endObject();
+		}
+	}
+
+	String ProfilerCapture::toChromeTrace() const
+	{
+		JSONWriter json;
+
+		detail::WriteChromeTrace(*this, json);
+
+		return json.get();
+	}
+
+	bool ProfilerCapture::saveChromeTrace(const FilePathView path) const
+	{
+		JSONWriter json;
+
+		detail::WriteChromeTrace(*this, json);
+
+		return json.save(path);
+	}
+}
@@ -11,6 +11,8 @@
 
 # include <Siv3DEngine.hpp>
 # include <Siv3D/Profiler.hpp>
+# include <Siv3D/FrameProfiler.hpp>
+# include <Asset/IAsset.hpp>
 # include "IProfiler.hpp"
 
 namespace s3d
@@ -31,5 +33,25 @@ namespace s3d
 		{
 			return Siv3DEngine::Get<ISiv3DProfiler>()->getStatistics();
 		}
+
+		size_t AssetLoadingQueueDepth()
+		{
+			return Siv3DEngine::Get<ISiv3DAsset>()->getLoadingQueueDepth();
+		}
+
+		void BeginCapture(const size_t frames)
+		{
+			Siv3DEngine::Get<ISiv3DProfiler>()->beginCapture(frames);
+		}
+
+		bool IsCapturing()
+		{
+			return Siv3DEngine::Get<ISiv3DProfiler>()->isCapturing();
+		}
+
+		const ProfilerCapture& GetCapture()
+		{
+			return Siv3DEngine::Get<ISiv3DProfiler>()->getCapture();
+		}
 	}
 }
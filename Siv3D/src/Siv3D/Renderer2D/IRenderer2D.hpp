@@ -88,6 +88,10 @@ namespace s3d
 
 		virtual Optional<RenderTexture> getRT() const = 0;
 
+		virtual void setCommandCompactionEnabled(bool enabled) = 0;
+
+		virtual bool isCommandCompactionEnabled() const = 0;
+
 		virtual void addLine(const LineStyle& style, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2]) = 0;
 
 		virtual void addTriangle(const Float2(&pts)[3], const Float4& color) = 0;
@@ -130,6 +134,11 @@ namespace s3d
 
 		virtual void addShape2DTransformed(const Array<Float2>& vertices, const Array<uint16>& indices, float s, float c, const Float2& offset, const Float4& color) = 0;
 
+		// インデックスの数に応じて、通常のバッチか 32-bit インデックスの 1 回の Draw が選ばれる
+		virtual void addShape2D(const Array<Float2>& vertices, const Array<uint32>& indices, const Optional<Float2>& offset, const Float4& color) = 0;
+
+		virtual void addShape2DTransformed(const Array<Float2>& vertices, const Array<uint32>& indices, float s, float c, const Float2& offset, const Float4& color) = 0;
+
 		virtual void addShape2DFrame(const Float2* pts, uint16 size, float thickness, const Float4& color) = 0;
 
 		virtual void addSprite(const Vertex2D* vertices, size_t vertexCount, const uint16* indices, size_t indexCount) = 0;
@@ -150,6 +159,12 @@ namespace s3d
 			ParticleSystem2DParameters::SizeOverLifeTimeFunc sizeOverLifeTimeFunc,
 			ParticleSystem2DParameters::ColorOverLifeTimeFunc colorOverLifeTimeFunc) = 0;
 
+		virtual void addRects(const RectF* rects, size_t count, const ColorF* colors, size_t colorStride) = 0;
+
+		virtual void addCircles(const Circle* circles, size_t count, const ColorF* colors, size_t colorStride) = 0;
+
+		virtual void addTextureRegions(const Texture& texture, const RectF* rects, const RectF* uvs, size_t count, const ColorF* colors, size_t colorStride) = 0;
+
 		virtual const Texture& getBoxShadowTexture() const = 0;
 	};
 }
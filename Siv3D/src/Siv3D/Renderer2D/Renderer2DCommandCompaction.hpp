@@ -0,0 +1,138 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <array>
+# include <Siv3D/Fwd.hpp>
+# include <Siv3D/Array.hpp>
+# include <Siv3D/Number.hpp>
+# include <Siv3D/Functor.hpp>
+
+namespace s3d
+{
+	namespace detail
+	{
+		/// <summary>
+		/// 記録済みの 2D コマンド列から効果の無いステート変更を取り除き、隣接する Draw をまとめます。
+		/// </summary>
+		/// <remarks>
+		/// ステート変更は、それを使う次の Draw（または DrawLarge, SetCB）の直前に 1 回だけ適用する。
+		/// 同じ種類のステートが Draw の前に再び変更された場合は、最初の変更の位置のまま値だけを更新する。
+		/// ステートは種類ごとに独立しているので、種類の異なるステート変更の順序や、バッファの更新との前後は描画結果に影響しない。
+		/// </remarks>
+		/// <param name="commands">
+		/// コマンド列。結果で置き換えられる
+		/// </param>
+		/// <param name="compactedCommands">
+		/// 作業用のバッファ
+		/// </param>
+		/// <param name="pendingStates">
+		/// 作業用のバッファ
+		/// </param>
+		/// <param name="mergeDraws">
+		/// mergeDraws(dst, src): src 番目の Draw のインデックス数を dst 番目の Draw に加える関数
+		/// </param>
+		/// <param name="isSameState">
+		/// isSameState(command, a, b): command のステートの a 番目と b 番目が同じであるかを返す関数
+		/// </param>
+		template <class RendererCommand, class MergeDraws, class IsSameState>
+		void CompactRenderer2DCommands(Array<std::pair<RendererCommand, uint32>>& commands,
+			Array<std::pair<RendererCommand, uint32>>& compactedCommands, Array<RendererCommand>& pendingStates,
+			MergeDraws mergeDraws, IsSameState isSameState)
+		{
+			constexpr size_t NumCommandTypes = (FromEnum(RendererCommand::InternalPSConstants) + 1);
+			constexpr uint32 None = Largest<uint32>;
+
+			// GPU に適用済みのステートと、次の Draw の直前に適用されるステートのインデックス
+			std::array<uint32, NumCommandTypes> applied;
+			std::array<uint32, NumCommandTypes> pending;
+			applied.fill(None);
+			pending.fill(None);
+
+			compactedCommands.clear();
+			pendingStates.clear();
+
+			const auto applyPendingStates = [&]()
+			{
+				for (const auto command : pendingStates)
+				{
+					const size_t type = FromEnum(command);
+
+					if ((applied[type] == None) || !isSameState(command, applied[type], pending[type]))
+					{
+						compactedCommands.emplace_back(command, pending[type]);
+						applied[type] = pending[type];
+					}
+
+					pending[type] = None;
+				}
+
+				pendingStates.clear();
+			};
+
+			for (const auto& [command, index] : commands)
+			{
+				switch (command)
+				{
+				case RendererCommand::Draw:
+					{
+						applyPendingStates();
+
+						// 間にステート変更もバッファの更新も無い Draw は、インデックスが連続しているので 1 つにまとめられる
+						if (!compactedCommands.isEmpty() && (compactedCommands.back().first == RendererCommand::Draw))
+						{
+							mergeDraws(compactedCommands.back().second, index);
+						}
+						else
+						{
+							compactedCommands.emplace_back(command, index);
+						}
+
+						break;
+					}
+				case RendererCommand::SetBuffers:
+				case RendererCommand::UpdateBuffers:
+				case RendererCommand::NextBatch:
+					{
+						// ステートとは独立しているので、保留中のステート変更はそのまま次の Draw まで遅らせる
+						compactedCommands.emplace_back(command, index);
+						break;
+					}
+				case RendererCommand::DrawLarge:
+				case RendererCommand::SetCB:
+					{
+						applyPendingStates();
+						compactedCommands.emplace_back(command, index);
+						break;
+					}
+				default:
+					{
+						// Draw の前に上書きされるステート変更は、最初の変更の位置で値だけを置き換える
+						const size_t type = FromEnum(command);
+
+						if (pending[type] == None)
+						{
+							pendingStates.push_back(command);
+						}
+
+						pending[type] = index;
+						break;
+					}
+				}
+			}
+
+			// 最後の Draw の後のステート変更も、次のフレームまで GPU の状態として残るので適用する
+			applyPendingStates();
+
+			commands.swap(compactedCommands);
+		}
+	}
+}
@@ -53,6 +53,26 @@ namespace s3d
 			return &CircleSinCosTable[((quality - 6) * (6 + (quality - 1))) / 2];
 		}
 
+		// 一括描画で 1 回のバッファ要求に使う頂点数・インデックス数の上限
+		static constexpr uint32 MaxBulkVertexSize = 32768;
+
+		static constexpr uint32 MaxBulkIndexSize = 49152;
+
+		static constexpr size_t MaxBulkQuads = (MaxBulkVertexSize / 4);
+
+		inline void BuildQuadIndices(IndexType* pIndex, IndexType indexBase, const size_t num) noexcept
+		{
+			for (size_t n = 0; n < num; ++n)
+			{
+				for (IndexType i = 0; i < 6; ++i)
+				{
+					*pIndex++ = (indexBase + RectIndexTable[i]);
+				}
+
+				indexBase += 4;
+			}
+		}
+
 		inline constexpr IndexType CalculateCircleQuality(const float size) noexcept
 		{
 			if (size <= 5.0f)
@@ -114,6 +134,112 @@ namespace s3d
 				: r <= 12.0f ? 8
 				: static_cast<uint16>(std::min(64.0f, r * 0.2f + 6));
 		}
+
+		static void WriteShape2DVertices(Vertex2D* pVertex, const Array<Float2>& vertices, const Optional<Float2>& offset, const Float4& color)
+		{
+			const Float2* pSrc = vertices.data();
+			const Float2* pSrcEnd = pSrc + vertices.size();
+
+			if (offset)
+			{
+				const Float2 _offset = offset.value();
+
+				while (pSrc != pSrcEnd)
+				{
+					pVertex->pos = _offset + *pSrc++;
+					pVertex->color = color;
+					++pVertex;
+				}
+			}
+			else
+			{
+				while (pSrc != pSrcEnd)
+				{
+					pVertex->pos = *pSrc++;
+					pVertex->color = color;
+					++pVertex;
+				}
+			}
+		}
+
+		static void WriteShape2DVerticesTransformed(Vertex2D* pVertex, const Array<Float2>& vertices, const float s, const float c, const Float2& offset, const Float4& color)
+		{
+			const Float2* pSrc = vertices.data();
+			const Float2* pSrcEnd = pSrc + vertices.size();
+
+			while (pSrc != pSrcEnd)
+			{
+				const Float2 v = *pSrc++;
+				const float x = v.x * c - v.y * s + offset.x;
+				const float y = v.x * s + v.y * c + offset.y;
+				pVertex->pos.set(x, y);
+				pVertex->color = color;
+				++pVertex;
+			}
+		}
+
+		// 32-bit のインデックスも、IsLargeShape2D() でなければ 16-bit に収まる
+		template <class SrcIndexType>
+		static void WriteShape2DIndices(IndexType* pIndex, const Array<SrcIndexType>& indices, const IndexType indexOffset)
+		{
+			const SrcIndexType* pSrc = indices.data();
+			const SrcIndexType* pSrcEnd = pSrc + indices.size();
+
+			while (pSrc != pSrcEnd)
+			{
+				*pIndex++ = static_cast<IndexType>(indexOffset + *pSrc++);
+			}
+		}
+
+		template <class SrcIndexType>
+		static uint16 BuildShape2DImpl(const BufferCreator& bufferCreator, const Array<Float2>& vertices, const Array<SrcIndexType>& indices, const Optional<Float2>& offset, const Float4& color)
+		{
+			if (vertices.isEmpty() || indices.isEmpty()
+				|| Vertex2DBuilder::IsLargeShape2D(vertices.size(), indices.size()))
+			{
+				return 0;
+			}
+
+			const IndexType vertexSize = static_cast<IndexType>(vertices.size());
+			const IndexType indexSize = static_cast<IndexType>(indices.size());
+			auto[pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
+
+			if (!pVertex)
+			{
+				return 0;
+			}
+
+			WriteShape2DVertices(pVertex, vertices, offset, color);
+
+			WriteShape2DIndices(pIndex, indices, indexOffset);
+
+			return indexSize;
+		}
+
+		template <class SrcIndexType>
+		static uint16 BuildShape2DTransformedImpl(const BufferCreator& bufferCreator, const Array<Float2>& vertices, const Array<SrcIndexType>& indices, const float s, const float c, const Float2& offset, const Float4& color)
+		{
+			if (vertices.isEmpty() || indices.isEmpty()
+				|| Vertex2DBuilder::IsLargeShape2D(vertices.size(), indices.size()))
+			{
+				return 0;
+			}
+
+			const IndexType vertexSize = static_cast<IndexType>(vertices.size());
+			const IndexType indexSize = static_cast<IndexType>(indices.size());
+			auto[pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
+
+			if (!pVertex)
+			{
+				return 0;
+			}
+
+			WriteShape2DVerticesTransformed(pVertex, vertices, s, c, offset, color);
+
+			WriteShape2DIndices(pIndex, indices, indexOffset);
+
+			return indexSize;
+		}
 	}
 
 	namespace Vertex2DBuilder
@@ -121,7 +247,7 @@ namespace s3d
 		using Math::Constants::TwoPiF;
 		using Math::Constants::HalfPiF;
 
-		uint16 BuildSquareCappedLine(BufferCreatorFunc bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2])
+		uint16 BuildSquareCappedLine(const BufferCreator& bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2])
 		{
 			if (thickness <= 0.0f)
 			{
@@ -154,7 +280,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildRoundCappedLine(BufferCreatorFunc bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2], float& startAngle)
+		uint16 BuildRoundCappedLine(const BufferCreator& bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2], float& startAngle)
 		{
 			if (thickness <= 0.0f)
 			{
@@ -187,7 +313,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildUncappedLine(BufferCreatorFunc bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2])
+		uint16 BuildUncappedLine(const BufferCreator& bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2])
 		{
 			if (thickness <= 0.0f)
 			{
@@ -218,7 +344,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildSquareDotLine(BufferCreatorFunc bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2], const float dotOffset, const float scale)
+		uint16 BuildSquareDotLine(const BufferCreator& bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2], const float dotOffset, const float scale)
 		{
 			if (thickness <= 0.0f)
 			{
@@ -256,7 +382,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildRoundDotLine(BufferCreatorFunc bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2], const float dotOffset, const bool hasAlignedDot)
+		uint16 BuildRoundDotLine(const BufferCreator& bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2], const float dotOffset, const bool hasAlignedDot)
 		{
 			if (thickness <= 0.0f)
 			{
@@ -300,7 +426,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildTriangle(BufferCreatorFunc bufferCreator, const Float2(&pts)[3], const Float4& color)
+		uint16 BuildTriangle(const BufferCreator& bufferCreator, const Float2(&pts)[3], const Float4& color)
 		{
 			constexpr IndexType vertexSize = 3, indexSize = 3;
 			auto[pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
@@ -321,7 +447,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildTriangle(BufferCreatorFunc bufferCreator, const Float2(&pts)[3], const Float4(&colors)[3])
+		uint16 BuildTriangle(const BufferCreator& bufferCreator, const Float2(&pts)[3], const Float4(&colors)[3])
 		{
 			constexpr IndexType vertexSize = 3, indexSize = 3;
 			auto[pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
@@ -342,7 +468,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildRect(BufferCreatorFunc bufferCreator, const FloatRect& rect, const Float4& color)
+		uint16 BuildRect(const BufferCreator& bufferCreator, const FloatRect& rect, const Float4& color)
 		{
 			constexpr IndexType vertexSize = 4, indexSize = 6;
 			auto[pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
@@ -365,7 +491,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildRect(BufferCreatorFunc bufferCreator, const FloatRect& rect, const Float4(&colors)[4])
+		uint16 BuildRect(const BufferCreator& bufferCreator, const FloatRect& rect, const Float4(&colors)[4])
 		{
 			constexpr IndexType vertexSize = 4, indexSize = 6;
 			auto[pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
@@ -388,7 +514,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildRectFrame(BufferCreatorFunc bufferCreator, const FloatRect& rect, float thickness, const Float4& innerColor, const Float4& outerColor)
+		uint16 BuildRectFrame(const BufferCreator& bufferCreator, const FloatRect& rect, float thickness, const Float4& innerColor, const Float4& outerColor)
 		{
 			constexpr IndexType vertexSize = 8, indexSize = 24;
 			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
@@ -421,7 +547,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildCircle(BufferCreatorFunc bufferCreator, const Float2& center, float r, const Float4& innerColor, const Float4& outerColor, const float scale)
+		uint16 BuildCircle(const BufferCreator& bufferCreator, const Float2& center, float r, const Float4& innerColor, const Float4& outerColor, const float scale)
 		{
 			const float absR = Math::Abs(r);
 			const IndexType quality = detail::CalculateCircleQuality(absR * scale);
@@ -487,7 +613,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildCircleFrame(BufferCreatorFunc bufferCreator, const Float2& center, const float rInner, const float thickness, const Float4& innerColor, const Float4& outerColor, const float scale)
+		uint16 BuildCircleFrame(const BufferCreator& bufferCreator, const Float2& center, const float rInner, const float thickness, const Float4& innerColor, const Float4& outerColor, const float scale)
 		{
 			const float rOuter = rInner + thickness;
 			const IndexType quality = detail::CalculateCircleFrameQuality(rOuter * scale);
@@ -546,7 +672,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildCirclePie(BufferCreatorFunc bufferCreator, const Float2& center, const float r, const float startAngle, const float _angle, const Float4& innerColor, const Float4& outerColor, const float scale)
+		uint16 BuildCirclePie(const BufferCreator& bufferCreator, const Float2& center, const float r, const float startAngle, const float _angle, const Float4& innerColor, const Float4& outerColor, const float scale)
 		{
 			if (_angle == 0.0f)
 			{
@@ -602,7 +728,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildCircleArc(BufferCreatorFunc bufferCreator, const Float2& center, const float rInner, const float startAngle, const float _angle, const float thickness, const Float4& color, const float scale)
+		uint16 BuildCircleArc(const BufferCreator& bufferCreator, const Float2& center, const float rInner, const float startAngle, const float _angle, const float thickness, const Float4& color, const float scale)
 		{
 			if (_angle == 0.0f)
 			{
@@ -654,7 +780,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildCircleArc(BufferCreatorFunc bufferCreator, const Float2& center, const float rInner, const float startAngle, const float _angle, const float thickness, const Float4& innerColor, const Float4& outerColor, const float scale)
+		uint16 BuildCircleArc(const BufferCreator& bufferCreator, const Float2& center, const float rInner, const float startAngle, const float _angle, const float thickness, const Float4& innerColor, const Float4& outerColor, const float scale)
 		{
 			if (_angle == 0.0f)
 			{
@@ -707,7 +833,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildEllipse(BufferCreatorFunc bufferCreator, const Float2& center, const float a, const float b, const Float4& innerColor, const Float4& outerColor, const float scale)
+		uint16 BuildEllipse(const BufferCreator& bufferCreator, const Float2& center, const float a, const float b, const Float4& innerColor, const Float4& outerColor, const float scale)
 		{
 			const float majorAxis = std::max(Math::Abs(a), Math::Abs(b));
 			const IndexType quality = static_cast<IndexType>(std::clamp(majorAxis * scale * 0.225f + 18.0f, 6.0f, 255.0f));
@@ -773,7 +899,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildEllipseFrame(BufferCreatorFunc bufferCreator, const Float2& center, const float aInner, const float bInner, const float thickness, const Float4& innerColor, const Float4& outerColor, const float scale)
+		uint16 BuildEllipseFrame(const BufferCreator& bufferCreator, const Float2& center, const float aInner, const float bInner, const float thickness, const Float4& innerColor, const Float4& outerColor, const float scale)
 		{
 			const float aOuter = aInner + thickness;
 			const float bOuter = bInner + thickness;
@@ -834,7 +960,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildQuad(BufferCreatorFunc bufferCreator, const FloatQuad& quad, const Float4 color)
+		uint16 BuildQuad(const BufferCreator& bufferCreator, const FloatQuad& quad, const Float4 color)
 		{
 			constexpr IndexType vertexSize = 4, indexSize = 6;
 			auto[pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
@@ -857,7 +983,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildQuad(BufferCreatorFunc bufferCreator, const FloatQuad& quad, const Float4(&colors)[4])
+		uint16 BuildQuad(const BufferCreator& bufferCreator, const FloatQuad& quad, const Float4(&colors)[4])
 		{
 			constexpr IndexType vertexSize = 4, indexSize = 6;
 			auto[pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
@@ -880,7 +1006,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildRoundRect(BufferCreatorFunc bufferCreator, const FloatRect& rect, const float w, const float h, const float r, const Float4& color, float scale)
+		uint16 BuildRoundRect(const BufferCreator& bufferCreator, const FloatRect& rect, const float w, const float h, const float r, const Float4& color, float scale)
 		{
 			const float rr = std::min({ w * 0.5f, h * 0.5f, std::max(0.0f, r) });
 			const IndexType quality = detail::CaluculateFanQuality(rr * scale);
@@ -959,104 +1085,42 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildShape2D(BufferCreatorFunc bufferCreator, const Array<Float2>& vertices, const Array<uint16>& indices, const Optional<Float2>& offset, const Float4& color)
+		uint16 BuildShape2D(const BufferCreator& bufferCreator, const Array<Float2>& vertices, const Array<uint16>& indices, const Optional<Float2>& offset, const Float4& color)
 		{
-			if (vertices.isEmpty() || indices.isEmpty())
-			{
-				return 0;
-			}
-
-			const IndexType vertexSize = static_cast<IndexType>(vertices.size());
-			const IndexType indexSize = static_cast<IndexType>(indices.size());
-			auto[pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
-
-			if (!pVertex)
-			{
-				return 0;
-			}
-
-			{
-				const Float2* pSrc = vertices.data();
-				const Float2* pSrcEnd = pSrc + vertices.size();
-
-				if (offset)
-				{
-					const Float2 _offset = offset.value();
-
-					while (pSrc != pSrcEnd)
-					{
-						pVertex->pos = _offset + *pSrc++;
-						pVertex->color = color;
-						++pVertex;
-					}
-				}
-				else
-				{
-					while (pSrc != pSrcEnd)
-					{
-						pVertex->pos = *pSrc++;
-						pVertex->color = color;
-						++pVertex;
-					}
-				}
-			}
-
-			{
-				std::memcpy(pIndex, indices.data(), indices.size_bytes());
-
-				for (size_t i = 0; i < indexSize; ++i)
-				{
-					*(pIndex++) += indexOffset;
-				}
-			}
-
-			return indexSize;
+			return detail::BuildShape2DImpl(bufferCreator, vertices, indices, offset, color);
 		}
 
-		uint16 BuildShape2DTransformed(BufferCreatorFunc bufferCreator, const Array<Float2>& vertices, const Array<uint16>& indices, const float s, const float c, const Float2& offset, const Float4& color)
+		uint16 BuildShape2DTransformed(const BufferCreator& bufferCreator, const Array<Float2>& vertices, const Array<uint16>& indices, const float s, const float c, const Float2& offset, const Float4& color)
 		{
-			if (vertices.isEmpty() || indices.isEmpty())
-			{
-				return 0;
-			}
-
-			const IndexType vertexSize = static_cast<IndexType>(vertices.size());
-			const IndexType indexSize = static_cast<IndexType>(indices.size());
-			auto[pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
+			return detail::BuildShape2DTransformedImpl(bufferCreator, vertices, indices, s, c, offset, color);
+		}
 
-			if (!pVertex)
-			{
-				return 0;
-			}
+		uint16 BuildShape2D(const BufferCreator& bufferCreator, const Array<Float2>& vertices, const Array<uint32>& indices, const Optional<Float2>& offset, const Float4& color)
+		{
+			return detail::BuildShape2DImpl(bufferCreator, vertices, indices, offset, color);
+		}
 
-			{
-				const Float2* pSrc = vertices.data();
-				const Float2* pSrcEnd = pSrc + vertices.size();
+		uint16 BuildShape2DTransformed(const BufferCreator& bufferCreator, const Array<Float2>& vertices, const Array<uint32>& indices, const float s, const float c, const Float2& offset, const Float4& color)
+		{
+			return detail::BuildShape2DTransformedImpl(bufferCreator, vertices, indices, s, c, offset, color);
+		}
 
-				while (pSrc != pSrcEnd)
-				{
-					const Float2 v = *pSrc++;
-					const float x = v.x * c - v.y * s + offset.x;
-					const float y = v.x * s + v.y * c + offset.y;
-					pVertex->pos.set(x, y);
-					pVertex->color = color;
-					++pVertex;
-				}
-			}
+		void BuildLargeShape2D(Vertex2D* pVertex, uint32* pIndex, const Array<Float2>& vertices, const Array<uint32>& indices, const Optional<Float2>& offset, const Float4& color)
+		{
+			detail::WriteShape2DVertices(pVertex, vertices, offset, color);
 
-			{
-				std::memcpy(pIndex, indices.data(), indices.size_bytes());
+			// 専用のバッファに 1 つだけ置かれるので、インデックスのオフセットは不要
+			std::memcpy(pIndex, indices.data(), indices.size_bytes());
+		}
 
-				for (size_t i = 0; i < indexSize; ++i)
-				{
-					*(pIndex++) += indexOffset;
-				}
-			}
+		void BuildLargeShape2DTransformed(Vertex2D* pVertex, uint32* pIndex, const Array<Float2>& vertices, const Array<uint32>& indices, const float s, const float c, const Float2& offset, const Float4& color)
+		{
+			detail::WriteShape2DVerticesTransformed(pVertex, vertices, s, c, offset, color);
 
-			return indexSize;
+			std::memcpy(pIndex, indices.data(), indices.size_bytes());
 		}
 
-		uint16 BuildShape2DFrame(BufferCreatorFunc bufferCreator, const Float2* pts, uint16 size, const float thickness, const Float4& color, const float scale)
+		uint16 BuildShape2DFrame(const BufferCreator& bufferCreator, const Float2* pts, uint16 size, const float thickness, const Float4& color, const float scale)
 		{
 			if (size < 2 || !pts)
 			{
@@ -1246,7 +1310,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildSprite(BufferCreatorFunc bufferCreator, const Vertex2D* vertices, const size_t vertexCount, const IndexType* indices, size_t indexCount)
+		uint16 BuildSprite(const BufferCreator& bufferCreator, const Vertex2D* vertices, const size_t vertexCount, const IndexType* indices, size_t indexCount)
 		{
 			if (!vertices || (vertexCount == 0) || !indices || (indexCount == 0))
 			{
@@ -1285,7 +1349,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildSprite(BufferCreatorFunc bufferCreator, const Sprite& sprite, const IndexType startIndex, IndexType indexCount)
+		uint16 BuildSprite(const BufferCreator& bufferCreator, const Sprite& sprite, const IndexType startIndex, IndexType indexCount)
 		{
 			if (sprite.vertices.isEmpty() || sprite.indices.isEmpty() || sprite.indices.size() <= startIndex)
 			{
@@ -1329,7 +1393,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildSquareCappedLineString(BufferCreatorFunc bufferCreator, const Vec2* pts, uint16 size, const Optional<Float2>& offset, const float thickness, const bool inner, const Float4& color, const bool isClosed, const float scale)
+		uint16 BuildSquareCappedLineString(const BufferCreator& bufferCreator, const Vec2* pts, uint16 size, const Optional<Float2>& offset, const float thickness, const bool inner, const Float4& color, const bool isClosed, const float scale)
 		{
 			if (thickness <= 0.0f || !pts || size < 2)
 			{
@@ -1562,7 +1626,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildRoundCappedLineString(BufferCreatorFunc bufferCreator, const Vec2* pts, uint16 size, const Optional<Float2>& offset, const float thickness, const bool inner, const Float4& color, const float scale, float& startAngle, float& endAngle)
+		uint16 BuildRoundCappedLineString(const BufferCreator& bufferCreator, const Vec2* pts, uint16 size, const Optional<Float2>& offset, const float thickness, const bool inner, const Float4& color, const float scale, float& startAngle, float& endAngle)
 		{
 			if (thickness <= 0.0f || !pts || size < 2)
 			{
@@ -1726,7 +1790,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildDotLineString(BufferCreatorFunc bufferCreator, const Vec2* pts, uint16 size, const Optional<Float2>& offset, const float thickness, const Float4& color, const bool isClosed, const bool squareDot, const float dotOffset, const bool hasAlignedDot, const float scale)
+		uint16 BuildDotLineString(const BufferCreator& bufferCreator, const Vec2* pts, uint16 size, const Optional<Float2>& offset, const float thickness, const Float4& color, const bool isClosed, const bool squareDot, const float dotOffset, const bool hasAlignedDot, const float scale)
 		{
 			if (thickness <= 0.0f || !pts || size < 2)
 			{
@@ -1895,7 +1959,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildTextureRegion(BufferCreatorFunc bufferCreator, const FloatRect& rect, const FloatRect& uv, const Float4& color)
+		uint16 BuildTextureRegion(const BufferCreator& bufferCreator, const FloatRect& rect, const FloatRect& uv, const Float4& color)
 		{
 			constexpr IndexType vertexSize = 4, indexSize = 6;
 			auto[pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
@@ -1918,7 +1982,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildTextureRegion(BufferCreatorFunc bufferCreator, const FloatRect& rect, const FloatRect& uv, const Float4(&colors)[4])
+		uint16 BuildTextureRegion(const BufferCreator& bufferCreator, const FloatRect& rect, const FloatRect& uv, const Float4(&colors)[4])
 		{
 			constexpr IndexType vertexSize = 4, indexSize = 6;
 			auto[pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
@@ -1941,7 +2005,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildTexturedCircle(BufferCreatorFunc bufferCreator, const Circle& circle, const FloatRect& uv, const Float4& color, const float scale)
+		uint16 BuildTexturedCircle(const BufferCreator& bufferCreator, const Circle& circle, const FloatRect& uv, const Float4& color, const float scale)
 		{
 			const float rf = static_cast<float>(circle.r);
 			const float absR = Math::Abs(rf);
@@ -1990,7 +2054,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildTexturedQuad(BufferCreatorFunc bufferCreator, const FloatQuad& quad, const FloatRect& uv, const Float4& color)
+		uint16 BuildTexturedQuad(const BufferCreator& bufferCreator, const FloatQuad& quad, const FloatRect& uv, const Float4& color)
 		{
 			constexpr IndexType vertexSize = 4, indexSize = 6;
 			auto[pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
@@ -2013,7 +2077,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildTexturedParticles(BufferCreatorFunc bufferCreator, const Array<Particle2D>& particles,
+		uint16 BuildTexturedParticles(const BufferCreator& bufferCreator, const Array<Particle2D>& particles,
 			const ParticleSystem2DParameters::SizeOverLifeTimeFunc& sizeOverLifeTimeFunc, const ParticleSystem2DParameters::ColorOverLifeTimeFunc& colorOverLifeTimeFunc)
 		{
 			const IndexType vertexSize = static_cast<IndexType>(particles.size() * 4), indexSize = static_cast<IndexType>(particles.size() * 6);
@@ -2062,5 +2126,160 @@ namespace s3d
 
 			return indexSize;
 		}
+
+		uint16 BuildRects(const BufferCreator& bufferCreator, const RectF* rects, const size_t count, const ColorF* colors, const size_t colorStride, size_t& numBuilt)
+		{
+			const size_t num = std::min(count, detail::MaxBulkQuads);
+			const IndexType vertexSize = static_cast<IndexType>(num * 4), indexSize = static_cast<IndexType>(num * 6);
+			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
+
+			if (!pVertex)
+			{
+				numBuilt = 0;
+				return 0;
+			}
+
+			for (size_t n = 0; n < num; ++n)
+			{
+				const RectF& rect = rects[n];
+				const Float4 color = colors[n * colorStride].toFloat4();
+				const float left = static_cast<float>(rect.x);
+				const float top = static_cast<float>(rect.y);
+				const float right = static_cast<float>(rect.x + rect.w);
+				const float bottom = static_cast<float>(rect.y + rect.h);
+
+				pVertex[0].set(left, top, color);
+				pVertex[1].set(right, top, color);
+				pVertex[2].set(left, bottom, color);
+				pVertex[3].set(right, bottom, color);
+				pVertex += 4;
+			}
+
+			detail::BuildQuadIndices(pIndex, indexOffset, num);
+
+			numBuilt = num;
+			return indexSize;
+		}
+
+		uint16 BuildCircles(const BufferCreator& bufferCreator, const Circle* circles, const size_t count, const ColorF* colors, const size_t colorStride, const float scale, size_t& numBuilt)
+		{
+			// 1 回のバッファ要求に収まる個数を数える
+			uint32 vertexSize = 0, indexSize = 0;
+			size_t num = 0;
+
+			for (; num < count; ++num)
+			{
+				const IndexType quality = detail::CalculateCircleQuality(static_cast<float>(Math::Abs(circles[num].r)) * scale);
+
+				if ((detail::MaxBulkVertexSize < (vertexSize + quality + 1))
+					|| (detail::MaxBulkIndexSize < (indexSize + quality * 3)))
+				{
+					break;
+				}
+
+				vertexSize += (quality + 1);
+				indexSize += (quality * 3);
+			}
+
+			auto [pVertex, pIndex, indexOffset] = bufferCreator(static_cast<IndexType>(vertexSize), static_cast<IndexType>(indexSize));
+
+			if (!pVertex)
+			{
+				numBuilt = 0;
+				return 0;
+			}
+
+			IndexType indexBase = indexOffset;
+
+			for (size_t n = 0; n < num; ++n)
+			{
+				const Circle& circle = circles[n];
+				const Float4 color = colors[n * colorStride].toFloat4();
+				const float r = static_cast<float>(circle.r);
+				const float centerX = static_cast<float>(circle.x);
+				const float centerY = static_cast<float>(circle.y);
+				const IndexType quality = detail::CalculateCircleQuality(Math::Abs(r) * scale);
+
+				// 中心
+				(pVertex++)->set(centerX, centerY, color);
+
+				// 周
+				if (quality <= detail::MaxSinCosTableQuality)
+				{
+					const Float2* pCS = detail::GetSinCosTableStartPtr(quality);
+
+					for (IndexType i = 0; i < quality; ++i)
+					{
+						(pVertex++)->set(r * pCS->x + centerX, r * pCS->y + centerY, color);
+						++pCS;
+					}
+				}
+				else
+				{
+					const float radDelta = TwoPiF / quality;
+
+					for (IndexType i = 0; i < quality; ++i)
+					{
+						const float rad = radDelta * i;
+						(pVertex++)->set(centerX + r * std::cos(rad), centerY - r * std::sin(rad), color);
+					}
+				}
+
+				for (IndexType i = 0; i < quality - 1; ++i)
+				{
+					*pIndex++ = indexBase + (i + 1);
+					*pIndex++ = indexBase;
+					*pIndex++ = indexBase + (i + 2);
+				}
+
+				*pIndex++ = indexBase + quality;
+				*pIndex++ = indexBase;
+				*pIndex++ = indexBase + 1;
+
+				indexBase += (quality + 1);
+			}
+
+			numBuilt = num;
+			return static_cast<uint16>(indexSize);
+		}
+
+		uint16 BuildTextureRegions(const BufferCreator& bufferCreator, const RectF* rects, const RectF* uvs, const size_t count, const ColorF* colors, const size_t colorStride, size_t& numBuilt)
+		{
+			const size_t num = std::min(count, detail::MaxBulkQuads);
+			const IndexType vertexSize = static_cast<IndexType>(num * 4), indexSize = static_cast<IndexType>(num * 6);
+			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
+
+			if (!pVertex)
+			{
+				numBuilt = 0;
+				return 0;
+			}
+
+			for (size_t n = 0; n < num; ++n)
+			{
+				const RectF& rect = rects[n];
+				const RectF& uv = uvs[n];
+				const Float4 color = colors[n * colorStride].toFloat4();
+				const float left = static_cast<float>(rect.x);
+				const float top = static_cast<float>(rect.y);
+				const float right = static_cast<float>(rect.x + rect.w);
+				const float bottom = static_cast<float>(rect.y + rect.h);
+				const float uvLeft = static_cast<float>(uv.x);
+				const float uvTop = static_cast<float>(uv.y);
+				const float uvRight = static_cast<float>(uv.x + uv.w);
+				const float uvBottom = static_cast<float>(uv.y + uv.h);
+
+				pVertex[0].set(left, top, uvLeft, uvTop, color);
+				pVertex[1].set(right, top, uvRight, uvTop, color);
+				pVertex[2].set(left, bottom, uvLeft, uvBottom, color);
+				pVertex[3].set(right, bottom, uvRight, uvBottom, color);
+				pVertex += 4;
+			}
+
+			detail::BuildQuadIndices(pIndex, indexOffset, num);
+
+			numBuilt = num;
+			return indexSize;
+		}
 	}
 }
@@ -19,75 +19,177 @@ namespace s3d
 {
 	using IndexType = Vertex2D::IndexType;
 
-	using BufferCreatorFunc = std::function<std::tuple<Vertex2D*, IndexType*, IndexType>(IndexType, IndexType)>;
+	/// <summary>
+	/// スプライトバッチの現在のバッチへの書き込み位置
+	/// </summary>
+	struct Vertex2DBufferState
+	{
+		Vertex2D* pVertex = nullptr;
+
+		IndexType* pIndex = nullptr;
+
+		// 配列の拡張やバッチの切り替えをせずに書き込める頂点数・インデックス数
+		uint32 vertexSpace = 0;
+
+		uint32 indexSpace = 0;
+
+		// 現在のバッチに書き込まれた頂点数・インデックス数
+		IndexType batchVertexPos = 0;
+
+		uint32 batchIndexPos = 0;
+	};
+
+	/// <summary>
+	/// 頂点・インデックスの書き込み先を確保する
+	/// </summary>
+	/// <remarks>
+	/// 現在のバッチに空きがあれば、呼び出し元にインライン展開される経路で確保する。
+	/// 配列の拡張やバッチの切り替えが必要な場合のみ、スプライトバッチの関数を呼ぶ。
+	/// </remarks>
+	class BufferCreator
+	{
+	public:
+
+		// std::tuple だとインライン展開後も戻り値がスタックを経由し、書き込みの直後の読み込みで待たされるため、単純な構造体で返す
+		struct BufferType
+		{
+			Vertex2D* pVertex;
+
+			IndexType* pIndex;
+
+			IndexType indexOffset;
+		};
+
+		using GetBufferFunc = BufferType(*)(void* context, IndexType vertexSize, IndexType indexSize);
+
+		BufferCreator() = default;
+
+		BufferCreator(Vertex2DBufferState& state, void* context, GetBufferFunc getBuffer) noexcept
+			: m_state(&state)
+			, m_context(context)
+			, m_getBuffer(getBuffer) {}
+
+		[[nodiscard]] BufferType operator ()(const IndexType vertexSize, const IndexType indexSize) const
+		{
+			Vertex2DBufferState& state = *m_state;
+
+			if ((vertexSize <= state.vertexSpace) && (indexSize <= state.indexSpace))
+			{
+				const BufferType result{ state.pVertex, state.pIndex, state.batchVertexPos };
+
+				state.pVertex			+= vertexSize;
+				state.pIndex			+= indexSize;
+				state.vertexSpace		-= vertexSize;
+				state.indexSpace		-= indexSize;
+				state.batchVertexPos	+= vertexSize;
+				state.batchIndexPos		+= indexSize;
+
+				return result;
+			}
+
+			return m_getBuffer(m_context, vertexSize, indexSize);
+		}
+
+	private:
+
+		Vertex2DBufferState* m_state = nullptr;
+
+		void* m_context = nullptr;
+
+		GetBufferFunc m_getBuffer = nullptr;
+	};
 
 	namespace Vertex2DBuilder
 	{
-		[[nodiscard]] uint16 BuildSquareCappedLine(BufferCreatorFunc bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2]);
+		[[nodiscard]] uint16 BuildSquareCappedLine(const BufferCreator& bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2]);
+
+		[[nodiscard]] uint16 BuildRoundCappedLine(const BufferCreator& bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2], float& startAngle);
 
-		[[nodiscard]] uint16 BuildRoundCappedLine(BufferCreatorFunc bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2], float& startAngle);
+		[[nodiscard]] uint16 BuildUncappedLine(const BufferCreator& bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2]);
 
-		[[nodiscard]] uint16 BuildUncappedLine(BufferCreatorFunc bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2]);
+		[[nodiscard]] uint16 BuildSquareDotLine(const BufferCreator& bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2], float dotOffset, float scale);
 
-		[[nodiscard]] uint16 BuildSquareDotLine(BufferCreatorFunc bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2], float dotOffset, float scale);
+		[[nodiscard]] uint16 BuildRoundDotLine(const BufferCreator& bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2], float dotOffset, bool hasAlignedDot);
 
-		[[nodiscard]] uint16 BuildRoundDotLine(BufferCreatorFunc bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2], float dotOffset, bool hasAlignedDot);
+		[[nodiscard]] uint16 BuildTriangle(const BufferCreator& bufferCreator, const Float2(&pts)[3], const Float4& color);
 
-		[[nodiscard]] uint16 BuildTriangle(BufferCreatorFunc bufferCreator, const Float2(&pts)[3], const Float4& color);
+		[[nodiscard]] uint16 BuildTriangle(const BufferCreator& bufferCreator, const Float2(&pts)[3], const Float4(&colors)[3]);
 
-		[[nodiscard]] uint16 BuildTriangle(BufferCreatorFunc bufferCreator, const Float2(&pts)[3], const Float4(&colors)[3]);
+		[[nodiscard]] uint16 BuildRect(const BufferCreator& bufferCreator, const FloatRect& rect, const Float4& color);
 
-		[[nodiscard]] uint16 BuildRect(BufferCreatorFunc bufferCreator, const FloatRect& rect, const Float4& color);
+		[[nodiscard]] uint16 BuildRect(const BufferCreator& bufferCreator, const FloatRect& rect, const Float4(&colors)[4]);
 
-		[[nodiscard]] uint16 BuildRect(BufferCreatorFunc bufferCreator, const FloatRect& rect, const Float4(&colors)[4]);
+		[[nodiscard]] uint16 BuildRectFrame(const BufferCreator& bufferCreator, const FloatRect& rect, float thickness, const Float4& innerColor, const Float4& outerColor);
 
-		[[nodiscard]] uint16 BuildRectFrame(BufferCreatorFunc bufferCreator, const FloatRect& rect, float thickness, const Float4& innerColor, const Float4& outerColor);
+		[[nodiscard]] uint16 BuildCircle(const BufferCreator& bufferCreator, const Float2& center, float r, const Float4& innerColor, const Float4& outerColor, float scale);
 
-		[[nodiscard]] uint16 BuildCircle(BufferCreatorFunc bufferCreator, const Float2& center, float r, const Float4& innerColor, const Float4& outerColor, float scale);
+		[[nodiscard]] uint16 BuildCircleFrame(const BufferCreator& bufferCreator, const Float2& center, float rInner, float thickness, const Float4& innerColor, const Float4& outerColor, float scale);
 
-		[[nodiscard]] uint16 BuildCircleFrame(BufferCreatorFunc bufferCreator, const Float2& center, float rInner, float thickness, const Float4& innerColor, const Float4& outerColor, float scale);
+		[[nodiscard]] uint16 BuildCirclePie(const BufferCreator& bufferCreator, const Float2& center, float r, float startAngle, float angle, const Float4& innerColor, const Float4& outerColor, float scale);
 
-		[[nodiscard]] uint16 BuildCirclePie(BufferCreatorFunc bufferCreator, const Float2& center, float r, float startAngle, float angle, const Float4& innerColor, const Float4& outerColor, float scale);
+		[[nodiscard]] uint16 BuildCircleArc(const BufferCreator& bufferCreator, const Float2& center, float rInner, float startAngle, float angle, float thickness, const Float4& color, float scale);
 
-		[[nodiscard]] uint16 BuildCircleArc(BufferCreatorFunc bufferCreator, const Float2& center, float rInner, float startAngle, float angle, float thickness, const Float4& color, float scale);
+		[[nodiscard]] uint16 BuildCircleArc(const BufferCreator& bufferCreator, const Float2& center, float rInner, float startAngle, float angle, float thickness, const Float4& innerColor, const Float4& outerColor, float scale);
 
-		[[nodiscard]] uint16 BuildCircleArc(BufferCreatorFunc bufferCreator, const Float2& center, float rInner, float startAngle, float angle, float thickness, const Float4& innerColor, const Float4& outerColor, float scale);
+		[[nodiscard]] uint16 BuildEllipse(const BufferCreator& bufferCreator, const Float2& center, float a, float b, const Float4& innerColor, const Float4& outerColor, float scale);
 
-		[[nodiscard]] uint16 BuildEllipse(BufferCreatorFunc bufferCreator, const Float2& center, float a, float b, const Float4& innerColor, const Float4& outerColor, float scale);
+		[[nodiscard]] uint16 BuildEllipseFrame(const BufferCreator& bufferCreator, const Float2& center, float aInner, float bInner, float thickness, const Float4& innerColor, const Float4& outerColor, float scale);
 
-		[[nodiscard]] uint16 BuildEllipseFrame(BufferCreatorFunc bufferCreator, const Float2& center, float aInner, float bInner, float thickness, const Float4& innerColor, const Float4& outerColor, float scale);
+		[[nodiscard]] uint16 BuildQuad(const BufferCreator& bufferCreator, const FloatQuad& quad, const Float4 color);
 
-		[[nodiscard]] uint16 BuildQuad(BufferCreatorFunc bufferCreator, const FloatQuad& quad, const Float4 color);
+		[[nodiscard]] uint16 BuildQuad(const BufferCreator& bufferCreator, const FloatQuad& quad, const Float4(&colors)[4]);
 
-		[[nodiscard]] uint16 BuildQuad(BufferCreatorFunc bufferCreator, const FloatQuad& quad, const Float4(&colors)[4]);
+		[[nodiscard]] uint16 BuildRoundRect(const BufferCreator& bufferCreator, const FloatRect& rect, float w, float h, float r, const Float4& color, float scale);
 
-		[[nodiscard]] uint16 BuildRoundRect(BufferCreatorFunc bufferCreator, const FloatRect& rect, float w, float h, float r, const Float4& color, float scale);
+		[[nodiscard]] uint16 BuildShape2D(const BufferCreator& bufferCreator, const Array<Float2>& vertices, const Array<uint16>& indices, const Optional<Float2>& offset, const Float4& color);
 
-		[[nodiscard]] uint16 BuildShape2D(BufferCreatorFunc bufferCreator, const Array<Float2>& vertices, const Array<uint16>& indices, const Optional<Float2>& offset, const Float4& color);
+		[[nodiscard]] uint16 BuildShape2DTransformed(const BufferCreator& bufferCreator, const Array<Float2>& vertices, const Array<uint16>& indices, float s, float c, const Float2& offset, const Float4& color);
 
-		[[nodiscard]] uint16 BuildShape2DTransformed(BufferCreatorFunc bufferCreator, const Array<Float2>& vertices, const Array<uint16>& indices, float s, float c, const Float2& offset, const Float4& color);
+		[[nodiscard]] uint16 BuildShape2D(const BufferCreator& bufferCreator, const Array<Float2>& vertices, const Array<uint32>& indices, const Optional<Float2>& offset, const Float4& color);
 
-		[[nodiscard]] uint16 BuildShape2DFrame(BufferCreatorFunc bufferCreator, const Float2* pts, uint16 size, float thickness, const Float4& color, float scale);
+		[[nodiscard]] uint16 BuildShape2DTransformed(const BufferCreator& bufferCreator, const Array<Float2>& vertices, const Array<uint32>& indices, float s, float c, const Float2& offset, const Float4& color);
 
-		[[nodiscard]] uint16 BuildSprite(BufferCreatorFunc bufferCreator, const Vertex2D* vertices, size_t vertexCount, const IndexType* indices, size_t indexCount);
+		// 16-bit インデックスのバッチに収まらず、32-bit インデックスで 1 回で描く必要があるか
+		[[nodiscard]] constexpr bool IsLargeShape2D(const size_t vertexCount, const size_t indexCount) noexcept
+		{
+			return (Largest<IndexType> < vertexCount) || (Largest<IndexType> < indexCount);
+		}
 
-		[[nodiscard]] uint16 BuildSprite(BufferCreatorFunc bufferCreator, const Sprite& sprite, IndexType startIndex, IndexType indexCount);
+		// IsLargeShape2D() な図形を、スプライトバッチの 32-bit インデックス用の配列に書き込む
+		void BuildLargeShape2D(Vertex2D* pVertex, uint32* pIndex, const Array<Float2>& vertices, const Array<uint32>& indices, const Optional<Float2>& offset, const Float4& color);
 
-		[[nodiscard]] uint16 BuildSquareCappedLineString(BufferCreatorFunc bufferCreator, const Vec2* pts, uint16 size, const Optional<Float2>& offset, float thickness, bool inner, const Float4& color, bool isClosed, float scale);
+		void BuildLargeShape2DTransformed(Vertex2D* pVertex, uint32* pIndex, const Array<Float2>& vertices, const Array<uint32>& indices, float s, float c, const Float2& offset, const Float4& color);
 
-		[[nodiscard]] uint16 BuildRoundCappedLineString(BufferCreatorFunc bufferCreator, const Vec2* pts, uint16 size, const Optional<Float2>& offset, float thickness, bool inner, const Float4& color, float scale, float& startAngle, float& endAngle);
+		[[nodiscard]] uint16 BuildShape2DFrame(const BufferCreator& bufferCreator, const Float2* pts, uint16 size, float thickness, const Float4& color, float scale);
 
-		[[nodiscard]] uint16 BuildDotLineString(BufferCreatorFunc bufferCreator, const Vec2* pts, uint16 size, const Optional<Float2>& offset, float thickness, const Float4& color, bool isClosed, bool squareDot, float dotOffset, bool hasAlignedDot, float scale);
+		[[nodiscard]] uint16 BuildSprite(const BufferCreator& bufferCreator, const Vertex2D* vertices, size_t vertexCount, const IndexType* indices, size_t indexCount);
 
-		[[nodiscard]] uint16 BuildTextureRegion(BufferCreatorFunc bufferCreator, const FloatRect& rect, const FloatRect& uv, const Float4& color);
+		[[nodiscard]] uint16 BuildSprite(const BufferCreator& bufferCreator, const Sprite& sprite, IndexType startIndex, IndexType indexCount);
 
-		[[nodiscard]] uint16 BuildTextureRegion(BufferCreatorFunc bufferCreator, const FloatRect& rect, const FloatRect& uv, const Float4(&colors)[4]);
+		[[nodiscard]] uint16 BuildSquareCappedLineString(const BufferCreator& bufferCreator, const Vec2* pts, uint16 size, const Optional<Float2>& offset, float thickness, bool inner, const Float4& color, bool isClosed, float scale);
+
+		[[nodiscard]] uint16 BuildRoundCappedLineString(const BufferCreator& bufferCreator, const Vec2* pts, uint16 size, const Optional<Float2>& offset, float thickness, bool inner, const Float4& color, float scale, float& startAngle, float& endAngle);
+
+		[[nodiscard]] uint16 BuildDotLineString(const BufferCreator& bufferCreator, const Vec2* pts, uint16 size, const Optional<Float2>& offset, float thickness, const Float4& color, bool isClosed, bool squareDot, float dotOffset, bool hasAlignedDot, float scale);
+
+		[[nodiscard]] uint16 BuildTextureRegion(const BufferCreator& bufferCreator, const FloatRect& rect, const FloatRect& uv, const Float4& color);
+
+		[[nodiscard]] uint16 BuildTextureRegion(const BufferCreator& bufferCreator, const FloatRect& rect, const FloatRect& uv, const Float4(&colors)[4]);
 	
-		[[nodiscard]] uint16 BuildTexturedCircle(BufferCreatorFunc bufferCreator, const Circle& circle, const FloatRect& uv, const Float4& color, float scale);
+		[[nodiscard]] uint16 BuildTexturedCircle(const BufferCreator& bufferCreator, const Circle& circle, const FloatRect& uv, const Float4& color, float scale);
 
-		[[nodiscard]] uint16 BuildTexturedQuad(BufferCreatorFunc bufferCreator, const FloatQuad& quad, const FloatRect& uv, const Float4& color);
+		[[nodiscard]] uint16 BuildTexturedQuad(const BufferCreator& bufferCreator, const FloatQuad& quad, const FloatRect& uv, const Float4& color);
 	
-		[[nodiscard]] uint16 BuildTexturedParticles(BufferCreatorFunc bufferCreator, const Array<Particle2D>& particles,
+		[[nodiscard]] uint16 BuildTexturedParticles(const BufferCreator& bufferCreator, const Array<Particle2D>& particles,
 			const ParticleSystem2DParameters::SizeOverLifeTimeFunc& sizeOverLifeTimeFunc, const ParticleSystem2DParameters::ColorOverLifeTimeFunc& colorOverLifeTimeFunc);
+
+		// 以下は 1 回のバッファ要求に収まる数だけ図形を構築し、構築した個数を numBuilt に格納する
+		// colorStride が 0 の場合は colors[0] をすべての図形に使う
+
+		[[nodiscard]] uint16 BuildRects(const BufferCreator& bufferCreator, const RectF* rects, size_t count, const ColorF* colors, size_t colorStride, size_t& numBuilt);
+
+		[[nodiscard]] uint16 BuildCircles(const BufferCreator& bufferCreator, const Circle* circles, size_t count, const ColorF* colors, size_t colorStride, float scale, size_t& numBuilt);
+
+		[[nodiscard]] uint16 BuildTextureRegions(const BufferCreator& bufferCreator, const RectF* rects, const RectF* uvs, size_t count, const ColorF* colors, size_t colorStride, size_t& numBuilt);
 	}
 }
@@ -220,4 +220,9 @@ namespace s3d
 	{
 		return Siv3DEngine::Get<ISiv3DAsset>()->isReady(AssetType::Texture, name);
 	}
+
+	Optional<AssetLoadingTime> TextureAsset::GetLoadingTime(const AssetName& name)
+	{
+		return Siv3DEngine::Get<ISiv3DAsset>()->getLoadingTime(AssetType::Texture, name);
+	}
 }
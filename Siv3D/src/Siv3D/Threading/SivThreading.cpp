@@ -1,4 +1,4 @@
-//-----------------------------------------------
+﻿//-----------------------------------------------
 //
 //	This file is part of the Siv3D Engine.
 //
@@ -12,6 +12,7 @@
 # include <thread>
 # include <algorithm>
 # include <Siv3D/Threading.hpp>
+# include "TaskScheduler.hpp"
 
 namespace s3d
 {
@@ -22,5 +23,18 @@ namespace s3d
 			static const size_t n = std::max<size_t>(1, std::thread::hardware_concurrency());
 			return n;
 		}
+
+		size_t GetWorkerCount() noexcept
+		{
+			return TaskScheduler::Get().getWorkerCount();
+		}
+	}
+
+	namespace detail
+	{
+		void ParallelForImpl(const size_t first, const size_t last, const size_t grainSize, const ParallelForFunction function, void* context)
+		{
+			TaskScheduler::Get().parallelFor(first, last, grainSize, function, context);
+		}
 	}
 }
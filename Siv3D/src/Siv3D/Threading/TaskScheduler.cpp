@@ -0,0 +1,255 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "TaskScheduler.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		constexpr size_t ExternalQueueIndex = Largest<size_t>;
+
+		// 自動で grainSize を決める際の、スレッドあたりのタスク数の目安
+		constexpr size_t TasksPerThread = 8;
+
+		thread_local size_t tls_queueIndex = ExternalQueueIndex;
+	}
+
+	TaskScheduler::TaskScheduler()
+		: m_numWorkers(Threading::GetConcurrency() - 1)
+	{
+		for (size_t i = 0; i < (m_numWorkers + 1); ++i)
+		{
+			m_queues.push_back(std::make_unique<WorkQueue>());
+		}
+
+		for (size_t i = 0; i < m_numWorkers; ++i)
+		{
+			m_threads.emplace_back(&TaskScheduler::run, this, i);
+		}
+	}
+
+	TaskScheduler::~TaskScheduler()
+	{
+		{
+			std::lock_guard lock(m_sleepMutex);
+
+			m_abort = true;
+		}
+
+		m_sleepCondition.notify_all();
+
+		for (auto& thread : m_threads)
+		{
+			thread.join();
+		}
+	}
+
+	TaskScheduler& TaskScheduler::Get()
+	{
+		static TaskScheduler scheduler;
+
+		return scheduler;
+	}
+
+	size_t TaskScheduler::getWorkerCount() const noexcept
+	{
+		return m_numWorkers;
+	}
+
+	void TaskScheduler::parallelFor(const size_t first, const size_t last, size_t grainSize, const detail::ParallelForFunction function, void* context)
+	{
+		if (last <= first)
+		{
+			return;
+		}
+
+		const size_t count = (last - first);
+
+		if (grainSize == 0)
+		{
+			grainSize = std::max<size_t>(1, count / ((m_numWorkers + 1) * detail::TasksPerThread));
+		}
+
+		if ((m_numWorkers == 0) || (count <= grainSize))
+		{
+			function(context, first, last);
+
+			return;
+		}
+
+		Job job;
+		job.function	= function;
+		job.context		= context;
+		job.grainSize	= grainSize;
+		job.remaining	= count;
+
+		const size_t queueIndex = getQueueIndex();
+
+		execute(queueIndex, Task{ &job, first, last });
+
+		// 完了するまで、待たずに他のタスクを処理する（ネストされた ParallelFor もここで進む）
+		while (job.remaining.load(std::memory_order_acquire) != 0)
+		{
+			Task task;
+
+			if (pop(queueIndex, task) || steal(queueIndex, task))
+			{
+				execute(queueIndex, task);
+			}
+			else
+			{
+				std::this_thread::yield();
+			}
+		}
+
+		if (job.exception)
+		{
+			std::rethrow_exception(job.exception);
+		}
+	}
+
+	size_t TaskScheduler::getQueueIndex() const noexcept
+	{
+		if (detail::tls_queueIndex == detail::ExternalQueueIndex)
+		{
+			return m_numWorkers;
+		}
+
+		return detail::tls_queueIndex;
+	}
+
+	void TaskScheduler::push(const size_t queueIndex, const Task& task)
+	{
+		{
+			WorkQueue& queue = *m_queues[queueIndex];
+
+			std::lock_guard lock(queue.mutex);
+
+			queue.tasks.push_back(task);
+		}
+
+		m_numTasks.fetch_add(1);
+
+		// 眠っているワーカーがいるときだけ起こす
+		if (m_numSleeping.load() != 0)
+		{
+			{
+				std::lock_guard lock(m_sleepMutex);
+			}
+
+			m_sleepCondition.notify_one();
+		}
+	}
+
+	bool TaskScheduler::pop(const size_t queueIndex, Task& task)
+	{
+		WorkQueue& queue = *m_queues[queueIndex];
+
+		std::lock_guard lock(queue.mutex);
+
+		if (queue.tasks.empty())
+		{
+			return false;
+		}
+
+		task = queue.tasks.back();
+
+		queue.tasks.pop_back();
+
+		m_numTasks.fetch_sub(1);
+
+		return true;
+	}
+
+	bool TaskScheduler::steal(const size_t queueIndex, Task& task)
+	{
+		const size_t numQueues = m_queues.size();
+
+		for (size_t i = 1; i < numQueues; ++i)
+		{
+			WorkQueue& queue = *m_queues[(queueIndex + i) % numQueues];
+
+			std::lock_guard lock(queue.mutex);
+
+			if (queue.tasks.empty())
+			{
+				continue;
+			}
+
+			// 先頭には分割前の大きな範囲が残っている
+			task = queue.tasks.front();
+
+			queue.tasks.pop_front();
+
+			m_numTasks.fetch_sub(1);
+
+			return true;
+		}
+
+		return false;
+	}
+
+	void TaskScheduler::execute(const size_t queueIndex, Task task)
+	{
+		Job& job = *task.job;
+
+		while ((task.last - task.first) > job.grainSize)
+		{
+			const size_t middle = task.first + (task.last - task.first) / 2;
+
+			push(queueIndex, Task{ &job, middle, task.last });
+
+			task.last = middle;
+		}
+
+		try
+		{
+			job.function(job.context, task.first, task.last);
+		}
+		catch (...)
+		{
+			std::lock_guard lock(job.exceptionMutex);
+
+			if (!job.exception)
+			{
+				job.exception = std::current_exception();
+			}
+		}
+
+		job.remaining.fetch_sub(task.last - task.first, std::memory_order_acq_rel);
+	}
+
+	void TaskScheduler::run(const size_t queueIndex)
+	{
+		detail::tls_queueIndex = queueIndex;
+
+		while (!m_abort)
+		{
+			Task task;
+
+			if (pop(queueIndex, task) || steal(queueIndex, task))
+			{
+				execute(queueIndex, task);
+
+				continue;
+			}
+
+			std::unique_lock lock(m_sleepMutex);
+
+			m_numSleeping.fetch_add(1);
+
+			m_sleepCondition.wait(lock, [this]() { return (m_abort || (m_numTasks.load() != 0)); });
+
+			m_numSleeping.fetch_sub(1);
+		}
+	}
+}
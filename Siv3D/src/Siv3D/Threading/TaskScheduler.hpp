@@ -0,0 +1,110 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <memory>
+# include <atomic>
+# include <mutex>
+# include <condition_variable>
+# include <thread>
+# include <deque>
+# include <exception>
+# include <Siv3D/Array.hpp>
+# include <Siv3D/Threading.hpp>
+
+namespace s3d
+{
+	/// <summary>
+	/// ワークスティーリング方式のタスクスケジューラ
+	/// </summary>
+	/// <remarks>
+	/// 各ワーカーは自身のキューの末尾から取り出し（LIFO）、他のキューの先頭から盗む（FIFO）。
+	/// 範囲は実行時に grainSize まで二分割され、後半がキューに積まれる。
+	/// ワーカー以外のスレッドは共有キューを使い、完了を待つ間は自らもタスクを処理する。
+	/// </remarks>
+	class TaskScheduler
+	{
+	private:
+
+		struct Job
+		{
+			detail::ParallelForFunction function = nullptr;
+
+			void* context = nullptr;
+
+			size_t grainSize = 1;
+
+			// まだ処理が完了していないインデックスの数
+			std::atomic<size_t> remaining = 0;
+
+			std::mutex exceptionMutex;
+
+			std::exception_ptr exception;
+		};
+
+		struct Task
+		{
+			Job* job = nullptr;
+
+			size_t first = 0;
+
+			size_t last = 0;
+		};
+
+		struct WorkQueue
+		{
+			std::mutex mutex;
+
+			std::deque<Task> tasks;
+		};
+
+		// [0, m_numWorkers) はワーカー用、m_numWorkers は外部スレッドの共有キュー
+		Array<std::unique_ptr<WorkQueue>> m_queues;
+
+		Array<std::thread> m_threads;
+
+		size_t m_numWorkers = 0;
+
+		std::atomic<size_t> m_numTasks = 0;
+
+		std::atomic<size_t> m_numSleeping = 0;
+
+		std::mutex m_sleepMutex;
+
+		std::condition_variable m_sleepCondition;
+
+		std::atomic<bool> m_abort = false;
+
+		[[nodiscard]] size_t getQueueIndex() const noexcept;
+
+		void push(size_t queueIndex, const Task& task);
+
+		[[nodiscard]] bool pop(size_t queueIndex, Task& task);
+
+		[[nodiscard]] bool steal(size_t queueIndex, Task& task);
+
+		void execute(size_t queueIndex, Task task);
+
+		void run(size_t queueIndex);
+
+	public:
+
+		TaskScheduler();
+
+		~TaskScheduler();
+
+		[[nodiscard]] static TaskScheduler& Get();
+
+		[[nodiscard]] size_t getWorkerCount() const noexcept;
+
+		void parallelFor(size_t first, size_t last, size_t grainSize, detail::ParallelForFunction function, void* context);
+	};
+}
@@ -0,0 +1,351 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/Platform.hpp>
+# if SIV3D_WITH_FEATURE(SSE2)
+#	include <emmintrin.h>
+# endif
+# include <Siv3D/CompactWave.hpp>
+# include <Siv3D/Math.hpp>
+
+namespace s3d
+{
+	namespace detail
+	{
+		// Wave を変換するときに 1 回に扱うサンプル数
+		constexpr size_t ConvertChunkSamples = 4096;
+
+		[[nodiscard]] static bool IsMono(const Wave& wave) noexcept
+		{
+			for (const auto& sample : wave)
+			{
+				if (sample.left != sample.right)
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		// dst[n] = (src[n * 2] + src[n * 2 + 1]) / 2
+		static void DownmixF32(const float* pSrc, const size_t count, float* dst) noexcept
+		{
+			size_t i = 0;
+
+		# if SIV3D_WITH_FEATURE(SSE2)
+
+			const __m128 half = _mm_set1_ps(0.5f);
+
+			for (; (i + 4) <= count; i += 4)
+			{
+				const __m128 s0 = _mm_loadu_ps(pSrc + i * 2);
+				const __m128 s1 = _mm_loadu_ps(pSrc + i * 2 + 4);
+				const __m128 left = _mm_shuffle_ps(s0, s1, _MM_SHUFFLE(2, 0, 2, 0));
+				const __m128 right = _mm_shuffle_ps(s0, s1, _MM_SHUFFLE(3, 1, 3, 1));
+
+				_mm_storeu_ps(dst + i, _mm_mul_ps(_mm_add_ps(left, right), half));
+			}
+
+		# endif
+
+			for (; i < count; ++i)
+			{
+				dst[i] = ((pSrc[i * 2] + pSrc[i * 2 + 1]) * 0.5f);
+			}
+		}
+
+		// 範囲 [-1.0, 1.0] に丸めて、最も近い int16 に変換する（WaveSample::FromS16() の逆変換）
+		static void F32ToS16(const float* src, const size_t count, int16* dst) noexcept
+		{
+			size_t i = 0;
+
+		# if SIV3D_WITH_FEATURE(SSE2)
+
+			const __m128 minValue = _mm_set1_ps(-1.0f);
+			const __m128 maxValue = _mm_set1_ps(1.0f);
+			const __m128 scale = _mm_set1_ps(32768.0f);
+
+			for (; (i + 8) <= count; i += 8)
+			{
+				const __m128 a = _mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i), minValue), maxValue), scale);
+				const __m128 b = _mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i + 4), minValue), maxValue), scale);
+
+				// 32768 は飽和して 32767 になる
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packs_epi32(_mm_cvtps_epi32(a), _mm_cvtps_epi32(b)));
+			}
+
+		# endif
+
+			for (; i < count; ++i)
+			{
+				const float value = std::round(Clamp(src[i], -1.0f, 1.0f) * 32768.0f);
+
+				dst[i] = static_cast<int16>(Min(value, 32767.0f));
+			}
+		}
+
+		// dst[n] = src[n] / 32768
+		static void S16ToF32(const int16* src, const size_t count, float* dst) noexcept
+		{
+			size_t i = 0;
+
+		# if SIV3D_WITH_FEATURE(SSE2)
+
+			const __m128 scale = _mm_set1_ps(1.0f / 32768.0f);
+
+			for (; (i + 8) <= count; i += 8)
+			{
+				const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+				const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(s, s), 16);
+				const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(s, s), 16);
+
+				_mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+				_mm_storeu_ps(dst + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+			}
+
+		# endif
+
+			for (; i < count; ++i)
+			{
+				dst[i] = (src[i] / 32768.0f);
+			}
+		}
+
+		// dst[n].left = dst[n].right = src[n] / 32768
+		static void S16MonoToStereo(const int16* src, const size_t count, WaveSample* dst) noexcept
+		{
+			float* pDst = &dst->left;
+			size_t i = 0;
+
+		# if SIV3D_WITH_FEATURE(SSE2)
+
+			const __m128 scale = _mm_set1_ps(1.0f / 32768.0f);
+
+			for (; (i + 4) <= count; i += 4)
+			{
+				const __m128i s = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i));
+				const __m128 m = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(s, s), 16)), scale);
+
+				_mm_storeu_ps(pDst + i * 2, _mm_unpacklo_ps(m, m));
+				_mm_storeu_ps(pDst + i * 2 + 4, _mm_unpackhi_ps(m, m));
+			}
+
+		# endif
+
+			for (; i < count; ++i)
+			{
+				pDst[i * 2] = pDst[i * 2 + 1] = (src[i] / 32768.0f);
+			}
+		}
+
+		// dst[n] = (src[n * 2] + src[n * 2 + 1]) / 65536
+		static void S16StereoToMono(const int16* src, const size_t count, float* dst) noexcept
+		{
+			size_t i = 0;
+
+		# if SIV3D_WITH_FEATURE(SSE2)
+
+			const __m128i one = _mm_set1_epi16(1);
+			const __m128 scale = _mm_set1_ps(1.0f / 65536.0f);
+
+			for (; (i + 4) <= count; i += 4)
+			{
+				const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2));
+
+				_mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(_mm_madd_epi16(s, one)), scale));
+			}
+
+		# endif
+
+			for (; i < count; ++i)
+			{
+				dst[i] = ((static_cast<int32>(src[i * 2]) + src[i * 2 + 1]) / 65536.0f);
+			}
+		}
+
+		// dst[n].left = dst[n].right = src[n]
+		static void F32MonoToStereo(const float* src, const size_t count, WaveSample* dst) noexcept
+		{
+			float* pDst = &dst->left;
+			size_t i = 0;
+
+		# if SIV3D_WITH_FEATURE(SSE2)
+
+			for (; (i + 4) <= count; i += 4)
+			{
+				const __m128 m = _mm_loadu_ps(src + i);
+
+				_mm_storeu_ps(pDst + i * 2, _mm_unpacklo_ps(m, m));
+				_mm_storeu_ps(pDst + i * 2 + 4, _mm_unpackhi_ps(m, m));
+			}
+
+		# endif
+
+			for (; i < count; ++i)
+			{
+				pDst[i * 2] = pDst[i * 2 + 1] = src[i];
+			}
+		}
+	}
+
+	CompactWave::CompactWave(const Wave& wave, const WaveSampleFormat format)
+		: CompactWave(wave, format, detail::IsMono(wave)) {}
+
+	CompactWave::CompactWave(const Wave& wave, const WaveSampleFormat format, const bool mono)
+		: m_samples(wave.size())
+		, m_samplingRate(wave.samplingRate())
+		, m_channels(mono ? 1 : 2)
+		, m_format(format)
+	{
+		if (wave.isEmpty())
+		{
+			return;
+		}
+
+		const size_t count = (m_samples * m_channels);
+
+		if (format == WaveSampleFormat::F32)
+		{
+			m_f32.resize(count);
+
+			if (mono)
+			{
+				detail::DownmixF32(&wave.data()->left, m_samples, m_f32.data());
+			}
+			else
+			{
+				std::memcpy(m_f32.data(), wave.data(), wave.size_bytes());
+			}
+
+			return;
+		}
+
+		m_s16.resize(count);
+
+		if (!mono)
+		{
+			detail::F32ToS16(&wave.data()->left, count, m_s16.data());
+
+			return;
+		}
+
+		float buffer[detail::ConvertChunkSamples];
+
+		for (size_t pos = 0; pos < m_samples; pos += detail::ConvertChunkSamples)
+		{
+			const size_t n = Min(detail::ConvertChunkSamples, m_samples - pos);
+
+			detail::DownmixF32(&wave[pos].left, n, buffer);
+
+			detail::F32ToS16(buffer, n, m_s16.data() + pos);
+		}
+	}
+
+	CompactWave::CompactWave(const FilePath& path, const WaveSampleFormat format)
+		: CompactWave(Wave(path), format) {}
+
+	CompactWave::CompactWave(Array<int16>&& samples, const size_t channels, const Arg::samplingRate_<uint32> samplingRate)
+		: m_samplingRate(*samplingRate)
+		, m_channels(static_cast<uint32>(channels))
+		, m_format(WaveSampleFormat::S16)
+	{
+		if ((channels != 1) && (channels != 2))
+		{
+			m_channels = 2;
+
+			return;
+		}
+
+		m_s16 = std::move(samples);
+
+		m_samples = (m_s16.size() / channels);
+
+		m_s16.resize(m_samples * channels);
+	}
+
+	size_t CompactWave::size_bytes() const noexcept
+	{
+		return (m_s16.size_bytes() + m_f32.size_bytes());
+	}
+
+	void CompactWave::getSamples(const size_t pos, const size_t count, WaveSample* dst) const
+	{
+		const size_t begin = Min(pos, m_samples);
+		const size_t n = Min(count, m_samples - begin);
+
+		if (m_format == WaveSampleFormat::S16)
+		{
+			if (m_channels == 1)
+			{
+				detail::S16MonoToStereo(m_s16.data() + begin, n, dst);
+			}
+			else
+			{
+				detail::S16ToF32(m_s16.data() + begin * 2, n * 2, &dst->left);
+			}
+		}
+		else
+		{
+			if (m_channels == 1)
+			{
+				detail::F32MonoToStereo(m_f32.data() + begin, n, dst);
+			}
+			else
+			{
+				std::memcpy(dst, m_f32.data() + begin * 2, sizeof(WaveSample) * n);
+			}
+		}
+
+		// 範囲外は無音
+		std::fill(dst + n, dst + count, WaveSample::Zero());
+	}
+
+	void CompactWave::getMonoSamples(const size_t pos, const size_t count, float* dst) const
+	{
+		const size_t begin = Min(pos, m_samples);
+		const size_t n = Min(count, m_samples - begin);
+
+		if (m_format == WaveSampleFormat::S16)
+		{
+			if (m_channels == 1)
+			{
+				detail::S16ToF32(m_s16.data() + begin, n, dst);
+			}
+			else
+			{
+				detail::S16StereoToMono(m_s16.data() + begin * 2, n, dst);
+			}
+		}
+		else
+		{
+			if (m_channels == 1)
+			{
+				std::memcpy(dst, m_f32.data() + begin, sizeof(float) * n);
+			}
+			else
+			{
+				detail::DownmixF32(m_f32.data() + begin * 2, n, dst);
+			}
+		}
+
+		std::fill(dst + n, dst + count, 0.0f);
+	}
+
+	Wave CompactWave::toWave() const
+	{
+		Wave wave(m_samples, Arg::samplingRate = m_samplingRate);
+
+		getSamples(0, m_samples, wave.data());
+
+		return wave;
+	}
+}
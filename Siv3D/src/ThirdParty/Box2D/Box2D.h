@@ -51,6 +51,9 @@ For discussion please visit http://box2d.org/forum
 #include "Box2D/Dynamics/b2TimeStep.h"
 #include "Box2D/Dynamics/b2World.h"
 
+//	[Siv3D]
+#include "Box2D/Dynamics/b2WorldSnapshot.h"
+
 #include "Box2D/Dynamics/Contacts/b2Contact.h"
 
 #include "Box2D/Dynamics/Joints/b2DistanceJoint.h"
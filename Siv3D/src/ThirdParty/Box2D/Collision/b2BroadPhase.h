@@ -108,6 +108,9 @@ private:
 
 	friend class b2DynamicTree;
 
+	//	[Siv3D]
+	friend class b2WorldSnapshot;
+
 	void BufferMove(int32 proxyId);
 	void UnBufferMove(int32 proxyId);
 
@@ -125,6 +125,9 @@ public:
 
 private:
 
+	//	[Siv3D]
+	friend class b2WorldSnapshot;
+
 	int32 AllocateNode();
 	void FreeNode(int32 node);
 
@@ -151,6 +151,9 @@ protected:
 	friend class b2Body;
 	friend class b2Fixture;
 
+	//	[Siv3D]
+	friend class b2WorldSnapshot;
+
 	// Flags stored in m_flags
 	enum
 	{
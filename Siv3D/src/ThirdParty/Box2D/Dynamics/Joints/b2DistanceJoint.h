@@ -104,6 +104,9 @@ public:
 protected:
 
 	friend class b2Joint;
+
+	//	[Siv3D]
+	friend class b2WorldSnapshot;
 	b2DistanceJoint(const b2DistanceJointDef* data);
 
 	void InitVelocityConstraints(const b2SolverData& data) override;
@@ -155,6 +155,9 @@ protected:
 	friend class b2Island;
 	friend class b2GearJoint;
 
+	//	[Siv3D]
+	friend class b2WorldSnapshot;
+
 	static b2Joint* Create(const b2JointDef* def, b2BlockAllocator* allocator);
 	static void Destroy(b2Joint* joint, b2BlockAllocator* allocator);
 
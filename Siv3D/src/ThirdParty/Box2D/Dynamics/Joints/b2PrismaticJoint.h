@@ -150,6 +150,9 @@ public:
 protected:
 	friend class b2Joint;
 	friend class b2GearJoint;
+
+	//	[Siv3D]
+	friend class b2WorldSnapshot;
 	b2PrismaticJoint(const b2PrismaticJointDef* def);
 
 	void InitVelocityConstraints(const b2SolverData& data) override;
@@ -159,6 +159,9 @@ protected:
 	friend class b2Joint;
 	friend class b2GearJoint;
 
+	//	[Siv3D]
+	friend class b2WorldSnapshot;
+
 	b2RevoluteJoint(const b2RevoluteJointDef* def);
 
 	void InitVelocityConstraints(const b2SolverData& data) override;
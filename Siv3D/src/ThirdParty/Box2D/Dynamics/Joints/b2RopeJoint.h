@@ -82,6 +82,9 @@ public:
 protected:
 
 	friend class b2Joint;
+
+	//	[Siv3D]
+	friend class b2WorldSnapshot;
 	b2RopeJoint(const b2RopeJointDef* data);
 
 	void InitVelocityConstraints(const b2SolverData& data) override;
@@ -138,6 +138,9 @@ public:
 protected:
 
 	friend class b2Joint;
+
+	//	[Siv3D]
+	friend class b2WorldSnapshot;
 	b2WheelJoint(const b2WheelJointDef* def);
 
 	void InitVelocityConstraints(const b2SolverData& data) override;
@@ -396,6 +396,9 @@ private:
 	friend class b2ContactManager;
 	friend class b2ContactSolver;
 	friend class b2Contact;
+
+	//	[Siv3D]
+	friend class b2WorldSnapshot;
 	
 	friend class b2DistanceJoint;
 	friend class b2FrictionJoint;
@@ -202,6 +202,9 @@ protected:
 	friend class b2Contact;
 	friend class b2ContactManager;
 
+	//	[Siv3D]
+	friend class b2WorldSnapshot;
+
 	b2Fixture();
 
 	// We need separation create/destroy functions from the constructor/destructor because
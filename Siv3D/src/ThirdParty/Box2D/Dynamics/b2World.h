@@ -224,6 +224,9 @@ private:
 	friend class b2ContactManager;
 	friend class b2Controller;
 
+	//	[Siv3D]
+	friend class b2WorldSnapshot;
+
 	void Solve(const b2TimeStep& step);
 	void SolveTOI(const b2TimeStep& step);
 
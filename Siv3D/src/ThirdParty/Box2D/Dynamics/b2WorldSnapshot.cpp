@@ -0,0 +1,719 @@
+//-----------------------------------------------
+//
+//	[Siv3D]
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+#include "Box2D/Dynamics/b2WorldSnapshot.h"
+#include "Box2D/Dynamics/b2World.h"
+#include "Box2D/Dynamics/b2Body.h"
+#include "Box2D/Dynamics/b2Fixture.h"
+#include "Box2D/Dynamics/Contacts/b2Contact.h"
+#include "Box2D/Dynamics/Joints/b2DistanceJoint.h"
+#include "Box2D/Dynamics/Joints/b2PrismaticJoint.h"
+#include "Box2D/Dynamics/Joints/b2RevoluteJoint.h"
+#include "Box2D/Dynamics/Joints/b2RopeJoint.h"
+#include "Box2D/Dynamics/Joints/b2WheelJoint.h"
+#include <cstring>
+
+namespace
+{
+	// Records are copied with memcpy, so the layout only has to match the same build.
+
+	struct b2SnapshotHeader
+	{
+		int32 bodyCount;
+		int32 jointCount;
+		int32 contactCount;
+		int32 proxyCount;
+		int32 moveCount;
+
+		int32 root;
+		int32 nodeCount;
+		int32 nodeCapacity;
+		int32 freeList;
+		uint32 path;
+		int32 insertionCount;
+
+		int32 flags;
+		b2Vec2 gravity;
+		float32 inv_dt0;
+		bool stepComplete;
+	};
+
+	struct b2SnapshotContact
+	{
+		int32 proxyIdA;
+		int32 proxyIdB;
+		uint32 flags;
+		b2Manifold manifold;
+		int32 toiCount;
+		float32 toi;
+		float32 friction;
+		float32 restitution;
+		float32 tangentSpeed;
+	};
+
+	struct b2SnapshotBody
+	{
+		int32 type;
+		int32 fixtureCount;
+
+		b2Transform xf;
+		b2Sweep sweep;
+		b2Vec2 linearVelocity;
+		float32 angularVelocity;
+		b2Vec2 force;
+		float32 torque;
+		float32 mass, invMass;
+		float32 I, invI;
+		float32 linearDamping;
+		float32 angularDamping;
+		float32 gravityScale;
+		float32 sleepTime;
+		uint16 flags;
+	};
+
+	struct b2SnapshotFixture
+	{
+		int32 proxyCount;
+		float32 density;
+		float32 friction;
+		float32 restitution;
+		b2Filter filter;
+		bool isSensor;
+	};
+
+	struct b2SnapshotProxy
+	{
+		int32 proxyId;
+		b2AABB aabb;
+	};
+
+	// Joint types that do not use a field leave it zero.
+	struct b2SnapshotJoint
+	{
+		int32 type;
+		b2Vec3 impulse;
+		float32 motorImpulse;
+		float32 springImpulse;
+		float32 length;
+		int32 limitState;
+	};
+
+	class b2SnapshotWriter
+	{
+	public:
+
+		b2SnapshotWriter(void* data, int32 capacity)
+			: m_data(static_cast<uint8*>(data))
+			, m_capacity(capacity)
+			, m_size(0) {}
+
+		void Write(const void* src, int32 size)
+		{
+			if (m_size + size <= m_capacity)
+			{
+				memcpy(m_data + m_size, src, size);
+			}
+
+			m_size += size;
+		}
+
+		template <class T>
+		void Write(const T& value)
+		{
+			Write(&value, sizeof(T));
+		}
+
+		int32 GetSize() const
+		{
+			return m_size;
+		}
+
+	private:
+
+		uint8* m_data;
+		int32 m_capacity;
+		int32 m_size;
+	};
+
+	class b2SnapshotReader
+	{
+	public:
+
+		b2SnapshotReader(const void* data, int32 size)
+			: m_data(static_cast<const uint8*>(data))
+			, m_size(size)
+			, m_pos(0) {}
+
+		/// Returns nullptr if the data is too short.
+		const uint8* Read(int32 size)
+		{
+			if (size < 0 || m_size - m_pos < size)
+			{
+				return nullptr;
+			}
+
+			const uint8* p = m_data + m_pos;
+			m_pos += size;
+			return p;
+		}
+
+		template <class T>
+		bool Read(T* value)
+		{
+			const uint8* p = Read(sizeof(T));
+
+			if (p == nullptr)
+			{
+				return false;
+			}
+
+			memcpy(value, p, sizeof(T));
+			return true;
+		}
+
+		bool IsEnd() const
+		{
+			return m_pos == m_size;
+		}
+
+	private:
+
+		const uint8* m_data;
+		int32 m_size;
+		int32 m_pos;
+	};
+}
+
+int32 b2WorldSnapshot::Save(const b2World* world, void* data, int32 capacity)
+{
+	const b2ContactManager& contactManager = world->m_contactManager;
+	const b2BroadPhase& broadPhase = contactManager.m_broadPhase;
+	const b2DynamicTree& tree = broadPhase.m_tree;
+
+	b2SnapshotWriter writer(data, capacity);
+
+	b2SnapshotHeader header;
+	memset(static_cast<void*>(&header), 0, sizeof(header));
+	header.bodyCount = world->m_bodyCount;
+	header.jointCount = world->m_jointCount;
+	header.contactCount = contactManager.m_contactCount;
+	header.proxyCount = broadPhase.m_proxyCount;
+	header.moveCount = broadPhase.m_moveCount;
+	header.root = tree.m_root;
+	header.nodeCount = tree.m_nodeCount;
+	header.nodeCapacity = tree.m_nodeCapacity;
+	header.freeList = tree.m_freeList;
+	header.path = tree.m_path;
+	header.insertionCount = tree.m_insertionCount;
+	header.flags = world->m_flags;
+	header.gravity = world->m_gravity;
+	header.inv_dt0 = world->m_inv_dt0;
+	header.stepComplete = world->m_stepComplete;
+	writer.Write(header);
+
+	// Contacts are written in world list order.
+	for (const b2Contact* c = contactManager.m_contactList; c; c = c->m_next)
+	{
+		b2SnapshotContact contact;
+		memset(static_cast<void*>(&contact), 0, sizeof(contact));
+		contact.proxyIdA = c->m_fixtureA->m_proxies[c->m_indexA].proxyId;
+		contact.proxyIdB = c->m_fixtureB->m_proxies[c->m_indexB].proxyId;
+		contact.flags = c->m_flags;
+		contact.manifold = c->m_manifold;
+		contact.toiCount = c->m_toiCount;
+		contact.toi = c->m_toi;
+		contact.friction = c->m_friction;
+		contact.restitution = c->m_restitution;
+		contact.tangentSpeed = c->m_tangentSpeed;
+		writer.Write(contact);
+	}
+
+	for (const b2Body* b = world->m_bodyList; b; b = b->m_next)
+	{
+		b2SnapshotBody body;
+		memset(static_cast<void*>(&body), 0, sizeof(body));
+		body.type = b->m_type;
+		body.fixtureCount = b->m_fixtureCount;
+		body.xf = b->m_xf;
+		body.sweep = b->m_sweep;
+		body.linearVelocity = b->m_linearVelocity;
+		body.angularVelocity = b->m_angularVelocity;
+		body.force = b->m_force;
+		body.torque = b->m_torque;
+		body.mass = b->m_mass;
+		body.invMass = b->m_invMass;
+		body.I = b->m_I;
+		body.invI = b->m_invI;
+		body.linearDamping = b->m_linearDamping;
+		body.angularDamping = b->m_angularDamping;
+		body.gravityScale = b->m_gravityScale;
+		body.sleepTime = b->m_sleepTime;
+		body.flags = b->m_flags;
+		writer.Write(body);
+
+		for (const b2Fixture* f = b->m_fixtureList; f; f = f->m_next)
+		{
+			b2SnapshotFixture fixture;
+			memset(static_cast<void*>(&fixture), 0, sizeof(fixture));
+			fixture.proxyCount = f->m_proxyCount;
+			fixture.density = f->m_density;
+			fixture.friction = f->m_friction;
+			fixture.restitution = f->m_restitution;
+			fixture.filter = f->m_filter;
+			fixture.isSensor = f->m_isSensor;
+			writer.Write(fixture);
+
+			for (int32 i = 0; i < f->m_proxyCount; ++i)
+			{
+				b2SnapshotProxy proxy;
+				memset(static_cast<void*>(&proxy), 0, sizeof(proxy));
+				proxy.proxyId = f->m_proxies[i].proxyId;
+				proxy.aabb = f->m_proxies[i].aabb;
+				writer.Write(proxy);
+			}
+		}
+	}
+
+	for (const b2Joint* j = world->m_jointList; j; j = j->m_next)
+	{
+		b2SnapshotJoint joint;
+		memset(static_cast<void*>(&joint), 0, sizeof(joint));
+		joint.type = j->m_type;
+
+		switch (j->m_type)
+		{
+		case e_distanceJoint:
+			{
+				const b2DistanceJoint* d = static_cast<const b2DistanceJoint*>(j);
+				joint.impulse.x = d->m_impulse;
+			}
+			break;
+
+		case e_revoluteJoint:
+			{
+				const b2RevoluteJoint* r = static_cast<const b2RevoluteJoint*>(j);
+				joint.impulse = r->m_impulse;
+				joint.motorImpulse = r->m_motorImpulse;
+				joint.limitState = r->m_limitState;
+			}
+			break;
+
+		case e_prismaticJoint:
+			{
+				const b2PrismaticJoint* p = static_cast<const b2PrismaticJoint*>(j);
+				joint.impulse = p->m_impulse;
+				joint.motorImpulse = p->m_motorImpulse;
+				joint.limitState = p->m_limitState;
+			}
+			break;
+
+		case e_ropeJoint:
+			{
+				const b2RopeJoint* r = static_cast<const b2RopeJoint*>(j);
+				joint.impulse.x = r->m_impulse;
+				joint.length = r->m_length;
+				joint.limitState = r->m_state;
+			}
+			break;
+
+		case e_wheelJoint:
+			{
+				const b2WheelJoint* w = static_cast<const b2WheelJoint*>(j);
+				joint.impulse.x = w->m_impulse;
+				joint.motorImpulse = w->m_motorImpulse;
+				joint.springImpulse = w->m_springImpulse;
+			}
+			break;
+
+		default:
+			break;
+		}
+
+		writer.Write(joint);
+	}
+
+	writer.Write(broadPhase.m_moveBuffer, broadPhase.m_moveCount * sizeof(int32));
+
+	writer.Write(tree.m_nodes, tree.m_nodeCapacity * sizeof(b2TreeNode));
+
+	return writer.GetSize();
+}
+
+bool b2WorldSnapshot::Restore(b2World* world, const void* data, int32 size)
+{
+	if (world->IsLocked())
+	{
+		return false;
+	}
+
+	b2ContactManager& contactManager = world->m_contactManager;
+	b2BroadPhase& broadPhase = contactManager.m_broadPhase;
+	b2DynamicTree& tree = broadPhase.m_tree;
+
+	b2SnapshotHeader header;
+
+	// Validate the whole data before modifying the world.
+	{
+		b2SnapshotReader reader(data, size);
+
+		if (!reader.Read(&header)
+			|| header.bodyCount != world->m_bodyCount
+			|| header.jointCount != world->m_jointCount
+			|| header.proxyCount != broadPhase.m_proxyCount
+			|| header.contactCount < 0
+			|| header.moveCount < 0
+			|| header.nodeCapacity <= 0
+			|| tree.m_nodeCapacity < header.nodeCapacity)
+		{
+			return false;
+		}
+
+		for (int32 i = 0; i < header.contactCount; ++i)
+		{
+			b2SnapshotContact contact;
+
+			if (!reader.Read(&contact))
+			{
+				return false;
+			}
+
+			// Both proxies must be leaves of the current tree.
+			const int32 ids[2] = { contact.proxyIdA, contact.proxyIdB };
+
+			for (int32 id : ids)
+			{
+				if (id < 0 || tree.m_nodeCapacity <= id || tree.m_nodes[id].height != 0)
+				{
+					return false;
+				}
+			}
+		}
+
+		for (const b2Body* b = world->m_bodyList; b; b = b->m_next)
+		{
+			b2SnapshotBody body;
+
+			if (!reader.Read(&body)
+				|| body.type != b->m_type
+				|| body.fixtureCount != b->m_fixtureCount)
+			{
+				return false;
+			}
+
+			for (const b2Fixture* f = b->m_fixtureList; f; f = f->m_next)
+			{
+				b2SnapshotFixture fixture;
+
+				if (!reader.Read(&fixture)
+					|| fixture.proxyCount != f->m_proxyCount)
+				{
+					return false;
+				}
+
+				for (int32 i = 0; i < f->m_proxyCount; ++i)
+				{
+					b2SnapshotProxy proxy;
+
+					if (!reader.Read(&proxy)
+						|| proxy.proxyId != f->m_proxies[i].proxyId)
+					{
+						return false;
+					}
+				}
+			}
+		}
+
+		for (const b2Joint* j = world->m_jointList; j; j = j->m_next)
+		{
+			b2SnapshotJoint joint;
+
+			if (!reader.Read(&joint)
+				|| joint.type != j->m_type)
+			{
+				return false;
+			}
+		}
+
+		if (!reader.Read(header.moveCount * static_cast<int32>(sizeof(int32)))
+			|| !reader.Read(header.nodeCapacity * static_cast<int32>(sizeof(b2TreeNode)))
+			|| !reader.IsEnd())
+		{
+			return false;
+		}
+	}
+
+	b2SnapshotReader reader(data, size);
+	reader.Read(&header);
+
+	world->m_flags = header.flags;
+	world->m_gravity = header.gravity;
+	world->m_inv_dt0 = header.inv_dt0;
+	world->m_stepComplete = header.stepComplete;
+
+	// Contacts are restored before bodies, because destroying a contact wakes its bodies.
+	{
+		const uint8* contacts = reader.Read(header.contactCount * static_cast<int32>(sizeof(b2SnapshotContact)));
+
+		// If the world has the same contacts in the same order, only their state is overwritten.
+		bool sameContacts = (contactManager.m_contactCount == header.contactCount);
+
+		if (sameContacts)
+		{
+			const b2Contact* c = contactManager.m_contactList;
+
+			for (int32 i = 0; i < header.contactCount; ++i, c = c->m_next)
+			{
+				b2SnapshotContact contact;
+				memcpy(&contact, contacts + i * sizeof(b2SnapshotContact), sizeof(contact));
+
+				if (c->m_fixtureA->m_proxies[c->m_indexA].proxyId != contact.proxyIdA
+					|| c->m_fixtureB->m_proxies[c->m_indexB].proxyId != contact.proxyIdB)
+				{
+					sameContacts = false;
+					break;
+				}
+			}
+		}
+
+		if (!sameContacts)
+		{
+			b2ContactListener* listener = contactManager.m_contactListener;
+			contactManager.m_contactListener = nullptr;
+
+			while (contactManager.m_contactList)
+			{
+				contactManager.Destroy(contactManager.m_contactList);
+			}
+
+			contactManager.m_contactListener = listener;
+
+			// Contacts are prepended to the world and body lists, so creating them in reverse
+			// order reproduces the order of both lists.
+			for (int32 i = header.contactCount - 1; 0 <= i; --i)
+			{
+				b2SnapshotContact contact;
+				memcpy(&contact, contacts + i * sizeof(b2SnapshotContact), sizeof(contact));
+
+				const b2FixtureProxy* proxyA = static_cast<const b2FixtureProxy*>(tree.m_nodes[contact.proxyIdA].userData);
+				const b2FixtureProxy* proxyB = static_cast<const b2FixtureProxy*>(tree.m_nodes[contact.proxyIdB].userData);
+
+				b2Contact* c = b2Contact::Create(proxyA->fixture, proxyA->childIndex, proxyB->fixture, proxyB->childIndex, contactManager.m_allocator);
+				b2Assert(c != nullptr);
+				b2Assert(c->m_fixtureA == proxyA->fixture);
+
+				b2Body* bodyA = c->m_fixtureA->m_body;
+				b2Body* bodyB = c->m_fixtureB->m_body;
+
+				c->m_prev = nullptr;
+				c->m_next = contactManager.m_contactList;
+				if (contactManager.m_contactList != nullptr)
+				{
+					contactManager.m_contactList->m_prev = c;
+				}
+				contactManager.m_contactList = c;
+
+				c->m_nodeA.contact = c;
+				c->m_nodeA.other = bodyB;
+				c->m_nodeA.prev = nullptr;
+				c->m_nodeA.next = bodyA->m_contactList;
+				if (bodyA->m_contactList != nullptr)
+				{
+					bodyA->m_contactList->prev = &c->m_nodeA;
+				}
+				bodyA->m_contactList = &c->m_nodeA;
+
+				c->m_nodeB.contact = c;
+				c->m_nodeB.other = bodyA;
+				c->m_nodeB.prev = nullptr;
+				c->m_nodeB.next = bodyB->m_contactList;
+				if (bodyB->m_contactList != nullptr)
+				{
+					bodyB->m_contactList->prev = &c->m_nodeB;
+				}
+				bodyB->m_contactList = &c->m_nodeB;
+
+				++contactManager.m_contactCount;
+			}
+		}
+
+		b2Contact* c = contactManager.m_contactList;
+
+		for (int32 i = 0; i < header.contactCount; ++i, c = c->m_next)
+		{
+			b2SnapshotContact contact;
+			memcpy(&contact, contacts + i * sizeof(b2SnapshotContact), sizeof(contact));
+
+			c->m_flags = contact.flags;
+			c->m_manifold = contact.manifold;
+			c->m_toiCount = contact.toiCount;
+			c->m_toi = contact.toi;
+			c->m_friction = contact.friction;
+			c->m_restitution = contact.restitution;
+			c->m_tangentSpeed = contact.tangentSpeed;
+		}
+	}
+
+	for (b2Body* b = world->m_bodyList; b; b = b->m_next)
+	{
+		b2SnapshotBody body;
+		reader.Read(&body);
+
+		b->m_flags = body.flags;
+		b->m_xf = body.xf;
+		b->m_sweep = body.sweep;
+		b->m_linearVelocity = body.linearVelocity;
+		b->m_angularVelocity = body.angularVelocity;
+		b->m_force = body.force;
+		b->m_torque = body.torque;
+		b->m_mass = body.mass;
+		b->m_invMass = body.invMass;
+		b->m_I = body.I;
+		b->m_invI = body.invI;
+		b->m_linearDamping = body.linearDamping;
+		b->m_angularDamping = body.angularDamping;
+		b->m_gravityScale = body.gravityScale;
+		b->m_sleepTime = body.sleepTime;
+
+		for (b2Fixture* f = b->m_fixtureList; f; f = f->m_next)
+		{
+			b2SnapshotFixture fixture;
+			reader.Read(&fixture);
+
+			f->m_density = fixture.density;
+			f->m_friction = fixture.friction;
+			f->m_restitution = fixture.restitution;
+			f->m_filter = fixture.filter;
+			f->m_isSensor = fixture.isSensor;
+
+			for (int32 i = 0; i < f->m_proxyCount; ++i)
+			{
+				b2SnapshotProxy proxy;
+				reader.Read(&proxy);
+
+				f->m_proxies[i].aabb = proxy.aabb;
+			}
+		}
+	}
+
+	for (b2Joint* j = world->m_jointList; j; j = j->m_next)
+	{
+		b2SnapshotJoint joint;
+		reader.Read(&joint);
+
+		switch (j->m_type)
+		{
+		case e_distanceJoint:
+			{
+				b2DistanceJoint* d = static_cast<b2DistanceJoint*>(j);
+				d->m_impulse = joint.impulse.x;
+			}
+			break;
+
+		case e_revoluteJoint:
+			{
+				b2RevoluteJoint* r = static_cast<b2RevoluteJoint*>(j);
+				r->m_impulse = joint.impulse;
+				r->m_motorImpulse = joint.motorImpulse;
+				r->m_limitState = static_cast<b2LimitState>(joint.limitState);
+			}
+			break;
+
+		case e_prismaticJoint:
+			{
+				b2PrismaticJoint* p = static_cast<b2PrismaticJoint*>(j);
+				p->m_impulse = joint.impulse;
+				p->m_motorImpulse = joint.motorImpulse;
+				p->m_limitState = static_cast<b2LimitState>(joint.limitState);
+			}
+			break;
+
+		case e_ropeJoint:
+			{
+				b2RopeJoint* r = static_cast<b2RopeJoint*>(j);
+				r->m_impulse = joint.impulse.x;
+				r->m_length = joint.length;
+				r->m_state = static_cast<b2LimitState>(joint.limitState);
+			}
+			break;
+
+		case e_wheelJoint:
+			{
+				b2WheelJoint* w = static_cast<b2WheelJoint*>(j);
+				w->m_impulse = joint.impulse.x;
+				w->m_motorImpulse = joint.motorImpulse;
+				w->m_springImpulse = joint.springImpulse;
+			}
+			break;
+
+		default:
+			break;
+		}
+	}
+
+	// BufferMove grows the buffer only if it is smaller than the saved one.
+	{
+		const uint8* moves = reader.Read(header.moveCount * static_cast<int32>(sizeof(int32)));
+
+		broadPhase.m_moveCount = 0;
+
+		for (int32 i = 0; i < header.moveCount; ++i)
+		{
+			int32 proxyId;
+			memcpy(&proxyId, moves + i * sizeof(int32), sizeof(proxyId));
+			broadPhase.BufferMove(proxyId);
+		}
+	}
+
+	// The saved tree has the same leaves as the current one (validated by the proxy ids above),
+	// so the user data of the current leaves stays valid.
+	{
+		const uint8* nodes = reader.Read(header.nodeCapacity * static_cast<int32>(sizeof(b2TreeNode)));
+
+		for (int32 i = 0; i < header.nodeCapacity; ++i)
+		{
+			b2TreeNode node;
+			memcpy(&node, nodes + i * sizeof(b2TreeNode), sizeof(node));
+
+			if (node.height == 0)
+			{
+				node.userData = tree.m_nodes[i].userData;
+			}
+			else
+			{
+				node.userData = nullptr;
+			}
+
+			tree.m_nodes[i] = node;
+		}
+
+		tree.m_root = header.root;
+		tree.m_nodeCount = header.nodeCount;
+		tree.m_freeList = header.freeList;
+		tree.m_path = header.path;
+		tree.m_insertionCount = header.insertionCount;
+
+		// Nodes allocated after the snapshot are returned to the free list.
+		if (header.nodeCapacity < tree.m_nodeCapacity)
+		{
+			for (int32 i = header.nodeCapacity; i < tree.m_nodeCapacity - 1; ++i)
+			{
+				tree.m_nodes[i].next = i + 1;
+				tree.m_nodes[i].height = -1;
+			}
+
+			tree.m_nodes[tree.m_nodeCapacity - 1].next = header.freeList;
+			tree.m_nodes[tree.m_nodeCapacity - 1].height = -1;
+			tree.m_freeList = header.nodeCapacity;
+		}
+	}
+
+	return true;
+}
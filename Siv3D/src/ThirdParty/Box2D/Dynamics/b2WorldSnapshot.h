@@ -0,0 +1,40 @@
+//-----------------------------------------------
+//
+//	[Siv3D]
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+#ifndef B2_WORLD_SNAPSHOT_H
+#define B2_WORLD_SNAPSHOT_H
+
+#include "Box2D/Common/b2Settings.h"
+
+class b2World;
+
+/// Saves and restores the simulation state of a world: body motion, fixture proxies,
+/// contacts with their warm starting impulses, the broad-phase tree and joint impulses.
+/// Stepping a restored world reproduces the original steps bit for bit.
+/// The structure of the world (bodies, fixtures and joints) must be the same as when it was saved.
+/// Only the joint types distance, revolute, prismatic, rope and wheel keep their impulses.
+class b2WorldSnapshot
+{
+public:
+
+	/// Write the state of the world to data.
+	/// @return the number of bytes the state requires. If it exceeds capacity,
+	/// the data is incomplete and Save must be called again with a larger buffer.
+	static int32 Save(const b2World* world, void* data, int32 capacity);
+
+	/// Restore the state of the world from data written by Save.
+	/// @return false if the data does not match the structure of the world.
+	/// The world is not modified in that case.
+	/// Contact listener callbacks are not called.
+	static bool Restore(b2World* world, const void* data, int32 size);
+};
+
+#endif
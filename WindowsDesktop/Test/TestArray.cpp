@@ -751,6 +751,11 @@ TEST_CASE("Array")
 		REQUIRE(sum == 10000100000LL);
 	}
 
+	{
+		const Array<int32> v = Range(0, 100'000);
+		REQUIRE(v.parallel_map(Plus(1)) == Range(1, 100'001).asArray());
+	}
+
 	{
 		const Array<int32> v = Range(0, 100'000);
 		REQUIRE(v.map(Plus(1)) == Range(1, 100'001).asArray());
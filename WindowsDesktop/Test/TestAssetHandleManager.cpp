@@ -0,0 +1,237 @@
+﻿
+# include "Test.hpp"
+
+# if defined(SIV3D_DO_TEST)
+
+# define SIV3D_CONCURRENT
+# include <Siv3D.hpp>
+# include <ThirdParty/Catch2/catch.hpp>
+# include <AssetHandleManager/AssetHandleManager.hpp>
+
+namespace TestAssetHandleManager
+{
+	struct TestAsset {};
+
+	using TestID = AssetIDWrapper<TestAsset>;
+
+	// スロット番号が 10 ビット（1 ～ 1022）のマネージャ
+	using SmallManager = AssetHandleManager<TestID, int32, 10>;
+
+	// 置き換える前の、HashTable と mutex によるマネージャ
+	template <class IDType, class Data>
+	class MutexHandleManager
+	{
+	private:
+
+		HashTable<IDType, std::unique_ptr<Data>> m_data;
+
+		typename IDType::ValueType m_idCount = 0;
+
+		std::mutex m_mutex;
+
+	public:
+
+		Data* operator [](const IDType id)
+		{
+			std::lock_guard lock(m_mutex);
+
+			return m_data[id].get();
+		}
+
+		IDType add(std::unique_ptr<Data>&& data)
+		{
+			std::lock_guard lock(m_mutex);
+
+			m_data.emplace(++m_idCount, std::move(data));
+
+			return IDType(m_idCount);
+		}
+	};
+
+	// threads 個のスレッドが ids を繰り返し参照したときの、1 秒あたりの参照回数
+	template <class Manager>
+	static double MeasureLookups(Manager& manager, const Array<TestID>& ids, const size_t threads)
+	{
+		constexpr size_t LookupsPerThread = 2'000'000;
+
+		std::atomic<int64> checksum = 0;
+		Array<std::future<void>> tasks;
+		const Stopwatch stopwatch(true);
+
+		for (size_t t = 0; t < threads; ++t)
+		{
+			tasks << std::async(std::launch::async, [&, t]()
+			{
+				int64 sum = 0;
+
+				for (size_t i = 0; i < LookupsPerThread; ++i)
+				{
+					sum += *manager[ids[(i * 7 + t) % ids.size()]];
+				}
+
+				checksum += sum;
+			});
+		}
+
+		for (auto& task : tasks)
+		{
+			task.get();
+		}
+
+		REQUIRE(checksum != 0);
+
+		return (LookupsPerThread * threads / stopwatch.sF());
+	}
+}
+
+TEST_CASE("AssetHandleManager")
+{
+	using namespace TestAssetHandleManager;
+
+	SECTION("Add and erase")
+	{
+		AssetHandleManager<TestID, int32> manager(U"Test");
+		manager.setNullData(std::make_unique<int32>(-1));
+
+		const TestID a = manager.add(std::make_unique<int32>(10));
+		const TestID b = manager.add(std::make_unique<int32>(20));
+		const TestID c = manager.add(std::make_unique<int32>(30));
+
+		REQUIRE(*manager[TestID::NullAsset()] == -1);
+		REQUIRE(*manager[a] == 10);
+		REQUIRE(*manager[b] == 20);
+		REQUIRE(*manager[c] == 30);
+		REQUIRE(std::distance(manager.begin(), manager.end()) == 4);
+
+		manager.erase(b);
+
+		REQUIRE(manager[b] == nullptr);
+		REQUIRE(*manager[a] == 10);
+		REQUIRE(*manager[c] == 30);
+		REQUIRE(std::distance(manager.begin(), manager.end()) == 3);
+
+		// 確保されていないチャンクや、範囲外の ID
+		REQUIRE(manager[TestID(5000)] == nullptr);
+		REQUIRE(manager[TestID::InvalidValue()] == nullptr);
+
+		manager.destroy();
+
+		REQUIRE(manager[a] == nullptr);
+		REQUIRE(manager[TestID::NullAsset()] == nullptr);
+		REQUIRE(manager.begin() == manager.end());
+	}
+
+	SECTION("Exhaustion and slot reuse")
+	{
+		SmallManager manager(U"Test");
+		manager.setNullData(std::make_unique<int32>(-1));
+
+		Array<TestID> ids;
+
+		for (;;)
+		{
+			const TestID id = manager.add(std::make_unique<int32>(static_cast<int32>(ids.size())));
+
+			if (id.isNullAsset())
+			{
+				break;
+			}
+
+			ids << id;
+		}
+
+		// スロット 1 ～ 1022 を使い切ると NullAsset を返す
+		REQUIRE(ids.size() == 1022);
+
+		for (size_t i = 0; i < ids.size(); ++i)
+		{
+			REQUIRE(*manager[ids[i]] == static_cast<int32>(i));
+		}
+
+		const TestID stale = ids[100];
+		manager.erase(stale);
+
+		// 空いたスロットは、世代を進めて再利用される
+		const TestID reused = manager.add(std::make_unique<int32>(12345));
+
+		REQUIRE(!reused.isNullAsset());
+		REQUIRE((reused.value() & 1023) == (stale.value() & 1023));
+		REQUIRE(reused != stale);
+		REQUIRE((reused.value() >> 10) == ((stale.value() >> 10) + 1));
+
+		// 古い ID では参照できない
+		REQUIRE(manager[stale] == nullptr);
+		REQUIRE(*manager[reused] == 12345);
+
+		REQUIRE(manager.add(std::make_unique<int32>(0)).isNullAsset());
+	}
+
+	SECTION("Concurrent lookups")
+	{
+		AssetHandleManager<TestID, int32> manager(U"Test");
+		manager.setNullData(std::make_unique<int32>(-1));
+
+		Array<TestID> ids;
+
+		for (int32 i = 1; i <= 1000; ++i)
+		{
+			ids << manager.add(std::make_unique<int32>(i));
+		}
+
+		// 参照しながら別のアセットを追加・削除しても、既存のアセットは常に見える
+		std::atomic<bool> done = false;
+
+		auto reader = std::async(std::launch::async, [&]()
+		{
+			bool ok = true;
+
+			while (!done)
+			{
+				for (size_t i = 0; i < ids.size(); ++i)
+				{
+					const int32* p = manager[ids[i]];
+
+					ok &= (p && (*p == static_cast<int32>(i + 1)));
+				}
+			}
+
+			return ok;
+		});
+
+		for (int32 i = 0; i < 5000; ++i)
+		{
+			manager.erase(manager.add(std::make_unique<int32>(0)));
+		}
+
+		done = true;
+
+		REQUIRE(reader.get());
+	}
+}
+
+TEST_CASE("AssetHandleManager.Benchmark", "[.benchmark]")
+{
+	using namespace TestAssetHandleManager;
+
+	AssetHandleManager<TestID, int32> slotMap(U"Test");
+	MutexHandleManager<TestID, int32> mutexMap;
+	Array<TestID> slotMapIDs, mutexMapIDs;
+
+	for (int32 i = 1; i <= 4096; ++i)
+	{
+		slotMapIDs << slotMap.add(std::make_unique<int32>(i));
+
+		mutexMapIDs << mutexMap.add(std::make_unique<int32>(i));
+	}
+
+	for (const size_t threads : { size_t(1), Max<size_t>(Threading::GetConcurrency(), 2) })
+	{
+		const double mutexRate = MeasureLookups(mutexMap, mutexMapIDs, threads);
+		const double slotMapRate = MeasureLookups(slotMap, slotMapIDs, threads);
+
+		Console << U"{} reader threads: HashTable + mutex {:.1f} M lookups/s, slot map {:.1f} M lookups/s ({:.1f}x)"_fmt(
+			threads, mutexRate / 1e6, slotMapRate / 1e6, slotMapRate / mutexRate);
+	}
+}
+
+# endif
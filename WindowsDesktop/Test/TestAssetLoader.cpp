@@ -0,0 +1,200 @@
+﻿
+# include "Test.hpp"
+
+# if defined(SIV3D_DO_TEST)
+
+# define SIV3D_CONCURRENT
+# include <Siv3D.hpp>
+# include <ThirdParty/Catch2/catch.hpp>
+# include <Asset/AssetLoader.hpp>
+
+namespace TestAssetLoader
+{
+	// 唯一のワーカーを、release() が呼ばれるまで占有するジョブ
+	class Blocker
+	{
+	private:
+
+		std::promise<void> m_started;
+
+		std::promise<void> m_release;
+
+		std::shared_future<void> m_releaseFuture = m_release.get_future().share();
+
+	public:
+
+		std::shared_ptr<AssetLoadingJob> submit(AssetLoader& loader)
+		{
+			auto started = m_started.get_future();
+
+			auto job = loader.submit([future = m_releaseFuture, this]()
+			{
+				m_started.set_value();
+				future.wait();
+				return true;
+			}, 0);
+
+			started.wait();
+
+			return job;
+		}
+
+		void release()
+		{
+			m_release.set_value();
+		}
+	};
+
+	// 実行された順にジョブの名前を記録する
+	class Recorder
+	{
+	private:
+
+		std::mutex m_mutex;
+
+		Array<String> m_order;
+
+	public:
+
+		std::function<bool()> job(const String& name)
+		{
+			return [this, name]()
+			{
+				std::lock_guard lock(m_mutex);
+
+				m_order << name;
+
+				return true;
+			};
+		}
+
+		Array<String> order()
+		{
+			std::lock_guard lock(m_mutex);
+
+			return m_order;
+		}
+	};
+}
+
+TEST_CASE("AssetLoader")
+{
+	using Status = AssetLoadingJob::Status;
+
+	AssetLoader loader(1);
+	TestAssetLoader::Blocker blocker;
+	TestAssetLoader::Recorder recorder;
+
+	const auto blockingJob = blocker.submit(loader);
+
+	REQUIRE(blockingJob->getStatus() == Status::Running);
+
+	SECTION("Priority")
+	{
+		const auto a = loader.submit(recorder.job(U"a"), 0);
+		const auto b = loader.submit(recorder.job(U"b"), 5);
+		const auto c = loader.submit(recorder.job(U"c"), 1);
+		const auto d = loader.submit(recorder.job(U"d"), 0);
+
+		REQUIRE(loader.getQueueDepth() == 4);
+
+		// 最初に要求されたアセットは、優先度を上げてキューの先頭に移る
+		loader.prioritize(d, 10);
+
+		// 優先度を下げる要求は無視される
+		loader.prioritize(b, -10);
+
+		REQUIRE(loader.getQueueDepth() == 4);
+
+		blocker.release();
+
+		for (const auto& job : { a, b, c, d })
+		{
+			REQUIRE(loader.wait(job));
+			REQUIRE(job->getStatus() == Status::Done);
+		}
+
+		REQUIRE(recorder.order() == Array<String>{ U"d", U"b", U"c", U"a" });
+		REQUIRE(loader.getQueueDepth() == 0);
+		REQUIRE(a->getLoadingTime().queueTime >= b->getLoadingTime().queueTime);
+	}
+
+	SECTION("Cancel")
+	{
+		const auto a = loader.submit(recorder.job(U"a"), 0);
+		const auto b = loader.submit(recorder.job(U"b"), 0);
+
+		REQUIRE(loader.cancel(a));
+		REQUIRE(a->getStatus() == Status::Canceled);
+		REQUIRE(a->isFinished());
+		REQUIRE(loader.getQueueDepth() == 1);
+
+		// 実行中・取り消し済みのジョブは取り消せない
+		REQUIRE_FALSE(loader.cancel(blockingJob));
+		REQUIRE_FALSE(loader.cancel(a));
+
+		// 取り消したジョブの優先度を上げても実行されない
+		loader.prioritize(a, 10);
+
+		blocker.release();
+
+		REQUIRE(loader.wait(b));
+		REQUIRE_FALSE(loader.wait(a));
+		REQUIRE(recorder.order() == Array<String>{ U"b" });
+	}
+
+	SECTION("Cancel all")
+	{
+		const auto a = loader.submit(recorder.job(U"a"), 0);
+		const auto b = loader.submit(recorder.job(U"b"), 3);
+
+		loader.cancelAll();
+
+		REQUIRE(a->getStatus() == Status::Canceled);
+		REQUIRE(b->getStatus() == Status::Canceled);
+		REQUIRE(blockingJob->getStatus() == Status::Running);
+		REQUIRE(loader.getQueueDepth() == 0);
+
+		blocker.release();
+
+		REQUIRE(loader.wait(blockingJob));
+		REQUIRE(recorder.order().isEmpty());
+	}
+
+	SECTION("Wait runs a queued job inline")
+	{
+		std::thread::id executedOn;
+
+		const auto job = loader.submit([&]()
+		{
+			executedOn = std::this_thread::get_id();
+			return true;
+		}, 0);
+
+		// 唯一のワーカーが占有されていても、wait() は呼び出し元のスレッドで実行して返る
+		REQUIRE(loader.wait(job));
+		REQUIRE(executedOn == std::this_thread::get_id());
+		REQUIRE(job->getStatus() == Status::Done);
+		REQUIRE(blockingJob->getStatus() == Status::Running);
+		REQUIRE(loader.getQueueDepth() == 0);
+
+		blocker.release();
+
+		REQUIRE(loader.wait(blockingJob));
+	}
+}
+
+TEST_CASE("AssetLoader.PublicAPI")
+{
+	REQUIRE(Profiler::AssetLoadingQueueDepth() == 0);
+
+	REQUIRE(TextureAsset::Register(U"TestAssetLoader", Emoji(U"🐈")));
+
+	// 非同期ロードされていないアセットにはロード時間がない
+	REQUIRE_FALSE(TextureAsset::GetLoadingTime(U"TestAssetLoader").has_value());
+	REQUIRE_FALSE(TextureAsset::GetLoadingTime(U"TestAssetLoader.Unregistered").has_value());
+
+	TextureAsset::Unregister(U"TestAssetLoader");
+}
+
+# endif
@@ -0,0 +1,79 @@
+﻿
+# include "Test.hpp"
+
+# if defined(SIV3D_DO_TEST)
+
+# define SIV3D_CONCURRENT
+# include <Siv3D.hpp>
+# include <ThirdParty/Catch2/catch.hpp>
+
+namespace TestAudio
+{
+	// sec 秒の正弦波を Ogg Vorbis で一時フォルダに保存する
+	static FilePath MakeOggVorbisFile(const double sec)
+	{
+		Wave wave(SecondsF(sec), Arg::generator = [](const double t)
+		{
+			return 0.5 * std::sin(t * Math::TwoPi * 440.0);
+		});
+
+		const FilePath path = FileSystem::UniqueFilePath() + U".ogg";
+
+		REQUIRE(wave.saveOggVorbis(path));
+
+		return path;
+	}
+}
+
+TEST_CASE("Audio.Streaming")
+{
+	const FilePath path = TestAudio::MakeOggVorbisFile(10.0);
+
+	{
+		const Audio audio(path);
+		Audio streamed(Audio::Stream, path);
+
+		REQUIRE(audio);
+		REQUIRE(streamed);
+		REQUIRE(!audio.isStreaming());
+		REQUIRE(streamed.samplingRate() == audio.samplingRate());
+		REQUIRE(streamed.samples() == audio.samples());
+		REQUIRE(streamed.residentBytes() <= audio.residentBytes());
+
+		// ストリーミング再生に対応していないプラットフォームでは、すべてデコードしたオーディオになる
+		if (streamed.isStreaming())
+		{
+			REQUIRE(streamed.getWave().isEmpty());
+			REQUIRE(streamed.residentBytes() < (audio.residentBytes() / 4));
+
+			streamed.setLoop(true);
+			streamed.setPosSample(streamed.samples() / 2);
+
+			REQUIRE(streamed.isLoop());
+			REQUIRE(streamed.posSample() == static_cast<int64>(streamed.samples() / 2));
+		}
+	}
+
+	FileSystem::Remove(path);
+}
+
+TEST_CASE("Audio.Streaming.Benchmark", "[.benchmark]")
+{
+	const FilePath path = TestAudio::MakeOggVorbisFile(180.0);
+
+	for (const bool streaming : { false, true })
+	{
+		const MillisecClock clock;
+
+		const Audio audio = streaming ? Audio(Audio::Stream, path) : Audio(path);
+
+		const uint64 loadMillisec = clock.ms();
+
+		Console << U"{}: load {} ms, resident {} KiB ({:.1f} s)"_fmt(
+			(audio.isStreaming() ? U"streaming" : U"decoded"), loadMillisec, audio.residentBytes() / 1024, audio.lengthSec());
+	}
+
+	FileSystem::Remove(path);
+}
+
+# endif
@@ -0,0 +1,288 @@
+﻿
+# include "Test.hpp"
+
+# if defined(SIV3D_DO_TEST)
+
+# define SIV3D_CONCURRENT
+# include <Siv3D.hpp>
+# include <ThirdParty/Catch2/catch.hpp>
+# include <Audio/Mixer/AudioMixer.hpp>
+# include <Audio/Mixer/AudioOutput_Null.hpp>
+
+namespace TestAudioMixer
+{
+	// i 番目のサンプルが (i, -i) のソース
+	static std::shared_ptr<IMixerSource> MakeRampSource(const size_t size, const uint32 samplingRate = Wave::DefaultSamplingRate)
+	{
+		Array<WaveSample> samples(size);
+
+		for (size_t i = 0; i < size; ++i)
+		{
+			samples[i].set(static_cast<float>(i), -static_cast<float>(i));
+		}
+
+		return std::make_shared<WaveMixerSource>(Wave(std::move(samples), Arg::samplingRate = samplingRate));
+	}
+
+	static std::shared_ptr<IMixerSource> MakeConstantSource(const size_t size, const WaveSample& sample)
+	{
+		return std::make_shared<WaveMixerSource>(Wave(size, sample, Arg::samplingRate = Wave::DefaultSamplingRate));
+	}
+
+	static Array<float> Mix(AudioMixer& mixer, const size_t frames)
+	{
+		Array<float> output(frames * 2, 1.0f);
+
+		mixer.mix(output.data(), frames);
+
+		return output;
+	}
+}
+
+TEST_CASE("AudioMixer.Mix")
+{
+	using namespace TestAudioMixer;
+
+	SECTION("Same sampling rate")
+	{
+		AudioMixer mixer;
+		const auto a = mixer.createVoice(MakeRampSource(1000));
+		const auto b = mixer.createVoice(MakeConstantSource(1000, WaveSample(1.0f, -1.0f)));
+		const auto paused = mixer.createVoice(MakeConstantSource(1000, WaveSample(100.0f)));
+
+		mixer.setVolume(a, 0.5, 0.25);
+		mixer.play(a);
+		mixer.play(b);
+		mixer.play(paused);
+		mixer.pause(paused);
+
+		// BlockFrames を超えて、SSE で処理しきれない端数も含む
+		const Array<float> output = Mix(mixer, 603);
+
+		for (size_t i = 0; i < 603; ++i)
+		{
+			REQUIRE(output[i * 2] == (i * 0.5f + 1.0f));
+			REQUIRE(output[i * 2 + 1] == (i * -0.25f - 1.0f));
+		}
+
+		REQUIRE(mixer.posSample(a) == 603);
+		REQUIRE(mixer.samplesPlayed(a) == 603);
+		REQUIRE(mixer.posSample(paused) == 0);
+		REQUIRE(mixer.isPaused(paused));
+	}
+
+	SECTION("End of source")
+	{
+		AudioMixer mixer;
+		const auto voice = mixer.createVoice(MakeRampSource(100));
+		mixer.play(voice);
+
+		const Array<float> output = Mix(mixer, 256);
+
+		for (size_t i = 0; i < 256; ++i)
+		{
+			REQUIRE(output[i * 2] == ((i < 100) ? static_cast<float>(i) : 0.0f));
+		}
+
+		// ワンショットでないボイスは、止まって先頭に戻るだけで残る
+		REQUIRE(!mixer.isPlaying(voice));
+		REQUIRE(mixer.hasVoice(voice));
+		REQUIRE(mixer.posSample(voice) == 0);
+		REQUIRE(mixer.samplesPlayed(voice) == 100);
+	}
+
+	SECTION("Resampling")
+	{
+		// 22050 Hz のソースを 44100 Hz で合成すると、1 フレームに 0.5 サンプル進む
+		AudioMixer mixer;
+		const auto voice = mixer.createVoice(MakeRampSource(1000, 22050));
+		mixer.play(voice);
+
+		// 補間の途中の位置が、ブロックをまたいで引き継がれる
+		Array<float> output;
+
+		for (const size_t frames : { 37, 200, 1 })
+		{
+			output.append(Mix(mixer, frames));
+		}
+
+		for (size_t i = 0; i < 238; ++i)
+		{
+			REQUIRE(output[i * 2] == Approx(i * 0.5));
+			REQUIRE(output[i * 2 + 1] == Approx(i * -0.5));
+		}
+
+		REQUIRE(mixer.posSample(voice) == 119);
+
+		// 同じサンプリングレートでも、速度を変えると補間で読み出す
+		const auto fast = mixer.createVoice(MakeRampSource(1000));
+		mixer.setSpeed(fast, 1.5);
+		mixer.stop(voice);
+		mixer.play(fast);
+
+		output = Mix(mixer, 300);
+
+		for (size_t i = 0; i < 300; ++i)
+		{
+			REQUIRE(output[i * 2] == Approx(i * 1.5));
+		}
+
+		REQUIRE(mixer.posSample(fast) == 450);
+	}
+
+	SECTION("Loop")
+	{
+		AudioMixer mixer;
+		const auto voice = mixer.createVoice(MakeRampSource(100));
+		mixer.setLoop(voice, AudioLoopTiming(20, 60));
+		mixer.play(voice);
+
+		// 0 ～ 59 のあと、20 ～ 59 を繰り返す
+		const Array<float> output = Mix(mixer, 1000);
+
+		for (size_t i = 0; i < 1000; ++i)
+		{
+			const size_t expected = (i < 60) ? i : (20 + (i - 60) % 40);
+
+			REQUIRE(output[i * 2] == static_cast<float>(expected));
+		}
+
+		REQUIRE(mixer.isPlaying(voice));
+		REQUIRE(mixer.posSample(voice) == (20 + (1000 - 60) % 40));
+		REQUIRE(mixer.samplesPlayed(voice) == 1000);
+
+		// 補間しながらループしても、ループ区間の外を読まない
+		mixer.setSpeed(voice, 1.7);
+
+		for (const float sample : Mix(mixer, 1000))
+		{
+			REQUIRE(InRange(std::abs(sample), 20.0f, 59.0f));
+		}
+
+		REQUIRE(mixer.isPlaying(voice));
+	}
+
+	SECTION("One-shot")
+	{
+		AudioMixer mixer;
+		const auto voice = mixer.playOneShot(MakeRampSource(100), 0.5, 1.0);
+
+		REQUIRE(mixer.hasVoice(voice));
+		REQUIRE(mixer.isPlaying(voice));
+
+		Array<float> output = Mix(mixer, 64);
+
+		REQUIRE(mixer.hasVoice(voice));
+		REQUIRE(output[63 * 2] == (63 * 0.5f));
+
+		// 最後まで再生したブロックで削除される
+		output = Mix(mixer, 64);
+
+		for (size_t i = 0; i < 64; ++i)
+		{
+			REQUIRE(output[i * 2] == ((i < 36) ? ((64 + i) * 0.5f) : 0.0f));
+		}
+
+		REQUIRE(!mixer.hasVoice(voice));
+		REQUIRE(mixer.getStats().num_voices == 0);
+		REQUIRE(mixer.getStats().mixedFrames == 128);
+	}
+}
+
+TEST_CASE("AudioMixer.ConvertToS16")
+{
+	const Array<float> values = { -2.0f, -1.0f, -0.5f, -0.25f, 0.0f, 0.25f, 0.5f, 1.0f, 2.0f, 1e9f, -1e9f,
+		std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(), 0.999f, -0.999f, (1.0f / 32767.0f), (-1.0f / 32767.0f) };
+
+	// SSE で 8 個ずつ変換する部分と、端数を 1 個ずつ変換する部分の両方を通す
+	for (const size_t offset : { 0, 3, 7 })
+	{
+		Array<float> src(offset, 0.0f);
+		src.append(values);
+
+		Array<int16> dst(src.size());
+		AudioMixer::ConvertToS16(src.data(), dst.data(), src.size());
+
+		for (size_t i = 0; i < src.size(); ++i)
+		{
+			const int16 expected = static_cast<int16>(Clamp(src[i], -1.0f, 1.0f) * 32767.0f);
+
+			REQUIRE(dst[i] == expected);
+		}
+
+		REQUIRE(dst[offset + 0] == -32767);
+		REQUIRE(dst[offset + 1] == -32767);
+		REQUIRE(dst[offset + 7] == 32767);
+		REQUIRE(dst[offset + 8] == 32767);
+		REQUIRE(dst[offset + 9] == 32767);
+		REQUIRE(dst[offset + 10] == -32767);
+		REQUIRE(dst[offset + 11] == 32767);
+		REQUIRE(dst[offset + 12] == -32767);
+	}
+}
+
+TEST_CASE("AudioMixer.Benchmark", "[.benchmark]")
+{
+	using namespace TestAudioMixer;
+
+	const Wave wave(SecondsF(10.0), Arg::generator = [](const double t)
+	{
+		return 0.5 * std::sin(t * Math::TwoPi * 440.0);
+	});
+
+	const auto source = std::make_shared<WaveMixerSource>(Wave(wave));
+
+	// 合成スレッドを使わずに、10 秒分を合成する時間
+	for (const size_t voices : { 1, 16, 64 })
+	{
+		AudioMixer mixer;
+
+		for (size_t i = 0; i < voices; ++i)
+		{
+			const auto voice = mixer.createVoice(source);
+
+			// 半分のボイスは補間が必要な速度で再生する
+			mixer.setSpeed(voice, IsEven(i) ? 1.0 : 0.9);
+			mixer.play(voice);
+		}
+
+		Array<float> output(AudioMixer::BlockFrames * 2);
+		const size_t blocks = (wave.size() / AudioMixer::BlockFrames);
+
+		const MicrosecClock clock;
+
+		for (size_t i = 0; i < blocks; ++i)
+		{
+			mixer.mix(output.data(), AudioMixer::BlockFrames);
+		}
+
+		const double sec = (clock.us() / 1e6);
+		const double audioSec = (static_cast<double>(blocks * AudioMixer::BlockFrames) / mixer.samplingRate());
+
+		Console << U"{} voices: {:.1f}x real time, {:.3f} ms per block"_fmt(
+			voices, audioSec / sec, mixer.getStats().averageMixMillisec);
+	}
+
+	// オーディオデバイスの代わりに AudioOutput_Null で実時間で 1 秒再生する
+	{
+		AudioMixer mixer;
+
+		for (size_t i = 0; i < 64; ++i)
+		{
+			mixer.play(mixer.createVoice(source));
+		}
+
+		mixer.start(std::make_unique<AudioOutput_Null>(Wave::DefaultSamplingRate, AudioMixer::BlockFrames * 4));
+
+		System::Sleep(SecondsF(1.0));
+
+		const AudioMixerStats stats = mixer.getStats();
+
+		mixer.stop();
+
+		Console << U"64 voices (null output): {} blocks, mix {:.3f} ms (max {:.3f} ms), latency {:.1f} ms, {} underruns"_fmt(
+			stats.num_blocks, stats.averageMixMillisec, stats.maxMixMillisec, stats.latencyMillisec, stats.num_underruns);
+	}
+}
+
+# endif
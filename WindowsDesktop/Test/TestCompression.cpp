@@ -0,0 +1,105 @@
+﻿
+# include "Test.hpp"
+
+# if defined(SIV3D_DO_TEST)
+
+# define SIV3D_CONCURRENT
+# include <Siv3D.hpp>
+# include <ThirdParty/Catch2/catch.hpp>
+
+namespace TestCompression
+{
+	static ByteArray MakeTestData(const size_t size)
+	{
+		Reseed(12345);
+
+		Array<Byte> data(size);
+
+		for (size_t i = 0; i < size; ++i)
+		{
+			data[i] = static_cast<Byte>(((i / 7) % 251) ^ (RandomBool(0.25) ? Random<uint8>(255) : 0));
+		}
+
+		return ByteArray(std::move(data));
+	}
+
+	static bool Equal(const ByteArray& a, const ByteArray& b)
+	{
+		return (a.size() == b.size())
+			&& (std::memcmp(a.data(), b.data(), static_cast<size_t>(a.size())) == 0);
+	}
+}
+
+TEST_CASE("Compression")
+{
+	const ByteArray data = TestCompression::MakeTestData(3'000'000);
+
+	const ByteArrayViewAdapter view(data.data(), static_cast<size_t>(data.size()));
+
+	for (const size_t numWorkers : { 0, 2 })
+	{
+		const ByteArray compressed = Compression::Compress(view, 3, numWorkers);
+
+		REQUIRE(compressed.size() < data.size());
+		REQUIRE(TestCompression::Equal(Compression::Decompress(compressed.view()), data));
+
+		// ストリームで圧縮したものは、どちらの方法でも展開できる
+		ReaderView reader(data.data(), static_cast<size_t>(data.size()));
+		MemoryWriter writer;
+		REQUIRE(Compression::CompressStream(reader, writer, 3, numWorkers));
+
+		const ByteArray streamed = writer.retrieve();
+		REQUIRE(TestCompression::Equal(Compression::Decompress(streamed.view()), data));
+
+		ReaderView compressedReader(streamed.data(), static_cast<size_t>(streamed.size()));
+		MemoryWriter decompressedWriter;
+		REQUIRE(Compression::DecompressStream(compressedReader, decompressedWriter));
+		REQUIRE(TestCompression::Equal(decompressedWriter.retrieve(), data));
+	}
+
+	REQUIRE(Compression::Decompress(ByteArrayView(view.data(), view.size())).size() == 0);
+}
+
+TEST_CASE("Compression.Dictionary")
+{
+	Reseed(12345);
+
+	Array<std::string> samples;
+
+	for (size_t i = 0; i < 2000; ++i)
+	{
+		samples << U"{{\"name\":\"player{}\",\"score\":{},\"level\":{},\"guild\":\"alpha\"}}"_fmt(
+			Random(999), Random(99999), Random(49)).narrow();
+	}
+
+	const Array<ByteArrayView> views = samples.map([](const std::string& s) { return ByteArrayView(s.data(), s.size()); });
+
+	const CompressionDictionary dictionary = CompressionDictionary::Train(views, 4096);
+
+	REQUIRE(dictionary);
+	REQUIRE(dictionary.view().size() <= 4096);
+
+	// 同じコンテキストを使い回して、小さなデータを続けて圧縮・展開する
+	Compressor compressor(dictionary);
+	Decompressor decompressor(dictionary);
+	Compressor plainCompressor;
+
+	size_t dictionaryTotal = 0, plainTotal = 0;
+
+	for (const auto& sample : views)
+	{
+		const ByteArrayViewAdapter input(sample.data(), sample.size());
+
+		const ByteArray compressed = compressor.compress(input);
+		dictionaryTotal += static_cast<size_t>(compressed.size());
+		plainTotal += static_cast<size_t>(plainCompressor.compress(input).size());
+
+		const ByteArray decompressed = decompressor.decompress(compressed.view());
+		REQUIRE(decompressed.size() == static_cast<int64>(sample.size()));
+		REQUIRE(std::memcmp(decompressed.data(), sample.data(), sample.size()) == 0);
+	}
+
+	REQUIRE(dictionaryTotal < plainTotal);
+}
+
+# endif
@@ -0,0 +1,165 @@
+﻿
+# include "Test.hpp"
+
+# if defined(SIV3D_DO_TEST)
+
+# define SIV3D_CONCURRENT
+# include <Siv3D.hpp>
+# include <ThirdParty/Catch2/catch.hpp>
+
+namespace TestFFT
+{
+	// 440 Hz の正弦波に高い周波数の成分を重ねたモノラルの波形
+	static Array<float> MakeSignal(const size_t length, const uint32 samplingRate)
+	{
+		return Array<float>::IndexedGenerate(length, [=](const size_t i)
+		{
+			return static_cast<float>(0.5 * std::sin(i * Math::TwoPi * 440.0 / samplingRate) + 0.1 * std::sin(i * 0.37));
+		});
+	}
+}
+
+TEST_CASE("FFT.STFT")
+{
+	constexpr uint32 SamplingRate = 44100;
+	const Array<float> signal = TestFFT::MakeSignal(SamplingRate * 3, SamplingRate);
+
+	SECTION("Frames")
+	{
+		STFTDesc desc;
+		desc.sampleLength = FFTSampleLength::SL2K;
+		desc.hopSize = 1000;
+		desc.window = FFTWindow::Rectangular;
+
+		Spectrogram spectrogram;
+		FFT::STFT(spectrogram, signal.data(), signal.size(), SamplingRate, desc);
+
+		REQUIRE(spectrogram.num_frames() == FFT::STFTFrameCount(signal.size(), desc.hopSize));
+		REQUIRE(spectrogram.num_frames() == 133);
+		REQUIRE(spectrogram.num_bins() == 1024);
+		REQUIRE(spectrogram.frameTimeSec(44) == Approx(1.0).epsilon(0.01));
+
+		// 矩形窓のフレームは、同じ区間を Analyze() した結果と一致する
+		for (const size_t frame : { size_t(0), size_t(50), (spectrogram.num_frames() - 1) })
+		{
+			Array<float> input(2048, 0.0f);
+			const size_t pos = (frame * desc.hopSize);
+			std::copy(signal.begin() + pos, signal.begin() + Min(pos + input.size(), signal.size()), input.begin());
+
+			FFTResult result;
+			FFT::Analyze(result, input.data(), static_cast<uint32>(input.size()), SamplingRate, FFTSampleLength::SL2K);
+
+			REQUIRE(std::equal(result.buffer.begin(), result.buffer.end(), spectrogram.magnitudes[frame]));
+		}
+	}
+
+	SECTION("Window and input types")
+	{
+		Spectrogram fromFloat, fromWave, fromCompact;
+		FFT::STFT(fromFloat, signal.data(), signal.size(), SamplingRate);
+
+		// 最も大きいビンは 440 Hz 付近
+		const float* frame = fromFloat.magnitudes[fromFloat.num_frames() / 2];
+		const size_t peak = (std::max_element(frame, frame + fromFloat.num_bins()) - frame);
+
+		REQUIRE(std::abs(peak * fromFloat.resolution - 440.0) <= fromFloat.resolution);
+
+		Wave wave(signal.size(), Arg::samplingRate = SamplingRate);
+
+		for (size_t i = 0; i < signal.size(); ++i)
+		{
+			wave[i].set(signal[i]);
+		}
+
+		FFT::STFT(fromWave, wave);
+		FFT::STFT(fromCompact, CompactWave(wave, WaveSampleFormat::F32));
+
+		REQUIRE(fromWave.magnitudes == fromFloat.magnitudes);
+		REQUIRE(fromCompact.magnitudes == fromFloat.magnitudes);
+	}
+
+	SECTION("Concurrent calls")
+	{
+		FFTResult expected;
+		FFT::Analyze(expected, signal.data(), 8192, SamplingRate, FFTSampleLength::SL8K);
+
+		Spectrogram expectedSpectrogram;
+		FFT::STFT(expectedSpectrogram, signal.data(), signal.size(), SamplingRate);
+
+		Array<std::future<bool>> tasks;
+
+		for (size_t i = 0; i < 4; ++i)
+		{
+			tasks << std::async(std::launch::async, [&]()
+			{
+				bool ok = true;
+
+				for (size_t k = 0; k < 20; ++k)
+				{
+					FFTResult result;
+					FFT::Analyze(result, signal.data(), 8192, SamplingRate, FFTSampleLength::SL8K);
+
+					Spectrogram spectrogram;
+					FFT::STFT(spectrogram, signal.data(), signal.size(), SamplingRate);
+
+					ok &= (result.buffer == expected.buffer);
+					ok &= (spectrogram.magnitudes == expectedSpectrogram.magnitudes);
+				}
+
+				return ok;
+			});
+		}
+
+		for (auto& task : tasks)
+		{
+			REQUIRE(task.get());
+		}
+	}
+}
+
+TEST_CASE("FFT.STFT.Benchmark", "[.benchmark]")
+{
+	// 3 分の曲
+	constexpr uint32 SamplingRate = 44100;
+	const Array<float> signal = TestFFT::MakeSignal(SamplingRate * 180, SamplingRate);
+
+	for (const auto sampleLength : { FFTSampleLength::SL1K, FFTSampleLength::SL2K, FFTSampleLength::SL4K })
+	{
+		const uint32 samples = (256u << static_cast<int32>(sampleLength));
+
+		STFTDesc desc;
+		desc.sampleLength = sampleLength;
+		desc.hopSize = (samples / 4);
+
+		// 1 回目で結果のメモリを確保する
+		Spectrogram spectrogram;
+		FFT::STFT(spectrogram, signal.data(), signal.size(), SamplingRate, desc);
+
+		const MicrosecClock stftClock;
+		FFT::STFT(spectrogram, signal.data(), signal.size(), SamplingRate, desc);
+		const double stftSec = (stftClock.us() / 1e6);
+
+		// 1 フレームずつ Analyze() する場合
+		Array<float> input(samples);
+		FFTResult result;
+		const MicrosecClock analyzeClock;
+
+		for (size_t frame = 0; frame < spectrogram.num_frames(); ++frame)
+		{
+			const size_t pos = (frame * desc.hopSize);
+			const size_t count = Min<size_t>(samples, signal.size() - pos);
+
+			std::fill(std::copy(signal.begin() + pos, signal.begin() + pos + count, input.begin()), input.end(), 0.0f);
+
+			FFT::Analyze(result, input.data(), samples, SamplingRate, sampleLength);
+		}
+
+		const double analyzeSec = (analyzeClock.us() / 1e6);
+
+		Console << U"{} samples, hop {}: {} frames, STFT {:.0f} frames/s, Analyze {:.0f} frames/s ({} threads)"_fmt(
+			samples, desc.hopSize, spectrogram.num_frames(),
+			spectrogram.num_frames() / stftSec, spectrogram.num_frames() / analyzeSec, Threading::GetConcurrency());
+	}
+}
+
+# endif
@@ -0,0 +1,179 @@
+﻿
+# include "Test.hpp"
+
+# if defined(SIV3D_DO_TEST)
+
+# define SIV3D_CONCURRENT
+# include <Siv3D.hpp>
+# include <ThirdParty/Catch2/catch.hpp>
+
+namespace TestFont
+{
+	// CJK 統合漢字から count 文字
+	static String MakeText(const size_t count, const size_t offset = 0)
+	{
+		String text;
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			text.push_back(static_cast<char32>(0x4E00 + offset + i));
+		}
+
+		return text;
+	}
+}
+
+TEST_CASE("Font.Atlas")
+{
+	const Font font(24, Typeface::Default, FontStyle::Default, FontAtlasDesc{ 256, 2 });
+
+	SECTION("Pages and stats")
+	{
+		const String text = TestFont::MakeText(40);
+
+		REQUIRE(font(text).region().w > 0);
+
+		// 描画でテクスチャへの転送まで行う
+		font(text).draw();
+
+		const FontAtlasStats stats = font.getAtlasStats();
+
+		REQUIRE(stats.num_pages == 1);
+		REQUIRE(stats.num_glyphs == text.size());
+		REQUIRE(0.0 < stats.occupancy);
+		REQUIRE(stats.occupancy <= 1.0);
+		REQUIRE(stats.num_evictions == 0);
+		REQUIRE(stats.num_uploads > 0);
+
+		// 転送後も CPU 側に残るのは 1 ピクセル 1 バイトのページだけ
+		REQUIRE(stats.imageBytes == (256 * 256));
+
+		// ページを使わない従来のアトラス（RGBA 画像）よりも少ない
+		const Font legacy(24);
+
+		REQUIRE(legacy(text).region().w > 0);
+		REQUIRE(stats.imageBytes < legacy.getAtlasStats().imageBytes);
+	}
+
+	SECTION("Page eviction")
+	{
+		// 1 ページに収まらない数のグリフを、フレームをまたいで描く
+		for (size_t i = 0; i < 8; ++i)
+		{
+			REQUIRE(font(TestFont::MakeText(100, i * 100)).region().w > 0);
+
+			REQUIRE(System::Update());
+		}
+
+		const FontAtlasStats stats = font.getAtlasStats();
+
+		REQUIRE(stats.num_pages == 2);
+		REQUIRE(stats.num_evictions > 0);
+
+		// 追い出されたグリフも描き直せる
+		const String text = TestFont::MakeText(20);
+
+		REQUIRE(font(text).region() == Font(24)(text).region());
+	}
+}
+
+TEST_CASE("Font.LayoutCache")
+{
+	const Font font(20);
+	const String text = U"Siv3D\tFont\nLayout cache";
+
+	// 1 回目で配置を作り、2 回目以降はキャッシュを使う
+	const RectF region = font(text).region();
+	const RectF drawn0 = font(text).draw(10, 20);
+	const RectF drawn1 = font(text).draw(10, 20);
+	const RectF drawn2 = font(text).draw(-30, 40);
+
+	REQUIRE(font(text).region() == region);
+	REQUIRE(drawn0 == drawn1);
+	REQUIRE(drawn2.size == drawn0.size);
+	REQUIRE(drawn2.pos == Vec2(-30, 40));
+	REQUIRE(font(U"").draw(5, 5) == RectF(5, 5, 0, 0));
+	REQUIRE(font(U"\t").region().h == 0.0);
+	REQUIRE(font(U"\t").region().w > 0.0);
+}
+
+TEST_CASE("Font.LayoutCache.Benchmark", "[.benchmark]")
+{
+	constexpr size_t NumLabels = 5000;
+	constexpr size_t NumFrames = 10;
+
+	const Font font(16);
+
+	const Array<String> staticLabels = Array<String>::IndexedGenerate(NumLabels, [](const size_t i)
+	{
+		return U"Label {}"_fmt(i);
+	});
+
+	// 毎フレーム内容が変わるラベル（キャッシュが効かない）
+	const Array<String> dynamicLabels = Array<String>::IndexedGenerate(NumLabels * NumFrames, [](const size_t i)
+	{
+		return U"Label {}"_fmt(NumLabels + i);
+	});
+
+	for (const bool isStatic : { false, true })
+	{
+		double totalMillisec = 0.0;
+
+		for (size_t frame = 0; frame < NumFrames; ++frame)
+		{
+			const MicrosecClock clock;
+
+			for (size_t i = 0; i < NumLabels; ++i)
+			{
+				const String& label = isStatic ? staticLabels[i] : dynamicLabels[frame * NumLabels + i];
+
+				font(label).draw((i % 50) * 24, (i / 50) * 8);
+			}
+
+			// 1 フレーム目はグリフとキャッシュの作成を含むので除く
+			if (frame != 0)
+			{
+				totalMillisec += (clock.us() / 1000.0);
+			}
+
+			if (!System::Update())
+			{
+				return;
+			}
+		}
+
+		Console << U"{} labels ({}): {:.2f} ms/frame"_fmt(NumLabels, isStatic ? U"static" : U"dynamic", totalMillisec / (NumFrames - 1));
+	}
+}
+
+TEST_CASE("Font.Atlas.Benchmark", "[.benchmark]")
+{
+	const Array<String> texts = Array<String>::IndexedGenerate(60, [](const size_t i)
+	{
+		return TestFont::MakeText(50, i * 50);
+	});
+
+	const Array<std::pair<String, Font>> fonts =
+	{
+		{ U"legacy", Font(24) },
+		{ U"paged", Font(24, Typeface::Default, FontStyle::Default, FontAtlasDesc{ 1024, 4 }) },
+	};
+
+	for (const auto& [name, font] : fonts)
+	{
+		const MillisecClock clock;
+
+		for (const auto& text : texts)
+		{
+			font(text).draw();
+		}
+
+		const FontAtlasStats stats = font.getAtlasStats();
+
+		Console << U"{}: {} ms, {} pages, {} glyphs, occupancy {:.2f}, image {} KiB, uploaded {} KiB ({} uploads)"_fmt(
+			name, clock.ms(), stats.num_pages, stats.num_glyphs,
+			stats.occupancy, stats.imageBytes / 1024, stats.uploadedBytes / 1024, stats.num_uploads);
+	}
+}
+
+# endif
@@ -0,0 +1,130 @@
+﻿
+# include "Test.hpp"
+
+# if defined(SIV3D_DO_TEST)
+
+# define SIV3D_CONCURRENT
+# include <Siv3D.hpp>
+# include <ThirdParty/Catch2/catch.hpp>
+
+namespace TestImage
+{
+	static Image MakeTestImage(const size_t width, const size_t height)
+	{
+		return Image(width, height, Arg::generator = [](const Point& p)
+		{
+			return Color(p.x * 7 + p.y * 13, (p.x * 31) ^ p.y, p.x * p.y, p.x + p.y);
+		});
+	}
+
+	template <class Fty>
+	static bool AllPixels(const Image& src, const Image& dst, Fty f)
+	{
+		if (src.size() != dst.size())
+		{
+			return false;
+		}
+
+		for (size_t i = 0; i < src.num_pixels(); ++i)
+		{
+			if (!f(src.data()[i], dst.data()[i]))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	static bool Equal(const Image& a, const Image& b)
+	{
+		return AllPixels(a, b, [](Color x, Color y) { return x == y; });
+	}
+}
+
+TEST_CASE("Image.PointOperation")
+{
+	// 端数のある小さな画像と、複数のスレッドで処理される大きな画像
+	for (const auto& size : { Size(37, 5), Size(1021, 769) })
+	{
+		const Image src = TestImage::MakeTestImage(size.x, size.y);
+
+		REQUIRE(TestImage::AllPixels(src, src.negated(), [](Color a, Color b) { return b == ~a; }));
+
+		REQUIRE(TestImage::AllPixels(src, Image(src).swapRB(), [](Color a, Color b) { return b == Color(a.b, a.g, a.r, a.a); }));
+
+		REQUIRE(TestImage::AllPixels(src, src.grayscaled(), [](Color a, Color b)
+		{
+			return (b.r == b.g) && (b.g == b.b) && (b.a == a.a) && (std::abs(b.r - a.grayscale0_255()) <= 1);
+		}));
+
+		for (const int32 level : { -300, -40, 0, 25, 300 })
+		{
+			REQUIRE(TestImage::AllPixels(src, src.brightened(level), [=](Color a, Color b)
+			{
+				return b == Color(Clamp(a.r + level, 0, 255), Clamp(a.g + level, 0, 255), Clamp(a.b + level, 0, 255), a.a);
+			}));
+		}
+
+		for (const uint8 threshold : { 0, 100, 255 })
+		{
+			REQUIRE(TestImage::AllPixels(src, src.thresholded(threshold), [=](Color a, Color b)
+			{
+				const uint8 v = ((threshold * 1000) < (299 * a.r + 587 * a.g + 114 * a.b)) ? 255 : 0;
+				return b == Color(v, v, v, a.a);
+			}));
+		}
+
+		REQUIRE(TestImage::Equal(src.sepiaed(0), src.grayscaled()));
+
+		REQUIRE(TestImage::Equal(Image(src).negate(), src.negated()));
+		REQUIRE(TestImage::Equal(Image(src).grayscale(), src.grayscaled()));
+		REQUIRE(TestImage::Equal(Image(src).sepia(40), src.sepiaed(40)));
+		REQUIRE(TestImage::Equal(Image(src).posterize(4), src.posterized(4)));
+		REQUIRE(TestImage::Equal(Image(src).brighten(-10), src.brightened(-10)));
+		REQUIRE(TestImage::Equal(Image(src).gammaCorrect(2.2), src.gammaCorrected(2.2)));
+		REQUIRE(TestImage::Equal(Image(src).threshold(128, true), src.thresholded(128, true)));
+	}
+
+	REQUIRE(Image().negated().isEmpty());
+}
+
+TEST_CASE("Image.PointOperation.Benchmark", "[.benchmark]")
+{
+	const std::pair<String, std::function<void(Image&)>> operations[] =
+	{
+		{ U"negate", [](Image& image) { image.negate(); } },
+		{ U"grayscale", [](Image& image) { image.grayscale(); } },
+		{ U"sepia", [](Image& image) { image.sepia(); } },
+		{ U"posterize", [](Image& image) { image.posterize(4); } },
+		{ U"brighten", [](Image& image) { image.brighten(10); } },
+		{ U"gammaCorrect", [](Image& image) { image.gammaCorrect(2.2); } },
+		{ U"threshold", [](Image& image) { image.threshold(128); } },
+		{ U"swapRB", [](Image& image) { image.swapRB(); } },
+	};
+
+	for (const auto& size : { Size(256, 256), Size(1920, 1080), Size(3840, 2160) })
+	{
+		Image image = TestImage::MakeTestImage(size.x, size.y);
+
+		for (const auto& [name, operation] : operations)
+		{
+			constexpr size_t Iterations = 20;
+
+			operation(image);
+
+			const Stopwatch stopwatch(true);
+
+			for (size_t i = 0; i < Iterations; ++i)
+			{
+				operation(image);
+			}
+
+			const double megapixels = (image.num_pixels() * Iterations / 1'000'000.0);
+
+			Console << U"{} {}x{}: {:.1f} MP/s"_fmt(name, size.x, size.y, megapixels / stopwatch.sF());
+		}
+	}
+}
+
+# endif
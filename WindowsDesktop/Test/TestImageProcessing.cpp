@@ -0,0 +1,226 @@
+﻿
+# include "Test.hpp"
+
+# if defined(SIV3D_DO_TEST)
+
+# define SIV3D_CONCURRENT
+# include <Siv3D.hpp>
+# include <ThirdParty/Catch2/catch.hpp>
+
+namespace TestImageProcessing
+{
+	static Image MakeCircles(const size_t width, const size_t height, const size_t count, const int32 maxRadius)
+	{
+		Reseed(12345);
+
+		Image image(width, height, Color(0, 255));
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			const Circle circle(Random(0, static_cast<int32>(width) - 1), Random(0, static_cast<int32>(height) - 1), Random(1, maxRadius));
+
+			circle.paint(image, Color(255));
+		}
+
+		return image;
+	}
+
+	static bool IsBorder(const Image& image, const int32 x, const int32 y)
+	{
+		if (image[y][x].r != 255)
+		{
+			return false;
+		}
+
+		return ((0 < x) && (image[y][x - 1].r != 255))
+			|| ((x < image.width() - 1) && (image[y][x + 1].r != 255))
+			|| ((0 < y) && (image[y - 1][x].r != 255))
+			|| ((y < image.height() - 1) && (image[y + 1][x].r != 255));
+	}
+
+	// 8 近傍に境界を伝播させる、以前の GenerateSDF と同じ方法
+	static Image GenerateSDF_Sweep(const Image& image, const uint32 scale, const double spread)
+	{
+		const int32 width = image.width();
+		const int32 height = image.height();
+
+		Grid<Point> border(width, height, Point(-1, -1));
+		Grid<float> distance(width, height, Largest<float>);
+
+		for (int32 y = 0; y < height; ++y)
+		{
+			for (int32 x = 0; x < width; ++x)
+			{
+				if (IsBorder(image, x, y))
+				{
+					border[y][x].set(x, y);
+					distance[y][x] = 0.0f;
+				}
+			}
+		}
+
+		const auto propagate = [&](const int32 x, const int32 y, const int32 dx, const int32 dy)
+		{
+			const int32 ox = (x + dx), oy = (y + dy);
+
+			if ((ox < 0) || (width <= ox) || (oy < 0) || (height <= oy))
+			{
+				return;
+			}
+
+			const float step = ((dx != 0) && (dy != 0)) ? Math::Constants::Sqrt2_v<float> : 1.0f;
+
+			if ((distance[oy][ox] + step) < distance[y][x])
+			{
+				border[y][x] = border[oy][ox];
+				distance[y][x] = static_cast<float>(Point(x, y).distanceFrom(border[y][x]));
+			}
+		};
+
+		for (int32 y = 0; y < height; ++y)
+		{
+			for (int32 x = 0; x < width; ++x)
+			{
+				propagate(x, y, -1, -1);
+				propagate(x, y, 0, -1);
+				propagate(x, y, 1, -1);
+				propagate(x, y, -1, 0);
+			}
+		}
+
+		for (int32 y = (height - 1); y >= 0; --y)
+		{
+			for (int32 x = (width - 1); x >= 0; --x)
+			{
+				propagate(x, y, 1, 0);
+				propagate(x, y, -1, 1);
+				propagate(x, y, 0, 1);
+				propagate(x, y, 1, 1);
+			}
+		}
+
+		Image result(width / scale, height / scale, Color(255, 255));
+
+		const float div = 1.0f / (scale * scale * static_cast<float>(spread));
+
+		for (int32 y = 0; y < result.height(); ++y)
+		{
+			for (int32 x = 0; x < result.width(); ++x)
+			{
+				float sum = 0.0f;
+
+				for (uint32 dy = 0; dy < scale; ++dy)
+				{
+					for (uint32 dx = 0; dx < scale; ++dx)
+					{
+						const int32 sx = (x * scale + dx), sy = (y * scale + dy);
+						sum += (image[sy][sx].r == 255) ? distance[sy][sx] : -distance[sy][sx];
+					}
+				}
+
+				const float d = sum * div;
+
+				result[y][x].a = (d <= -1.0f) ? 0 : (1.0f <= d) ? 255 : static_cast<uint8>((d + 1.0f) * 127.5f + 0.5f);
+			}
+		}
+
+		return result;
+	}
+}
+
+TEST_CASE("ImageProcessing.GenerateSDF")
+{
+	// spread = 127.5, scale = 1 のとき、アルファ値は 128 ± (最も近い境界までの距離)
+	{
+		const Image image = TestImageProcessing::MakeCircles(97, 61, 8, 12);
+
+		Array<Point> borders;
+
+		for (int32 y = 0; y < image.height(); ++y)
+		{
+			for (int32 x = 0; x < image.width(); ++x)
+			{
+				if (TestImageProcessing::IsBorder(image, x, y))
+				{
+					borders << Point(x, y);
+				}
+			}
+		}
+
+		REQUIRE(!borders.isEmpty());
+
+		const Image sdf = ImageProcessing::GenerateSDF(image, 1, 127.5);
+
+		REQUIRE(sdf.size() == image.size());
+
+		bool exact = true;
+
+		for (int32 y = 0; y < image.height(); ++y)
+		{
+			for (int32 x = 0; x < image.width(); ++x)
+			{
+				double distance = Largest<double>;
+
+				for (const auto& border : borders)
+				{
+					distance = std::min(distance, Point(x, y).distanceFrom(border));
+				}
+
+				const double d = ((image[y][x].r == 255) ? distance : -distance) / 127.5;
+				const int32 expected = (d <= -1.0) ? 0 : (1.0 <= d) ? 255 : static_cast<int32>((d + 1.0) * 127.5 + 0.5);
+
+				exact &= (std::abs(sdf[y][x].a - expected) <= 1);
+			}
+		}
+
+		REQUIRE(exact);
+	}
+
+	// 幅と高さが scale で割り切れない
+	{
+		const Image sdf = ImageProcessing::GenerateSDF(TestImageProcessing::MakeCircles(103, 50, 4, 20), 4);
+
+		REQUIRE(sdf.size() == Size(25, 12));
+	}
+
+	// 境界が無い
+	{
+		const Image sdf = ImageProcessing::GenerateSDF(Image(32, 32, Color(0)), 2);
+
+		REQUIRE(sdf.size() == Size(16, 16));
+		REQUIRE(sdf[0][0].a == 0);
+	}
+
+	REQUIRE(ImageProcessing::GenerateSDF(Image(), 1).isEmpty());
+}
+
+TEST_CASE("ImageProcessing.GenerateSDF.Benchmark", "[.benchmark]")
+{
+	for (const auto& size : { Size(512, 512), Size(2048, 2048), Size(4096, 4096) })
+	{
+		const Image image = TestImageProcessing::MakeCircles(size.x, size.y, 200, size.x / 16);
+
+		Stopwatch stopwatch(true);
+
+		const Image sdf = ImageProcessing::GenerateSDF(image, 4);
+
+		const double ms = stopwatch.msF();
+
+		stopwatch.restart();
+
+		const Image reference = TestImageProcessing::GenerateSDF_Sweep(image, 4, 16.0);
+
+		const double referenceMs = stopwatch.msF();
+
+		size_t numDifferent = 0;
+
+		for (size_t i = 0; i < sdf.num_pixels(); ++i)
+		{
+			numDifferent += (sdf.data()[i].a != reference.data()[i].a);
+		}
+
+		Console << U"GenerateSDF {}x{}: {:.1f} ms (sweep: {:.1f} ms, {} pixels differ)"_fmt(size.x, size.y, ms, referenceMs, numDifferent);
+	}
+}
+
+# endif
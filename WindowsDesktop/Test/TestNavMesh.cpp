@@ -0,0 +1,300 @@
+﻿# include "Test.hpp"
+
+# if defined(SIV3D_DO_TEST)
+
+# define SIV3D_CONCURRENT
+# include <Siv3D.hpp>
+# include <ThirdParty/Catch2/catch.hpp>
+
+namespace TestNavMesh
+{
+	// size x size の床に、20 マスごとに片側だけ抜けられる壁を置いた迷路
+	static bool BuildMaze(NavMesh& navMesh, const int32 size, const NavMeshConfig& config = NavMeshConfig::Default())
+	{
+		Array<Float3> vertices;
+		Array<uint16> indices;
+
+		for (int32 z = 0; z <= size; ++z)
+		{
+			for (int32 x = 0; x <= size; ++x)
+			{
+				vertices.emplace_back(static_cast<float>(x), 0.0f, static_cast<float>(z));
+			}
+		}
+
+		for (int32 z = 0; z < size; ++z)
+		{
+			for (int32 x = 0; x < size; ++x)
+			{
+				const bool wall = ((x % 20) == 10) && (((x / 20) % 2) ? (5 <= z) : (z < (size - 5)));
+
+				if (wall)
+				{
+					continue;
+				}
+
+				const uint16 i = static_cast<uint16>(z * (size + 1) + x);
+				const uint16 k = static_cast<uint16>(i + size + 1);
+				indices << i << k << static_cast<uint16>(i + 1);
+				indices << static_cast<uint16>(i + 1) << k << static_cast<uint16>(k + 1);
+			}
+		}
+
+		return navMesh.build(vertices, indices, config);
+	}
+
+	static NavMesh MakeMaze(const int32 size, const NavMeshConfig& config = NavMeshConfig::Default())
+	{
+		NavMesh navMesh;
+		BuildMaze(navMesh, size, config);
+		return navMesh;
+	}
+
+	static Array<std::pair<Vec3, Vec3>> MakeQueries(const size_t count, const int32 size)
+	{
+		Reseed(12345);
+
+		Array<std::pair<Vec3, Vec3>> startEnds(count);
+
+		for (auto& startEnd : startEnds)
+		{
+			startEnd.first = Vec3(Random(1.0, 9.0), 0.0, Random(1.0, size - 1.0));
+			startEnd.second = Vec3(Random(size - 9.0, size - 1.0), 0.0, Random(1.0, size - 1.0));
+		}
+
+		return startEnds;
+	}
+}
+
+TEST_CASE("NavMesh.Query")
+{
+	constexpr int32 Size = 100;
+
+	const NavMesh navMesh = TestNavMesh::MakeMaze(Size);
+
+	const Array<Vec3> path = navMesh.query(Vec3(1, 0, 1), Vec3(Size - 2, 0, Size - 2));
+
+	// 壁を回り込むので、直線より多くの頂点を通る
+	REQUIRE(path.size() > 2);
+	REQUIRE(path.back().distanceFrom(Vec3(Size - 2, 0, Size - 2)) < 1.0);
+
+	const Array<std::pair<Vec3, Vec3>> startEnds = TestNavMesh::MakeQueries(100, Size);
+	const Array<Array<Vec3>> paths = navMesh.queryBatch(startEnds);
+
+	REQUIRE(paths.size() == startEnds.size());
+
+	for (size_t i = 0; i < startEnds.size(); ++i)
+	{
+		REQUIRE(paths[i] == navMesh.query(startEnds[i].first, startEnds[i].second));
+	}
+
+	// 少しずつ進めても、同じ経路になる
+	NavMeshSlicedQuery sliced = navMesh.querySliced(Vec3(1, 0, 1), Vec3(Size - 2, 0, Size - 2));
+	size_t numUpdates = 0;
+
+	while (!sliced.update(10))
+	{
+		REQUIRE(!sliced.isDone());
+		++numUpdates;
+	}
+
+	REQUIRE(numUpdates > 0);
+	REQUIRE(sliced.isDone());
+	REQUIRE(sliced.getPath() == path);
+
+	NavMeshSlicedQuery budgeted = navMesh.querySliced(Vec3(1, 0, 1), Vec3(Size - 2, 0, Size - 2));
+
+	while (!budgeted.updateFor(MicrosecondsF(50)))
+	{
+		REQUIRE(!budgeted.isDone());
+	}
+
+	REQUIRE(budgeted.getPath() == path);
+
+	REQUIRE(NavMesh().queryBatch(startEnds).size() == startEnds.size());
+	REQUIRE(NavMesh().querySliced(Vec3(1, 0, 1), Vec3(2, 0, 2)).isDone());
+}
+
+TEST_CASE("NavMesh.Query.Benchmark", "[.benchmark]")
+{
+	constexpr int32 Size = 200;
+
+	const NavMesh navMesh = TestNavMesh::MakeMaze(Size);
+
+	const Array<std::pair<Vec3, Vec3>> startEnds = TestNavMesh::MakeQueries(1000, Size);
+
+	Stopwatch stopwatch(true);
+
+	size_t numVertices = 0;
+
+	for (const auto& startEnd : startEnds)
+	{
+		numVertices += navMesh.query(startEnd.first, startEnd.second).size();
+	}
+
+	const double sequentialMs = stopwatch.msF();
+
+	stopwatch.restart();
+
+	for (const auto& path : navMesh.queryBatch(startEnds))
+	{
+		numVertices -= path.size();
+	}
+
+	const double batchMs = stopwatch.msF();
+
+	Console << U"NavMesh 1000 queries: {:.1f} ms sequential, {:.1f} ms batched ({} workers, vertex count difference: {})"_fmt(
+		sequentialMs, batchMs, Threading::GetWorkerCount(), static_cast<int64>(numVertices));
+}
+
+TEST_CASE("NavMesh.Tiled")
+{
+	constexpr int32 Size = 100;
+
+	NavMeshConfig config;
+	config.tileSize = 16;
+
+	NavMesh navMesh = TestNavMesh::MakeMaze(Size, config);
+
+	const Vec3 start(1, 0, 1), end(Size - 2, 0, Size - 2);
+
+	const Array<Vec3> path = navMesh.query(start, end);
+
+	REQUIRE(path.size() > 2);
+	REQUIRE(path.back().distanceFrom(end) < 1.0);
+	REQUIRE(!navMesh.isRebuilding());
+
+	// 最初の壁の抜け道をふさぐと、終点にたどり着けなくなる
+	const uint32 id = navMesh.addObstacle(AABB(Vec3(10, 0, Size - 2.5), Vec3(4, 2, 5)));
+
+	REQUIRE(id != 0);
+	REQUIRE(navMesh.isRebuilding());
+
+	const size_t numTiles = navMesh.update(true);
+
+	REQUIRE(0 < numTiles);
+	REQUIRE(numTiles < 10);
+	REQUIRE(!navMesh.isRebuilding());
+	REQUIRE(navMesh.query(start, end).back().distanceFrom(end) > 10.0);
+
+	// 取り除くと、バックグラウンドで再構築された後に元に戻る
+	REQUIRE(navMesh.removeArea(id));
+	REQUIRE(!navMesh.removeArea(id));
+
+	while (navMesh.isRebuilding())
+	{
+		navMesh.update();
+	}
+
+	REQUIRE(navMesh.query(start, end) == path);
+
+	// タイルに分けない場合も、全体を再構築して反映する
+	NavMesh single = TestNavMesh::MakeMaze(Size);
+	single.addObstacle(AABB(Vec3(10, 0, Size - 2.5), Vec3(4, 2, 5)));
+
+	REQUIRE(single.update(true) == 1);
+	REQUIRE(single.query(start, end).back().distanceFrom(end) > 10.0);
+
+	REQUIRE(NavMesh().addObstacle(AABB(Vec3(0, 0, 0), 1.0)) == 0);
+}
+
+TEST_CASE("NavMesh.Rebuild")
+{
+	NavMeshConfig config;
+	config.tileSize = 16;
+
+	NavMesh navMesh;
+	REQUIRE(TestNavMesh::BuildMaze(navMesh, 100, config));
+
+	const Vec3 start(1, 0, 1);
+	REQUIRE(navMesh.query(start, Vec3(98, 0, 98)).back().distanceFrom(Vec3(98, 0, 98)) < 1.0);
+
+	// プールに複数の探索用のデータを残す
+	REQUIRE(navMesh.queryBatch(TestNavMesh::MakeQueries(100, 100)).size() == 100);
+
+	NavMesh previous = navMesh;
+	NavMeshSlicedQuery sliced = navMesh.querySliced(start, Vec3(98, 0, 98));
+	REQUIRE(!sliced.update(10));
+
+	// 再構築の途中で作り直す
+	const uint32 id = navMesh.addObstacle(AABB(Vec3(10, 0, 97.5), Vec3(4, 2, 5)));
+	navMesh.update(false);
+
+	REQUIRE(TestNavMesh::BuildMaze(navMesh, 60, config));
+	REQUIRE(!navMesh.isRebuilding());
+	REQUIRE(!navMesh.removeArea(id));
+
+	// コピーと探索中の NavMeshSlicedQuery は、前のメッシュを使い続ける
+	while (!sliced.update(10));
+
+	REQUIRE(sliced.getPath().back().distanceFrom(Vec3(98, 0, 98)) < 1.0);
+	REQUIRE(previous.query(start, Vec3(98, 0, 98)).back().distanceFrom(Vec3(98, 0, 98)) < 1.0);
+	REQUIRE(previous.removeArea(id));
+
+	const Vec3 end(58, 0, 58);
+	const Array<Vec3> path = navMesh.query(start, end);
+
+	REQUIRE(path.size() > 2);
+	REQUIRE(path.back().distanceFrom(end) < 1.0);
+	REQUIRE(path == TestNavMesh::MakeMaze(60, config).query(start, end));
+
+	const Array<std::pair<Vec3, Vec3>> startEnds = TestNavMesh::MakeQueries(100, 60);
+	const Array<Array<Vec3>> paths = navMesh.queryBatch(startEnds);
+
+	for (size_t i = 0; i < startEnds.size(); ++i)
+	{
+		REQUIRE(paths[i] == navMesh.query(startEnds[i].first, startEnds[i].second));
+	}
+
+	NavMeshSlicedQuery resliced = navMesh.querySliced(start, end);
+
+	while (!resliced.update(10));
+
+	REQUIRE(resliced.getPath() == path);
+
+	// 構築に失敗した後は、何も見つからない
+	REQUIRE(!navMesh.build({}, {}));
+	REQUIRE(navMesh.query(start, end).isEmpty());
+}
+
+TEST_CASE("NavMesh.Tiled.Benchmark", "[.benchmark]")
+{
+	constexpr int32 Size = 250;
+
+	NavMeshConfig config;
+	config.tileSize = 32;
+
+	Stopwatch stopwatch(true);
+
+	NavMesh single = TestNavMesh::MakeMaze(Size);
+
+	const double singleBuildMs = stopwatch.msF();
+
+	stopwatch.restart();
+
+	NavMesh tiled = TestNavMesh::MakeMaze(Size, config);
+
+	const double tiledBuildMs = stopwatch.msF();
+
+	const AABB obstacle(Vec3(Size / 2.0, 0, Size / 2.0), Vec3(3, 2, 3));
+
+	single.addObstacle(obstacle);
+	tiled.addObstacle(obstacle);
+
+	stopwatch.restart();
+
+	single.update(true);
+
+	const double singleUpdateMs = stopwatch.msF();
+
+	stopwatch.restart();
+
+	const size_t numTiles = tiled.update(true);
+
+	const double tiledUpdateMs = stopwatch.msF();
+
+	Console << U"NavMesh {0}x{0} build: {1:.1f} ms single, {2:.1f} ms tiled / obstacle: {3:.1f} ms single, {4:.1f} ms tiled ({5} tiles)"_fmt(
+		Size, singleBuildMs, tiledBuildMs, singleUpdateMs, tiledUpdateMs, numTiles);
+}
+
+# endif
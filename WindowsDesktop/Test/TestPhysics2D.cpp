@@ -0,0 +1,470 @@
+﻿
+# include "Test.hpp"
+
+# if defined(SIV3D_DO_TEST)
+
+# define SIV3D_CONCURRENT
+# include <Siv3D.hpp>
+# include <ThirdParty/Catch2/catch.hpp>
+
+namespace TestPhysics2D
+{
+	struct World
+	{
+		P2World p2World{ 0.0 };
+
+		Array<P2Body> bodies;
+
+		Array<Circle> circles;
+	};
+
+	static std::unique_ptr<World> MakeWorld(const size_t numBodies, const double extent)
+	{
+		auto world = std::make_unique<World>();
+
+		Reseed(12345);
+
+		for (size_t i = 0; i < numBodies; ++i)
+		{
+			const Circle circle(RandomVec2(RectF(-extent, -extent, extent * 2, extent * 2)), 1.0 + (i % 3));
+
+			world->bodies << world->p2World.createStaticCircle(circle.center, circle.r);
+			world->circles << circle;
+		}
+
+		return world;
+	}
+
+	static Array<Line> MakeRays(const size_t numRays, const double extent)
+	{
+		const RectF area(-extent, -extent, extent * 2, extent * 2);
+
+		Array<Line> rays(numRays);
+
+		for (auto& ray : rays)
+		{
+			ray.set(RandomVec2(area), RandomVec2(area));
+		}
+
+		return rays;
+	}
+
+	// 全部の円と交差判定する、木を使わない方法
+	static Optional<double> RaycastScan(const World& world, const Line& ray)
+	{
+		const Vec2 d = (ray.end - ray.begin);
+		const double a = d.dot(d);
+
+		Optional<double> result;
+
+		for (const auto& circle : world.circles)
+		{
+			const Vec2 f = (ray.begin - circle.center);
+			const double b = 2 * f.dot(d);
+			const double c = f.dot(f) - circle.r * circle.r;
+			const double discriminant = (b * b - 4 * a * c);
+
+			if (discriminant < 0.0)
+			{
+				continue;
+			}
+
+			const double t = (-b - std::sqrt(discriminant)) / (2 * a);
+
+			if ((0.0 <= t) && (t <= 1.0) && (!result || (t < *result)))
+			{
+				result = t;
+			}
+		}
+
+		return result;
+	}
+
+	// 床の上に落ちてくる物体
+	static std::unique_ptr<World> MakeFallingWorld(const size_t numBodies)
+	{
+		auto world = std::make_unique<World>();
+
+		world->p2World.setGravity(980.0);
+
+		world->bodies << world->p2World.createStaticRect(Vec2(0, 200), SizeF(4000, 20));
+
+		Reseed(12345);
+
+		const RectF area(-1000, -3000, 2000, 3000);
+
+		for (size_t i = 0; i < numBodies; ++i)
+		{
+			if (i % 2)
+			{
+				world->bodies << world->p2World.createCircle(RandomVec2(area), 4.0);
+			}
+			else
+			{
+				world->bodies << world->p2World.createRect(RandomVec2(area), SizeF(8, 6));
+			}
+		}
+
+		return world;
+	}
+
+	static Array<double> GetState(const World& world)
+	{
+		Array<double> state;
+
+		for (const auto& body : world.bodies)
+		{
+			state << body.getPos().x << body.getPos().y << body.getAngle() << body.getVelocity().x << body.getVelocity().y;
+		}
+
+		return state;
+	}
+
+	static const P2Collision* FindCollision(const P2World& world, const P2Body& a, const P2Body& b)
+	{
+		const auto& collisions = world.getCollisions();
+
+		if (auto it = collisions.find(P2ContactPair{ a.id(), b.id() }); it != collisions.end())
+		{
+			return &it->second;
+		}
+
+		if (auto it = collisions.find(P2ContactPair{ b.id(), a.id() }); it != collisions.end())
+		{
+			return &it->second;
+		}
+
+		return nullptr;
+	}
+
+	static void Step(const World& world, const size_t steps)
+	{
+		for (size_t i = 0; i < steps; ++i)
+		{
+			world.p2World.update(1.0 / 60.0);
+		}
+	}
+}
+
+TEST_CASE("Physics2D.Query")
+{
+	constexpr double Extent = 200.0;
+
+	const auto world = TestPhysics2D::MakeWorld(2000, Extent);
+
+	const RectF rect(-30, -20, 60, 40);
+	const Array<P2BodyID> inRect = world->p2World.queryAABB(rect);
+	const Array<P2BodyID> inCircle = world->p2World.queryOverlap(Circle(10, 10, 40));
+
+	for (size_t i = 0; i < world->circles.size(); ++i)
+	{
+		const Circle& circle = world->circles[i];
+		const P2BodyID id = world->bodies[i].id();
+
+		const RectF boundingRect(circle.center - Vec2(circle.r, circle.r), circle.r * 2);
+		const bool aabbOverlaps = boundingRect.stretched(0.1).intersects(rect);
+		const bool aabbSeparated = !boundingRect.stretched(-0.1).intersects(rect);
+		REQUIRE((aabbOverlaps || !inRect.includes(id)));
+		REQUIRE((aabbSeparated || inRect.includes(id)));
+
+		const double distance = circle.center.distanceFrom(Vec2(10, 10));
+		REQUIRE(((distance < (40 + circle.r + 0.1)) || !inCircle.includes(id)));
+		REQUIRE(((distance > (40 + circle.r - 0.1)) || inCircle.includes(id)));
+	}
+
+	const Array<Line> rays = TestPhysics2D::MakeRays(500, Extent);
+	const Array<Optional<P2RaycastHit>> hits = world->p2World.raycast(rays);
+
+	REQUIRE(hits.size() == rays.size());
+
+	for (size_t i = 0; i < rays.size(); ++i)
+	{
+		const Optional<double> expected = TestPhysics2D::RaycastScan(*world, rays[i]);
+
+		REQUIRE(hits[i].has_value() == expected.has_value());
+
+		if (hits[i])
+		{
+			REQUIRE(hits[i]->fraction == Approx(*expected).margin(1e-3));
+
+			const Optional<P2RaycastHit> single = world->p2World.raycast(rays[i].begin, rays[i].end);
+			REQUIRE(single.has_value());
+			REQUIRE(single->id == hits[i]->id);
+
+			const Array<P2RaycastHit> all = world->p2World.raycastAll(rays[i].begin, rays[i].end);
+			REQUIRE(all.front().id == hits[i]->id);
+			REQUIRE(std::is_sorted(all.begin(), all.end(), [](const P2RaycastHit& a, const P2RaycastHit& b) { return a.fraction < b.fraction; }));
+		}
+	}
+
+	// 離れた位置から円を動かすと、表面で止まる
+	P2World smallWorld(0.0);
+	const P2Body target = smallWorld.createStaticCircle(Vec2(10, 0), 1.0);
+	const P2Body ignored = smallWorld.createStaticRect(Vec2(0, 10), SizeF(4, 2), P2Material(), P2Filter(0b10));
+
+	const Optional<P2RaycastHit> hit = smallWorld.circleCast(Circle(0, 0, 1), Vec2(20, 0));
+	REQUIRE(hit.has_value());
+	REQUIRE(hit->id == target.id());
+	REQUIRE(hit->fraction == Approx(0.4).margin(1e-2));
+	REQUIRE(hit->normal.x == Approx(-1.0).margin(1e-3));
+
+	REQUIRE(smallWorld.circleCast(Circle(0, 0, 1), Vec2(0, 20)).has_value());
+	REQUIRE(!smallWorld.circleCast(Circle(0, 0, 1), Vec2(0, 20), P2Filter(0b01, 0b01)).has_value());
+	REQUIRE(smallWorld.queryOverlap(Quad(Vec2(-1, 9), Vec2(1, 9), Vec2(1, 11), Vec2(-1, 11))) == Array<P2BodyID>{ ignored.id() });
+	REQUIRE(smallWorld.queryOverlap(Polygon{ Vec2(8, -2), Vec2(12, -2), Vec2(10, 2) }) == Array<P2BodyID>{ target.id() });
+}
+
+TEST_CASE("Physics2D.QueryOverlap")
+{
+	P2World world(0.0);
+
+	// 退化した図形の代わりに原点に作られていた 2x2 の四角形と重なる位置
+	const P2Body origin = world.createStaticCircle(Vec2(0, 0), 0.5);
+
+	// 凹んだ Quad の内側と、凸包にだけ含まれる位置
+	const P2Body inside = world.createStaticCircle(Vec2(102, 0), 0.5);
+	const P2Body notch = world.createStaticCircle(Vec2(94, 0), 0.5);
+
+	// 面積が 0 の図形は何とも重ならない
+	REQUIRE(world.queryOverlap(Quad(Vec2(10, 10), Vec2(20, 20), Vec2(30, 30), Vec2(40, 40))).isEmpty());
+	REQUIRE(world.queryOverlap(Quad(Vec2(10, 10), Vec2(10, 10), Vec2(10, 10), Vec2(10, 10))).isEmpty());
+	REQUIRE(world.queryOverlap(Quad(Vec2(10, 10), Vec2(20, 10), Vec2(20, 10.000001), Vec2(10, 10.000001))).isEmpty());
+
+	// 一方の三角形だけが退化していても、もう一方は調べる
+	REQUIRE(world.queryOverlap(Quad(Vec2(-1, -1), Vec2(1, -1), Vec2(1, 1), Vec2(1, 1))) == Array<P2BodyID>{ origin.id() });
+
+	// 同一直線上の頂点を含む多角形
+	REQUIRE(world.queryOverlap(Polygon{ Vec2(20, -2), Vec2(24, -2), Vec2(24, 2), Vec2(22, 2), Vec2(20, 2) }).isEmpty());
+	REQUIRE(world.queryOverlap(Polygon{ Vec2(-2, -2), Vec2(0, -2), Vec2(2, -2), Vec2(2, 2), Vec2(-2, 2) }) == Array<P2BodyID>{ origin.id() });
+
+	// 矢じり形の Quad は凸包ではなく、Quad::intersects() と同じ 2 つの三角形として調べる
+	const Quad arrowhead(Vec2(90, -10), Vec2(110, 0), Vec2(90, 10), Vec2(100, 0));
+	REQUIRE(arrowhead.intersects(Vec2(102, 0)));
+	REQUIRE(!arrowhead.intersects(Vec2(94, 0)));
+	REQUIRE(world.queryOverlap(arrowhead) == Array<P2BodyID>{ inside.id() });
+}
+
+TEST_CASE("Physics2D.Query.Benchmark", "[.benchmark]")
+{
+	constexpr double Extent = 1000.0;
+
+	const auto world = TestPhysics2D::MakeWorld(10'000, Extent);
+
+	const Array<Line> rays = TestPhysics2D::MakeRays(10'000, Extent);
+
+	Stopwatch stopwatch(true);
+
+	const Array<Optional<P2RaycastHit>> hits = world->p2World.raycast(rays);
+
+	const double batchedMs = stopwatch.msF();
+
+	stopwatch.restart();
+
+	size_t numHits = 0;
+
+	for (const auto& ray : rays)
+	{
+		numHits += world->p2World.raycast(ray.begin, ray.end).has_value();
+	}
+
+	const double sequentialMs = stopwatch.msF();
+
+	stopwatch.restart();
+
+	for (const auto& ray : rays)
+	{
+		numHits -= TestPhysics2D::RaycastScan(*world, ray).has_value();
+	}
+
+	const double scanMs = stopwatch.msF();
+
+	Console << U"P2World::raycast() 10k bodies, 10k rays: {:.1f} ms batched, {:.1f} ms sequential, {:.1f} ms O(N) scan (hit count difference: {})"_fmt(
+		batchedMs, sequentialMs, scanMs, static_cast<int64>(numHits));
+}
+
+TEST_CASE("Physics2D.Snapshot")
+{
+	const auto world = TestPhysics2D::MakeFallingWorld(500);
+
+	const P2PivotJoint pivotJoint = world->p2World.createPivotJoint(world->bodies[1], world->bodies[2], world->bodies[1].getPos());
+	const P2DistanceJoint distanceJoint = world->p2World.createDistanceJoint(world->bodies[3], world->bodies[3].getPos(), world->bodies[4], world->bodies[4].getPos(), 10.0);
+
+	TestPhysics2D::Step(*world, 120);
+
+	P2WorldSnapshot snapshot;
+	world->p2World.takeSnapshot(snapshot);
+	REQUIRE(!snapshot.isEmpty());
+
+	TestPhysics2D::Step(*world, 90);
+
+	const Array<double> expected = TestPhysics2D::GetState(*world);
+	const size_t numCollisions = world->p2World.getCollisions().size();
+
+	// 接触が変わった後からの復元
+	REQUIRE(world->p2World.restoreSnapshot(snapshot));
+	TestPhysics2D::Step(*world, 90);
+	REQUIRE(std::memcmp(TestPhysics2D::GetState(*world).data(), expected.data(), expected.size_bytes()) == 0);
+	REQUIRE(world->p2World.getCollisions().size() == numCollisions);
+
+	// 復元した直後からの復元
+	REQUIRE(world->p2World.restoreSnapshot(snapshot));
+	REQUIRE(world->p2World.restoreSnapshot(snapshot));
+	TestPhysics2D::Step(*world, 90);
+	REQUIRE(std::memcmp(TestPhysics2D::GetState(*world).data(), expected.data(), expected.size_bytes()) == 0);
+
+	// 構成の違うワールドには復元できない
+	const auto otherWorld = TestPhysics2D::MakeFallingWorld(400);
+	REQUIRE(!otherWorld->p2World.restoreSnapshot(snapshot));
+	REQUIRE(!otherWorld->p2World.restoreSnapshot(P2WorldSnapshot()));
+}
+
+TEST_CASE("Physics2D.Snapshot.Benchmark", "[.benchmark]")
+{
+	for (const size_t numBodies : { 1'000, 10'000, 50'000 })
+	{
+		const auto world = TestPhysics2D::MakeFallingWorld(numBodies);
+
+		TestPhysics2D::Step(*world, 10);
+
+		P2WorldSnapshot snapshot;
+		world->p2World.takeSnapshot(snapshot);
+
+		constexpr size_t N = 20;
+
+		Stopwatch stopwatch(true);
+
+		for (size_t i = 0; i < N; ++i)
+		{
+			world->p2World.takeSnapshot(snapshot);
+		}
+
+		const double takeMs = (stopwatch.msF() / N);
+
+		stopwatch.restart();
+
+		for (size_t i = 0; i < N; ++i)
+		{
+			world->p2World.restoreSnapshot(snapshot);
+		}
+
+		const double restoreMs = (stopwatch.msF() / N);
+
+		Console << U"P2WorldSnapshot {} bodies: {} KiB, {:.3f} ms take, {:.3f} ms restore"_fmt(
+			numBodies, snapshot.size_bytes() / 1024, takeMs, restoreMs);
+	}
+}
+
+TEST_CASE("Physics2D.FixedStep")
+{
+	const auto variableWorld = TestPhysics2D::MakeFallingWorld(100);
+	const auto fixedWorld = TestPhysics2D::MakeFallingWorld(100);
+
+	// 半分の経過時間を 2 回渡すと、固定ステップ 1 回分になる
+	TestPhysics2D::Step(*variableWorld, 30);
+
+	size_t numSteps = 0;
+
+	for (size_t i = 0; i < 60; ++i)
+	{
+		numSteps += fixedWorld->p2World.updateFixed(1.0 / 120.0);
+	}
+
+	REQUIRE(numSteps == 30);
+
+	const Array<double> expected = TestPhysics2D::GetState(*variableWorld);
+	REQUIRE(std::memcmp(TestPhysics2D::GetState(*fixedWorld).data(), expected.data(), expected.size_bytes()) == 0);
+	REQUIRE(fixedWorld->p2World.getProfile().numSteps == 1);
+
+	// ステップが進まなかった分は補間される
+	REQUIRE(fixedWorld->p2World.updateFixed(1.0 / 240.0) == 0);
+	REQUIRE(fixedWorld->p2World.getInterpolationAlpha() == Approx(0.25));
+	REQUIRE(fixedWorld->p2World.getProfile().numSteps == 0);
+
+	const P2Body& body = fixedWorld->bodies[1];
+	const Vec2 currentPos = body.getPos();
+	const Vec2 interpolatedPos = body.getInterpolatedPos();
+	REQUIRE(interpolatedPos.y < currentPos.y);
+	REQUIRE(body.getInterpolationMat().transform(currentPos).distanceFrom(interpolatedPos) < 0.01);
+
+	// 最大ステップ数を超えた時間は捨てられる
+	REQUIRE(fixedWorld->p2World.updateFixed(1.0, (1.0 / 60.0), 4) == 4);
+	REQUIRE(fixedWorld->p2World.getProfile().numSteps == 4);
+	REQUIRE(fixedWorld->p2World.getInterpolationAlpha() < 1.0);
+
+	fixedWorld->p2World.update(1.0 / 60.0);
+	REQUIRE(fixedWorld->p2World.getInterpolationAlpha() == 1.0);
+	REQUIRE(body.getInterpolatedPos() == body.getPos());
+}
+
+TEST_CASE("Physics2D.FixedStep.Collisions")
+{
+	using TestPhysics2D::FindCollision;
+
+	P2World world(60.0);
+
+	const P2Body floor = world.createStaticRect(Vec2(0, 0), SizeF(100, 2));
+
+	// 床に置かれた箱
+	const P2Body box = world.createRect(Vec2(-20, -2), SizeF(2, 2));
+
+	// 1 ステップで 1 ずつ床に近づき、跳ね返る球
+	P2Body ball = world.createCircle(Vec2(20, -6), 1.0, P2Material(1.0, 1.0, 0.0));
+	ball.setVelocity(Vec2(0, 60));
+
+	// 箱が床に押し付けられている間に、球が床に当たって離れる
+	REQUIRE(world.updateFixed(8.0 / 60.0) == 8);
+
+	const P2Collision* boxCollision = FindCollision(world, floor, box);
+	REQUIRE(boxCollision);
+	REQUIRE(boxCollision->num_contacts == 2);
+
+	// 途中のステップで離れた接触も残る
+	const P2Collision* ballCollision = FindCollision(world, floor, ball);
+	REQUIRE(ballCollision);
+	REQUIRE(ballCollision->num_contacts == 1);
+	REQUIRE(ballCollision->contacts[0].normalImpulse > 0.0);
+	REQUIRE(ball.getVelocity().y < 0.0);
+
+	// 次の呼び出しで取り除かれる
+	world.update(1.0 / 60.0);
+	REQUIRE(FindCollision(world, floor, box));
+	REQUIRE(!FindCollision(world, floor, ball));
+
+	// 力積はすべてのステップの合計
+	const double singleStepImpulse = (FindCollision(world, floor, box)->contacts[0].normalImpulse + FindCollision(world, floor, box)->contacts[1].normalImpulse);
+	REQUIRE(world.updateFixed(4.0 / 60.0) == 4);
+	const double fourStepImpulse = (FindCollision(world, floor, box)->contacts[0].normalImpulse + FindCollision(world, floor, box)->contacts[1].normalImpulse);
+	REQUIRE(fourStepImpulse > (singleStepImpulse * 2.0));
+
+	// ステップが進まなければ、接触中の組は残るが接触点は無い
+	REQUIRE(world.updateFixed(1.0 / 240.0) == 0);
+	REQUIRE(FindCollision(world, floor, box));
+	REQUIRE(FindCollision(world, floor, box)->num_contacts == 0);
+}
+
+TEST_CASE("Physics2D.FixedStep.Benchmark", "[.benchmark]")
+{
+	const auto world = TestPhysics2D::MakeFallingWorld(10'000);
+
+	P2Profile total;
+
+	for (size_t i = 0; i < 120; ++i)
+	{
+		world->p2World.updateFixed(1.0 / 60.0);
+
+		const P2Profile& profile = world->p2World.getProfile();
+		total.step += profile.step;
+		total.collide += profile.collide;
+		total.solve += profile.solve;
+		total.broadphase += profile.broadphase;
+		total.solveTOI += profile.solveTOI;
+		total.numSteps += profile.numSteps;
+	}
+
+	const double n = static_cast<double>(total.numSteps);
+
+	Console << U"P2World::updateFixed() 10k bodies, per step: {:.3f} ms (collide {:.3f} ms, solve {:.3f} ms, broadphase {:.3f} ms, TOI {:.3f} ms)"_fmt(
+		total.step / n, total.collide / n, total.solve / n, total.broadphase / n, total.solveTOI / n);
+}
+
+# endif
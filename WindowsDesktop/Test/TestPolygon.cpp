@@ -0,0 +1,491 @@
+﻿# include "Test.hpp"
+
+# if defined(SIV3D_DO_TEST)
+
+# define SIV3D_CONCURRENT
+# include <Siv3D.hpp>
+# include <ThirdParty/Catch2/catch.hpp>
+
+namespace TestPolygon
+{
+	// 頂点数 n の、輪郭が波打った多角形。中央に四角形の穴がある
+	static Polygon MakeWavy(const size_t n)
+	{
+		Array<Vec2> outer(n);
+
+		for (size_t i = 0; i < n; ++i)
+		{
+			const double angle = (i * Math::TwoPi / n);
+			const double r = (250.0 + 30.0 * std::sin(7 * angle) + 8.0 * std::sin(61 * angle));
+			outer[i] = Vec2(400, 300) + Circular(r, angle);
+		}
+
+		// Circular は時計回りなので、反時計回りの穴を加える
+		return Polygon(outer, { { Vec2(380, 280), Vec2(380, 320), Vec2(420, 320), Vec2(420, 280) } });
+	}
+
+	static Array<Vec2> MakePoints(const size_t count)
+	{
+		Reseed(12345);
+
+		Array<Vec2> points(count);
+
+		for (auto& point : points)
+		{
+			point = RandomVec2(RectF(50, 0, 700, 600));
+		}
+
+		return points;
+	}
+
+	static Array<Line> MakeLines(const size_t count)
+	{
+		Reseed(23456);
+
+		Array<Line> lines(count);
+
+		for (auto& line : lines)
+		{
+			const Vec2 begin = RandomVec2(RectF(50, 0, 700, 600));
+			line.set(begin, begin + RandomVec2(RectF(-40, -40, 80, 80)));
+		}
+
+		return lines;
+	}
+	// 互いに重なり合う、大きさの異なる円と四角形
+	static Array<Polygon> MakeBlobs(const size_t count)
+	{
+		Reseed(34567);
+
+		Array<Polygon> polygons(count);
+
+		for (auto& polygon : polygons)
+		{
+			const Vec2 center = RandomVec2(RectF(50, 0, 700, 600));
+			const double size = Random(10.0, 40.0);
+
+			if (RandomBool())
+			{
+				polygon = Circle(center, size).asPolygon(24);
+			}
+			else
+			{
+				polygon = RectF(Arg::center = center, size * 1.5, size).rotated(Random(Math::Pi)).asPolygon();
+			}
+		}
+
+		return polygons;
+	}
+
+	template <class Polygons>
+	static bool Contains(const Polygons& polygons, const Vec2& point)
+	{
+		return std::any_of(polygons.begin(), polygons.end(), [&](const Polygon& polygon) { return polygon.contains(point); });
+	}
+
+	template <class Polygons>
+	static double SumArea(const Polygons& polygons)
+	{
+		double area = 0.0;
+
+		for (const auto& polygon : polygons)
+		{
+			area += polygon.area();
+		}
+
+		return area;
+	}
+}
+
+TEST_CASE("Polygon.PreparedPolygon")
+{
+	const Polygon polygon = TestPolygon::MakeWavy(1000);
+	const PreparedPolygon prepared(polygon);
+
+	REQUIRE(prepared);
+	REQUIRE(prepared.boundingRect() == polygon.boundingRect());
+	REQUIRE(prepared.num_bands() > 1);
+
+	REQUIRE(prepared.contains(Vec2(400, 150)));
+	REQUIRE(!prepared.contains(Vec2(400, 300)));
+	REQUIRE(!prepared.contains(Vec2(0, 0)));
+	REQUIRE(prepared.intersects(Line(Vec2(400, 300), Vec2(400, 0))));
+	REQUIRE(!prepared.intersects(Line(Vec2(395, 295), Vec2(405, 305))));
+
+	// 前処理をしない判定と一致する
+	for (const auto& point : TestPolygon::MakePoints(1000))
+	{
+		REQUIRE(prepared.contains(point) == polygon.contains(point));
+	}
+
+	for (const auto& line : TestPolygon::MakeLines(1000))
+	{
+		REQUIRE(prepared.intersects(line) == polygon.intersects(line));
+	}
+
+	REQUIRE(!PreparedPolygon());
+	REQUIRE(!PreparedPolygon().contains(Vec2(0, 0)));
+	REQUIRE(!PreparedPolygon().intersects(Line(0, 0, 100, 100)));
+}
+
+TEST_CASE("Polygon.PreparedPolygon.Benchmark", "[.benchmark]")
+{
+	const Array<Vec2> points = TestPolygon::MakePoints(10000);
+
+	const Array<Line> lines = TestPolygon::MakeLines(10000);
+
+	for (const size_t n : { 1'000, 10'000, 100'000 })
+	{
+		const Polygon polygon = TestPolygon::MakeWavy(n);
+
+		Stopwatch stopwatch(true);
+
+		const PreparedPolygon prepared(polygon);
+
+		const double prepareMs = stopwatch.msF();
+
+		size_t count = 0;
+
+		stopwatch.restart();
+
+		for (const auto& point : points)
+		{
+			count += polygon.contains(point);
+		}
+
+		const double polygonPointUs = (stopwatch.usF() / points.size());
+
+		stopwatch.restart();
+
+		for (const auto& point : points)
+		{
+			count -= prepared.contains(point);
+		}
+
+		const double preparedPointUs = (stopwatch.usF() / points.size());
+
+		stopwatch.restart();
+
+		for (const auto& line : lines)
+		{
+			count += polygon.intersects(line);
+		}
+
+		const double polygonLineUs = (stopwatch.usF() / lines.size());
+
+		stopwatch.restart();
+
+		for (const auto& line : lines)
+		{
+			count -= prepared.intersects(line);
+		}
+
+		const double preparedLineUs = (stopwatch.usF() / lines.size());
+
+		Console << U"PreparedPolygon {} vertices: prepare {:.2f} ms / point {:.3f} us -> {:.3f} us / line {:.3f} us -> {:.3f} us (difference: {})"_fmt(
+			n, prepareMs, polygonPointUs, preparedPointUs, polygonLineUs, preparedLineUs, count);
+	}
+}
+
+TEST_CASE("Polygon.LargeIndices")
+{
+	// 頂点数が 16-bit インデックスの範囲を超える
+	const Polygon polygon = TestPolygon::MakeWavy(100'000);
+
+	REQUIRE(polygon);
+
+	const Array<Float2>& vertices = polygon.vertices();
+	const Array<uint32>& indices = polygon.indices32();
+
+	REQUIRE(vertices.size() == 100'004);
+	REQUIRE(polygon.indices().isEmpty());
+	REQUIRE((indices.size() % 3) == 0);
+	REQUIRE(polygon.num_triangles() == (indices.size() / 3));
+	REQUIRE(indices.size() >= (3 * (vertices.size() - 2)));
+	REQUIRE(Largest<uint16> < *std::max_element(indices.begin(), indices.end()));
+	REQUIRE(*std::max_element(indices.begin(), indices.end()) < vertices.size());
+
+	// 三角形分割が多角形全体を覆っている
+	double area = 0.0;
+
+	for (size_t i = 0; i < polygon.num_triangles(); ++i)
+	{
+		area += polygon.triangle(i).area();
+	}
+
+	REQUIRE(area == Approx(polygon.area()).epsilon(1e-4));
+	REQUIRE(polygon.area() == Approx(TestPolygon::MakeWavy(1'000).area()).epsilon(1e-2));
+
+	// インデックスの数が 65535 を超えても、頂点数が収まれば 16-bit のまま
+	const Polygon medium = TestPolygon::MakeWavy(30'000);
+
+	REQUIRE(medium.indices32().isEmpty());
+	REQUIRE(Largest<uint16> < medium.indices().size());
+	REQUIRE(medium.num_triangles() == (medium.indices().size() / 3));
+
+	// 32-bit のインデックスを渡しても、頂点数が収まれば 16-bit で持つ
+	const Array<Vec2> quad = { Vec2(0, 0), Vec2(10, 0), Vec2(10, 10), Vec2(0, 10) };
+	const Polygon narrowed(quad, Array<uint32>{ 0, 1, 2, 0, 2, 3 }, RectF(0, 0, 10, 10));
+
+	REQUIRE(narrowed.indices() == Array<Polygon::IndexType>{ 0, 1, 2, 0, 2, 3 });
+	REQUIRE(narrowed.indices32().isEmpty());
+	REQUIRE(narrowed.area() == Approx(100.0));
+
+	const Polygon copied(polygon.outer(), polygon.inners(), polygon.vertices(), polygon.indices32(), polygon.boundingRect());
+
+	REQUIRE(copied.indices32() == indices);
+
+	// 16-bit のインデックスを持つ Shape2D からも作れる
+	const Shape2D star = Shape2D::Star(100, Vec2(400, 300));
+	const Polygon starPolygon(star);
+
+	REQUIRE(starPolygon.indices() == star.indices());
+}
+
+TEST_CASE("Polygon.LargeIndices.Serialization")
+{
+	// 16-bit のインデックスを持つ多角形は、以前と同じ形式で保存される
+	const Polygon small = TestPolygon::MakeWavy(1'000);
+	{
+		Serializer<MemoryWriter> writer;
+		writer(small);
+
+		Serializer<MemoryWriter> expected;
+		expected(small.outer());
+		expected(small.inners());
+		expected(small.vertices());
+		expected(small.indices());
+		expected(small.boundingRect());
+
+		const ByteArray data = writer.getWriter().retrieve();
+		const ByteArray expectedData = expected.getWriter().retrieve();
+		REQUIRE(data.size() == expectedData.size());
+		REQUIRE(std::memcmp(data.data(), expectedData.data(), static_cast<size_t>(data.size())) == 0);
+
+		Deserializer<ByteArray> reader(data);
+		Polygon loaded;
+		reader(loaded);
+
+		REQUIRE(loaded.indices() == small.indices());
+		REQUIRE(loaded.boundingRect() == small.boundingRect());
+	}
+
+	const Polygon large = TestPolygon::MakeWavy(100'000);
+	{
+		Serializer<MemoryWriter> writer;
+		writer(large);
+
+		Deserializer<ByteArray> reader(writer.getWriter().retrieve());
+		Polygon loaded;
+		reader(loaded);
+
+		REQUIRE(loaded.indices().isEmpty());
+		REQUIRE(loaded.indices32() == large.indices32());
+		REQUIRE(loaded.vertices() == large.vertices());
+		REQUIRE(loaded.boundingRect() == large.boundingRect());
+	}
+}
+
+TEST_CASE("Polygon.LargeIndices.Benchmark", "[.benchmark]")
+{
+	for (const size_t n : { 10'000, 20'000, 100'000 })
+	{
+		Stopwatch stopwatch(true);
+
+		const Polygon polygon = TestPolygon::MakeWavy(n);
+
+		const double triangulateMs = stopwatch.msF();
+
+		stopwatch.restart();
+
+		// 2 万頂点まではインデックスが 16-bit のバッチに収まり、10 万頂点は 32-bit インデックスの 1 回の Draw になる
+		polygon.draw();
+
+		const double drawMs = stopwatch.msF();
+
+		const size_t indexBytes = (polygon.indices().size_bytes() + polygon.indices32().size_bytes());
+
+		Console << U"Polygon {} vertices: triangulate {:.2f} ms / {} triangles ({} KiB of indices) / draw {:.3f} ms"_fmt(
+			n, triangulateMs, polygon.num_triangles(), indexBytes / 1024, drawMs);
+	}
+}
+
+TEST_CASE("Polygon.BatchedBoolean")
+{
+	// 少しずつずらして並べた四角形の和集合は 1 つの長方形になる
+	{
+		Array<Polygon> squares;
+
+		for (int32 i = 0; i < 100; ++i)
+		{
+			squares << RectF(i * 10, 0, 20, 20).asPolygon();
+		}
+
+		const Array<Polygon> result = Geometry2D::Or(squares);
+
+		REQUIRE(result.size() == 1);
+		REQUIRE(result[0].area() == Approx(1010.0 * 20.0));
+		REQUIRE(Geometry2D::Or(Array<Polygon>()).isEmpty());
+	}
+
+	const Array<Polygon> blobs = TestPolygon::MakeBlobs(200);
+	const Array<Polygon> holes = TestPolygon::MakeBlobs(20).map([](const Polygon& p) { return p.scaled(0.5); });
+	const MultiPolygon united(Geometry2D::Or(blobs));
+	const MultiPolygon subtracted(Geometry2D::Subtract(blobs, holes));
+
+	// 和集合の面積は、元の多角形の面積の合計を超えない
+	REQUIRE(TestPolygon::SumArea(united) <= TestPolygon::SumArea(blobs));
+	REQUIRE(TestPolygon::SumArea(subtracted) < TestPolygon::SumArea(united));
+
+	for (const auto& point : TestPolygon::MakePoints(1000))
+	{
+		const bool inBlobs = TestPolygon::Contains(blobs, point);
+		const bool inHoles = TestPolygon::Contains(holes, point);
+
+		REQUIRE(TestPolygon::Contains(united, point) == inBlobs);
+		REQUIRE(TestPolygon::Contains(subtracted, point) == (inBlobs && !inHoles));
+	}
+
+	// 広げた多角形は、元の多角形を含む
+	const MultiPolygon buffered = united.calculateBuffer(5.0);
+	const MultiPolygon roundBuffered = united.calculateRoundBuffer(5.0);
+
+	REQUIRE(TestPolygon::SumArea(buffered) > TestPolygon::SumArea(united));
+	REQUIRE(TestPolygon::SumArea(roundBuffered) > TestPolygon::SumArea(united));
+
+	for (const auto& point : TestPolygon::MakePoints(1000))
+	{
+		if (TestPolygon::Contains(united, point))
+		{
+			REQUIRE(TestPolygon::Contains(buffered, point));
+			REQUIRE(TestPolygon::Contains(roundBuffered, point));
+		}
+	}
+}
+
+TEST_CASE("Polygon.IncrementalMultiPolygon")
+{
+	Array<Polygon> blobs = TestPolygon::MakeBlobs(200);
+	const Array<Polygon> holes = TestPolygon::MakeBlobs(20).map([](const Polygon& p) { return p.scaled(0.5); });
+
+	IncrementalMultiPolygon incremental(100.0);
+	Array<uint32> ids;
+
+	for (const auto& blob : blobs)
+	{
+		ids << incremental.add(blob);
+	}
+
+	for (const auto& hole : holes)
+	{
+		REQUIRE(incremental.subtract(hole) != 0);
+	}
+
+	REQUIRE(incremental.add(Polygon()) == 0);
+	REQUIRE(incremental.hasChanges());
+	REQUIRE(incremental.update() == incremental.num_tiles());
+	REQUIRE(!incremental.hasChanges());
+	REQUIRE(incremental.update() == 0);
+
+	// 1 つを動かし、1 つを取り除く
+	blobs[0] = blobs[0].movedBy(30, 30);
+	REQUIRE(incremental.replace(ids[0], blobs[0]));
+	REQUIRE(incremental.remove(ids[1]));
+	REQUIRE(!incremental.remove(ids[1]));
+	blobs.remove_at(1);
+
+	const size_t numUpdated = incremental.update();
+	REQUIRE(0 < numUpdated);
+	REQUIRE(numUpdated < incremental.num_tiles());
+
+	// タイルに分かれていること以外は、まとめて計算した結果と一致する
+	const MultiPolygon& result = incremental.getMultiPolygon();
+	const Array<Polygon> batched = Geometry2D::Subtract(blobs, holes);
+
+	REQUIRE(TestPolygon::SumArea(result) == Approx(TestPolygon::SumArea(batched)).epsilon(1e-6));
+
+	for (const auto& point : TestPolygon::MakePoints(1000))
+	{
+		const bool expected = TestPolygon::Contains(batched, point);
+
+		REQUIRE(TestPolygon::Contains(result, point) == expected);
+	}
+
+	incremental.clear();
+	REQUIRE(incremental.num_tiles() == 0);
+	REQUIRE(incremental.getMultiPolygon().isEmpty());
+}
+
+TEST_CASE("Polygon.BatchedBoolean.Benchmark", "[.benchmark]")
+{
+	for (const size_t n : { 100, 1000, 5000 })
+	{
+		const Array<Polygon> blobs = TestPolygon::MakeBlobs(n);
+
+		// 1 つずつ順番に、重なっているものと合わせる
+		Stopwatch stopwatch(true);
+
+		Array<Polygon> sequential;
+
+		for (const auto& blob : blobs)
+		{
+			Polygon merged = blob;
+			Array<Polygon> rest;
+
+			for (const auto& polygon : sequential)
+			{
+				if (Array<Polygon> result = Geometry2D::Or(merged, polygon); result.size() == 1)
+				{
+					merged = std::move(result[0]);
+				}
+				else
+				{
+					rest << polygon;
+				}
+			}
+
+			rest << merged;
+			sequential = std::move(rest);
+		}
+
+		const double sequentialMs = stopwatch.msF();
+
+		stopwatch.restart();
+
+		const Array<Polygon> united = Geometry2D::Or(blobs);
+
+		const double batchedMs = stopwatch.msF();
+
+		stopwatch.restart();
+
+		const MultiPolygon buffered = MultiPolygon(united).calculateBuffer(2.0);
+
+		const double bufferMs = stopwatch.msF();
+
+		IncrementalMultiPolygon incremental;
+
+		for (const auto& blob : blobs)
+		{
+			incremental.add(blob);
+		}
+
+		stopwatch.restart();
+
+		incremental.update();
+
+		const double fullUpdateMs = stopwatch.msF();
+
+		incremental.replace(1, blobs[0].movedBy(10, 10));
+
+		stopwatch.restart();
+
+		const size_t numUpdated = incremental.update();
+
+		const double incrementalMs = stopwatch.msF();
+
+		Console << U"Or {} polygons: sequential {:.1f} ms / batched {:.1f} ms / buffer {:.1f} ms / incremental {:.1f} ms -> {:.2f} ms ({}/{} tiles)"_fmt(
+			n, sequentialMs, batchedMs, bufferMs, fullUpdateMs, incrementalMs, numUpdated, incremental.num_tiles());
+	}
+}
+
+# endif
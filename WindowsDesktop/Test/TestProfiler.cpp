@@ -0,0 +1,159 @@
+﻿
+# include "Test.hpp"
+
+# if defined(SIV3D_DO_TEST)
+
+# define SIV3D_CONCURRENT
+# include <Siv3D.hpp>
+# include <ThirdParty/Catch2/catch.hpp>
+
+namespace TestProfiler
+{
+	static void Inner(int32& n)
+	{
+		SIV3D_PROFILE_ZONE(U"Inner");
+
+		++n;
+	}
+
+	static void Outer(int32& n)
+	{
+		SIV3D_PROFILE_ZONE(U"Outer");
+
+		Inner(n);
+		Inner(n);
+	}
+
+	[[nodiscard]] static size_t Count(const ProfilerCapture& capture, const StringView name)
+	{
+		return capture.events.count_if([=](const ProfilerEvent& event) { return (event.zone->name == name); });
+	}
+}
+
+TEST_CASE("FrameProfiler")
+{
+	int32 n = 0;
+
+	SECTION("Idle")
+	{
+		// 計測中でなければ何も記録しない
+		TestProfiler::Outer(n);
+
+		REQUIRE(n == 2);
+		REQUIRE_FALSE(Profiler::IsCapturing());
+	}
+
+	SECTION("Capture")
+	{
+		Profiler::BeginCapture(2);
+
+		REQUIRE(Profiler::IsCapturing());
+		REQUIRE(System::Update());
+
+		for (size_t frame = 0; frame < 2; ++frame)
+		{
+			TestProfiler::Outer(n);
+
+			std::async(std::launch::async, [&]() { int32 m = 0; TestProfiler::Outer(m); }).get();
+
+			REQUIRE(System::Update());
+		}
+
+		REQUIRE_FALSE(Profiler::IsCapturing());
+
+		const ProfilerCapture& capture = Profiler::GetCapture();
+
+		REQUIRE(capture.frameBeginNanosec.size() == 2);
+		REQUIRE(capture.num_dropped == 0);
+		REQUIRE(TestProfiler::Count(capture, U"Outer") == 4);
+		REQUIRE(TestProfiler::Count(capture, U"Inner") == 8);
+		REQUIRE(TestProfiler::Count(capture, U"System::Update") == 2);
+
+		for (const auto& event : capture.events)
+		{
+			REQUIRE(event.beginNanosec <= event.endNanosec);
+
+			if (event.zone->name == StringView(U"Inner"))
+			{
+				// 外側の Outer に含まれる
+				REQUIRE(capture.events.any([&](const ProfilerEvent& outer)
+				{
+					return (outer.zone->name == StringView(U"Outer"))
+						&& (outer.threadIndex == event.threadIndex)
+						&& (outer.depth + 1 == event.depth)
+						&& (outer.beginNanosec <= event.beginNanosec)
+						&& (event.endNanosec <= outer.endNanosec);
+				}));
+			}
+		}
+
+		// メインスレッドとワーカースレッドで記録されている
+		REQUIRE(capture.events.any([](const ProfilerEvent& event) { return (event.threadIndex == 0); }));
+		REQUIRE(capture.events.any([](const ProfilerEvent& event) { return (event.threadIndex != 0); }));
+
+		const FilePath path = FileSystem::UniqueFilePath();
+
+		REQUIRE(capture.saveChromeTrace(path));
+		{
+			const JSONReader json(path);
+
+			REQUIRE(json);
+			REQUIRE(json[U"traceEvents"].isArray());
+			REQUIRE(json[U"traceEvents"].arrayCount() > capture.events.size());
+		}
+		FileSystem::Remove(path);
+	}
+}
+
+TEST_CASE("FrameProfiler.Benchmark", "[.benchmark]")
+{
+	constexpr size_t NumScopes = 1'000'000;
+	int32 n = 0;
+
+	// 計測中でないとき
+	{
+		const MicrosecClock clock;
+
+		for (size_t i = 0; i < (NumScopes / 3); ++i)
+		{
+			TestProfiler::Outer(n);
+		}
+
+		Console << U"idle: {:.2f} ns/scope"_fmt(clock.us() * 1000.0 / NumScopes);
+	}
+
+	// 計測中（1 フレームあたり 10,000 区間）
+	{
+		Profiler::BeginCapture(10);
+
+		double totalMicrosec = 0.0;
+
+		while (Profiler::IsCapturing())
+		{
+			const MicrosecClock clock;
+
+			for (size_t i = 0; i < 3'333; ++i)
+			{
+				TestProfiler::Outer(n);
+			}
+
+			totalMicrosec += clock.us();
+
+			if (!System::Update())
+			{
+				return;
+			}
+		}
+
+		const ProfilerCapture& capture = Profiler::GetCapture();
+
+		Console << U"capturing: {:.2f} ns/scope ({} events, {} dropped)"_fmt(totalMicrosec * 1000.0 / (3'333 * 3 * 10), capture.events.size(), capture.num_dropped);
+
+		const MicrosecClock clock;
+		const String trace = capture.toChromeTrace();
+
+		Console << U"Chrome trace: {:.1f} MiB in {:.1f} ms"_fmt(trace.size() * sizeof(char32) / 1048576.0, clock.us() / 1000.0);
+	}
+}
+
+# endif
@@ -0,0 +1,334 @@
+﻿
+# include "Test.hpp"
+
+# if defined(SIV3D_DO_TEST)
+
+# define SIV3D_CONCURRENT
+# include <Siv3D.hpp>
+# include <ThirdParty/Catch2/catch.hpp>
+
+# if SIV3D_PLATFORM(WINDOWS)
+#	include <Renderer2D/D3D11/D3D11Renderer2DCommand.hpp>
+# else
+#	include <Renderer2D/GL/GLRenderer2DCommand.hpp>
+# endif
+
+namespace TestRenderer2DCommand
+{
+# if SIV3D_PLATFORM(WINDOWS)
+	using Renderer2DCommand = D3D11Renderer2DCommand;
+# else
+	using Renderer2DCommand = GLRenderer2DCommand;
+# endif
+
+	static String ToString(const RendererCommand command)
+	{
+		switch (command)
+		{
+		case RendererCommand::Draw:
+			return U"Draw";
+		case RendererCommand::DrawLarge:
+			return U"DrawLarge";
+		case RendererCommand::UpdateBuffers:
+			return U"UpdateBuffers";
+		case RendererCommand::SetCB:
+			return U"SetCB";
+		case RendererCommand::ColorMul:
+			return U"ColorMul";
+		case RendererCommand::BlendState:
+			return U"BlendState";
+		default:
+			return U"State{}"_fmt(FromEnum(command));
+		}
+	}
+
+	// 最初の Draw 以降のコマンド列（reset() が記録する初期ステートを除く）
+	static String FromFirstDraw(const Renderer2DCommand& commands)
+	{
+		Array<String> result;
+
+		for (const auto& [command, index] : commands.getList())
+		{
+			if ((command == RendererCommand::Draw) || result)
+			{
+				result << ToString(command);
+			}
+		}
+
+		return result.join(U" ", U"", U"");
+	}
+
+	static size_t CountCommands(const Renderer2DCommand& commands, const RendererCommand type)
+	{
+		return commands.getList().count_if([=](const auto& command) { return (command.first == type); });
+	}
+
+	static uint32 LastIndex(const Renderer2DCommand& commands, const RendererCommand type)
+	{
+		for (auto it = commands.getList().rbegin(); it != commands.getList().rend(); ++it)
+		{
+			if (it->first == type)
+			{
+				return it->second;
+			}
+		}
+
+		return Largest<uint32>;
+	}
+
+	// 実行したときに、同じステートで連続して描かれるインデックスの範囲
+	struct DrawnRange
+	{
+		Float4 colorMul = Float4(1.0f, 1.0f, 1.0f, 1.0f);
+
+		Float4 colorAdd = Float4(0.0f, 0.0f, 0.0f, 0.0f);
+
+		BlendState blendState = BlendState::Default;
+
+		Rect scissorRect = Rect(0);
+
+		uint32 batchIndex = 0;
+
+		uint32 indexCount = 0;
+
+		[[nodiscard]] bool hasSameState(const DrawnRange& other) const
+		{
+			return (colorMul == other.colorMul)
+				&& (colorAdd == other.colorAdd)
+				&& (blendState == other.blendState)
+				&& (scissorRect == other.scissorRect)
+				&& (batchIndex == other.batchIndex);
+		}
+
+		[[nodiscard]] bool operator ==(const DrawnRange& other) const
+		{
+			return hasSameState(other) && (indexCount == other.indexCount);
+		}
+	};
+
+	// コマンド列を先頭から実行して、何がどのステートで描かれるかを返す
+	static Array<DrawnRange> Replay(Renderer2DCommand& commands)
+	{
+		Array<DrawnRange> result;
+		DrawnRange current;
+
+		for (const auto& [command, index] : commands.getList())
+		{
+			switch (command)
+			{
+			case RendererCommand::ColorMul:
+				current.colorMul = commands.getColorMul(index);
+				break;
+			case RendererCommand::ColorAdd:
+				current.colorAdd = commands.getColorAdd(index);
+				break;
+			case RendererCommand::BlendState:
+				current.blendState = commands.getBlendState(index);
+				break;
+			case RendererCommand::ScissorRect:
+				current.scissorRect = commands.getScissorRect(index);
+				break;
+			case RendererCommand::UpdateBuffers:
+				current.batchIndex = index;
+				break;
+			case RendererCommand::Draw:
+				{
+					const uint32 indexCount = commands.getDraw(index).indexCount;
+
+					if (indexCount == 0)
+					{
+						break;
+					}
+
+					if (result && result.back().hasSameState(current))
+					{
+						result.back().indexCount += indexCount;
+					}
+					else
+					{
+						current.indexCount = indexCount;
+						result << current;
+					}
+
+					break;
+				}
+			default:
+				break;
+			}
+		}
+
+		return result;
+	}
+}
+
+TEST_CASE("Renderer2DCommand.compact")
+{
+	using namespace TestRenderer2DCommand;
+	using RC = RendererCommand;
+
+	const Float4 red(1.0f, 0.0f, 0.0f, 1.0f), green(0.0f, 1.0f, 0.0f, 1.0f);
+
+	Renderer2DCommand commands;
+
+	SECTION("Adjacent draws are merged")
+	{
+		commands.pushDraw(6);
+		commands.flush();
+		commands.pushDraw(3);
+		commands.flush();
+		REQUIRE(FromFirstDraw(commands) == U"Draw Draw");
+
+		commands.compact();
+		REQUIRE(FromFirstDraw(commands) == U"Draw");
+		REQUIRE(commands.getDraw(LastIndex(commands, RC::Draw)).indexCount == 9);
+
+		// 統計のため、まとめる前の Draw の数は変わらない
+		REQUIRE(commands.num_draws() == 2);
+	}
+
+	SECTION("State changes overwritten before the next draw are dropped")
+	{
+		commands.pushDraw(6);
+		commands.pushColorMul(red);
+		commands.pushDraw(0);
+		commands.pushColorMul(green);
+		commands.pushDraw(6);
+		commands.flush();
+		REQUIRE(FromFirstDraw(commands) == U"Draw ColorMul ColorMul Draw");
+
+		commands.compact();
+		REQUIRE(FromFirstDraw(commands) == U"Draw ColorMul Draw");
+		REQUIRE(commands.getColorMul(LastIndex(commands, RC::ColorMul)) == green);
+	}
+
+	SECTION("State changes back to the applied state are dropped")
+	{
+		commands.pushDraw(6);
+		commands.pushBlendState(BlendState::Additive);
+		commands.pushDraw(0);
+		commands.pushBlendState(BlendState::Default);
+		commands.pushDraw(6);
+		commands.flush();
+		REQUIRE(FromFirstDraw(commands) == U"Draw BlendState BlendState Draw");
+
+		commands.compact();
+		REQUIRE(FromFirstDraw(commands) == U"Draw");
+		REQUIRE(commands.getDraw(LastIndex(commands, RC::Draw)).indexCount == 12);
+
+		// 初期ステートは最初の Draw の前に 1 回だけ適用される
+		REQUIRE(CountCommands(commands, RC::BlendState) == 1);
+	}
+
+	SECTION("Buffer updates separate draws")
+	{
+		commands.pushDraw(6);
+		commands.pushUpdateBuffers(1);
+		commands.pushDraw(6);
+		commands.flush();
+
+		commands.compact();
+		REQUIRE(FromFirstDraw(commands) == U"Draw UpdateBuffers Draw");
+	}
+
+	SECTION("SetCB is a barrier")
+	{
+		const float constants[4] = { 1.0f, 2.0f, 3.0f, 4.0f };
+
+		commands.pushDraw(6);
+		commands.pushColorMul(red);
+		commands.pushCB(ShaderStage::Pixel, 1, detail::ConstantBufferBase{}, constants, 1);
+		commands.pushDraw(6);
+		commands.pushCB(ShaderStage::Pixel, 1, detail::ConstantBufferBase{}, constants, 1);
+		commands.pushDraw(6);
+		commands.flush();
+		REQUIRE(FromFirstDraw(commands) == U"Draw ColorMul SetCB Draw SetCB Draw");
+
+		// 保留中のステート変更は SetCB の前に適用され、SetCB をはさむ Draw はまとめられない
+		commands.compact();
+		REQUIRE(FromFirstDraw(commands) == U"Draw ColorMul SetCB Draw SetCB Draw");
+	}
+
+	SECTION("DrawLarge is a barrier")
+	{
+		commands.pushDraw(6);
+		commands.pushColorMul(red);
+		commands.pushDrawLarge(0);
+		commands.pushDraw(6);
+		commands.flush();
+		REQUIRE(FromFirstDraw(commands) == U"Draw ColorMul DrawLarge Draw");
+
+		// DrawLarge は保留中のステートで描かれる必要がある
+		commands.compact();
+		REQUIRE(FromFirstDraw(commands) == U"Draw ColorMul DrawLarge Draw");
+		REQUIRE(commands.num_draws() == 3);
+	}
+
+	SECTION("Many small draws with a repeated state")
+	{
+		for (int32 i = 0; i < 100; ++i)
+		{
+			commands.pushColorMul((i % 2) ? red : green);
+			commands.pushDraw(0);
+			commands.pushColorMul(green);
+			commands.pushDraw(6);
+		}
+		commands.flush();
+
+		commands.compact();
+		REQUIRE(CountCommands(commands, RC::Draw) == 1);
+		REQUIRE(commands.getDraw(LastIndex(commands, RC::Draw)).indexCount == 600);
+	}
+
+	SECTION("Compaction does not change what is drawn")
+	{
+		const Float4 colors[3] = { red, green, Float4(0.5f, 0.5f, 0.5f, 1.0f) };
+		const BlendState blendStates[3] = { BlendState::Default, BlendState::Additive, BlendState::Subtractive };
+		const Rect scissorRects[2] = { Rect(0, 0, 640, 480), Rect(10, 10, 100, 100) };
+		uint32 batchIndex = 0;
+
+		// 種類の異なるステート変更、途中で上書きされるステート変更、空の Draw、バッファの更新を混ぜる
+		for (uint32 i = 0; i < 2000; ++i)
+		{
+			const uint32 r = ((i * 2654435761u) >> 16);
+
+			switch (r % 8)
+			{
+			case 0:
+				commands.pushColorMul(colors[(r >> 3) % 3]);
+				break;
+			case 1:
+				commands.pushColorAdd(colors[(r >> 3) % 3]);
+				break;
+			case 2:
+				commands.pushBlendState(blendStates[(r >> 3) % 3]);
+				break;
+			case 3:
+				commands.pushScissorRect(scissorRects[(r >> 3) % 2]);
+				break;
+			case 4:
+				commands.pushDraw(0);
+				break;
+			case 5:
+				if (((r >> 3) % 4) == 0)
+				{
+					commands.pushUpdateBuffers(++batchIndex);
+				}
+				break;
+			default:
+				commands.pushDraw(static_cast<uint16>(3 * (1 + (r >> 3) % 4)));
+				break;
+			}
+		}
+		commands.flush();
+
+		const size_t numCommands = commands.getList().size();
+		const Array<DrawnRange> expected = Replay(commands);
+		REQUIRE(expected.size() > 100);
+
+		commands.compact();
+		REQUIRE(commands.getList().size() < numCommands);
+		REQUIRE((Replay(commands) == expected));
+	}
+}
+
+# endif
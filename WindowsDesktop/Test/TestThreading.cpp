@@ -0,0 +1,148 @@
+﻿
+# include "Test.hpp"
+
+# if defined(SIV3D_DO_TEST)
+
+# define SIV3D_CONCURRENT
+# include <Siv3D.hpp>
+# include <ThirdParty/Catch2/catch.hpp>
+
+namespace TestThreading
+{
+	// 以前の Array::parallel_each と同じ、チャンクごとに std::async でスレッドを起動する実装
+	template <class Fty>
+	static void AsyncFor(const size_t first, const size_t last, Fty f)
+	{
+		if (last <= first)
+		{
+			return;
+		}
+
+		const size_t numThreads = Threading::GetConcurrency();
+		const size_t count = (last - first);
+		const size_t countPerthread = Max<size_t>(1, (count + (numThreads - 1)) / numThreads);
+
+		Array<std::future<void>> futures;
+
+		size_t it = first;
+		size_t countLeft = count;
+
+		for (size_t i = 0; i < (numThreads - 1); ++i)
+		{
+			const size_t n = Min(countPerthread, countLeft);
+
+			if (n == 0)
+			{
+				break;
+			}
+
+			futures.emplace_back(std::async(std::launch::async, [=, &f]()
+			{
+				for (size_t k = it; k < (it + n); ++k)
+				{
+					f(k);
+				}
+			}));
+
+			it += n;
+			countLeft -= n;
+		}
+
+		for (size_t k = it; k < (it + countLeft); ++k)
+		{
+			f(k);
+		}
+
+		for (auto& future : futures)
+		{
+			future.get();
+		}
+	}
+}
+
+TEST_CASE("Threading")
+{
+	{
+		REQUIRE(Threading::GetConcurrency() >= 1);
+		REQUIRE(Threading::GetWorkerCount() == (Threading::GetConcurrency() - 1));
+	}
+
+	{
+		Array<int32> v(100'000, 0);
+		Threading::ParallelFor(0, v.size(), [&](size_t i) { v[i] = static_cast<int32>(i); });
+		REQUIRE(v == Range(0, 99'999).asArray());
+	}
+
+	{
+		std::atomic<size_t> count = 0;
+		Threading::ParallelFor(10, 10, [&](size_t) { ++count; });
+		Threading::ParallelFor(20, 10, [&](size_t) { ++count; });
+		REQUIRE(count == 0);
+	}
+
+	{
+		for (const size_t grainSize : { 1, 7, 1000, 1'000'000 })
+		{
+			std::atomic<size_t> sum = 0;
+			Threading::ParallelFor(0, 10'000, [&](size_t i) { sum += i; }, grainSize);
+			REQUIRE(sum == 49'995'000);
+		}
+	}
+
+	{
+		std::atomic<size_t> sum = 0;
+		Threading::ParallelFor(0, 100, [&](size_t i)
+		{
+			Threading::ParallelFor(0, 1000, [&](size_t k) { sum += (i * k); });
+		});
+		REQUIRE(sum == (size_t(4'950) * 499'500));
+	}
+
+	{
+		REQUIRE_THROWS_AS(Threading::ParallelFor(0, 1000, [](size_t i) { if (i == 500) { throw std::runtime_error("error"); } }), std::runtime_error);
+	}
+}
+
+TEST_CASE("Threading.ParallelFor.Benchmark", "[.benchmark]")
+{
+	Console << U"Concurrency: {}"_fmt(Threading::GetConcurrency());
+
+	Array<float> values(4'000'000);
+	std::iota(values.begin(), values.end(), 0.0f);
+
+	const std::function<void(size_t)> light = [&](size_t i) { values[i] = values[i] * 0.5f + 1.0f; };
+	const std::function<void(size_t)> heavy = [&](size_t i) { values[i] = std::sqrt(std::sin(values[i]) * std::cos(values[i]) + 2.0f); };
+
+	const std::pair<String, std::function<void(size_t, size_t, const std::function<void(size_t)>&)>> implementations[] =
+	{
+		{ U"std::async", [](size_t first, size_t last, const std::function<void(size_t)>& f) { TestThreading::AsyncFor(first, last, f); } },
+		{ U"ParallelFor", [](size_t first, size_t last, const std::function<void(size_t)>& f) { Threading::ParallelFor(first, last, f); } },
+	};
+
+	// 1 回の呼び出しで処理する要素数を変えて、起動のオーバーヘッドが占める割合を比べる
+	for (const size_t count : { 1'000, 100'000, 4'000'000 })
+	{
+		const size_t iterations = (40'000'000 / count);
+
+		for (const auto& [workName, work] : { std::pair(U"light"_s, light), std::pair(U"heavy"_s, heavy) })
+		{
+			for (const auto& [name, implementation] : implementations)
+			{
+				implementation(0, count, work);
+
+				const Stopwatch stopwatch(true);
+
+				for (size_t i = 0; i < iterations; ++i)
+				{
+					implementation(0, count, work);
+				}
+
+				const double elements = (count * iterations / 1'000'000.0);
+
+				Console << U"{} {} {}x{}: {:.1f} M elements/s"_fmt(name, workName, count, iterations, elements / stopwatch.sF());
+			}
+		}
+	}
+}
+
+# endif
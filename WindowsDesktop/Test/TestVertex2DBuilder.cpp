@@ -0,0 +1,449 @@
+﻿
+# include "Test.hpp"
+
+# if defined(SIV3D_DO_TEST)
+
+# define SIV3D_CONCURRENT
+# include <Siv3D.hpp>
+# include <ThirdParty/Catch2/catch.hpp>
+# include <Renderer2D/Vertex2DBuilder.hpp>
+
+namespace TestVertex2DBuilder
+{
+	// スプライトバッチの代わりに、CPU 上の配列に頂点・インデックスを書き込むバッファ
+	class CPUBuffer
+	{
+	public:
+
+		static constexpr uint32 VertexCapacity = 65'535;
+
+		static constexpr uint32 IndexCapacity = (VertexCapacity * 3);
+
+		// inlinePath が false の場合は、置き換える前と同じく毎回 std::function を呼んでバッファを確保する
+		explicit CPUBuffer(const bool inlinePath)
+			: m_vertices(VertexCapacity)
+			, m_indices(IndexCapacity)
+			, m_inlinePath(inlinePath)
+		{
+			m_legacyGetBuffer = [this](const IndexType vertexSize, const IndexType indexSize)
+			{
+				return allocate(vertexSize, indexSize);
+			};
+
+			restart();
+		}
+
+		CPUBuffer(const CPUBuffer&) = delete;
+
+		CPUBuffer& operator =(const CPUBuffer&) = delete;
+
+		[[nodiscard]] BufferCreator getCreator() noexcept
+		{
+			return BufferCreator(m_state, this, &GetBuffer);
+		}
+
+		// これまでに書き込まれた頂点の総数
+		[[nodiscard]] size_t num_vertices() const noexcept
+		{
+			return (m_numVerticesWritten + m_state.batchVertexPos);
+		}
+
+		[[nodiscard]] const Array<Vertex2D>& vertices() const noexcept
+		{
+			return m_vertices;
+		}
+
+		[[nodiscard]] const Array<IndexType>& indices() const noexcept
+		{
+			return m_indices;
+		}
+
+	private:
+
+		Array<Vertex2D> m_vertices;
+
+		Array<IndexType> m_indices;
+
+		Vertex2DBufferState m_state;
+
+		std::function<BufferCreator::BufferType(IndexType, IndexType)> m_legacyGetBuffer;
+
+		size_t m_numVerticesWritten = 0;
+
+		bool m_inlinePath = true;
+
+		static BufferCreator::BufferType GetBuffer(void* context, const IndexType vertexSize, const IndexType indexSize)
+		{
+			CPUBuffer* const buffer = static_cast<CPUBuffer*>(context);
+
+			if (buffer->m_inlinePath)
+			{
+				return buffer->allocate(vertexSize, indexSize);
+			}
+
+			return buffer->m_legacyGetBuffer(vertexSize, indexSize);
+		}
+
+		void restart() noexcept
+		{
+			m_state.pVertex			= m_vertices.data();
+			m_state.pIndex			= m_indices.data();
+			m_state.batchVertexPos	= 0;
+			m_state.batchIndexPos	= 0;
+			updateSpace();
+		}
+
+		void updateSpace() noexcept
+		{
+			m_state.vertexSpace	= (m_inlinePath ? (VertexCapacity - m_state.batchVertexPos) : 0);
+			m_state.indexSpace	= (m_inlinePath ? (IndexCapacity - m_state.batchIndexPos) : 0);
+		}
+
+		BufferCreator::BufferType allocate(const IndexType vertexSize, const IndexType indexSize)
+		{
+			// 配列の末尾に達したら、次のバッチとして先頭から書き込む
+			if (((VertexCapacity - m_state.batchVertexPos) < vertexSize)
+				|| ((IndexCapacity - m_state.batchIndexPos) < indexSize))
+			{
+				m_numVerticesWritten += m_state.batchVertexPos;
+				restart();
+			}
+
+			const BufferCreator::BufferType result{ m_state.pVertex, m_state.pIndex, m_state.batchVertexPos };
+
+			m_state.pVertex			+= vertexSize;
+			m_state.pIndex			+= indexSize;
+			m_state.batchVertexPos	+= vertexSize;
+			m_state.batchIndexPos	+= indexSize;
+			updateSpace();
+
+			return result;
+		}
+	};
+
+	// CRenderer2D_*::addRects などと同じく、構築できた個数だけ入力を進めながら残りを構築する
+	// 1 回の呼び出しで構築された個数を返す
+	template <class Builder>
+	static Array<size_t> BuildInChunks(size_t count, Builder builder)
+	{
+		Array<size_t> chunks;
+		size_t offset = 0;
+
+		while (count)
+		{
+			size_t numBuilt = 0;
+
+			builder(offset, count, numBuilt);
+
+			if (numBuilt == 0)
+			{
+				break;
+			}
+
+			chunks << numBuilt;
+			offset += numBuilt;
+			count -= numBuilt;
+		}
+
+		return chunks;
+	}
+
+	[[nodiscard]] static bool HasSameOutput(const CPUBuffer& a, const CPUBuffer& b)
+	{
+		return (a.num_vertices() == b.num_vertices())
+			&& (std::memcmp(a.vertices().data(), b.vertices().data(), sizeof(Vertex2D) * a.num_vertices()) == 0)
+			&& (a.indices() == b.indices());
+	}
+
+	template <class Fty>
+	static void Measure(const String& name, Fty f)
+	{
+		constexpr size_t Iterations = 2'000'000;
+
+		for (const bool inlinePath : { false, true })
+		{
+			CPUBuffer buffer(inlinePath);
+			const BufferCreator bufferCreator = buffer.getCreator();
+			uint64 indexCount = 0;
+
+			const Stopwatch stopwatch(true);
+
+			for (size_t i = 0; i < Iterations; ++i)
+			{
+				indexCount += f(bufferCreator, i);
+			}
+
+			const double megaVertices = (buffer.num_vertices() / 1'000'000.0);
+
+			Console << U"{} ({}): {:.1f} M vertices/s ({} indices)"_fmt(name, (inlinePath ? U"inline" : U"std::function"), megaVertices / stopwatch.sF(), indexCount);
+		}
+	}
+}
+
+TEST_CASE("Vertex2DBuilder")
+{
+	using TestVertex2DBuilder::CPUBuffer;
+
+	SECTION("Inline path and callback path write the same data")
+	{
+		CPUBuffer inlineBuffer(true), callbackBuffer(false);
+
+		for (auto* buffer : { &inlineBuffer, &callbackBuffer })
+		{
+			const BufferCreator bufferCreator = buffer->getCreator();
+
+			for (int32 i = 0; i < 100; ++i)
+			{
+				const Float4 color(i * 0.01f, 0.5f, 0.25f, 1.0f);
+				REQUIRE(Vertex2DBuilder::BuildRect(bufferCreator, FloatRect(i, i, i + 10, i + 20), color) == 6);
+				REQUIRE(Vertex2DBuilder::BuildCircle(bufferCreator, Float2(i, 50), 10.0f + i, color, color, 1.0f) > 0);
+			}
+		}
+
+		REQUIRE(inlineBuffer.num_vertices() == callbackBuffer.num_vertices());
+		REQUIRE(std::memcmp(inlineBuffer.vertices().data(), callbackBuffer.vertices().data(), sizeof(Vertex2D) * inlineBuffer.num_vertices()) == 0);
+		REQUIRE((inlineBuffer.indices() == callbackBuffer.indices()));
+	}
+
+	SECTION("Indices are relative to the current batch")
+	{
+		CPUBuffer buffer(true);
+		const BufferCreator bufferCreator = buffer.getCreator();
+		const size_t rectsPerBatch = (CPUBuffer::VertexCapacity / 4);
+
+		size_t indexCount = 0;
+
+		for (size_t i = 0; i <= rectsPerBatch; ++i)
+		{
+			indexCount += Vertex2DBuilder::BuildRect(bufferCreator, FloatRect(0, 0, 10, 10), Float4(1, 1, 1, 1));
+		}
+
+		REQUIRE(indexCount == ((rectsPerBatch + 1) * 6));
+
+		// 最後の四角形は新しいバッチの先頭に書き込まれる
+		REQUIRE(buffer.num_vertices() == ((rectsPerBatch + 1) * 4));
+		REQUIRE(buffer.indices()[0] == 0);
+		REQUIRE(buffer.indices()[5] == 3);
+	}
+}
+
+TEST_CASE("Vertex2DBuilder.Bulk")
+{
+	using namespace TestVertex2DBuilder;
+
+	SECTION("BuildRects")
+	{
+		const Array<RectF> rects = { RectF(10, 20, 30, 40), RectF(-5, 0, 1, 2), RectF(100, 100, 0, 0) };
+		const Array<ColorF> colors = { ColorF(1.0, 0.0, 0.0), ColorF(0.0, 1.0, 0.0), ColorF(0.0, 0.0, 1.0) };
+
+		CPUBuffer buffer(true);
+		size_t numBuilt = 0;
+
+		REQUIRE(Vertex2DBuilder::BuildRects(buffer.getCreator(), rects.data(), rects.size(), colors.data(), 1, numBuilt) == 18);
+		REQUIRE(numBuilt == 3);
+		REQUIRE(buffer.num_vertices() == 12);
+
+		for (size_t i = 0; i < rects.size(); ++i)
+		{
+			const Vertex2D* v = &buffer.vertices()[i * 4];
+
+			REQUIRE(v[0].pos == Float2(rects[i].tl()));
+			REQUIRE(v[1].pos == Float2(rects[i].tr()));
+			REQUIRE(v[2].pos == Float2(rects[i].bl()));
+			REQUIRE(v[3].pos == Float2(rects[i].br()));
+
+			for (size_t k = 0; k < 4; ++k)
+			{
+				REQUIRE(v[k].color == colors[i].toFloat4());
+			}
+		}
+
+		const Array<IndexType> expectedIndices = { 0, 1, 2, 2, 1, 3, 4, 5, 6, 6, 5, 7, 8, 9, 10, 10, 9, 11 };
+		REQUIRE(std::equal(expectedIndices.begin(), expectedIndices.end(), buffer.indices().begin()));
+
+		// colorStride が 0 の場合は、すべての四角形が colors[0] になる
+		CPUBuffer singleColorBuffer(true);
+
+		REQUIRE(Vertex2DBuilder::BuildRects(singleColorBuffer.getCreator(), rects.data(), rects.size(), colors.data(), 0, numBuilt) == 18);
+
+		for (size_t i = 0; i < 12; ++i)
+		{
+			REQUIRE(singleColorBuffer.vertices()[i].color == colors[0].toFloat4());
+		}
+	}
+
+	SECTION("BuildCircles")
+	{
+		const Array<Circle> circles = { Circle(10, 20, 3), Circle(-50, 0, 30), Circle(100, 100, 300) };
+		const Array<ColorF> colors = { ColorF(1.0, 0.0, 0.0), ColorF(0.0, 1.0, 0.0), ColorF(0.0, 0.0, 1.0) };
+
+		for (const size_t colorStride : { 0, 1 })
+		{
+			// 1 つずつ BuildCircle で構築した場合と同じ頂点・インデックスになる
+			CPUBuffer buffer(true), reference(true);
+			size_t numBuilt = 0, indexCount = 0;
+
+			for (size_t i = 0; i < circles.size(); ++i)
+			{
+				const Float4 color = colors[i * colorStride].toFloat4();
+				indexCount += Vertex2DBuilder::BuildCircle(reference.getCreator(), Float2(circles[i].center), static_cast<float>(circles[i].r), color, color, 2.0f);
+			}
+
+			REQUIRE(Vertex2DBuilder::BuildCircles(buffer.getCreator(), circles.data(), circles.size(), colors.data(), colorStride, 2.0f, numBuilt) == indexCount);
+			REQUIRE(numBuilt == 3);
+			REQUIRE(buffer.num_vertices() == (indexCount / 3 + circles.size()));
+			REQUIRE(HasSameOutput(buffer, reference));
+		}
+	}
+
+	SECTION("BuildTextureRegions")
+	{
+		const Array<RectF> rects = { RectF(10, 20, 30, 40), RectF(-5, 0, 1, 2) };
+		const Array<RectF> uvs = { RectF(0.0, 0.0, 0.5, 0.25), RectF(0.5, 0.25, 0.5, 0.75) };
+		const Array<ColorF> colors = { ColorF(1.0, 0.5, 0.0), ColorF(0.0, 0.5, 1.0) };
+
+		CPUBuffer buffer(true);
+		size_t numBuilt = 0;
+
+		REQUIRE(Vertex2DBuilder::BuildTextureRegions(buffer.getCreator(), rects.data(), uvs.data(), rects.size(), colors.data(), 1, numBuilt) == 12);
+		REQUIRE(numBuilt == 2);
+		REQUIRE(buffer.num_vertices() == 8);
+
+		for (size_t i = 0; i < rects.size(); ++i)
+		{
+			const Vertex2D* v = &buffer.vertices()[i * 4];
+
+			REQUIRE(v[0].pos == Float2(rects[i].tl()));
+			REQUIRE(v[3].pos == Float2(rects[i].br()));
+			REQUIRE(v[0].tex == Float2(uvs[i].tl()));
+			REQUIRE(v[1].tex == Float2(uvs[i].tr()));
+			REQUIRE(v[2].tex == Float2(uvs[i].bl()));
+			REQUIRE(v[3].tex == Float2(uvs[i].br()));
+			REQUIRE(v[2].color == colors[i].toFloat4());
+		}
+	}
+
+	SECTION("Input larger than one buffer request")
+	{
+		constexpr size_t N = 10'000;
+		Array<RectF> rects(N), uvs(N);
+		Array<Circle> circles(N / 10);
+		Array<ColorF> colors(N);
+
+		for (size_t i = 0; i < N; ++i)
+		{
+			rects[i].set(static_cast<double>(i % 100), static_cast<double>(i / 100), 8, 4);
+			uvs[i].set((i % 16) / 16.0, (i % 8) / 8.0, 0.0625, 0.125);
+			colors[i] = ColorF((i % 256) / 255.0, 0.5, 1.0);
+		}
+
+		for (size_t i = 0; i < circles.size(); ++i)
+		{
+			circles[i].set(static_cast<double>(i), 0.0, 2.0 + (i % 60));
+		}
+
+		for (const size_t colorStride : { 0, 1 })
+		{
+			{
+				CPUBuffer buffer(true), reference(true);
+
+				const Array<size_t> chunks = BuildInChunks(N, [&](const size_t offset, const size_t count, size_t& numBuilt)
+				{
+					return Vertex2DBuilder::BuildRects(buffer.getCreator(), rects.data() + offset, count, colors.data() + offset * colorStride, colorStride, numBuilt);
+				});
+
+				for (size_t i = 0; i < N; ++i)
+				{
+					const RectF& r = rects[i];
+					REQUIRE(Vertex2DBuilder::BuildRect(reference.getCreator(), FloatRect(r.x, r.y, r.x + r.w, r.y + r.h), colors[i * colorStride].toFloat4()) == 6);
+				}
+
+				REQUIRE(chunks.size() > 1);
+				REQUIRE(chunks.front() < N);
+				REQUIRE(chunks.sum() == N);
+				REQUIRE(HasSameOutput(buffer, reference));
+			}
+
+			{
+				CPUBuffer buffer(true), reference(true);
+
+				const Array<size_t> chunks = BuildInChunks(N, [&](const size_t offset, const size_t count, size_t& numBuilt)
+				{
+					return Vertex2DBuilder::BuildTextureRegions(buffer.getCreator(), rects.data() + offset, uvs.data() + offset, count, colors.data() + offset * colorStride, colorStride, numBuilt);
+				});
+
+				for (size_t i = 0; i < N; ++i)
+				{
+					const RectF& r = rects[i];
+					const RectF& uv = uvs[i];
+					REQUIRE(Vertex2DBuilder::BuildTextureRegion(reference.getCreator(), FloatRect(r.x, r.y, r.x + r.w, r.y + r.h),
+						FloatRect(uv.x, uv.y, uv.x + uv.w, uv.y + uv.h), colors[i * colorStride].toFloat4()) == 6);
+				}
+
+				REQUIRE(chunks.size() > 1);
+				REQUIRE(chunks.sum() == N);
+				REQUIRE(HasSameOutput(buffer, reference));
+			}
+
+			{
+				CPUBuffer buffer(true), reference(true);
+
+				const Array<size_t> chunks = BuildInChunks(circles.size(), [&](const size_t offset, const size_t count, size_t& numBuilt)
+				{
+					return Vertex2DBuilder::BuildCircles(buffer.getCreator(), circles.data() + offset, count, colors.data() + offset * colorStride, colorStride, 1.0f, numBuilt);
+				});
+
+				for (size_t i = 0; i < circles.size(); ++i)
+				{
+					const Float4 color = colors[i * colorStride].toFloat4();
+					REQUIRE(Vertex2DBuilder::BuildCircle(reference.getCreator(), Float2(circles[i].center), static_cast<float>(circles[i].r), color, color, 1.0f) > 0);
+				}
+
+				// どちらも 1 つのバッチに収まり、インデックスの基準がそろっている
+				REQUIRE(reference.num_vertices() < CPUBuffer::VertexCapacity);
+				REQUIRE(chunks.size() > 1);
+				REQUIRE(chunks.sum() == circles.size());
+				REQUIRE(HasSameOutput(buffer, reference));
+			}
+		}
+	}
+}
+
+TEST_CASE("Vertex2DBuilder.Benchmark", "[.benchmark]")
+{
+	const Float4 color(1.0f, 0.5f, 0.25f, 1.0f);
+	const Float4 colors[2] = { color, color };
+
+	TestVertex2DBuilder::Measure(U"BuildRect", [&](const BufferCreator& bufferCreator, size_t i)
+	{
+		const float x = static_cast<float>(i % 1000);
+		return Vertex2DBuilder::BuildRect(bufferCreator, FloatRect(x, 0.0f, x + 10.0f, 10.0f), color);
+	});
+
+	TestVertex2DBuilder::Measure(U"BuildTriangle", [&](const BufferCreator& bufferCreator, size_t i)
+	{
+		const float x = static_cast<float>(i % 1000);
+		const Float2 pts[3] = { Float2(x, 0.0f), Float2(x + 10.0f, 10.0f), Float2(x, 10.0f) };
+		return Vertex2DBuilder::BuildTriangle(bufferCreator, pts, color);
+	});
+
+	TestVertex2DBuilder::Measure(U"BuildSquareCappedLine", [&](const BufferCreator& bufferCreator, size_t i)
+	{
+		const float x = static_cast<float>(i % 1000);
+		return Vertex2DBuilder::BuildSquareCappedLine(bufferCreator, Float2(x, 0.0f), Float2(x + 40.0f, 30.0f), 2.0f, colors);
+	});
+
+	TestVertex2DBuilder::Measure(U"BuildCircle r=4", [&](const BufferCreator& bufferCreator, size_t i)
+	{
+		const float x = static_cast<float>(i % 1000);
+		return Vertex2DBuilder::BuildCircle(bufferCreator, Float2(x, 0.0f), 4.0f, color, color, 1.0f);
+	});
+
+	TestVertex2DBuilder::Measure(U"BuildCircle r=40", [&](const BufferCreator& bufferCreator, size_t i)
+	{
+		const float x = static_cast<float>(i % 1000);
+		return Vertex2DBuilder::BuildCircle(bufferCreator, Float2(x, 0.0f), 40.0f, color, color, 1.0f);
+	});
+}
+
+# endif
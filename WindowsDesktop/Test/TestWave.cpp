@@ -0,0 +1,167 @@
+﻿
+# include "Test.hpp"
+
+# if defined(SIV3D_DO_TEST)
+
+# define SIV3D_CONCURRENT
+# include <Siv3D.hpp>
+# include <ThirdParty/Catch2/catch.hpp>
+
+namespace TestWave
+{
+	// 16 ビットの音声ファイルを読み込んだときと同じ、32768 で割り切れるサンプルの効果音
+	static Wave MakeSoundEffect(const size_t index, const bool stereo, const uint32 samplingRate)
+	{
+		const double sec = 0.1 + 0.9 * ((index * 37) % 100) / 100.0;
+		const double frequency = 220.0 + (index % 24) * 40.0;
+
+		Wave wave(SecondsF(sec), Arg::samplingRate = samplingRate);
+
+		for (size_t i = 0; i < wave.size(); ++i)
+		{
+			const double t = static_cast<double>(i) / samplingRate;
+			const int16 value = static_cast<int16>(std::round(std::sin(t * Math::TwoPi * frequency) * 12000.0 * (1.0 - t / sec)));
+
+			wave[i] = stereo ? WaveSample::FromS16(value, value / 2) : WaveSample::FromS16(value);
+		}
+
+		return wave;
+	}
+}
+
+TEST_CASE("CompactWave")
+{
+	const Wave mono = TestWave::MakeSoundEffect(1, false, 22050);
+	const Wave stereo = TestWave::MakeSoundEffect(2, true, 44100);
+
+	SECTION("Mono S16")
+	{
+		const CompactWave compact(mono);
+
+		REQUIRE(compact.channels() == 1);
+		REQUIRE(compact.format() == WaveSampleFormat::S16);
+		REQUIRE(compact.samplingRate() == 22050);
+		REQUIRE(compact.samples() == mono.size());
+		REQUIRE(compact.size_bytes() == (mono.size_bytes() / 4));
+
+		// 16 ビットのサンプルは誤差なく復元できる
+		const Wave restored = compact.toWave();
+
+		REQUIRE(restored.samplingRate() == mono.samplingRate());
+		REQUIRE(std::equal(restored.begin(), restored.end(), mono.begin(), mono.end(),
+			[](const WaveSample& a, const WaveSample& b) { return (a.left == b.left) && (a.right == b.right); }));
+	}
+
+	SECTION("Stereo")
+	{
+		const CompactWave s16(stereo);
+		const CompactWave f32(stereo, WaveSampleFormat::F32);
+		const CompactWave downmixed(stereo, WaveSampleFormat::S16, true);
+
+		REQUIRE(s16.channels() == 2);
+		REQUIRE(s16.size_bytes() == (stereo.size_bytes() / 2));
+		REQUIRE(f32.channels() == 2);
+		REQUIRE(f32.size_bytes() == stereo.size_bytes());
+		REQUIRE(downmixed.channels() == 1);
+
+		// 範囲外は無音になる
+		Array<WaveSample> samples(16);
+		const size_t pos = (stereo.size() - 5);
+
+		s16.getSamples(pos, samples.size(), samples.data());
+
+		for (size_t i = 0; i < samples.size(); ++i)
+		{
+			const WaveSample expected = (i < 5) ? stereo[pos + i] : WaveSample::Zero();
+
+			REQUIRE(samples[i].left == expected.left);
+			REQUIRE(samples[i].right == expected.right);
+		}
+
+		Array<float> monoSamples(16);
+
+		downmixed.getMonoSamples(100, monoSamples.size(), monoSamples.data());
+
+		for (size_t i = 0; i < monoSamples.size(); ++i)
+		{
+			const WaveSample& sample = stereo[100 + i];
+
+			REQUIRE(monoSamples[i] == Approx((sample.left + sample.right) / 2).margin(1.0 / 32768));
+		}
+	}
+
+	SECTION("FFT")
+	{
+		const CompactWave compact(mono);
+
+		for (const uint32 pos : { 0u, 1000u, static_cast<uint32>(mono.size()) })
+		{
+			FFTResult a, b;
+
+			FFT::Analyze(a, mono, pos);
+			FFT::Analyze(b, compact, pos);
+
+			REQUIRE(a.buffer == b.buffer);
+			REQUIRE(a.samplingRate == b.samplingRate);
+		}
+	}
+
+	SECTION("Audio")
+	{
+		const Audio audio(mono);
+		const Audio compact(CompactWave{ mono });
+
+		REQUIRE(compact.samplingRate() == audio.samplingRate());
+		REQUIRE(compact.samples() == audio.samples());
+		REQUIRE(compact.residentBytes() <= audio.residentBytes());
+
+		// CompactWave のまま再生できないプラットフォームでは Wave に変換される
+		if (compact.getCompactWave())
+		{
+			REQUIRE(compact.getWave().isEmpty());
+			REQUIRE(compact.residentBytes() == (audio.residentBytes() / 4));
+		}
+	}
+}
+
+TEST_CASE("CompactWave.Benchmark", "[.benchmark]")
+{
+	// 効果音 3000 個: 8 割は 16 ビットモノラル 22.05 kHz、残りはステレオ 44.1 kHz
+	constexpr size_t NumSoundEffects = 3000;
+
+	size_t waveBytes = 0, compactBytes = 0, totalSamples = 0;
+	double seconds = 0.0;
+	Array<CompactWave> compactWaves;
+
+	for (size_t i = 0; i < NumSoundEffects; ++i)
+	{
+		const bool stereo = ((i % 5) == 0);
+		const Wave wave = TestWave::MakeSoundEffect(i, stereo, stereo ? 44100 : 22050);
+
+		compactWaves.emplace_back(wave);
+
+		waveBytes += wave.size_bytes();
+		compactBytes += compactWaves.back().size_bytes();
+		totalSamples += wave.size();
+		seconds += wave.lengthSec();
+	}
+
+	Console << U"{} sound effects ({:.0f} s): Wave {:.1f} MiB, CompactWave {:.1f} MiB ({:.2f}x smaller)"_fmt(
+		NumSoundEffects, seconds, waveBytes / 1048576.0, compactBytes / 1048576.0, static_cast<double>(waveBytes) / compactBytes);
+
+	// ミキサーと同じく 4096 サンプルずつ float のステレオに変換する
+	Array<WaveSample> buffer(4096);
+	const MicrosecClock clock;
+
+	for (const auto& compact : compactWaves)
+	{
+		for (size_t pos = 0; pos < compact.samples(); pos += buffer.size())
+		{
+			compact.getSamples(pos, buffer.size(), buffer.data());
+		}
+	}
+
+	Console << U"conversion: {:.0f} M samples/s"_fmt(totalSamples / static_cast<double>(clock.us()));
+}
+
+# endif